@@ -0,0 +1,489 @@
+#include "AssetBundle.h"
+#include "AssetCache.h"
+#include "Compression.h"
+#include "../Core/Profiling/Profiler.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BGE {
+
+namespace {
+
+constexpr uint32_t BUNDLE_MAGIC = 0x42454742;     // "BGEB"
+constexpr uint32_t BUNDLE_VERSION = 1;
+constexpr uint16_t ENTRY_COMPRESSED = 1 << 0;
+
+struct BundleHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t alignment;
+    uint64_t tocOffset;
+    uint64_t tocSize;
+    uint64_t tocHash;
+    uint8_t reserved[24];
+};
+static_assert(sizeof(BundleHeader) == 64, "bundle header layout is part of the file format");
+
+// Followed in the table of contents by the dependency indices, then the strings
+struct BundleTocEntry {
+    uint64_t offset;
+    uint64_t storedSize;
+    uint64_t rawSize;
+    uint64_t contentHash;
+    uint32_t pathOffset;        // into the string table
+    uint32_t pathLength;
+    uint32_t handleOffset;
+    uint32_t handleLength;
+    uint32_t firstDependency;   // into the dependency table, which holds entry indices
+    uint32_t dependencyCount;
+    uint16_t type;
+    uint16_t flags;
+    uint32_t reserved;
+};
+static_assert(sizeof(BundleTocEntry) == 64, "bundle entry layout is part of the file format");
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // anonymous namespace
+
+AssetBundle::~AssetBundle() {
+    Close();
+}
+
+bool AssetBundle::Open(const std::string& path, AccessMode mode) {
+    BGE_PROFILE_SCOPE("AssetBundle::Open");
+    Close();
+    m_path = path;
+    m_mode = mode;
+    
+    if (mode == AccessMode::Mapped) {
+        if (!m_mapping.Open(path)) {
+            std::cerr << "Could not map asset bundle " << path << std::endl;
+            return false;
+        }
+        m_fileSize = m_mapping.GetSize();
+    } else {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+        LARGE_INTEGER size;
+        if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size)) {
+            if (file != INVALID_HANDLE_VALUE) {
+                CloseHandle(file);
+            }
+            std::cerr << "Could not open asset bundle " << path << std::endl;
+            return false;
+        }
+        m_fileHandle = file;
+        m_fileSize = static_cast<uint64_t>(size.QuadPart);
+#else
+        m_fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat info;
+        if (m_fd < 0 || fstat(m_fd, &info) != 0) {
+            std::cerr << "Could not open asset bundle " << path << std::endl;
+            Close();
+            return false;
+        }
+        m_fileSize = static_cast<uint64_t>(info.st_size);
+#endif
+    }
+    
+    BundleHeader header;
+    if (m_fileSize < sizeof(header) || !ReadAt(0, sizeof(header), &header) ||
+        header.magic != BUNDLE_MAGIC || header.version != BUNDLE_VERSION ||
+        header.alignment == 0 || (header.alignment & (header.alignment - 1)) != 0 ||
+        header.tocOffset > m_fileSize || header.tocSize > m_fileSize - header.tocOffset) {
+        std::cerr << "Not a valid asset bundle: " << path << std::endl;
+        Close();
+        return false;
+    }
+    m_alignment = header.alignment;
+    
+    // The table of contents is read once; in mapped mode it is already in memory
+    std::vector<unsigned char> tocBuffer;
+    const unsigned char* toc = nullptr;
+    if (m_mode == AccessMode::Mapped) {
+        toc = m_mapping.GetData() + header.tocOffset;
+    } else {
+        tocBuffer.resize(static_cast<size_t>(header.tocSize));
+        if (!ReadAt(header.tocOffset, tocBuffer.size(), tocBuffer.data())) {
+            Close();
+            return false;
+        }
+        toc = tocBuffer.data();
+    }
+    
+    if (AssetCache::HashBytes(toc, static_cast<size_t>(header.tocSize)) != header.tocHash ||
+        !ParseTableOfContents(toc, static_cast<size_t>(header.tocSize), header.entryCount)) {
+        std::cerr << "Asset bundle " << path << " has a corrupt table of contents" << std::endl;
+        Close();
+        return false;
+    }
+    
+    m_open = true;
+    return true;
+}
+
+void AssetBundle::Close() {
+    m_mapping.Close();
+#if defined(_WIN32)
+    if (m_fileHandle) {
+        CloseHandle(m_fileHandle);
+        m_fileHandle = nullptr;
+    }
+#else
+    if (m_fd >= 0) {
+        close(m_fd);
+        m_fd = -1;
+    }
+#endif
+    m_entries.clear();
+    m_byHandle.clear();
+    m_byPath.clear();
+    m_fileSize = 0;
+    m_alignment = 1;
+    m_open = false;
+}
+
+bool AssetBundle::ParseTableOfContents(const unsigned char* data, size_t size, uint32_t entryCount) {
+    size_t entriesSize = static_cast<size_t>(entryCount) * sizeof(BundleTocEntry);
+    if (entriesSize > size) {
+        return false;
+    }
+    
+    std::vector<BundleTocEntry> records(entryCount);
+    if (entryCount > 0) {
+        std::memcpy(records.data(), data, entriesSize);
+    }
+    
+    // Dependency table, then strings
+    uint64_t dependencyTotal = 0;
+    for (const BundleTocEntry& record : records) {
+        dependencyTotal = std::max<uint64_t>(dependencyTotal, uint64_t(record.firstDependency) + record.dependencyCount);
+    }
+    if (dependencyTotal > size / sizeof(uint32_t)) {
+        return false;
+    }
+    size_t dependenciesSize = static_cast<size_t>(dependencyTotal) * sizeof(uint32_t);
+    if (dependenciesSize > size - entriesSize) {
+        return false;
+    }
+    const unsigned char* dependencyTable = data + entriesSize;
+    const char* strings = reinterpret_cast<const char*>(dependencyTable + dependenciesSize);
+    size_t stringsSize = size - entriesSize - dependenciesSize;
+    
+    m_entries.resize(entryCount);
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        const BundleTocEntry& record = records[i];
+        if (record.pathOffset > stringsSize || record.pathLength > stringsSize - record.pathOffset ||
+            record.handleOffset > stringsSize || record.handleLength > stringsSize - record.handleOffset ||
+            record.offset > m_fileSize || record.storedSize > m_fileSize - record.offset) {
+            return false;
+        }
+        
+        AssetBundleEntry& entry = m_entries[i];
+        entry.path.assign(strings + record.pathOffset, record.pathLength);
+        entry.handle = AssetHandle::FromString(std::string(strings + record.handleOffset, record.handleLength));
+        entry.type = static_cast<AssetType>(record.type);
+        entry.offset = record.offset;
+        entry.storedSize = record.storedSize;
+        entry.rawSize = record.rawSize;
+        entry.contentHash = record.contentHash;
+        entry.compressed = (record.flags & ENTRY_COMPRESSED) != 0;
+        entry.dependencies.resize(record.dependencyCount);
+        if (record.dependencyCount > 0) {
+            std::memcpy(entry.dependencies.data(), dependencyTable + record.firstDependency * sizeof(uint32_t),
+                        record.dependencyCount * sizeof(uint32_t));
+        }
+        for (uint32_t dependency : entry.dependencies) {
+            if (dependency >= entryCount) {
+                return false;
+            }
+        }
+        
+        m_byHandle[entry.handle] = i;
+        m_byPath[entry.path] = i;
+    }
+    return true;
+}
+
+const AssetBundleEntry* AssetBundle::Find(const AssetHandle& handle) const {
+    auto it = m_byHandle.find(handle);
+    return it != m_byHandle.end() ? &m_entries[it->second] : nullptr;
+}
+
+const AssetBundleEntry* AssetBundle::FindPath(const std::string& relativePath) const {
+    auto it = m_byPath.find(relativePath);
+    return it != m_byPath.end() ? &m_entries[it->second] : nullptr;
+}
+
+bool AssetBundle::ReadEntry(const AssetBundleEntry& entry, std::vector<char>& data) const {
+    BGE_PROFILE_SCOPE("AssetBundle::ReadEntry");
+    data.resize(static_cast<size_t>(entry.rawSize));
+    if (!entry.compressed) {
+        return ReadAt(entry.offset, data.size(), data.data());
+    }
+    
+    const unsigned char* stored = nullptr;
+    std::vector<unsigned char> storedBuffer;
+    if (m_mode == AccessMode::Mapped) {
+        stored = m_mapping.GetData() + entry.offset;
+    } else {
+        storedBuffer.resize(static_cast<size_t>(entry.storedSize));
+        if (!ReadAt(entry.offset, storedBuffer.size(), storedBuffer.data())) {
+            return false;
+        }
+        stored = storedBuffer.data();
+    }
+    
+    if (!Compression::Decompress(stored, static_cast<size_t>(entry.storedSize),
+                                 reinterpret_cast<unsigned char*>(data.data()), data.size())) {
+        std::cerr << "Corrupt entry " << entry.path << " in asset bundle " << m_path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+const unsigned char* AssetBundle::GetMappedData(const AssetBundleEntry& entry) const {
+    if (m_mode != AccessMode::Mapped || entry.compressed || !m_mapping.IsOpen()) {
+        return nullptr;
+    }
+    return m_mapping.GetData() + entry.offset;
+}
+
+bool AssetBundle::ReadAt(uint64_t offset, size_t size, void* destination) const {
+    if (offset > m_fileSize || size > m_fileSize - offset) {
+        return false;
+    }
+    if (size == 0) {
+        return true;
+    }
+    
+    if (m_mode == AccessMode::Mapped) {
+        std::memcpy(destination, m_mapping.GetData() + offset, size);
+        return true;
+    }
+    
+    // Positional reads share the handle between threads without a lock
+    auto* cursor = static_cast<char*>(destination);
+    while (size > 0) {
+#if defined(_WIN32)
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+        DWORD read = 0;
+        if (!ReadFile(m_fileHandle, cursor, chunk, &read, &overlapped) || read == 0) {
+            return false;
+        }
+#else
+        ssize_t read = pread(m_fd, cursor, size, static_cast<off_t>(offset));
+        if (read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (read <= 0) {
+            return false;
+        }
+#endif
+        cursor += read;
+        offset += static_cast<uint64_t>(read);
+        size -= static_cast<size_t>(read);
+    }
+    return true;
+}
+
+void AssetBundleWriter::AddEntry(const AssetHandle& handle, AssetType type, const std::string& relativePath,
+                                 std::vector<char> data, const std::vector<AssetHandle>& dependencies) {
+    PendingEntry entry;
+    entry.handle = handle;
+    entry.type = type;
+    entry.path = relativePath;
+    entry.data = std::move(data);
+    entry.dependencies = dependencies;
+    m_pending.push_back(std::move(entry));
+}
+
+std::vector<size_t> AssetBundleWriter::GetWriteOrder() const {
+    std::vector<size_t> byPath(m_pending.size());
+    for (size_t i = 0; i < byPath.size(); ++i) {
+        byPath[i] = i;
+    }
+    std::sort(byPath.begin(), byPath.end(), [this](size_t a, size_t b) {
+        return m_pending[a].path < m_pending[b].path;
+    });
+    
+    std::unordered_map<AssetHandle, size_t, AssetHandleHash> indexOf;
+    for (size_t i = 0; i < m_pending.size(); ++i) {
+        indexOf[m_pending[i].handle] = i;
+    }
+    
+    // Depth-first post-order; a dependency cycle is cut where it is found
+    std::vector<size_t> order;
+    std::vector<uint8_t> state(m_pending.size(), 0);     // 0 new, 1 visiting, 2 written
+    std::function<void(size_t)> visit = [&](size_t index) {
+        if (state[index] != 0) {
+            return;
+        }
+        state[index] = 1;
+        for (const AssetHandle& dependency : m_pending[index].dependencies) {
+            auto it = indexOf.find(dependency);
+            if (it != indexOf.end()) {
+                visit(it->second);
+            }
+        }
+        state[index] = 2;
+        order.push_back(index);
+    };
+    for (size_t index : byPath) {
+        visit(index);
+    }
+    return order;
+}
+
+bool AssetBundleWriter::Write(const std::string& path, const Options& options) const {
+    BGE_PROFILE_SCOPE("AssetBundleWriter::Write");
+    uint32_t alignment = std::max<uint32_t>(options.alignment, 1);
+    if ((alignment & (alignment - 1)) != 0) {
+        std::cerr << "Bundle alignment must be a power of two, got " << alignment << std::endl;
+        return false;
+    }
+    
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Could not write asset bundle " << path << std::endl;
+        return false;
+    }
+    
+    std::vector<size_t> order = GetWriteOrder();
+    std::vector<uint32_t> position(m_pending.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        position[order[i]] = static_cast<uint32_t>(i);
+    }
+    std::unordered_map<AssetHandle, size_t, AssetHandleHash> indexOf;
+    for (size_t i = 0; i < m_pending.size(); ++i) {
+        indexOf[m_pending[i].handle] = i;
+    }
+    
+    BundleHeader header = {};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t cursor = sizeof(header);
+    
+    std::vector<BundleTocEntry> records;
+    std::vector<uint32_t> dependencyTable;
+    std::string strings;
+    std::vector<unsigned char> compressed;
+    static const char padding[4096] = {};
+    
+    for (size_t index : order) {
+        const PendingEntry& entry = m_pending[index];
+        
+        uint64_t aligned = AlignUp(cursor, alignment);
+        while (cursor < aligned) {
+            size_t chunk = static_cast<size_t>(std::min<uint64_t>(aligned - cursor, sizeof(padding)));
+            file.write(padding, static_cast<std::streamsize>(chunk));
+            cursor += chunk;
+        }
+        
+        BundleTocEntry record = {};
+        record.offset = cursor;
+        record.rawSize = entry.data.size();
+        record.contentHash = AssetCache::HashBytes(entry.data.data(), entry.data.size());
+        record.type = static_cast<uint16_t>(entry.type);
+        
+        const char* stored = entry.data.data();
+        size_t storedSize = entry.data.size();
+        if (options.compress && !entry.data.empty()) {
+            compressed.resize(Compression::CompressBound(entry.data.size()));
+            size_t compressedSize = Compression::Compress(entry.data.data(), entry.data.size(),
+                                                          compressed.data(), compressed.size());
+            if (compressedSize > 0 && compressedSize <= entry.data.size() - entry.data.size() / 8) {
+                stored = reinterpret_cast<const char*>(compressed.data());
+                storedSize = compressedSize;
+                record.flags |= ENTRY_COMPRESSED;
+            }
+        }
+        record.storedSize = storedSize;
+        file.write(stored, static_cast<std::streamsize>(storedSize));
+        cursor += storedSize;
+        
+        record.pathOffset = static_cast<uint32_t>(strings.size());
+        record.pathLength = static_cast<uint32_t>(entry.path.size());
+        strings += entry.path;
+        std::string handle = entry.handle.ToString();
+        record.handleOffset = static_cast<uint32_t>(strings.size());
+        record.handleLength = static_cast<uint32_t>(handle.size());
+        strings += handle;
+        
+        record.firstDependency = static_cast<uint32_t>(dependencyTable.size());
+        for (const AssetHandle& dependency : entry.dependencies) {
+            auto it = indexOf.find(dependency);
+            if (it != indexOf.end()) {
+                dependencyTable.push_back(position[it->second]);
+            }
+        }
+        record.dependencyCount = static_cast<uint32_t>(dependencyTable.size()) - record.firstDependency;
+        records.push_back(record);
+    }
+    
+    std::vector<unsigned char> toc(records.size() * sizeof(BundleTocEntry) +
+                                   dependencyTable.size() * sizeof(uint32_t) + strings.size());
+    unsigned char* out = toc.data();
+    if (!records.empty()) {
+        std::memcpy(out, records.data(), records.size() * sizeof(BundleTocEntry));
+        out += records.size() * sizeof(BundleTocEntry);
+    }
+    if (!dependencyTable.empty()) {
+        std::memcpy(out, dependencyTable.data(), dependencyTable.size() * sizeof(uint32_t));
+        out += dependencyTable.size() * sizeof(uint32_t);
+    }
+    if (!strings.empty()) {
+        std::memcpy(out, strings.data(), strings.size());
+    }
+    
+    header.magic = BUNDLE_MAGIC;
+    header.version = BUNDLE_VERSION;
+    header.entryCount = static_cast<uint32_t>(records.size());
+    header.alignment = alignment;
+    header.tocOffset = cursor;
+    header.tocSize = toc.size();
+    header.tocHash = AssetCache::HashBytes(toc.data(), toc.size());
+    
+    file.write(reinterpret_cast<const char*>(toc.data()), static_cast<std::streamsize>(toc.size()));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (!file) {
+        std::cerr << "Could not write asset bundle " << path << std::endl;
+        return false;
+    }
+    
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::cerr << "Could not replace asset bundle " << path << ": " << ec.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace BGE
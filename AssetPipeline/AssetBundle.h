@@ -0,0 +1,115 @@
+#pragma once
+
+#include "AssetHandle.h"
+#include "MappedFile.h"
+#include "../Core/AssetTypes.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BGE {
+
+// One file in a bundle's table of contents
+struct AssetBundleEntry {
+    AssetHandle handle;
+    std::string path;                       // relative to the assets directory, '/' separated
+    AssetType type = AssetType::Unknown;
+    uint64_t offset = 0;                    // from the start of the archive, a multiple of the bundle's alignment
+    uint64_t storedSize = 0;
+    uint64_t rawSize = 0;
+    uint64_t contentHash = 0;               // AssetCache::HashBytes of the raw bytes
+    bool compressed = false;
+    std::vector<uint32_t> dependencies;     // entry indices; earlier entries unless there was a cycle
+};
+
+// Read side of an asset bundle: many assets packed into one archive so a
+// shipping build opens one file instead of thousands.
+//
+// Layout: a fixed header, the entries (each aligned, optionally compressed),
+// then the table of contents. Entries are stored in dependency order, so
+// every asset comes after the assets it refers to and a front-to-back read
+// never seeks backwards. The archive is memory-mapped by default; Streamed
+// mode reads entries with pread() instead, for archives that should not be
+// mapped (very large files, or filesystems where mmap performs poorly).
+// ReadEntry() may be called from any thread.
+class AssetBundle {
+public:
+    enum class AccessMode {
+        Mapped,
+        Streamed
+    };
+    
+    AssetBundle() = default;
+    ~AssetBundle();
+    
+    AssetBundle(const AssetBundle&) = delete;
+    AssetBundle& operator=(const AssetBundle&) = delete;
+    
+    bool Open(const std::string& path, AccessMode mode = AccessMode::Mapped);
+    void Close();
+    bool IsOpen() const { return m_open; }
+    
+    const std::string& GetPath() const { return m_path; }
+    uint32_t GetAlignment() const { return m_alignment; }
+    const std::vector<AssetBundleEntry>& GetEntries() const { return m_entries; }
+    const AssetBundleEntry* Find(const AssetHandle& handle) const;
+    const AssetBundleEntry* FindPath(const std::string& relativePath) const;
+    
+    // Copies the entry's bytes out, decompressing if needed
+    bool ReadEntry(const AssetBundleEntry& entry, std::vector<char>& data) const;
+    // The entry in place, for uncompressed entries of a mapped bundle; null otherwise
+    const unsigned char* GetMappedData(const AssetBundleEntry& entry) const;
+
+private:
+    bool ReadAt(uint64_t offset, size_t size, void* destination) const;
+    bool ParseTableOfContents(const unsigned char* data, size_t size, uint32_t entryCount);
+    
+    std::string m_path;
+    AccessMode m_mode = AccessMode::Mapped;
+    bool m_open = false;
+    uint64_t m_fileSize = 0;
+    uint32_t m_alignment = 1;
+    
+    MappedFile m_mapping;
+#if defined(_WIN32)
+    void* m_fileHandle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+
+    std::vector<AssetBundleEntry> m_entries;
+    std::unordered_map<AssetHandle, uint32_t, AssetHandleHash> m_byHandle;
+    std::unordered_map<std::string, uint32_t> m_byPath;
+};
+
+// Write side: collects assets and writes them as one bundle
+class AssetBundleWriter {
+public:
+    struct Options {
+        uint32_t alignment = 64;            // power of two; 4096 lines entries up with pages
+        bool compress = false;              // kept only when it saves at least 1/8
+    };
+    
+    void AddEntry(const AssetHandle& handle, AssetType type, const std::string& relativePath,
+                  std::vector<char> data, const std::vector<AssetHandle>& dependencies);
+    size_t GetEntryCount() const { return m_pending.size(); }
+    
+    bool Write(const std::string& path, const Options& options) const;
+
+private:
+    struct PendingEntry {
+        AssetHandle handle;
+        AssetType type;
+        std::string path;
+        std::vector<char> data;
+        std::vector<AssetHandle> dependencies;
+    };
+    
+    // Dependencies before dependents, ties broken by path so output is reproducible
+    std::vector<size_t> GetWriteOrder() const;
+    
+    std::vector<PendingEntry> m_pending;
+};
+
+} // namespace BGE
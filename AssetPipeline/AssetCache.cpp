@@ -0,0 +1,368 @@
+#include "AssetCache.h"
+#include "Compression.h"
+#include "../Core/Profiling/Profiler.h"
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace BGE {
+
+namespace {
+
+constexpr uint32_t COOKED_MAGIC = 0x43454742;  // "BGEC"
+constexpr uint16_t COOKED_FORMAT_VERSION = 1;
+constexpr uint32_t COOKED_COMPRESSED = 1u << 0;
+constexpr const char* INDEX_FILE_NAME = "sources.idx";
+
+// Fixed-size entry header; the payload follows at a 64-byte offset
+struct CookedHeader {
+    uint32_t magic;
+    uint16_t formatVersion;
+    uint16_t assetType;
+    uint32_t cookVersion;
+    uint32_t flags;
+    uint64_t key;
+    uint64_t storedSize;    // payload bytes in the file
+    uint64_t rawSize;       // payload bytes once decompressed
+    uint8_t reserved[24];
+};
+static_assert(sizeof(CookedHeader) == 64, "Cooked payloads start 64-byte aligned");
+
+constexpr uint64_t PRIME1 = 11400714785074694791ULL;
+constexpr uint64_t PRIME2 = 14029467366897019727ULL;
+constexpr uint64_t PRIME3 = 1609587929392839161ULL;
+constexpr uint64_t PRIME4 = 9650029242287828579ULL;
+constexpr uint64_t PRIME5 = 2870177450012600261ULL;
+
+uint64_t RotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t Read64(const unsigned char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Read32(const unsigned char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t HashRound(uint64_t accumulator, uint64_t input) {
+    accumulator += input * PRIME2;
+    accumulator = RotateLeft(accumulator, 31);
+    return accumulator * PRIME1;
+}
+
+uint64_t HashMerge(uint64_t accumulator, uint64_t value) {
+    accumulator ^= HashRound(0, value);
+    return accumulator * PRIME1 + PRIME4;
+}
+
+int64_t GetFileTicks(std::filesystem::file_time_type time) {
+    return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+std::string ToHex(uint64_t value) {
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << value;
+    return stream.str();
+}
+
+} // anonymous namespace
+
+AssetCache::~AssetCache() {
+    Shutdown();
+}
+
+bool AssetCache::Initialize(const std::string& cacheDirectory, bool compress) {
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDirectory, ec);
+    if (!std::filesystem::is_directory(cacheDirectory, ec)) {
+        std::cerr << "Could not create asset cache directory: " << cacheDirectory << std::endl;
+        return false;
+    }
+    
+    m_directory = std::filesystem::absolute(cacheDirectory, ec);
+    m_compress = compress;
+    m_enabled = true;
+    LoadIndex();
+    return true;
+}
+
+void AssetCache::Shutdown() {
+    if (!m_enabled) {
+        return;
+    }
+    SaveIndex();
+    m_enabled = false;
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    m_sources.clear();
+}
+
+uint64_t AssetCache::FindSourceKey(const std::string& sourcePath, AssetType type, uint32_t cookVersion) {
+    std::error_code ec;
+    uint64_t size = std::filesystem::file_size(sourcePath, ec);
+    if (ec) {
+        return 0;
+    }
+    int64_t modified = GetFileTicks(std::filesystem::last_write_time(sourcePath, ec));
+    if (ec) {
+        return 0;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    auto it = m_sources.find(sourcePath);
+    if (it == m_sources.end() || it->second.size != size || it->second.modified != modified) {
+        return 0;
+    }
+    return MakeKey(it->second.contentHash, type, cookVersion);
+}
+
+uint64_t AssetCache::RecordSource(const std::string& sourcePath, const std::vector<char>& sourceData,
+                                  AssetType type, uint32_t cookVersion) {
+    BGE_PROFILE_SCOPE("AssetCache::RecordSource");
+    m_sourceHashes.fetch_add(1, std::memory_order_relaxed);
+    
+    SourceStamp stamp;
+    stamp.size = sourceData.size();
+    stamp.contentHash = HashBytes(sourceData.data(), sourceData.size());
+    
+    // The timestamp read after the bytes may be newer than what we hashed; that only costs a rehash next time
+    std::error_code ec;
+    stamp.modified = GetFileTicks(std::filesystem::last_write_time(sourcePath, ec));
+    if (!ec) {
+        std::lock_guard<std::mutex> lock(m_indexMutex);
+        m_sources[sourcePath] = stamp;
+        m_indexDirty = true;
+    }
+    return MakeKey(stamp.contentHash, type, cookVersion);
+}
+
+std::shared_ptr<const CookedBlob> AssetCache::Load(uint64_t key, AssetType type, uint32_t cookVersion) {
+    BGE_PROFILE_SCOPE("AssetCache::Load");
+    auto blob = std::make_shared<CookedBlob>();
+    if (!blob->m_file.Open(GetEntryPath(key).string()) || blob->m_file.GetSize() < sizeof(CookedHeader)) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    
+    CookedHeader header;
+    std::memcpy(&header, blob->m_file.GetData(), sizeof(header));
+    const unsigned char* stored = blob->m_file.GetData() + sizeof(header);
+    bool valid = header.magic == COOKED_MAGIC && header.formatVersion == COOKED_FORMAT_VERSION &&
+                 header.assetType == static_cast<uint16_t>(type) && header.cookVersion == cookVersion &&
+                 header.key == key && header.storedSize == blob->m_file.GetSize() - sizeof(header);
+    if (!valid) {
+        std::cerr << "Ignoring invalid asset cache entry " << GetEntryPath(key) << std::endl;
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    
+    if (header.flags & COOKED_COMPRESSED) {
+        blob->m_buffer.resize(static_cast<size_t>(header.rawSize));
+        if (!Compression::Decompress(stored, static_cast<size_t>(header.storedSize), blob->m_buffer.data(),
+                                     blob->m_buffer.size())) {
+            std::cerr << "Corrupt asset cache entry " << GetEntryPath(key) << std::endl;
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        blob->m_file.Close();
+        blob->m_data = blob->m_buffer.data();
+        blob->m_size = blob->m_buffer.size();
+    } else {
+        blob->m_data = stored;
+        blob->m_size = static_cast<size_t>(header.storedSize);
+    }
+    blob->m_type = type;
+    
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return blob;
+}
+
+bool AssetCache::Store(uint64_t key, AssetType type, uint32_t cookVersion, const std::vector<char>& payload) {
+    BGE_PROFILE_SCOPE("AssetCache::Store");
+    CookedHeader header = {};
+    header.magic = COOKED_MAGIC;
+    header.formatVersion = COOKED_FORMAT_VERSION;
+    header.assetType = static_cast<uint16_t>(type);
+    header.cookVersion = cookVersion;
+    header.key = key;
+    header.rawSize = payload.size();
+    
+    // Keep compressed data only when it saves at least an eighth
+    std::vector<char> compressed;
+    if (m_compress && !payload.empty()) {
+        compressed.resize(Compression::CompressBound(payload.size()));
+        size_t compressedSize = Compression::Compress(payload.data(), payload.size(), compressed.data(), compressed.size());
+        if (compressedSize > 0 && compressedSize <= payload.size() - payload.size() / 8) {
+            compressed.resize(compressedSize);
+            header.flags |= COOKED_COMPRESSED;
+        } else {
+            compressed.clear();
+        }
+    }
+    const std::vector<char>& stored = (header.flags & COOKED_COMPRESSED) ? compressed : payload;
+    header.storedSize = stored.size();
+    
+    // Write beside the entry and rename over it, so readers never see a partial file
+    std::filesystem::path entryPath = GetEntryPath(key);
+    std::ostringstream tempName;
+    tempName << entryPath.string() << ".tmp" << std::hash<std::thread::id>{}(std::this_thread::get_id());
+    std::filesystem::path tempPath = tempName.str();
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Could not write asset cache entry " << entryPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(stored.data(), static_cast<std::streamsize>(stored.size()));
+        if (!file) {
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+    
+    std::error_code ec;
+    std::filesystem::rename(tempPath, entryPath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    
+    m_stores.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+AssetCacheStats AssetCache::GetStats() const {
+    AssetCacheStats stats;
+    stats.hits = m_hits.load(std::memory_order_relaxed);
+    stats.misses = m_misses.load(std::memory_order_relaxed);
+    stats.stores = m_stores.load(std::memory_order_relaxed);
+    stats.sourceHashes = m_sourceHashes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+uint64_t AssetCache::HashBytes(const void* data, size_t size, uint64_t seed) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+    uint64_t hash;
+    
+    if (size >= 32) {
+        uint64_t v1 = seed + PRIME1 + PRIME2;
+        uint64_t v2 = seed + PRIME2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME1;
+        const unsigned char* limit = end - 32;
+        do {
+            v1 = HashRound(v1, Read64(p));
+            v2 = HashRound(v2, Read64(p + 8));
+            v3 = HashRound(v3, Read64(p + 16));
+            v4 = HashRound(v4, Read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = HashMerge(hash, v1);
+        hash = HashMerge(hash, v2);
+        hash = HashMerge(hash, v3);
+        hash = HashMerge(hash, v4);
+    } else {
+        hash = seed + PRIME5;
+    }
+    
+    hash += static_cast<uint64_t>(size);
+    
+    while (end - p >= 8) {
+        hash ^= HashRound(0, Read64(p));
+        hash = RotateLeft(hash, 27) * PRIME1 + PRIME4;
+        p += 8;
+    }
+    if (end - p >= 4) {
+        hash ^= static_cast<uint64_t>(Read32(p)) * PRIME1;
+        hash = RotateLeft(hash, 23) * PRIME2 + PRIME3;
+        p += 4;
+    }
+    while (p < end) {
+        hash ^= (*p) * PRIME5;
+        hash = RotateLeft(hash, 11) * PRIME1;
+        ++p;
+    }
+    
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t AssetCache::MakeKey(uint64_t contentHash, AssetType type, uint32_t cookVersion) {
+    uint64_t settings[3] = {contentHash, static_cast<uint64_t>(type), cookVersion};
+    uint64_t key = HashBytes(settings, sizeof(settings));
+    return key != 0 ? key : 1;  // 0 means "no key"
+}
+
+std::filesystem::path AssetCache::GetEntryPath(uint64_t key) const {
+    return m_directory / (ToHex(key) + ".bin");
+}
+
+bool AssetCache::LoadIndex() {
+    std::ifstream file(m_directory / INDEX_FILE_NAME);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    // One source per line: content hash, size, timestamp, absolute path
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        SourceStamp stamp;
+        std::string path;
+        if (stream >> std::hex >> stamp.contentHash >> std::dec >> stamp.size >> stamp.modified) {
+            stream.get();
+            std::getline(stream, path);
+            if (!path.empty()) {
+                m_sources[path] = stamp;
+            }
+        }
+    }
+    m_indexDirty = false;
+    return true;
+}
+
+void AssetCache::SaveIndex() {
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    if (!m_indexDirty) {
+        return;
+    }
+    
+    std::filesystem::path indexPath = m_directory / INDEX_FILE_NAME;
+    std::filesystem::path tempPath = indexPath;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Could not write asset cache index " << indexPath << std::endl;
+            return;
+        }
+        for (const auto& [path, stamp] : m_sources) {
+            file << ToHex(stamp.contentHash) << ' ' << stamp.size << ' ' << stamp.modified << ' ' << path << '\n';
+        }
+    }
+    
+    std::error_code ec;
+    std::filesystem::rename(tempPath, indexPath, ec);
+    m_indexDirty = ec.value() != 0;
+}
+
+} // namespace BGE
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "../Core/AssetTypes.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BGE {
+
+// Payload of one cache entry: mapped straight from disk, or decompressed
+class CookedBlob {
+public:
+    const unsigned char* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+    AssetType GetType() const { return m_type; }
+
+private:
+    friend class AssetCache;
+    
+    MappedFile m_file;
+    std::vector<unsigned char> m_buffer;    // compressed entries only
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+    AssetType m_type = AssetType::Unknown;
+};
+
+struct AssetCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stores = 0;
+    uint64_t sourceHashes = 0;  // sources read and hashed because their size or timestamp changed
+};
+
+// Content-addressed store of cooked (import-processed) assets.
+//
+// Entries are keyed by a hash of the source file's bytes, the asset type and
+// the loader's cook version, so renaming or touching a file, or switching
+// branches back and forth, finds the existing entry. A small index remembers
+// each source's size, timestamp and content hash, so an unchanged source is
+// matched to its entry without being read at all. Entries are written once
+// (to a temporary file, then renamed) and memory-mapped when loaded;
+// uncompressed payloads are used in place. Stale entries are never deleted
+// automatically; removing the cache directory resets it.
+class AssetCache {
+public:
+    AssetCache() = default;
+    ~AssetCache();
+    
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+    
+    bool Initialize(const std::string& cacheDirectory, bool compress);
+    void Shutdown();
+    bool IsEnabled() const { return m_enabled; }
+    
+    // Key for `sourcePath` if its size and timestamp match the index, without reading it; 0 otherwise
+    uint64_t FindSourceKey(const std::string& sourcePath, AssetType type, uint32_t cookVersion);
+    // Hashes the source bytes, remembers them in the index and returns the key
+    uint64_t RecordSource(const std::string& sourcePath, const std::vector<char>& sourceData,
+                          AssetType type, uint32_t cookVersion);
+    
+    std::shared_ptr<const CookedBlob> Load(uint64_t key, AssetType type, uint32_t cookVersion);
+    bool Store(uint64_t key, AssetType type, uint32_t cookVersion, const std::vector<char>& payload);
+    
+    AssetCacheStats GetStats() const;
+    
+    // 64-bit XXH64 hash
+    static uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0);
+    // Key for source bytes already hashed with HashBytes(), e.g. by an asset bundle
+    static uint64_t MakeKey(uint64_t contentHash, AssetType type, uint32_t cookVersion);
+
+private:
+    struct SourceStamp {
+        uint64_t size = 0;
+        int64_t modified = 0;   // file clock ticks
+        uint64_t contentHash = 0;
+    };
+    
+    std::filesystem::path GetEntryPath(uint64_t key) const;
+    bool LoadIndex();
+    void SaveIndex();
+    
+    std::filesystem::path m_directory;
+    bool m_enabled = false;
+    bool m_compress = false;
+    
+    std::mutex m_indexMutex;
+    std::unordered_map<std::string, SourceStamp> m_sources;
+    bool m_indexDirty = false;
+    
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+    std::atomic<uint64_t> m_stores{0};
+    std::atomic<uint64_t> m_sourceHashes{0};
+};
+
+} // namespace BGE
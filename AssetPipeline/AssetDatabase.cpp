@@ -0,0 +1,269 @@
+#include "AssetDatabase.h"
+#include "../Core/Profiling/Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace BGE {
+
+namespace {
+
+constexpr uint32_t DATABASE_MAGIC = 0x49454742;    // "BGEI"
+constexpr uint32_t DATABASE_VERSION = 1;
+
+const std::vector<std::string> EMPTY_CHILDREN;
+
+class Writer {
+public:
+    explicit Writer(std::ofstream& file) : m_file(file) {}
+    
+    template<typename T>
+    void Put(const T& value) { m_file.write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+    void PutString(const std::string& text) {
+        uint32_t length = static_cast<uint32_t>(text.size());
+        Put(length);
+        m_file.write(text.data(), length);
+    }
+
+private:
+    std::ofstream& m_file;
+};
+
+class Reader {
+public:
+    explicit Reader(std::ifstream& file) : m_file(file) {}
+    
+    template<typename T>
+    bool Get(T& value) { return static_cast<bool>(m_file.read(reinterpret_cast<char*>(&value), sizeof(T))); }
+    bool GetString(std::string& text) {
+        uint32_t length = 0;
+        if (!Get(length) || length > (1u << 20)) {
+            return false;
+        }
+        text.resize(length);
+        return static_cast<bool>(m_file.read(text.data(), length));
+    }
+
+private:
+    std::ifstream& m_file;
+};
+
+} // anonymous namespace
+
+bool AssetDatabase::Load(const std::string& databasePath, const std::string& assetsDirectory) {
+    BGE_PROFILE_SCOPE("AssetDatabase::Load");
+    Clear();
+    m_databasePath = databasePath;
+    m_assetsDirectory = assetsDirectory;
+    
+    std::ifstream file(databasePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    Reader reader(file);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (!reader.Get(magic) || !reader.Get(version) || !reader.Get(count) ||
+        magic != DATABASE_MAGIC || version != DATABASE_VERSION) {
+        std::cerr << "Ignoring outdated asset database " << databasePath << std::endl;
+        return false;
+    }
+    
+    std::filesystem::path root(m_assetsDirectory);
+    m_records.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        AssetRecord record;
+        std::string relativePath;
+        std::string handle;
+        uint8_t type = 0;
+        uint8_t isDirectory = 0;
+        uint32_t dependencyCount = 0;
+        bool ok = reader.GetString(relativePath) && reader.GetString(handle) && reader.Get(type) &&
+                  reader.Get(isDirectory) && reader.Get(record.version) && reader.GetString(record.importerSettings) &&
+                  reader.Get(record.size) && reader.Get(record.modified) && reader.Get(record.metaModified) &&
+                  reader.Get(record.contentHash) && reader.Get(dependencyCount);
+        for (uint32_t d = 0; ok && d < dependencyCount; ++d) {
+            std::string dependency;
+            ok = reader.GetString(dependency);
+            record.dependencies.push_back(AssetHandle::FromString(dependency));
+        }
+        if (!ok) {
+            std::cerr << "Asset database " << databasePath << " is truncated; rescanning everything" << std::endl;
+            Clear();
+            return false;
+        }
+        
+        record.path = relativePath.empty() ? m_assetsDirectory : (root / relativePath).string();
+        record.handle = handle.empty() ? AssetHandle() : AssetHandle::FromString(handle);
+        record.type = static_cast<AssetType>(type);
+        record.isDirectory = isDirectory != 0;
+        // A folder may already exist, created for one of its children read earlier
+        auto [it, inserted] = m_records.try_emplace(record.path);
+        it->second = std::move(record);
+        if (inserted) {
+            LinkToParent(it->first);
+        }
+    }
+    
+    m_dirty = false;
+    ++m_revision;
+    return true;
+}
+
+bool AssetDatabase::Save() {
+    if (!m_dirty || m_databasePath.empty()) {
+        return true;
+    }
+    BGE_PROFILE_SCOPE("AssetDatabase::Save");
+    
+    std::error_code ec;
+    std::filesystem::path databasePath(m_databasePath);
+    if (databasePath.has_parent_path()) {
+        std::filesystem::create_directories(databasePath.parent_path(), ec);
+    }
+    
+    std::filesystem::path tempPath = databasePath;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Could not write asset database " << m_databasePath << std::endl;
+            return false;
+        }
+        
+        Writer writer(file);
+        writer.Put(DATABASE_MAGIC);
+        writer.Put(DATABASE_VERSION);
+        writer.Put(static_cast<uint32_t>(m_records.size()));
+        for (const auto& [path, record] : m_records) {
+            // The assets directory itself is stored as ""
+            std::string relativePath = path == m_assetsDirectory ? std::string()
+                : std::filesystem::path(path).lexically_relative(m_assetsDirectory).generic_string();
+            writer.PutString(relativePath);
+            writer.PutString(record.handle.ToString());
+            writer.Put(static_cast<uint8_t>(record.type));
+            writer.Put(static_cast<uint8_t>(record.isDirectory ? 1 : 0));
+            writer.Put(record.version);
+            writer.PutString(record.importerSettings);
+            writer.Put(record.size);
+            writer.Put(record.modified);
+            writer.Put(record.metaModified);
+            writer.Put(record.contentHash);
+            writer.Put(static_cast<uint32_t>(record.dependencies.size()));
+            for (const AssetHandle& dependency : record.dependencies) {
+                writer.PutString(dependency.ToString());
+            }
+        }
+        if (!file) {
+            return false;
+        }
+    }
+    
+    std::filesystem::rename(tempPath, databasePath, ec);
+    if (ec) {
+        std::cerr << "Could not replace asset database " << m_databasePath << ": " << ec.message() << std::endl;
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+void AssetDatabase::Clear() {
+    m_records.clear();
+    m_children.clear();
+    m_dirty = true;
+    ++m_revision;
+}
+
+const AssetRecord* AssetDatabase::Find(const std::string& path) const {
+    auto it = m_records.find(path);
+    return it != m_records.end() ? &it->second : nullptr;
+}
+
+void AssetDatabase::Upsert(AssetRecord record) {
+    std::string path = record.path;
+    auto it = m_records.find(path);
+    if (it != m_records.end()) {
+        it->second = std::move(record);
+    } else {
+        m_records.emplace(path, std::move(record));
+        LinkToParent(path);
+    }
+    m_dirty = true;
+    ++m_revision;
+}
+
+void AssetDatabase::Remove(const std::string& path) {
+    auto it = m_records.find(path);
+    if (it == m_records.end()) {
+        return;
+    }
+    
+    if (it->second.isDirectory) {
+        auto children = m_children.find(path);
+        if (children != m_children.end()) {
+            std::vector<std::string> childPaths = std::move(children->second);
+            m_children.erase(children);
+            for (const std::string& child : childPaths) {
+                Remove(child);
+            }
+        }
+    }
+    
+    UnlinkFromParent(path);
+    m_records.erase(path);
+    m_dirty = true;
+    ++m_revision;
+}
+
+const std::vector<std::string>& AssetDatabase::GetChildren(const std::string& directory) const {
+    auto it = m_children.find(directory);
+    return it != m_children.end() ? it->second : EMPTY_CHILDREN;
+}
+
+bool AssetDatabase::HasSubdirectories(const std::string& directory) const {
+    for (const std::string& child : GetChildren(directory)) {
+        const AssetRecord* record = Find(child);
+        if (record && record->isDirectory) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AssetDatabase::LinkToParent(const std::string& path) {
+    if (path == m_assetsDirectory) {
+        return;
+    }
+    std::string parent = std::filesystem::path(path).parent_path().string();
+    m_children[parent].push_back(path);
+    
+    // A file reported on its own (e.g. by the file watcher) brings its folders with it
+    if (parent != m_assetsDirectory && parent.size() > m_assetsDirectory.size() && !m_records.count(parent)) {
+        AssetRecord folder;
+        folder.path = parent;
+        folder.isDirectory = true;
+        folder.type = AssetType::Folder;
+        m_records.emplace(parent, std::move(folder));
+        LinkToParent(parent);
+    }
+}
+
+void AssetDatabase::UnlinkFromParent(const std::string& path) {
+    std::string parent = std::filesystem::path(path).parent_path().string();
+    auto it = m_children.find(parent);
+    if (it == m_children.end()) {
+        return;
+    }
+    auto& siblings = it->second;
+    auto position = std::find(siblings.begin(), siblings.end(), path);
+    if (position != siblings.end()) {
+        *position = std::move(siblings.back());
+        siblings.pop_back();
+    }
+}
+
+} // namespace BGE
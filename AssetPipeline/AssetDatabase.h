@@ -0,0 +1,73 @@
+#pragma once
+
+#include "AssetHandle.h"
+#include "../Core/AssetTypes.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BGE {
+
+// One file or folder under the assets directory, as last seen on disk
+struct AssetRecord {
+    std::string path;                   // absolute
+    AssetHandle handle;                 // from the .meta file; invalid for folders
+    AssetType type = AssetType::Unknown;
+    int version = 1;
+    std::string importerSettings;
+    uint64_t size = 0;
+    int64_t modified = 0;               // file clock ticks
+    int64_t metaModified = 0;           // of the .meta file, 0 when there is none
+    uint64_t contentHash = 0;           // AssetCache::HashBytes of the file, 0 for folders
+    std::vector<AssetHandle> dependencies;
+    bool isDirectory = false;
+};
+
+// Persistent index of the assets directory, shared by the AssetRegistry and
+// the editor's asset browser.
+//
+// It is saved on shutdown and loaded on startup, so the next scan only has to
+// stat each file: records whose size and timestamps still match are reused
+// without opening the file or its .meta. Records are keyed by absolute path;
+// the file stores them relative to the assets directory, so a project can be
+// moved. Each folder's children are indexed for directory listings, and
+// GetRevision() changes whenever the contents do.
+class AssetDatabase {
+public:
+    bool Load(const std::string& databasePath, const std::string& assetsDirectory);
+    bool Save();
+    void Clear();
+    
+    const AssetRecord* Find(const std::string& path) const;
+    void Upsert(AssetRecord record);
+    // Removes the record and, for a folder, everything below it
+    void Remove(const std::string& path);
+    
+    // Immediate children of a folder, in no particular order
+    const std::vector<std::string>& GetChildren(const std::string& directory) const;
+    bool HasSubdirectories(const std::string& directory) const;
+    
+    const std::unordered_map<std::string, AssetRecord>& GetRecords() const { return m_records; }
+    const std::string& GetAssetsDirectory() const { return m_assetsDirectory; }
+    uint64_t GetRevision() const { return m_revision; }
+    
+    static int64_t ToTicks(std::filesystem::file_time_type time) { return static_cast<int64_t>(time.time_since_epoch().count()); }
+    static std::filesystem::file_time_type FromTicks(int64_t ticks) {
+        return std::filesystem::file_time_type(std::filesystem::file_time_type::duration(ticks));
+    }
+
+private:
+    void LinkToParent(const std::string& path);
+    void UnlinkFromParent(const std::string& path);
+    
+    std::string m_databasePath;
+    std::string m_assetsDirectory;
+    std::unordered_map<std::string, AssetRecord> m_records;
+    std::unordered_map<std::string, std::vector<std::string>> m_children;
+    uint64_t m_revision = 0;
+    bool m_dirty = false;
+};
+
+} // namespace BGE
@@ -1,5 +1,8 @@
 #include "AssetManager.h"
 #include "../Core/ServiceLocator.h"
+#include "../Core/ConfigManager.h"
+#include "../Core/Profiling/Profiler.h"
+#include <algorithm>
 #include <iostream>
 
 // Define STB_IMAGE_IMPLEMENTATION once for the entire AssetPipeline
@@ -17,12 +20,49 @@
 
 namespace BGE {
 
+namespace {
+
+struct BudgetSetting {
+    AssetType type;
+    const char* key;
+    int defaultMegabytes;
+};
+
+// Textures dominate; the rest only matter over very long sessions
+constexpr BudgetSetting BUDGET_SETTINGS[] = {
+    {AssetType::Texture, "assets.texture_budget_mb", 512},
+    {AssetType::Material, "assets.material_budget_mb", 16},
+    {AssetType::Prefab, "assets.prefab_budget_mb", 64},
+    {AssetType::Scene, "assets.scene_budget_mb", 64},
+};
+
+} // anonymous namespace
+
 bool AssetManager::Initialize(const std::string& assetsDirectory) {
     m_assetsDirectory = assetsDirectory;
     m_eventBus = ServiceLocator::Instance().GetService<EventBus>().get();
     
-    // Initialize the asset registry
-    if (!m_registry.Initialize(assetsDirectory)) {
+    size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    m_ioPool = std::make_unique<ThreadPool>(IO_THREADS);
+    m_decodePool = std::make_unique<ThreadPool>(std::clamp<size_t>(hardwareThreads / 4, 1, MAX_DECODE_THREADS));
+    
+    // Cooked asset cache; loading works without it, just slower
+    auto& config = ConfigManager::Instance();
+    std::string cachePath = config.GetString("assets.cache_path", "AssetCache/");
+    if (config.GetBool("assets.cache_enabled", true)) {
+        if (!m_cookedCache.Initialize(cachePath, config.GetBool("assets.compression", false))) {
+            std::cerr << "Asset cache disabled" << std::endl;
+        }
+    }
+    
+    for (const BudgetSetting& setting : BUDGET_SETTINGS) {
+        int megabytes = config.GetInt(setting.key, setting.defaultMegabytes);
+        SetMemoryBudget(setting.type, static_cast<size_t>(std::max(megabytes, 0)) * 1024 * 1024);
+    }
+    
+    // Initialize the asset registry; its index lives next to the cooked cache and is stat-checked on the I/O threads
+    std::string indexPath = (std::filesystem::path(cachePath) / "AssetIndex.db").string();
+    if (!m_registry.Initialize(assetsDirectory, indexPath, m_ioPool.get())) {
         std::cerr << "Failed to initialize AssetRegistry" << std::endl;
         return false;
     }
@@ -33,13 +73,48 @@ bool AssetManager::Initialize(const std::string& assetsDirectory) {
     RegisterLoader(std::make_unique<PrefabLoader>());
     RegisterLoader(std::make_unique<SceneLoader>());
     
+    // Bundles listed in the config, comma separated; streamed bundles are read with pread instead of mapped
+    auto mode = config.GetBool("assets.bundle_streaming", false) ? AssetBundle::AccessMode::Streamed
+                                                                 : AssetBundle::AccessMode::Mapped;
+    std::string bundles = config.GetString("assets.bundles", "");
+    size_t start = 0;
+    while (start < bundles.size()) {
+        size_t end = std::min(bundles.find(',', start), bundles.size());
+        std::string bundlePath = bundles.substr(start, end - start);
+        bundlePath.erase(0, bundlePath.find_first_not_of(" \t"));
+        bundlePath.erase(bundlePath.find_last_not_of(" \t") + 1);
+        if (!bundlePath.empty()) {
+            MountBundle(bundlePath, mode);
+        }
+        start = end + 1;
+    }
+    
+    if (!m_fileWatcher.Start(assetsDirectory)) {
+        std::cerr << "Hot-reloading disabled: cannot watch " << assetsDirectory << std::endl;
+    }
+    
     return true;
 }
 
 void AssetManager::Shutdown() {
+    m_fileWatcher.Stop();
+    m_fileChanges.clear();
+    StopLoaderThreads();
+    m_pendingLoads.clear();
+    m_completedLoads.clear();
+    m_failedLoads.clear();
+    m_bundledAssets.clear();
+    m_bundles.clear();
+    for (auto& [handle, resident] : m_assetCache) {
+        RetireAsset(std::move(resident.asset));
+    }
     m_assetCache.clear();
+    m_lru.clear();
+    ReleaseRetiredAssets(true);
+    m_memoryUsage.clear();
     m_loaders.clear();
     m_registry.Shutdown();
+    m_cookedCache.Shutdown();
     m_eventBus = nullptr;
 }
 
@@ -51,7 +126,13 @@ std::shared_ptr<IAsset> AssetManager::GetAsset(const AssetHandle& handle) {
     // Check cache first
     auto it = m_assetCache.find(handle);
     if (it != m_assetCache.end()) {
-        return it->second;
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+        return it->second.asset;
+    }
+    
+    // Still streaming in; callers wait for AssetLoadedEvent rather than loading it twice
+    if (m_pendingLoads.count(handle)) {
+        return nullptr;
     }
     
     // Load asset if not in cache
@@ -66,9 +147,22 @@ std::shared_ptr<IAsset> AssetManager::GetAsset(const AssetHandle& handle) {
         return nullptr;
     }
     
-    auto asset = loader->LoadAsset(path, handle);
+    BGE_PROFILE_SCOPE("AssetManager::LoadAsset");
+    std::shared_ptr<IAsset> asset;
+    auto bundled = m_bundledAssets.find(handle);
+    if (bundled != m_bundledAssets.end()) {
+        AssetSource source;
+        if (loader->ReadBundledSource(*bundled->second.bundle, *bundled->second.entry, &m_cookedCache, source)) {
+            asset = loader->DecodeSource(path, handle, &m_cookedCache, source);
+            if (asset && !loader->FinalizeAsset(*asset)) {
+                asset.reset();
+            }
+        }
+    } else {
+        asset = loader->LoadAsset(path, handle, &m_cookedCache);
+    }
     if (asset) {
-        m_assetCache[handle] = asset;
+        CacheAsset(handle, asset);
     }
     
     return asset;
@@ -83,22 +177,268 @@ AssetHandle AssetManager::LoadAsset(const std::string& filePath) {
     return handle;
 }
 
+AssetHandle AssetManager::LoadAssetAsync(const std::string& filePath) {
+    AssetHandle handle = m_registry.RegisterAsset(filePath);
+    if (!handle.IsValid() || m_pendingLoads.count(handle)) {
+        return handle;
+    }
+    
+    std::string path = m_registry.GetAssetPath(handle);
+    if (m_assetCache.count(handle)) {
+        // Already resident: still report completion, on the next deferred dispatch
+        if (m_eventBus) {
+            m_eventBus->Enqueue(AssetLoadedEvent(handle, m_registry.GetAssetType(handle), path, true, 0.0f));
+        }
+        return handle;
+    }
+    
+    auto load = std::make_shared<PendingLoad>();
+    load->handle = handle;
+    load->path = path;
+    load->loader = GetLoaderForAsset(path);
+    auto bundled = m_bundledAssets.find(handle);
+    if (bundled != m_bundledAssets.end()) {
+        load->bundle = bundled->second.bundle;
+        load->bundleEntry = bundled->second.entry;
+    }
+    load->requested = std::chrono::steady_clock::now();
+    m_failedLoads.erase(handle);
+    m_pendingLoads[handle] = load;
+    
+    if (!load->loader || !m_ioPool) {
+        if (!load->loader) {
+            std::cerr << "No loader found for asset: " << path << std::endl;
+        }
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        m_completedLoads.push_back(load);
+        return handle;
+    }
+    
+    m_ioPool->Submit([this, load]() { ReadPendingLoad(load); });
+    return handle;
+}
+
+AssetLoadState AssetManager::GetLoadState(const AssetHandle& handle) const {
+    if (m_assetCache.count(handle)) {
+        return AssetLoadState::Loaded;
+    }
+    if (m_pendingLoads.count(handle)) {
+        return AssetLoadState::Loading;
+    }
+    if (m_failedLoads.count(handle)) {
+        return AssetLoadState::Failed;
+    }
+    return AssetLoadState::Unloaded;
+}
+
+void AssetManager::ReadPendingLoad(std::shared_ptr<PendingLoad> load) {
+    BGE_PROFILE_SCOPE("AssetManager::ReadPendingLoad");
+    AssetSource source;
+    bool read = load->bundle ? load->loader->ReadBundledSource(*load->bundle, *load->bundleEntry, &m_cookedCache, source)
+                             : load->loader->ReadSource(load->path, &m_cookedCache, source);
+    if (read && m_decodePool) {
+        m_decodePool->Submit([this, load, source = std::move(source)]() mutable {
+            DecodePendingLoad(load, std::move(source));
+        });
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_completedMutex);
+    m_completedLoads.push_back(load);
+}
+
+void AssetManager::DecodePendingLoad(std::shared_ptr<PendingLoad> load, AssetSource source) {
+    BGE_PROFILE_SCOPE("AssetManager::DecodePendingLoad");
+    load->asset = load->loader->DecodeSource(load->path, load->handle, &m_cookedCache, source);
+    
+    std::lock_guard<std::mutex> lock(m_completedMutex);
+    m_completedLoads.push_back(load);
+}
+
+void AssetManager::ProcessCompletedLoads() {
+    BGE_PROFILE_SCOPE("AssetManager::ProcessCompletedLoads");
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::duration<float, std::milli>(m_uploadBudgetMs);
+    
+    while (true) {
+        std::shared_ptr<PendingLoad> load;
+        {
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            if (m_completedLoads.empty()) {
+                break;
+            }
+            load = std::move(m_completedLoads.front());
+            m_completedLoads.pop_front();
+        }
+        
+        if (load->cancelled) {
+            continue;
+        }
+        m_pendingLoads.erase(load->handle);
+        
+        bool success = load->asset && load->loader->FinalizeAsset(*load->asset);
+        if (success) {
+            CacheAsset(load->handle, load->asset);
+        } else {
+            m_failedLoads.insert(load->handle);
+        }
+        
+        auto now = std::chrono::steady_clock::now();
+        if (m_eventBus) {
+            float loadTimeMs = std::chrono::duration<float, std::milli>(now - load->requested).count();
+            m_eventBus->Publish(AssetLoadedEvent(load->handle, m_registry.GetAssetType(load->handle), load->path,
+                                                 success, loadTimeMs));
+        }
+        
+        // Whatever is left waits for the next frame
+        if (now - start >= budget) {
+            break;
+        }
+    }
+}
+
+void AssetManager::StopLoaderThreads() {
+    // In-flight jobs finish; queued ones are dropped
+    m_ioPool.reset();
+    m_decodePool.reset();
+}
+
 void AssetManager::UnloadAsset(const AssetHandle& handle) {
-    m_assetCache.erase(handle);
+    auto pending = m_pendingLoads.find(handle);
+    if (pending != m_pendingLoads.end()) {
+        pending->second->cancelled = true;
+        m_pendingLoads.erase(pending);
+    }
+    m_failedLoads.erase(handle);
+    RetireAsset(DropAsset(handle));
     m_registry.UnregisterAsset(handle);
 }
 
+void AssetManager::SetMemoryBudget(AssetType type, size_t bytes) {
+    m_memoryUsage[type].budgetBytes = bytes;
+}
+
+size_t AssetManager::GetMemoryBudget(AssetType type) const {
+    auto it = m_memoryUsage.find(type);
+    return it != m_memoryUsage.end() ? it->second.budgetBytes : 0;
+}
+
+void AssetManager::CacheAsset(const AssetHandle& handle, std::shared_ptr<IAsset> asset) {
+    RetireAsset(DropAsset(handle));
+    
+    ResidentAsset resident;
+    resident.cpuBytes = asset->GetCpuMemoryUsage();
+    resident.gpuBytes = asset->GetGpuMemoryUsage();
+    m_lru.push_front(handle);
+    resident.lruPosition = m_lru.begin();
+    
+    AssetMemoryUsage& usage = m_memoryUsage[asset->GetType()];
+    usage.residentCount++;
+    usage.cpuBytes += resident.cpuBytes;
+    usage.gpuBytes += resident.gpuBytes;
+    
+    std::vector<AssetHandle> dependencies;
+    asset->GetDependencies(dependencies);
+    m_registry.SetDependencies(handle, dependencies);
+    
+    resident.asset = std::move(asset);
+    m_assetCache.emplace(handle, std::move(resident));
+}
+
+std::shared_ptr<IAsset> AssetManager::DropAsset(const AssetHandle& handle) {
+    auto it = m_assetCache.find(handle);
+    if (it == m_assetCache.end()) {
+        return nullptr;
+    }
+    
+    ResidentAsset resident = std::move(it->second);
+    m_assetCache.erase(it);
+    m_lru.erase(resident.lruPosition);
+    
+    AssetMemoryUsage& usage = m_memoryUsage[resident.asset->GetType()];
+    usage.residentCount--;
+    usage.cpuBytes -= resident.cpuBytes;
+    usage.gpuBytes -= resident.gpuBytes;
+    
+    // Dependencies that only this asset was keeping become the first candidates for eviction
+    for (const AssetHandle& dependency : m_registry.GetDependencies(handle)) {
+        auto orphan = m_assetCache.find(dependency);
+        if (orphan != m_assetCache.end() && !HasResidentDependents(dependency)) {
+            m_lru.splice(m_lru.end(), m_lru, orphan->second.lruPosition);
+        }
+    }
+    
+    return std::move(resident.asset);
+}
+
+void AssetManager::RetireAsset(std::shared_ptr<IAsset> asset) {
+    if (asset) {
+        m_retiredAssets.push_back(std::move(asset));
+    }
+}
+
+void AssetManager::ReleaseRetiredAssets(bool force) {
+    // A sprite or panel may still draw with an old texture; its GPU copy goes when they let go
+    auto released = std::remove_if(m_retiredAssets.begin(), m_retiredAssets.end(),
+        [this, force](const std::shared_ptr<IAsset>& asset) {
+            if (!force && asset.use_count() > 1) {
+                return false;
+            }
+            auto loader = m_loaders.find(asset->GetType());
+            if (loader != m_loaders.end()) {
+                loader->second->ReleaseAsset(*asset);
+            }
+            return true;
+        });
+    m_retiredAssets.erase(released, m_retiredAssets.end());
+}
+
+void AssetManager::EnforceMemoryBudgets() {
+    for (auto& [type, usage] : m_memoryUsage) {
+        if (usage.budgetBytes == 0 || usage.GetTotalBytes() <= usage.budgetBytes) {
+            continue;
+        }
+        
+        BGE_PROFILE_SCOPE("AssetManager::EnforceMemoryBudgets");
+        auto it = m_lru.end();
+        while (it != m_lru.begin() && usage.GetTotalBytes() > usage.budgetBytes) {
+            --it;
+            const ResidentAsset& resident = m_assetCache.find(*it)->second;
+            if (resident.asset->GetType() != type || resident.asset.use_count() > 1 || HasResidentDependents(*it)) {
+                continue;
+            }
+            
+            AssetHandle handle = *it;
+            ++it;   // the node is erased; the next step back lands on its predecessor
+            RetireAsset(DropAsset(handle));
+            usage.evictions++;
+        }
+    }
+}
+
+bool AssetManager::HasResidentDependents(const AssetHandle& handle) const {
+    for (const AssetHandle& dependent : m_registry.GetDependents(handle)) {
+        if (m_assetCache.count(dependent)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void AssetManager::ReloadAsset(const AssetHandle& handle) {
+    BGE_PROFILE_SCOPE("AssetManager::ReloadAsset");
     std::string path = m_registry.GetAssetPath(handle);
     if (path.empty()) {
         return;
     }
     
-    // Remove from cache to force reload
-    m_assetCache.erase(handle);
+    // Remove from cache to force reload; the old copy stays valid for whoever still holds it
+    RetireAsset(DropAsset(handle));
     
-    // Refresh in registry
-    m_registry.RefreshAsset(path);
+    // Refresh in registry; a bundled asset has no file to re-read
+    if (!m_bundledAssets.count(handle)) {
+        m_registry.RefreshAsset(path);
+    }
     
     // Reload the asset
     auto asset = GetAsset(handle);
@@ -129,28 +469,73 @@ void AssetManager::RegisterLoader(std::unique_ptr<IAssetLoader> loader) {
 }
 
 void AssetManager::Update() {
-    // Check for file system changes and reload modified assets
-    for (const auto& assetPair : m_registry.GetAllAssets()) {
-        const AssetHandle& handle = assetPair.first;
-        const AssetMetadata& metadata = assetPair.second;
-        
-        std::string path = m_registry.GetAssetPath(handle);
-        if (path.empty() || !std::filesystem::exists(path)) {
+    BGE_PROFILE_SCOPE("AssetManager::Update");
+    ProcessCompletedLoads();
+    
+    // Nothing is stat'ed here: the watcher thread hands over only the files that changed
+    if (m_fileWatcher.PollChanges(m_fileChanges)) {
+        ProcessFileChanges();
+    }
+    
+    EnforceMemoryBudgets();
+    ReleaseRetiredAssets(false);
+}
+
+void AssetManager::ProcessFileChanges() {
+    BGE_PROFILE_SCOPE("AssetManager::ProcessFileChanges");
+    for (const FileChange& change : m_fileChanges) {
+        // An edited .meta file changes its asset's type or importer settings
+        const std::string& path = change.path;
+        bool isMeta = path.size() >= 5 && path.compare(path.size() - 5, 5, ".meta") == 0;
+        if (isMeta) {
+            m_registry.RefreshAsset(path.substr(0, path.size() - 5));
             continue;
         }
         
-        try {
-            auto currentModTime = std::filesystem::last_write_time(path);
-            if (currentModTime > metadata.lastModified) {
-                ReloadAsset(handle);
-            }
-        } catch (const std::filesystem::filesystem_error& e) {
-            std::cerr << "Error checking file time for " << path << ": " << e.what() << std::endl;
+        // Deleted files leave the index; a loaded copy remains usable
+        AssetHandle handle = m_registry.GetAssetHandle(path);
+        if (m_bundledAssets.count(handle)) {
+            continue;   // the bundle wins over the loose file
+        }
+        if (change.type == FileChangeType::Modified && m_assetCache.find(handle) != m_assetCache.end()) {
+            ReloadAsset(handle);
+        } else {
+            m_registry.RefreshAsset(path);
+        }
+    }
+}
+
+bool AssetManager::MountBundle(const std::string& bundlePath, AssetBundle::AccessMode mode) {
+    BGE_PROFILE_SCOPE("AssetManager::MountBundle");
+    auto bundle = std::make_unique<AssetBundle>();
+    if (!bundle->Open(bundlePath, mode)) {
+        std::cerr << "Failed to mount asset bundle: " << bundlePath << std::endl;
+        return false;
+    }
+    
+    const auto& entries = bundle->GetEntries();
+    std::filesystem::path root(m_registry.GetDatabase().GetAssetsDirectory());
+    for (const AssetBundleEntry& entry : entries) {
+        std::string path = (root / std::filesystem::path(entry.path).make_preferred()).string();
+        m_registry.RegisterBundledAsset(path, entry.handle, entry.type);
+        m_bundledAssets[entry.handle] = BundledAsset{bundle.get(), &entry};
+        // Already loaded from somewhere else: the next GetAsset() picks up the bundled copy
+        RetireAsset(DropAsset(entry.handle));
+    }
+    for (const AssetBundleEntry& entry : entries) {
+        std::vector<AssetHandle> dependencies;
+        for (uint32_t index : entry.dependencies) {
+            dependencies.push_back(entries[index].handle);
         }
+        m_registry.SetDependencies(entry.handle, dependencies);
     }
+    
+    m_bundles.push_back(std::move(bundle));
+    return true;
 }
 
 void AssetManager::RefreshAssets() {
+    BGE_PROFILE_SCOPE("AssetManager::RefreshAssets");
     m_registry.ScanAssetsDirectory();
 }
 
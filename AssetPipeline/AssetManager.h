@@ -2,15 +2,22 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <filesystem>
+#include <chrono>
+#include <deque>
+#include <list>
+#include <mutex>
 
 #include "AssetHandle.h"
 #include "IAsset.h"
 #include "IAssetLoader.h"
 #include "AssetRegistry.h"
+#include "FileWatcher.h"
 #include "../Core/AssetTypes.h"
 #include "../Core/EventBus.h"
+#include "../Core/Threading/ThreadPool.h"
 
 namespace BGE {
 
@@ -24,6 +31,36 @@ struct AssetReloadedEvent {
         : handle(h), type(t), path(p) {}
 };
 
+// Completion of LoadAssetAsync(), successful or not
+struct AssetLoadedEvent {
+    AssetHandle handle;
+    AssetType type;
+    std::string path;
+    bool success;
+    float loadTimeMs; // request to completion
+    
+    AssetLoadedEvent(const AssetHandle& h, AssetType t, const std::string& p, bool ok, float ms)
+        : handle(h), type(t), path(p), success(ok), loadTimeMs(ms) {}
+};
+
+// Resident assets of one type against its budget, for the editor's memory view
+struct AssetMemoryUsage {
+    size_t residentCount = 0;
+    size_t cpuBytes = 0;
+    size_t gpuBytes = 0;
+    size_t budgetBytes = 0;     // CPU + GPU; 0 = unlimited
+    size_t evictions = 0;       // since startup
+    
+    size_t GetTotalBytes() const { return cpuBytes + gpuBytes; }
+};
+
+enum class AssetLoadState {
+    Unloaded,
+    Loading,
+    Loaded,
+    Failed
+};
+
 class AssetManager {
 public:
     AssetManager() = default;
@@ -38,6 +75,16 @@ public:
     
     std::shared_ptr<IAsset> GetAsset(const AssetHandle& handle);
     AssetHandle LoadAsset(const std::string& filePath);
+    
+    // Reads and decodes on loader threads; the handle is Loading until Update() finishes it
+    // on the main thread, which then publishes an AssetLoadedEvent
+    AssetHandle LoadAssetAsync(const std::string& filePath);
+    AssetLoadState GetLoadState(const AssetHandle& handle) const;
+    size_t GetPendingLoadCount() const { return m_pendingLoads.size(); }
+    
+    // Main-thread time per Update() spent finishing async loads (GPU uploads); at least one completes per call
+    void SetUploadBudget(float milliseconds) { m_uploadBudgetMs = milliseconds; }
+    float GetUploadBudget() const { return m_uploadBudgetMs; }
     void UnloadAsset(const AssetHandle& handle);
     void ReloadAsset(const AssetHandle& handle);
     
@@ -54,7 +101,25 @@ public:
     AssetRegistry& GetRegistry() { return m_registry; }
     const AssetRegistry& GetRegistry() const { return m_registry; }
     
-    // File system monitoring
+    // Memory budgets (assets.<type>_budget_mb). Over budget, Update() evicts the least recently used
+    // assets of that type that nothing outside the manager references and no resident asset depends on.
+    void SetMemoryBudget(AssetType type, size_t bytes);
+    size_t GetMemoryBudget(AssetType type) const;
+    const std::unordered_map<AssetType, AssetMemoryUsage>& GetMemoryUsage() const { return m_memoryUsage; }
+    // Dropped assets whose GPU resources wait for the last outside reference to go
+    size_t GetRetiredAssetCount() const { return m_retiredAssets.size(); }
+    
+    // Cooked asset cache (assets.cache_enabled / assets.cache_path / assets.compression)
+    AssetCache& GetCookedCache() { return m_cookedCache; }
+    
+    // Asset bundles (assets.bundles / assets.bundle_streaming). A mounted bundle's assets are
+    // registered under their original paths and take precedence over loose files; a later
+    // mount overrides an earlier one, so patches are mounted after the bundles they patch.
+    bool MountBundle(const std::string& bundlePath, AssetBundle::AccessMode mode = AssetBundle::AccessMode::Mapped);
+    size_t GetMountedBundleCount() const { return m_bundles.size(); }
+    bool IsBundled(const AssetHandle& handle) const { return m_bundledAssets.count(handle) != 0; }
+    
+    // Finishes async loads and reloads assets whose files changed on disk
     void Update();
     void RefreshAssets();
     
@@ -62,15 +127,85 @@ public:
     std::shared_ptr<TextureAsset> LoadTexture(const std::string& path);
 
 private:
+    // One LoadAssetAsync() request as it moves through the loader threads
+    struct PendingLoad {
+        AssetHandle handle;
+        std::string path;
+        IAssetLoader* loader = nullptr;
+        const AssetBundle* bundle = nullptr;            // both set when the asset is bundled
+        const AssetBundleEntry* bundleEntry = nullptr;
+        std::shared_ptr<IAsset> asset;      // set by the decode thread, null on failure
+        std::chrono::steady_clock::time_point requested;
+        bool cancelled = false;             // main thread only
+    };
+    
+    // Where a bundled asset's bytes are
+    struct BundledAsset {
+        const AssetBundle* bundle = nullptr;
+        const AssetBundleEntry* entry = nullptr;
+    };
+    
+    // An asset in the cache; lruPosition is its place in m_lru, most recently used first
+    struct ResidentAsset {
+        std::shared_ptr<IAsset> asset;
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+        std::list<AssetHandle>::iterator lruPosition;
+    };
+    
     IAssetLoader* GetLoaderForAsset(const std::string& filePath) const;
     void BroadcastAssetReloaded(const AssetHandle& handle, const std::string& path);
+    void ReadPendingLoad(std::shared_ptr<PendingLoad> load);
+    void DecodePendingLoad(std::shared_ptr<PendingLoad> load, AssetSource source);
+    void ProcessCompletedLoads();
+    void ProcessFileChanges();
+    void StopLoaderThreads();
+    
+    // Residency: every insertion into and removal from m_assetCache goes through these
+    void CacheAsset(const AssetHandle& handle, std::shared_ptr<IAsset> asset);
+    std::shared_ptr<IAsset> DropAsset(const AssetHandle& handle);
+    void RetireAsset(std::shared_ptr<IAsset> asset);
+    void ReleaseRetiredAssets(bool force);
+    void EnforceMemoryBudgets();
+    bool HasResidentDependents(const AssetHandle& handle) const;
     
     AssetRegistry m_registry;
-    std::unordered_map<AssetHandle, std::shared_ptr<IAsset>, AssetHandleHash> m_assetCache;
+    std::unordered_map<AssetHandle, ResidentAsset, AssetHandleHash> m_assetCache;
+    std::list<AssetHandle> m_lru;
+    std::unordered_map<AssetType, AssetMemoryUsage> m_memoryUsage;
+    std::vector<std::shared_ptr<IAsset>> m_retiredAssets;
     std::unordered_map<AssetType, std::unique_ptr<IAssetLoader>> m_loaders;
     
     EventBus* m_eventBus = nullptr;
     std::string m_assetsDirectory;
+    
+    // Async loading: requests in flight, loads ready for the main thread, and failures
+    std::unordered_map<AssetHandle, std::shared_ptr<PendingLoad>, AssetHandleHash> m_pendingLoads;
+    std::deque<std::shared_ptr<PendingLoad>> m_completedLoads;
+    std::mutex m_completedMutex;
+    std::unordered_set<AssetHandle, AssetHandleHash> m_failedLoads;
+    float m_uploadBudgetMs = DEFAULT_UPLOAD_BUDGET_MS;
+    
+    // Cooked data used by the loader threads in place of parsing sources
+    AssetCache m_cookedCache;
+    
+    // Mounted bundles, in mount order; entries are read on the loader threads
+    std::vector<std::unique_ptr<AssetBundle>> m_bundles;
+    std::unordered_map<AssetHandle, BundledAsset, AssetHandleHash> m_bundledAssets;
+    
+    // Hot-reload: the watcher thread reports changed files, Update() reloads only those
+    FileWatcher m_fileWatcher;
+    std::vector<FileChange> m_fileChanges;
+    
+    // File reads and decoding run on separate pools so blocking I/O never idles a decode thread.
+    // Declared last so they are joined before the state their jobs touch is destroyed; the
+    // I/O pool goes first because its jobs hand work to the decode pool.
+    std::unique_ptr<ThreadPool> m_decodePool;
+    std::unique_ptr<ThreadPool> m_ioPool;
+    
+    static constexpr float DEFAULT_UPLOAD_BUDGET_MS = 2.0f;
+    static constexpr size_t IO_THREADS = 2;
+    static constexpr size_t MAX_DECODE_THREADS = 4;
 };
 
 // Template implementation
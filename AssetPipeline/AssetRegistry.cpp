@@ -1,28 +1,54 @@
 #include "AssetRegistry.h"
+#include "AssetCache.h"
+#include "MappedFile.h"
+#include "../Core/Profiling/Profiler.h"
+#include "../Core/Threading/ThreadPool.h"
 #include "../ThirdParty/json/json.hpp"
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <unordered_set>
 
 using json = nlohmann::json;
 
 namespace BGE {
 
-bool AssetRegistry::Initialize(const std::string& assetsDirectory) {
-    m_assetsDirectory = std::filesystem::absolute(assetsDirectory).string();
+namespace {
+
+// Below this many entries the pool's hand-off costs more than the stats save
+constexpr size_t PARALLEL_SCAN_THRESHOLD = 256;
+constexpr size_t SCAN_GRAIN_SIZE = 64;
+
+} // anonymous namespace
+
+bool AssetRegistry::Initialize(const std::string& assetsDirectory, const std::string& databasePath,
+                               ThreadPool* scanPool) {
+    std::filesystem::path root = std::filesystem::absolute(assetsDirectory);
+    if (!root.has_filename()) {
+        root = root.parent_path();  // "Assets/" and "Assets" must give the same keys
+    }
+    m_assetsDirectory = root.string();
+    m_scanPool = scanPool;
     
     if (!std::filesystem::exists(m_assetsDirectory)) {
         std::filesystem::create_directories(m_assetsDirectory);
     }
     
+    // The index from the last run lets the scan skip every file that has not changed since
+    m_database.Load(databasePath, m_assetsDirectory);
     ScanAssetsDirectory();
     return true;
 }
 
 void AssetRegistry::Shutdown() {
+    m_database.Save();
+    m_database.Clear();
     m_assets.clear();
     m_pathToHandle.clear();
+    m_handleToPath.clear();
     m_dependencies.clear();
     m_dependents.clear();
+    m_scanPool = nullptr;
 }
 
 AssetHandle AssetRegistry::RegisterAsset(const std::string& filePath) {
@@ -37,24 +63,27 @@ AssetHandle AssetRegistry::RegisterAsset(const std::string& filePath) {
         return it->second;
     }
     
-    AssetMetadata metadata;
-    
-    if (!LoadMetaFile(absolutePath, metadata)) {
-        CreateMetaFile(absolutePath, metadata);
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(absolutePath, ec) || IsMetaFile(absolutePath)) {
+        return AssetHandle();
     }
     
-    metadata.lastModified = std::filesystem::last_write_time(absolutePath);
-    m_assets[metadata.handle] = metadata;
-    m_pathToHandle[absolutePath] = metadata.handle;
+    ScanEntry entry;
+    entry.path = absolutePath;
+    ValidateEntry(entry);
+    CommitEntry(entry);
     
-    return metadata.handle;
+    return entry.record.handle;
 }
 
 void AssetRegistry::UnregisterAsset(const AssetHandle& handle) {
     auto it = m_assets.find(handle);
     if (it != m_assets.end()) {
-        std::string path = GetAssetPath(handle);
-        m_pathToHandle.erase(path);
+        auto path = m_handleToPath.find(handle);
+        if (path != m_handleToPath.end()) {
+            m_pathToHandle.erase(path->second);
+            m_handleToPath.erase(path);
+        }
         m_assets.erase(it);
         
         m_dependencies.erase(handle);
@@ -69,6 +98,24 @@ void AssetRegistry::UnregisterAsset(const std::string& filePath) {
     }
 }
 
+void AssetRegistry::RegisterBundledAsset(const std::string& filePath, const AssetHandle& handle, AssetType type) {
+    std::string absolutePath = std::filesystem::absolute(filePath).string();
+    auto existingHandle = m_pathToHandle.find(absolutePath);
+    if (existingHandle != m_pathToHandle.end() && existingHandle->second != handle) {
+        UnregisterAsset(existingHandle->second);
+    }
+    auto existingPath = m_handleToPath.find(handle);
+    if (existingPath != m_handleToPath.end() && existingPath->second != absolutePath) {
+        m_pathToHandle.erase(existingPath->second);
+    }
+    
+    AssetMetadata& metadata = m_assets[handle];
+    metadata.handle = handle;
+    metadata.type = type;
+    m_pathToHandle[absolutePath] = handle;
+    m_handleToPath[handle] = absolutePath;
+}
+
 bool AssetRegistry::HasAsset(const AssetHandle& handle) const {
     return m_assets.find(handle) != m_assets.end();
 }
@@ -85,12 +132,8 @@ AssetHandle AssetRegistry::GetAssetHandle(const std::string& filePath) const {
 }
 
 std::string AssetRegistry::GetAssetPath(const AssetHandle& handle) const {
-    for (const auto& pair : m_pathToHandle) {
-        if (pair.second == handle) {
-            return pair.first;
-        }
-    }
-    return "";
+    auto it = m_handleToPath.find(handle);
+    return it != m_handleToPath.end() ? it->second : "";
 }
 
 AssetMetadata AssetRegistry::GetAssetMetadata(const AssetHandle& handle) const {
@@ -108,38 +151,241 @@ void AssetRegistry::ScanAssetsDirectory() {
         return;
     }
     
-    for (const auto& entry : std::filesystem::recursive_directory_iterator(m_assetsDirectory)) {
-        if (entry.is_regular_file()) {
-            std::string path = entry.path().string();
-            
-            if (path.size() >= 5 && path.substr(path.size() - 5) == ".meta") {
-                continue;
-            }
-            
-            RegisterAsset(path);
-        }
-    }
+    ScanTree(m_assetsDirectory);
 }
 
 void AssetRegistry::RefreshAsset(const std::string& filePath) {
     std::string absolutePath = std::filesystem::absolute(filePath).string();
+    if (!IsInAssetsDirectory(absolutePath)) {
+        return;
+    }
+    
+    std::error_code ec;
+    auto status = std::filesystem::status(absolutePath, ec);
+    if (!std::filesystem::exists(status)) {
+        RemoveTree(absolutePath);
+    } else if (std::filesystem::is_directory(status)) {
+        ScanTree(absolutePath);
+    } else if (!IsMetaFile(absolutePath)) {
+        ScanEntry entry;
+        entry.path = absolutePath;
+        ValidateEntry(entry);
+        CommitEntry(entry);
+    }
+}
+
+void AssetRegistry::ScanTree(const std::string& root) {
+    BGE_PROFILE_SCOPE("AssetRegistry::ScanTree");
+    auto startTime = std::chrono::steady_clock::now();
+    
+    // Listing directories is cheap; collect everything first so the stat pass can be split up
+    std::vector<ScanEntry> entries;
+    ScanEntry& self = entries.emplace_back();
+    self.path = root;
+    self.isDirectory = true;
     
-    if (!std::filesystem::exists(absolutePath)) {
-        UnregisterAsset(absolutePath);
+    std::error_code ec;
+    auto options = std::filesystem::directory_options::skip_permission_denied;
+    for (std::filesystem::recursive_directory_iterator it(root, options, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code typeError;
+        bool isDirectory = it->is_directory(typeError);
+        if (!isDirectory && !it->is_regular_file(typeError)) {
+            continue;
+        }
+        
+        std::string path = it->path().string();
+        if (!isDirectory && IsMetaFile(path)) {
+            continue;
+        }
+        
+        ScanEntry& entry = entries.emplace_back();
+        entry.path = std::move(path);
+        entry.isDirectory = isDirectory;
+    }
+    
+    // Compare against the index; only new or changed files are opened
+    if (m_scanPool && entries.size() >= PARALLEL_SCAN_THRESHOLD) {
+        m_scanPool->ParallelFor(0, entries.size(), [this, &entries](size_t i) {
+            ValidateEntry(entries[i]);
+        }, SCAN_GRAIN_SIZE);
+    } else {
+        for (ScanEntry& entry : entries) {
+            ValidateEntry(entry);
+        }
+    }
+    
+    AssetScanStats stats;
+    std::unordered_set<std::string> seen;
+    seen.reserve(entries.size());
+    for (ScanEntry& entry : entries) {
+        if (entry.isDirectory) {
+            ++stats.directories;
+        } else {
+            ++stats.files;
+        }
+        if (entry.changed) {
+            ++stats.changed;
+        }
+        seen.insert(entry.path);
+        CommitEntry(entry);
+    }
+    
+    // Anything indexed below root that the walk did not find has been deleted
+    std::string prefix = root + static_cast<char>(std::filesystem::path::preferred_separator);
+    std::vector<std::string> missing;
+    for (const auto& [path, record] : m_database.GetRecords()) {
+        if (path.starts_with(prefix) && !seen.count(path)) {
+            missing.push_back(path);
+        }
+    }
+    for (const std::string& path : missing) {
+        if (m_database.Find(path)) {
+            RemoveTree(path);   // may take later entries of missing with it
+        }
+    }
+    stats.removed = missing.size();
+    
+    m_database.Save();
+    
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    m_lastScanStats = stats;
+}
+
+void AssetRegistry::ValidateEntry(ScanEntry& entry) const {
+    std::error_code ec;
+    int64_t modified = AssetDatabase::ToTicks(std::filesystem::last_write_time(entry.path, ec));
+    uint64_t size = entry.isDirectory ? 0 : std::filesystem::file_size(entry.path, ec);
+    int64_t metaModified = 0;
+    if (!entry.isDirectory) {
+        std::error_code metaError;
+        auto metaTime = std::filesystem::last_write_time(GetMetaFilePath(entry.path), metaError);
+        if (!metaError) {
+            metaModified = AssetDatabase::ToTicks(metaTime);
+        }
+    }
+    
+    const AssetRecord* known = m_database.Find(entry.path);
+    if (known && known->isDirectory == entry.isDirectory && known->size == size &&
+        known->modified == modified && known->metaModified == metaModified &&
+        (entry.isDirectory || known->handle.IsValid())) {
         return;
     }
     
-    auto currentModTime = std::filesystem::last_write_time(absolutePath);
-    AssetHandle handle = GetAssetHandle(absolutePath);
+    entry.changed = true;
+    entry.record = known ? *known : AssetRecord();
+    entry.record.path = entry.path;
+    entry.record.isDirectory = entry.isDirectory;
+    entry.record.size = size;
+    entry.record.modified = modified;
+    entry.record.metaModified = metaModified;
+    if (entry.isDirectory) {
+        entry.record.type = AssetType::Folder;
+        return;
+    }
     
-    if (handle.IsValid()) {
-        auto& metadata = m_assets[handle];
-        metadata.lastModified = currentModTime;
+    AssetMetadata metadata;
+    if (metaModified != 0 && LoadMetaFile(entry.path, metadata)) {
+        entry.record.handle = metadata.handle;
+        entry.record.type = metadata.type;
+        entry.record.version = metadata.version;
+        entry.record.importerSettings = metadata.importerSettings;
     } else {
-        RegisterAsset(absolutePath);
+        entry.needsMeta = true;  // handles are generated on the calling thread
+    }
+    
+    MappedFile file;
+    if (file.Open(entry.path)) {
+        entry.record.contentHash = AssetCache::HashBytes(file.GetData(), file.GetSize());
     }
 }
 
+void AssetRegistry::CommitEntry(ScanEntry& entry) {
+    if (entry.changed) {
+        if (entry.needsMeta) {
+            AssetMetadata metadata;
+            CreateMetaFile(entry.path, metadata);
+            entry.record.handle = metadata.handle;
+            entry.record.type = metadata.type;
+            entry.record.version = metadata.version;
+            entry.record.importerSettings = metadata.importerSettings;
+            
+            std::error_code ec;
+            auto metaTime = std::filesystem::last_write_time(GetMetaFilePath(entry.path), ec);
+            entry.record.metaModified = ec ? 0 : AssetDatabase::ToTicks(metaTime);
+            
+            // Writing the .meta touched the folder; keep its record current so it is not rescanned for that
+            std::string parent = std::filesystem::path(entry.path).parent_path().string();
+            const AssetRecord* folder = m_database.Find(parent);
+            auto folderTime = std::filesystem::last_write_time(parent, ec);
+            if (folder && !ec) {
+                AssetRecord updated = *folder;
+                updated.modified = AssetDatabase::ToTicks(folderTime);
+                m_database.Upsert(std::move(updated));
+            }
+        }
+        
+        // A handle that moved to a different path (a rename outside the editor) is dropped first
+        auto previous = m_pathToHandle.find(entry.path);
+        if (previous != m_pathToHandle.end() && previous->second != entry.record.handle) {
+            UnregisterAsset(previous->second);
+        }
+        m_database.Upsert(entry.record);
+    } else {
+        const AssetRecord* record = m_database.Find(entry.path);
+        if (record) {
+            entry.record = *record;
+        }
+    }
+    
+    if (!entry.isDirectory) {
+        RegisterRecord(entry.record);
+    }
+}
+
+void AssetRegistry::RegisterRecord(const AssetRecord& record) {
+    auto existingPath = m_handleToPath.find(record.handle);
+    if (existingPath != m_handleToPath.end() && existingPath->second != record.path) {
+        m_pathToHandle.erase(existingPath->second);
+    }
+    
+    AssetMetadata& metadata = m_assets[record.handle];
+    metadata.handle = record.handle;
+    metadata.type = record.type;
+    metadata.version = record.version;
+    metadata.importerSettings = record.importerSettings;
+    metadata.lastModified = AssetDatabase::FromTicks(record.modified);
+    m_pathToHandle[record.path] = record.handle;
+    m_handleToPath[record.handle] = record.path;
+    
+    // Dependencies recorded in an earlier session
+    if (!record.dependencies.empty() && !m_dependencies.count(record.handle)) {
+        for (const AssetHandle& dependency : record.dependencies) {
+            m_dependencies[record.handle].push_back(dependency);
+            m_dependents[dependency].push_back(record.handle);
+        }
+    }
+}
+
+void AssetRegistry::RemoveTree(const std::string& path) {
+    const AssetRecord* record = m_database.Find(path);
+    if (record && record->isDirectory) {
+        std::vector<std::string> children = m_database.GetChildren(path);
+        for (const std::string& child : children) {
+            RemoveTree(child);
+        }
+    }
+    
+    auto it = m_pathToHandle.find(path);
+    if (it != m_pathToHandle.end()) {
+        UnregisterAsset(it->second);
+    }
+    m_database.Remove(path);
+}
+
+bool AssetRegistry::IsMetaFile(const std::string& path) {
+    return path.size() >= 5 && path.compare(path.size() - 5, 5, ".meta") == 0;
+}
+
 std::string AssetRegistry::GetMetaFilePath(const std::string& assetPath) const {
     return assetPath + ".meta";
 }
@@ -159,7 +405,9 @@ bool AssetRegistry::LoadMetaFile(const std::string& assetPath, AssetMetadata& me
         metadata.handle = AssetHandle::FromString(j["uuid"].get<std::string>());
         metadata.type = static_cast<AssetType>(j["type"].get<int>());
         metadata.version = j.value("version", 1);
-        metadata.importerSettings = j.value("importerSettings", "{}");
+        // Written as a nested object by SaveMetaFile; older files may hold it as a string
+        const json& settings = j.contains("importerSettings") ? j["importerSettings"] : json::object();
+        metadata.importerSettings = settings.is_string() ? settings.get<std::string>() : settings.dump();
         
         return true;
     } catch (const std::exception& e) {
@@ -239,6 +487,7 @@ std::string AssetRegistry::GetRelativePath(const std::string& path) const {
 void AssetRegistry::AddDependency(const AssetHandle& asset, const AssetHandle& dependency) {
     m_dependencies[asset].push_back(dependency);
     m_dependents[dependency].push_back(asset);
+    UpdateRecordDependencies(asset);
 }
 
 void AssetRegistry::RemoveDependency(const AssetHandle& asset, const AssetHandle& dependency) {
@@ -247,6 +496,35 @@ void AssetRegistry::RemoveDependency(const AssetHandle& asset, const AssetHandle
     
     auto& dependents = m_dependents[dependency];
     dependents.erase(std::remove(dependents.begin(), dependents.end(), asset), dependents.end());
+    UpdateRecordDependencies(asset);
+}
+
+void AssetRegistry::SetDependencies(const AssetHandle& asset, const std::vector<AssetHandle>& dependencies) {
+    auto existing = m_dependencies.find(asset);
+    if (existing == m_dependencies.end() ? dependencies.empty() : existing->second == dependencies) {
+        return;
+    }
+    
+    auto& current = m_dependencies[asset];
+    for (const AssetHandle& dependency : current) {
+        auto& dependents = m_dependents[dependency];
+        dependents.erase(std::remove(dependents.begin(), dependents.end(), asset), dependents.end());
+    }
+    current = dependencies;
+    for (const AssetHandle& dependency : current) {
+        m_dependents[dependency].push_back(asset);
+    }
+    UpdateRecordDependencies(asset);
+}
+
+void AssetRegistry::UpdateRecordDependencies(const AssetHandle& asset) {
+    auto path = m_handleToPath.find(asset);
+    const AssetRecord* record = path != m_handleToPath.end() ? m_database.Find(path->second) : nullptr;
+    if (record) {
+        AssetRecord updated = *record;
+        updated.dependencies = m_dependencies[asset];
+        m_database.Upsert(std::move(updated));
+    }
 }
 
 std::vector<AssetHandle> AssetRegistry::GetDependencies(const AssetHandle& asset) const {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "AssetHandle.h"
+#include "AssetDatabase.h"
 #include "../Core/AssetTypes.h"
 #include <string>
 #include <unordered_map>
@@ -17,19 +18,35 @@ struct AssetMetadata {
     std::filesystem::file_time_type lastModified;
 };
 
+// Totals from the most recent directory scan
+struct AssetScanStats {
+    size_t files = 0;
+    size_t directories = 0;
+    size_t changed = 0;     // records re-read from disk
+    size_t removed = 0;
+    double milliseconds = 0.0;
+};
+
+class ThreadPool;
+
 // Manages asset registration and .meta file generation
 class AssetRegistry {
 public:
     AssetRegistry() = default;
     ~AssetRegistry() = default;
     
-    bool Initialize(const std::string& assetsDirectory);
+    // databasePath may be empty, in which case every startup is a full scan.
+    // scanPool, when given, is used to stat files in parallel.
+    bool Initialize(const std::string& assetsDirectory, const std::string& databasePath = "",
+                    ThreadPool* scanPool = nullptr);
     void Shutdown();
     
     // Asset registration
     AssetHandle RegisterAsset(const std::string& filePath);
     void UnregisterAsset(const AssetHandle& handle);
     void UnregisterAsset(const std::string& filePath);
+    // Registers an asset that lives in a mounted bundle rather than on disk; it is not indexed
+    void RegisterBundledAsset(const std::string& filePath, const AssetHandle& handle, AssetType type);
     
     // Asset lookup
     bool HasAsset(const AssetHandle& handle) const;
@@ -41,11 +58,18 @@ public:
     
     // Asset scanning and monitoring
     void ScanAssetsDirectory();
+    // Re-reads a file, rescans a folder, or forgets a path that no longer exists
     void RefreshAsset(const std::string& filePath);
+    const AssetScanStats& GetLastScanStats() const { return m_lastScanStats; }
+    
+    // Index of everything under the assets directory, folders included
+    const AssetDatabase& GetDatabase() const { return m_database; }
     
     // Dependency tracking
     void AddDependency(const AssetHandle& asset, const AssetHandle& dependency);
     void RemoveDependency(const AssetHandle& asset, const AssetHandle& dependency);
+    // Replaces everything recorded for asset; no-op when the list is unchanged
+    void SetDependencies(const AssetHandle& asset, const std::vector<AssetHandle>& dependencies);
     std::vector<AssetHandle> GetDependencies(const AssetHandle& asset) const;
     std::vector<AssetHandle> GetDependents(const AssetHandle& asset) const;
     
@@ -53,6 +77,23 @@ public:
     const std::unordered_map<AssetHandle, AssetMetadata, AssetHandleHash>& GetAllAssets() const { return m_assets; }
 
 private:
+    struct ScanEntry {
+        std::string path;
+        bool isDirectory = false;
+        bool changed = false;
+        bool needsMeta = false;
+        AssetRecord record;
+    };
+    
+    // Directory scanning; ValidateEntry only reads shared state and runs on the scan pool
+    void ScanTree(const std::string& root);
+    void ValidateEntry(ScanEntry& entry) const;
+    void CommitEntry(ScanEntry& entry);
+    void RegisterRecord(const AssetRecord& record);
+    void RemoveTree(const std::string& path);
+    void UpdateRecordDependencies(const AssetHandle& asset);
+    static bool IsMetaFile(const std::string& path);
+    
     // .meta file operations
     std::string GetMetaFilePath(const std::string& assetPath) const;
     bool LoadMetaFile(const std::string& assetPath, AssetMetadata& metadata) const;
@@ -69,6 +110,11 @@ private:
     std::string m_assetsDirectory;
     std::unordered_map<AssetHandle, AssetMetadata, AssetHandleHash> m_assets;
     std::unordered_map<std::string, AssetHandle> m_pathToHandle;
+    std::unordered_map<AssetHandle, std::string, AssetHandleHash> m_handleToPath;
+    
+    AssetDatabase m_database;
+    ThreadPool* m_scanPool = nullptr;
+    AssetScanStats m_lastScanStats;
     
     // Dependency tracking
     std::unordered_map<AssetHandle, std::vector<AssetHandle>, AssetHandleHash> m_dependencies;
@@ -0,0 +1,197 @@
+#include "Compression.h"
+#include <cstring>
+#include <vector>
+
+namespace BGE {
+namespace Compression {
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t LAST_LITERALS = 5;     // the final bytes are always literals
+constexpr size_t MAX_OFFSET = 65535;
+constexpr uint32_t HASH_BITS = 14;
+constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+uint32_t Read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t HashSequence(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Writes the extra bytes of a length that does not fit its 4-bit token field
+uint8_t* WriteLength(uint8_t* out, const uint8_t* end, size_t length) {
+    while (length >= 255) {
+        if (out >= end) {
+            return nullptr;
+        }
+        *out++ = 255;
+        length -= 255;
+    }
+    if (out >= end) {
+        return nullptr;
+    }
+    *out++ = static_cast<uint8_t>(length);
+    return out;
+}
+
+// One sequence: token, literal run, and (unless last) the match offset and length
+uint8_t* WriteSequence(uint8_t* out, const uint8_t* end, const uint8_t* literals, size_t literalCount,
+                       size_t offset, size_t matchLength, bool last) {
+    if (out >= end) {
+        return nullptr;
+    }
+    uint8_t* token = out++;
+    *token = static_cast<uint8_t>((literalCount >= 15 ? 15 : literalCount) << 4);
+    if (literalCount >= 15 && !(out = WriteLength(out, end, literalCount - 15))) {
+        return nullptr;
+    }
+    
+    if (static_cast<size_t>(end - out) < literalCount) {
+        return nullptr;
+    }
+    if (literalCount > 0) {
+        std::memcpy(out, literals, literalCount);
+        out += literalCount;
+    }
+    if (last) {
+        return out;
+    }
+    
+    if (end - out < 2) {
+        return nullptr;
+    }
+    *out++ = static_cast<uint8_t>(offset & 0xFF);
+    *out++ = static_cast<uint8_t>(offset >> 8);
+    
+    size_t extra = matchLength - MIN_MATCH;
+    *token |= static_cast<uint8_t>(extra >= 15 ? 15 : extra);
+    if (extra >= 15 && !(out = WriteLength(out, end, extra - 15))) {
+        return nullptr;
+    }
+    return out;
+}
+
+// Reads a length continued past its 4-bit token field
+bool ReadLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+    do {
+        if (in >= end) {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+} // anonymous namespace
+
+size_t CompressBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t Compress(const void* source, size_t size, void* destination, size_t capacity) {
+    const auto* src = static_cast<const uint8_t*>(source);
+    auto* out = static_cast<uint8_t*>(destination);
+    const uint8_t* outEnd = out + capacity;
+    
+    std::vector<uint32_t> table(size_t(1) << HASH_BITS, EMPTY_SLOT);
+    size_t anchor = 0;
+    size_t position = 0;
+    size_t matchLimit = size > LAST_LITERALS ? size - LAST_LITERALS : 0;
+    
+    while (position + MIN_MATCH <= matchLimit) {
+        uint32_t sequence = Read32(src + position);
+        uint32_t& slot = table[HashSequence(sequence)];
+        uint32_t candidate = slot;
+        slot = static_cast<uint32_t>(position);
+        
+        if (candidate == EMPTY_SLOT || position - candidate > MAX_OFFSET || Read32(src + candidate) != sequence) {
+            ++position;
+            continue;
+        }
+        
+        size_t matchLength = MIN_MATCH;
+        while (position + matchLength < matchLimit && src[candidate + matchLength] == src[position + matchLength]) {
+            ++matchLength;
+        }
+        
+        out = WriteSequence(out, outEnd, src + anchor, position - anchor, position - candidate, matchLength, false);
+        if (!out) {
+            return 0;
+        }
+        position += matchLength;
+        anchor = position;
+    }
+    
+    out = WriteSequence(out, outEnd, src + anchor, size - anchor, 0, 0, true);
+    return out ? static_cast<size_t>(out - static_cast<uint8_t*>(destination)) : 0;
+}
+
+bool Decompress(const void* source, size_t size, void* destination, size_t rawSize) {
+    const auto* in = static_cast<const uint8_t*>(source);
+    const uint8_t* inEnd = in + size;
+    auto* out = static_cast<uint8_t*>(destination);
+    uint8_t* outStart = out;
+    uint8_t* outEnd = out + rawSize;
+    
+    while (in < inEnd) {
+        uint8_t token = *in++;
+        
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !ReadLength(in, inEnd, literalCount)) {
+            return false;
+        }
+        if (static_cast<size_t>(inEnd - in) < literalCount || static_cast<size_t>(outEnd - out) < literalCount) {
+            return false;
+        }
+        if (literalCount > 0) {
+            std::memcpy(out, in, literalCount);
+            in += literalCount;
+            out += literalCount;
+        }
+        
+        if (in == inEnd) {
+            break;  // the last sequence has no match
+        }
+        
+        if (inEnd - in < 2) {
+            return false;
+        }
+        size_t offset = static_cast<size_t>(in[0]) | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        if (offset == 0 || offset > static_cast<size_t>(out - outStart)) {
+            return false;
+        }
+        
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLength(in, inEnd, matchLength)) {
+            return false;
+        }
+        matchLength += MIN_MATCH;
+        if (static_cast<size_t>(outEnd - out) < matchLength) {
+            return false;
+        }
+        
+        const uint8_t* match = out - offset;
+        if (offset >= matchLength) {
+            std::memcpy(out, match, matchLength);
+            out += matchLength;
+        } else {
+            // Overlapping copy repeats the last `offset` bytes
+            for (size_t i = 0; i < matchLength; ++i) {
+                *out++ = match[i];
+            }
+        }
+    }
+    
+    return out == outEnd;
+}
+
+} // namespace Compression
+} // namespace BGE
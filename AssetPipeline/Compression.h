@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace BGE {
+namespace Compression {
+
+// Byte-oriented LZ77 codec (LZ4 block layout): no entropy coding, so it
+// decompresses at memory speed while still shrinking the flat colour runs
+// and repeated rows typical of pixel-art textures. Blocks are limited to
+// 2 GB and carry no header; the caller stores the uncompressed size.
+
+// Worst-case compressed size of `size` bytes
+size_t CompressBound(size_t size);
+
+// Returns the compressed size, or 0 if the output would not fit in `capacity`
+size_t Compress(const void* source, size_t size, void* destination, size_t capacity);
+
+// Returns false on malformed input or if the output is not exactly `rawSize` bytes
+bool Decompress(const void* source, size_t size, void* destination, size_t rawSize);
+
+} // namespace Compression
+} // namespace BGE
@@ -0,0 +1,319 @@
+#include "FileWatcher.h"
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace BGE {
+
+#ifdef __linux__
+namespace {
+
+constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE;
+
+} // anonymous namespace
+#endif
+
+FileWatcher::~FileWatcher() {
+    Stop();
+}
+
+bool FileWatcher::Start(const std::string& rootDirectory) {
+    Stop();
+    
+    std::error_code ec;
+    std::filesystem::path root = std::filesystem::absolute(rootDirectory, ec);
+    if (ec || !std::filesystem::is_directory(root, ec)) {
+        std::cerr << "FileWatcher: not a directory: " << rootDirectory << std::endl;
+        return false;
+    }
+    if (!root.has_filename()) {
+        root = root.parent_path();
+    }
+    m_root = root.string();
+    
+    m_running.store(true, std::memory_order_relaxed);
+
+#ifdef __linux__
+    m_nativeEvents = InitializeNative();
+    if (m_nativeEvents) {
+        m_thread = std::thread(&FileWatcher::NativeThread, this);
+        return true;
+    }
+    std::cerr << "FileWatcher: inotify unavailable, polling " << m_root << " every "
+              << POLL_INTERVAL.count() << " ms" << std::endl;
+#endif
+
+    m_thread = std::thread(&FileWatcher::PollingThread, this);
+    return true;
+}
+
+void FileWatcher::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        if (!m_running.exchange(false, std::memory_order_relaxed) && !m_thread.joinable()) {
+            return;
+        }
+    }
+    m_stopCondition.notify_all();
+
+#ifdef __linux__
+    if (m_wakeFd >= 0) {
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = write(m_wakeFd, &one, sizeof(one));
+    }
+#endif
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+#ifdef __linux__
+    ShutdownNative();
+#endif
+
+    m_nativeEvents = false;
+    m_pending.clear();
+    std::lock_guard<std::mutex> lock(m_readyMutex);
+    m_ready.clear();
+    m_hasReady.store(false, std::memory_order_relaxed);
+}
+
+bool FileWatcher::PollChanges(std::vector<FileChange>& changes) {
+    changes.clear();
+    if (!m_hasReady.load(std::memory_order_acquire)) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(m_readyMutex);
+    changes.reserve(m_ready.size());
+    for (auto& [path, type] : m_ready) {
+        changes.push_back({path, type});
+    }
+    m_ready.clear();
+    m_hasReady.store(false, std::memory_order_relaxed);
+    return !changes.empty();
+}
+
+void FileWatcher::NoteChange(const std::string& path, FileChangeType type) {
+    // A delete followed by a write (editors that save by replacing the file) settles as Modified
+    PendingChange& pending = m_pending[path];
+    pending.type = type;
+    pending.lastEvent = Clock::now();
+}
+
+void FileWatcher::PublishSettled() {
+    if (m_pending.empty()) {
+        return;
+    }
+    
+    Clock::time_point now = Clock::now();
+    std::unique_lock<std::mutex> lock(m_readyMutex, std::defer_lock);
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (now - it->second.lastEvent < SETTLE_TIME) {
+            ++it;
+            continue;
+        }
+        if (!lock.owns_lock()) {
+            lock.lock();
+        }
+        m_ready[it->first] = it->second.type;
+        it = m_pending.erase(it);
+    }
+    
+    if (lock.owns_lock()) {
+        m_hasReady.store(true, std::memory_order_release);
+    }
+}
+
+void FileWatcher::ScanTree(std::unordered_map<std::string, FileState>& snapshot) const {
+    std::error_code ec;
+    auto options = std::filesystem::directory_options::skip_permission_denied;
+    for (std::filesystem::recursive_directory_iterator it(m_root, options, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code entryError;
+        if (!it->is_regular_file(entryError)) {
+            continue;
+        }
+        FileState state;
+        state.modified = it->last_write_time(entryError);
+        state.size = it->file_size(entryError);
+        if (!entryError) {
+            snapshot[it->path().string()] = state;
+        }
+    }
+}
+
+void FileWatcher::PollingThread() {
+    std::unordered_map<std::string, FileState> previous;
+    std::unordered_map<std::string, FileState> current;
+    ScanTree(previous);
+    
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_stopMutex);
+            m_stopCondition.wait_for(lock, POLL_INTERVAL, [this]() {
+                return !m_running.load(std::memory_order_relaxed);
+            });
+            if (!m_running.load(std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        
+        current.clear();
+        ScanTree(current);
+        for (const auto& [path, state] : current) {
+            auto it = previous.find(path);
+            if (it == previous.end() || it->second.modified != state.modified || it->second.size != state.size) {
+                NoteChange(path, FileChangeType::Modified);
+            }
+        }
+        for (const auto& entry : previous) {
+            if (current.find(entry.first) == current.end()) {
+                NoteChange(entry.first, FileChangeType::Removed);
+            }
+        }
+        previous.swap(current);
+        
+        // A change seen on this scan is published on the next unless the file keeps changing
+        PublishSettled();
+    }
+}
+
+#ifdef __linux__
+
+bool FileWatcher::InitializeNative() {
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) {
+        return false;
+    }
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd < 0 || !AddWatchRecursive(m_root, false)) {
+        ShutdownNative();
+        return false;
+    }
+    return true;
+}
+
+void FileWatcher::ShutdownNative() {
+    if (m_inotifyFd >= 0) {
+        close(m_inotifyFd);     // also drops every watch
+        m_inotifyFd = -1;
+    }
+    if (m_wakeFd >= 0) {
+        close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+    m_watchPaths.clear();
+}
+
+bool FileWatcher::AddWatchRecursive(const std::string& directory, bool reportFiles) {
+    int wd = inotify_add_watch(m_inotifyFd, directory.c_str(), WATCH_MASK | IN_ONLYDIR);
+    if (wd < 0) {
+        std::cerr << "FileWatcher: cannot watch " << directory << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    m_watchPaths[wd] = directory;
+    
+    // inotify is not recursive. Files in a directory that just appeared may have been
+    // written before its watch existed, so report them as well.
+    bool ok = true;
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code entryError;
+        if (it->is_directory(entryError)) {
+            ok = AddWatchRecursive(it->path().string(), reportFiles) && ok;
+        } else if (reportFiles && it->is_regular_file(entryError)) {
+            NoteChange(it->path().string(), FileChangeType::Modified);
+        }
+    }
+    return ok;
+}
+
+void FileWatcher::ReadNativeEvents() {
+    alignas(inotify_event) char buffer[16 * 1024];
+    
+    while (true) {
+        ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;  // EAGAIN: drained
+        }
+        
+        for (char* cursor = buffer; cursor < buffer + length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+            
+            if (event->mask & IN_Q_OVERFLOW) {
+                // The kernel dropped events; report the whole tree rather than miss an edit
+                std::cerr << "FileWatcher: event queue overflowed, rescanning " << m_root << std::endl;
+                std::unordered_map<std::string, FileState> snapshot;
+                ScanTree(snapshot);
+                for (const auto& entry : snapshot) {
+                    NoteChange(entry.first, FileChangeType::Modified);
+                }
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                m_watchPaths.erase(event->wd);
+                continue;
+            }
+            
+            auto watch = m_watchPaths.find(event->wd);
+            if (watch == m_watchPaths.end() || event->len == 0) {
+                continue;
+            }
+            std::string path = (std::filesystem::path(watch->second) / event->name).string();
+            
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    AddWatchRecursive(path, true);
+                } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                    NoteChange(path, FileChangeType::Removed);   // covers everything that was inside
+                }
+                continue;
+            }
+            
+            if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                NoteChange(path, FileChangeType::Removed);
+            } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                NoteChange(path, FileChangeType::Modified);
+            }
+        }
+    }
+}
+
+void FileWatcher::NativeThread() {
+    pollfd fds[2] = {
+        {m_inotifyFd, POLLIN, 0},
+        {m_wakeFd, POLLIN, 0}
+    };
+    
+    while (m_running.load(std::memory_order_relaxed)) {
+        // Sleep until something happens, or until the oldest pending change may have settled
+        int timeout = m_pending.empty() ? -1 : static_cast<int>(SETTLE_TIME.count());
+        int result = poll(fds, 2, timeout);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "FileWatcher: poll failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        if (fds[1].revents & POLLIN) {
+            break;  // Stop()
+        }
+        if (fds[0].revents & POLLIN) {
+            ReadNativeEvents();
+        }
+        PublishSettled();
+    }
+}
+
+#endif
+
+} // namespace BGE
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace BGE {
+
+enum class FileChangeType {
+    Modified,   // written, or created / moved into the tree
+    Removed     // deleted or moved out of the tree
+};
+
+struct FileChange {
+    std::string path;   // absolute
+    FileChangeType type;
+};
+
+// Watches a directory tree for file changes on a background thread.
+//
+// On Linux the watcher uses inotify; elsewhere, or when inotify is
+// unavailable (e.g. the watch limit is reached), it falls back to a
+// background scan comparing modification times and sizes. Events are
+// coalesced per path and held until the file has been quiet for a short
+// while, so an editor's burst of writes turns into a single change.
+// PollChanges() is cheap to call every frame: it only takes the lock when
+// something is ready.
+class FileWatcher {
+public:
+    FileWatcher() = default;
+    ~FileWatcher();
+    
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+    
+    bool Start(const std::string& rootDirectory);
+    void Stop();
+    bool IsRunning() const { return m_running.load(std::memory_order_relaxed); }
+    bool IsUsingNativeEvents() const { return m_nativeEvents; }
+    
+    // Moves the settled changes into `changes` (cleared first); returns false when there are none
+    bool PollChanges(std::vector<FileChange>& changes);
+    
+    static constexpr std::chrono::milliseconds SETTLE_TIME{100};
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{500};   // fallback scan period
+
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    struct PendingChange {
+        FileChangeType type;
+        Clock::time_point lastEvent;
+    };
+    
+    struct FileState {
+        std::filesystem::file_time_type modified;
+        uintmax_t size;
+    };
+    
+    void NativeThread();
+    void PollingThread();
+    
+    // Records an event for `path`; later events replace earlier ones
+    void NoteChange(const std::string& path, FileChangeType type);
+    // Publishes pending changes that have settled
+    void PublishSettled();
+
+#ifdef __linux__
+    bool InitializeNative();
+    void ShutdownNative();
+    bool AddWatchRecursive(const std::string& directory, bool reportFiles);
+    void ReadNativeEvents();
+    
+    int m_inotifyFd = -1;
+    int m_wakeFd = -1;
+    std::unordered_map<int, std::string> m_watchPaths;
+#endif
+
+    void ScanTree(std::unordered_map<std::string, FileState>& snapshot) const;
+    
+    std::string m_root;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    bool m_nativeEvents = false;
+    
+    // Watcher thread only
+    std::unordered_map<std::string, PendingChange> m_pending;
+    
+    // Handed to the main thread
+    std::mutex m_readyMutex;
+    std::unordered_map<std::string, FileChangeType> m_ready;
+    std::atomic<bool> m_hasReady{false};
+    
+    // Wakes the polling fallback early on Stop()
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCondition;
+};
+
+} // namespace BGE
@@ -4,6 +4,8 @@
 #include "../Core/AssetTypes.h"
 #include <string>
 #include <filesystem>
+#include <memory>
+#include <vector>
 
 namespace BGE {
 
@@ -20,6 +22,13 @@ public:
     void SetHandle(const AssetHandle& handle) { m_handle = handle; }
     void SetPath(const std::string& path) { m_path = path; }
     void SetLastModified(std::filesystem::file_time_type time) { m_lastModified = time; }
+    
+    // Resident size, counted against the AssetManager's per-type budgets
+    virtual size_t GetCpuMemoryUsage() const { return 0; }
+    virtual size_t GetGpuMemoryUsage() const { return 0; }
+    
+    // Assets this one refers to by handle; they are kept resident while it is
+    virtual void GetDependencies(std::vector<AssetHandle>& dependencies) const { (void)dependencies; }
 
 protected:
     IAsset(AssetType type) : m_type(type) {}
@@ -39,6 +48,15 @@ public:
     int height = 0;
     int channels = 0;
     uint32_t rendererId = 0;
+    
+    // Decoded pixels waiting for the GPU upload (a decoder buffer or a mapped cache entry); released once uploaded
+    std::shared_ptr<const unsigned char> pixels;
+    
+    size_t GetCpuMemoryUsage() const override { return sizeof(*this) + (pixels ? GetImageSize() : 0); }
+    size_t GetGpuMemoryUsage() const override { return rendererId != 0 ? GetImageSize() : 0; }
+
+private:
+    size_t GetImageSize() const { return static_cast<size_t>(width) * height * channels; }
 };
 
 class MaterialAsset : public IAsset {
@@ -54,6 +72,15 @@ public:
         AssetHandle normalTexture;
         AssetHandle roughnessTexture;
     } data;
+    
+    size_t GetCpuMemoryUsage() const override { return sizeof(*this); }
+    void GetDependencies(std::vector<AssetHandle>& dependencies) const override {
+        for (const AssetHandle& texture : {data.albedoTexture, data.normalTexture, data.roughnessTexture}) {
+            if (texture.IsValid()) {
+                dependencies.push_back(texture);
+            }
+        }
+    }
 };
 
 class PrefabAsset : public IAsset {
@@ -61,6 +88,8 @@ public:
     PrefabAsset() : IAsset(AssetType::Prefab) {}
     
     std::string entityData; // JSON serialized entity data
+    
+    size_t GetCpuMemoryUsage() const override { return sizeof(*this) + entityData.capacity(); }
 };
 
 class SceneAsset : public IAsset {
@@ -68,6 +97,8 @@ public:
     SceneAsset() : IAsset(AssetType::Scene) {}
     
     std::string sceneData; // JSON serialized scene data
+    
+    size_t GetCpuMemoryUsage() const override { return sizeof(*this) + sceneData.capacity(); }
 };
 
 } // namespace BGE
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "IAssetLoader.h"
 #include "../Core/ServiceLocator.h"
+#include "../Core/Profiling/Profiler.h"
 #include "../Renderer/Renderer.h"
 #include "../ThirdParty/json/json.hpp"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
 
 // STB Image for texture loading
@@ -14,44 +16,266 @@ using json = nlohmann::json;
 
 namespace BGE {
 
+namespace {
+
+// Leading fields of a cooked texture; the pixels follow, mip level 0 first
+struct CookedTextureHeader {
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t mipCount;
+};
+
+constexpr size_t COOKED_MATERIAL_FLOATS = 7;    // color[4], roughness, metallic, emission
+
+void AppendBytes(std::vector<char>& out, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+void AppendHandle(std::vector<char>& out, const AssetHandle& handle) {
+    const std::string& text = handle.ToString();
+    uint16_t length = static_cast<uint16_t>(text.size());
+    AppendBytes(out, &length, sizeof(length));
+    AppendBytes(out, text.data(), length);
+}
+
+bool ReadHandle(const unsigned char*& cursor, const unsigned char* end, AssetHandle& handle) {
+    uint16_t length;
+    if (end - cursor < static_cast<ptrdiff_t>(sizeof(length))) {
+        return false;
+    }
+    std::memcpy(&length, cursor, sizeof(length));
+    cursor += sizeof(length);
+    if (end - cursor < length) {
+        return false;
+    }
+    if (length > 0) {
+        handle = AssetHandle::FromString(std::string(reinterpret_cast<const char*>(cursor), length));
+    }
+    cursor += length;
+    return true;
+}
+
+// A bundled asset has no file of its own; it reports the epoch
+std::filesystem::file_time_type GetLastWriteTime(const std::string& filePath) {
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time(filePath, ec);
+    return ec ? std::filesystem::file_time_type() : time;
+}
+
+} // anonymous namespace
+
+// IAssetLoader Implementation
+std::shared_ptr<IAsset> IAssetLoader::LoadAsset(const std::string& filePath, const AssetHandle& handle,
+                                                AssetCache* cache) {
+    AssetSource source;
+    if (!CanLoadAsset(filePath) || !ReadSource(filePath, cache, source)) {
+        return nullptr;
+    }
+    
+    auto asset = DecodeSource(filePath, handle, cache, source);
+    if (asset && !FinalizeAsset(*asset)) {
+        return nullptr;
+    }
+    return asset;
+}
+
+bool IAssetLoader::ReadSource(const std::string& filePath, AssetCache* cache, AssetSource& source) const {
+    uint32_t cookVersion = GetCookVersion();
+    if (!cache || !cache->IsEnabled() || cookVersion == 0) {
+        return ReadFile(filePath, source.fileData);
+    }
+    
+    // Unchanged since we last hashed it: map the cooked entry without touching the source
+    source.cacheKey = cache->FindSourceKey(filePath, GetAssetType(), cookVersion);
+    if (source.cacheKey != 0) {
+        source.cooked = cache->Load(source.cacheKey, GetAssetType(), cookVersion);
+        if (source.cooked) {
+            return true;
+        }
+    }
+    
+    if (!ReadFile(filePath, source.fileData)) {
+        return false;
+    }
+    
+    // The content may still be cached, e.g. the file was only touched or was copied
+    uint64_t key = cache->RecordSource(filePath, source.fileData, GetAssetType(), cookVersion);
+    if (key != source.cacheKey) {
+        source.cacheKey = key;
+        source.cooked = cache->Load(key, GetAssetType(), cookVersion);
+    }
+    return true;
+}
+
+bool IAssetLoader::ReadBundledSource(const AssetBundle& bundle, const AssetBundleEntry& entry, AssetCache* cache,
+                                     AssetSource& source) const {
+    source.bundle = &bundle;
+    source.bundleEntry = &entry;
+    
+    uint32_t cookVersion = GetCookVersion();
+    if (cache && cache->IsEnabled() && cookVersion != 0) {
+        source.cacheKey = AssetCache::MakeKey(entry.contentHash, GetAssetType(), cookVersion);
+        source.cooked = cache->Load(source.cacheKey, GetAssetType(), cookVersion);
+        if (source.cooked) {
+            return true;
+        }
+    }
+    return bundle.ReadEntry(entry, source.fileData);
+}
+
+std::shared_ptr<IAsset> IAssetLoader::DecodeSource(const std::string& filePath, const AssetHandle& handle,
+                                                   AssetCache* cache, AssetSource& source) {
+    if (source.cooked) {
+        if (auto asset = DecodeCookedAsset(filePath, handle, source.cooked)) {
+            return asset;
+        }
+        std::cerr << "Discarding unreadable cooked data for " << filePath << std::endl;
+        source.cooked.reset();
+        if (source.fileData.empty()) {
+            bool read = source.bundle ? source.bundle->ReadEntry(*source.bundleEntry, source.fileData)
+                                      : ReadFile(filePath, source.fileData);
+            if (!read) {
+                return nullptr;
+            }
+        }
+    }
+    
+    auto asset = DecodeAsset(filePath, handle, source.fileData);
+    if (asset && cache && source.cacheKey != 0) {
+        std::vector<char> payload;
+        if (CookAsset(*asset, payload)) {
+            cache->Store(source.cacheKey, GetAssetType(), GetCookVersion(), payload);
+        }
+    }
+    return asset;
+}
+
+bool IAssetLoader::ReadFile(const std::string& filePath, std::vector<char>& data) {
+    BGE_PROFILE_SCOPE("IAssetLoader::ReadFile");
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Could not open asset file: " << filePath << std::endl;
+        return false;
+    }
+    
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    data.resize(static_cast<size_t>(std::max<std::streamsize>(size, 0)));
+    if (size > 0 && !file.read(data.data(), size)) {
+        std::cerr << "Could not read asset file: " << filePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
 // TextureLoader Implementation
-std::shared_ptr<IAsset> TextureLoader::LoadAsset(const std::string& filePath, const AssetHandle& handle) {
+std::shared_ptr<IAsset> TextureLoader::DecodeAsset(const std::string& filePath, const AssetHandle& handle,
+                                                   const std::vector<char>& fileData) {
+    BGE_PROFILE_SCOPE("TextureLoader::DecodeAsset");
     if (!CanLoadAsset(filePath)) {
         return nullptr;
     }
     
     int width, height, channels;
-    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 0);
+    unsigned char* data = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(fileData.data()),
+                                                static_cast<int>(fileData.size()), &width, &height, &channels, 0);
     
     if (!data) {
         std::cerr << "Error loading texture: " << filePath << " - " << stbi_failure_reason() << std::endl;
         return nullptr;
     }
     
-    auto renderer = ServiceLocator::Instance().GetService<Renderer>();
-    uint32_t textureId = 0;
-    
-    if (renderer) {
-        textureId = renderer->CreateTexture(width, height, channels, data);
-    } else {
-        std::cerr << "Renderer service not found. Cannot create GPU texture for: " << filePath << std::endl;
-        stbi_image_free(data);
-        return nullptr;
-    }
-    
     auto textureAsset = std::make_shared<TextureAsset>();
     textureAsset->SetHandle(handle);
     textureAsset->SetPath(filePath);
-    textureAsset->SetLastModified(std::filesystem::last_write_time(filePath));
+    textureAsset->SetLastModified(GetLastWriteTime(filePath));
     textureAsset->width = width;
     textureAsset->height = height;
     textureAsset->channels = channels;
-    textureAsset->rendererId = textureId;
+    textureAsset->pixels.reset(data, stbi_image_free);
+    return textureAsset;
+}
+
+bool TextureLoader::CookAsset(const IAsset& asset, std::vector<char>& payload) const {
+    const auto& textureAsset = static_cast<const TextureAsset&>(asset);
+    if (!textureAsset.pixels) {
+        return false;
+    }
+    
+    // The renderer samples level 0 only, so that is all we store for now
+    CookedTextureHeader header = {};
+    header.width = static_cast<uint32_t>(textureAsset.width);
+    header.height = static_cast<uint32_t>(textureAsset.height);
+    header.channels = static_cast<uint32_t>(textureAsset.channels);
+    header.mipCount = 1;
+    
+    size_t pixelBytes = size_t(header.width) * header.height * header.channels;
+    payload.reserve(sizeof(header) + pixelBytes);
+    AppendBytes(payload, &header, sizeof(header));
+    AppendBytes(payload, textureAsset.pixels.get(), pixelBytes);
+    return true;
+}
+
+std::shared_ptr<IAsset> TextureLoader::DecodeCookedAsset(const std::string& filePath, const AssetHandle& handle,
+                                                         const std::shared_ptr<const CookedBlob>& blob) {
+    BGE_PROFILE_SCOPE("TextureLoader::DecodeCookedAsset");
+    CookedTextureHeader header;
+    if (blob->GetSize() < sizeof(header)) {
+        return nullptr;
+    }
+    std::memcpy(&header, blob->GetData(), sizeof(header));
     
-    stbi_image_free(data);
+    size_t pixelBytes = size_t(header.width) * header.height * header.channels;
+    if (header.mipCount < 1 || header.channels < 1 || header.channels > 4 || blob->GetSize() < sizeof(header) + pixelBytes) {
+        return nullptr;
+    }
+    
+    auto textureAsset = std::make_shared<TextureAsset>();
+    textureAsset->SetHandle(handle);
+    textureAsset->SetPath(filePath);
+    textureAsset->SetLastModified(GetLastWriteTime(filePath));
+    textureAsset->width = static_cast<int>(header.width);
+    textureAsset->height = static_cast<int>(header.height);
+    textureAsset->channels = static_cast<int>(header.channels);
+    // Points into the cache entry, which stays mapped until the upload releases the pixels
+    textureAsset->pixels = std::shared_ptr<const unsigned char>(blob, blob->GetData() + sizeof(header));
     return textureAsset;
 }
 
+bool TextureLoader::FinalizeAsset(IAsset& asset) {
+    BGE_PROFILE_SCOPE("TextureLoader::FinalizeAsset");
+    auto& textureAsset = static_cast<TextureAsset&>(asset);
+    if (!textureAsset.pixels) {
+        return textureAsset.rendererId != 0;
+    }
+    
+    auto renderer = ServiceLocator::Instance().GetService<Renderer>();
+    if (!renderer) {
+        std::cerr << "Renderer service not found. Cannot create GPU texture for: " << asset.GetPath() << std::endl;
+        textureAsset.pixels.reset();
+        return false;
+    }
+    
+    textureAsset.rendererId = renderer->CreateTexture(textureAsset.width, textureAsset.height, textureAsset.channels,
+                                                      textureAsset.pixels.get());
+    textureAsset.pixels.reset();
+    return textureAsset.rendererId != 0;
+}
+
+void TextureLoader::ReleaseAsset(IAsset& asset) {
+    auto& textureAsset = static_cast<TextureAsset&>(asset);
+    if (textureAsset.rendererId == 0) {
+        return;
+    }
+    
+    if (auto renderer = ServiceLocator::Instance().GetService<Renderer>()) {
+        renderer->DeleteTexture(textureAsset.rendererId);
+    }
+    textureAsset.rendererId = 0;
+}
+
 bool TextureLoader::CanLoadAsset(const std::string& filePath) const {
     std::string ext = std::filesystem::path(filePath).extension().string();
     return IsValidTextureExtension(ext);
@@ -66,25 +290,20 @@ bool TextureLoader::IsValidTextureExtension(const std::string& extension) const
 }
 
 // MaterialLoader Implementation
-std::shared_ptr<IAsset> MaterialLoader::LoadAsset(const std::string& filePath, const AssetHandle& handle) {
+std::shared_ptr<IAsset> MaterialLoader::DecodeAsset(const std::string& filePath, const AssetHandle& handle,
+                                                    const std::vector<char>& fileData) {
+    BGE_PROFILE_SCOPE("MaterialLoader::DecodeAsset");
     if (!CanLoadAsset(filePath)) {
         return nullptr;
     }
     
     try {
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
-            std::cerr << "Could not open material file: " << filePath << std::endl;
-            return nullptr;
-        }
-        
-        json j;
-        file >> j;
+        json j = json::parse(fileData.begin(), fileData.end());
         
         auto materialAsset = std::make_shared<MaterialAsset>();
         materialAsset->SetHandle(handle);
         materialAsset->SetPath(filePath);
-        materialAsset->SetLastModified(std::filesystem::last_write_time(filePath));
+        materialAsset->SetLastModified(GetLastWriteTime(filePath));
         
         // Load material properties with defaults
         if (j.contains("color") && j["color"].is_array() && j["color"].size() >= 3) {
@@ -114,13 +333,55 @@ std::shared_ptr<IAsset> MaterialLoader::LoadAsset(const std::string& filePath, c
         }
         
         return materialAsset;
-        
+    
     } catch (const std::exception& e) {
         std::cerr << "Error loading material " << filePath << ": " << e.what() << std::endl;
         return nullptr;
     }
 }
 
+bool MaterialLoader::CookAsset(const IAsset& asset, std::vector<char>& payload) const {
+    const auto& data = static_cast<const MaterialAsset&>(asset).data;
+    float values[COOKED_MATERIAL_FLOATS] = {
+        data.color[0], data.color[1], data.color[2], data.color[3], data.roughness, data.metallic, data.emission
+    };
+    AppendBytes(payload, values, sizeof(values));
+    AppendHandle(payload, data.albedoTexture);
+    AppendHandle(payload, data.normalTexture);
+    AppendHandle(payload, data.roughnessTexture);
+    return true;
+}
+
+std::shared_ptr<IAsset> MaterialLoader::DecodeCookedAsset(const std::string& filePath, const AssetHandle& handle,
+                                                          const std::shared_ptr<const CookedBlob>& blob) {
+    BGE_PROFILE_SCOPE("MaterialLoader::DecodeCookedAsset");
+    const unsigned char* cursor = blob->GetData();
+    const unsigned char* end = cursor + blob->GetSize();
+    
+    float values[COOKED_MATERIAL_FLOATS];
+    if (blob->GetSize() < sizeof(values)) {
+        return nullptr;
+    }
+    std::memcpy(values, cursor, sizeof(values));
+    cursor += sizeof(values);
+    
+    auto materialAsset = std::make_shared<MaterialAsset>();
+    auto& data = materialAsset->data;
+    if (!ReadHandle(cursor, end, data.albedoTexture) || !ReadHandle(cursor, end, data.normalTexture) ||
+        !ReadHandle(cursor, end, data.roughnessTexture)) {
+        return nullptr;
+    }
+    std::copy(values, values + 4, data.color);
+    data.roughness = values[4];
+    data.metallic = values[5];
+    data.emission = values[6];
+    
+    materialAsset->SetHandle(handle);
+    materialAsset->SetPath(filePath);
+    materialAsset->SetLastModified(GetLastWriteTime(filePath));
+    return materialAsset;
+}
+
 bool MaterialLoader::CanLoadAsset(const std::string& filePath) const {
     return IsMaterialFile(filePath);
 }
@@ -138,28 +399,24 @@ bool MaterialLoader::IsMaterialFile(const std::string& filePath) const {
 }
 
 // PrefabLoader Implementation
-std::shared_ptr<IAsset> PrefabLoader::LoadAsset(const std::string& filePath, const AssetHandle& handle) {
+std::shared_ptr<IAsset> PrefabLoader::DecodeAsset(const std::string& filePath, const AssetHandle& handle,
+                                                  const std::vector<char>& fileData) {
+    BGE_PROFILE_SCOPE("PrefabLoader::DecodeAsset");
     if (!CanLoadAsset(filePath)) {
         return nullptr;
     }
     
     try {
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
-            std::cerr << "Could not open prefab file: " << filePath << std::endl;
-            return nullptr;
-        }
-        
-        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::string content(fileData.begin(), fileData.end());
         
         auto prefabAsset = std::make_shared<PrefabAsset>();
         prefabAsset->SetHandle(handle);
         prefabAsset->SetPath(filePath);
-        prefabAsset->SetLastModified(std::filesystem::last_write_time(filePath));
+        prefabAsset->SetLastModified(GetLastWriteTime(filePath));
         prefabAsset->entityData = content;
         
         return prefabAsset;
-        
+    
     } catch (const std::exception& e) {
         std::cerr << "Error loading prefab " << filePath << ": " << e.what() << std::endl;
         return nullptr;
@@ -172,28 +429,24 @@ bool PrefabLoader::CanLoadAsset(const std::string& filePath) const {
 }
 
 // SceneLoader Implementation
-std::shared_ptr<IAsset> SceneLoader::LoadAsset(const std::string& filePath, const AssetHandle& handle) {
+std::shared_ptr<IAsset> SceneLoader::DecodeAsset(const std::string& filePath, const AssetHandle& handle,
+                                                 const std::vector<char>& fileData) {
+    BGE_PROFILE_SCOPE("SceneLoader::DecodeAsset");
     if (!CanLoadAsset(filePath)) {
         return nullptr;
     }
     
     try {
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
-            std::cerr << "Could not open scene file: " << filePath << std::endl;
-            return nullptr;
-        }
-        
-        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::string content(fileData.begin(), fileData.end());
         
         auto sceneAsset = std::make_shared<SceneAsset>();
         sceneAsset->SetHandle(handle);
         sceneAsset->SetPath(filePath);
-        sceneAsset->SetLastModified(std::filesystem::last_write_time(filePath));
+        sceneAsset->SetLastModified(GetLastWriteTime(filePath));
         sceneAsset->sceneData = content;
         
         return sceneAsset;
-        
+    
     } catch (const std::exception& e) {
         std::cerr << "Error loading scene " << filePath << ": " << e.what() << std::endl;
         return nullptr;
@@ -2,28 +2,86 @@
 
 #include "IAsset.h"
 #include "AssetHandle.h"
+#include "AssetCache.h"
+#include "AssetBundle.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace BGE {
 
-// Base interface for asset loaders
+// What ReadSource() found: a cooked cache entry, or the source file's bytes
+struct AssetSource {
+    std::vector<char> fileData;
+    std::shared_ptr<const CookedBlob> cooked;
+    uint64_t cacheKey = 0;          // 0 when the asset is not cached
+    
+    // Set when the source is packed in a bundle rather than a loose file
+    const AssetBundle* bundle = nullptr;
+    const AssetBundleEntry* bundleEntry = nullptr;
+};
+
+// Base interface for asset loaders.
+//
+// Loading is split in two so it can run off the main thread: DecodeAsset()
+// builds the asset from the file's bytes on a loader thread and must not
+// touch the GPU or engine services; FinalizeAsset() then completes it on the
+// main thread (GPU uploads). LoadAsset() runs the whole thing synchronously.
+//
+// Loaders that return a non-zero GetCookVersion() also go through the
+// AssetCache: CookAsset() writes a freshly decoded asset in binary form and
+// DecodeCookedAsset() rebuilds it from that without parsing the source. Bump
+// the version whenever the cooked layout or the decoding changes.
 class IAssetLoader {
 public:
     virtual ~IAssetLoader() = default;
     
-    virtual std::shared_ptr<IAsset> LoadAsset(const std::string& filePath, const AssetHandle& handle) = 0;
+    std::shared_ptr<IAsset> LoadAsset(const std::string& filePath, const AssetHandle& handle,
+                                      AssetCache* cache = nullptr);
+    
+    // The loader-thread halves of LoadAsset(): file I/O, then decoding
+    bool ReadSource(const std::string& filePath, AssetCache* cache, AssetSource& source) const;
+    // ReadSource() for an asset packed in a bundle; the bundle's content hash stands in for hashing the bytes
+    bool ReadBundledSource(const AssetBundle& bundle, const AssetBundleEntry& entry, AssetCache* cache,
+                           AssetSource& source) const;
+    std::shared_ptr<IAsset> DecodeSource(const std::string& filePath, const AssetHandle& handle,
+                                         AssetCache* cache, AssetSource& source);
+    
+    virtual std::shared_ptr<IAsset> DecodeAsset(const std::string& filePath, const AssetHandle& handle,
+                                                const std::vector<char>& fileData) = 0;
+    virtual bool FinalizeAsset(IAsset& asset) { (void)asset; return true; }
+    // Undoes FinalizeAsset() once nothing references the asset any more; main thread
+    virtual void ReleaseAsset(IAsset& asset) { (void)asset; }
     virtual bool CanLoadAsset(const std::string& filePath) const = 0;
     virtual AssetType GetAssetType() const = 0;
+    
+    virtual uint32_t GetCookVersion() const { return 0; }
+    virtual bool CookAsset(const IAsset& asset, std::vector<char>& payload) const { (void)asset; (void)payload; return false; }
+    virtual std::shared_ptr<IAsset> DecodeCookedAsset(const std::string& filePath, const AssetHandle& handle,
+                                                      const std::shared_ptr<const CookedBlob>& blob) {
+        (void)filePath; (void)handle; (void)blob;
+        return nullptr;
+    }
+    
+    static bool ReadFile(const std::string& filePath, std::vector<char>& data);
 };
 
 // Texture loader implementation
 class TextureLoader : public IAssetLoader {
 public:
-    std::shared_ptr<IAsset> LoadAsset(const std::string& filePath, const AssetHandle& handle) override;
+    std::shared_ptr<IAsset> DecodeAsset(const std::string& filePath, const AssetHandle& handle,
+                                        const std::vector<char>& fileData) override;
+    bool FinalizeAsset(IAsset& asset) override;
+    void ReleaseAsset(IAsset& asset) override;
     bool CanLoadAsset(const std::string& filePath) const override;
     AssetType GetAssetType() const override { return AssetType::Texture; }
     
+    // Cooked: dimensions and the raw pixels, ready to upload
+    uint32_t GetCookVersion() const override { return 1; }
+    bool CookAsset(const IAsset& asset, std::vector<char>& payload) const override;
+    std::shared_ptr<IAsset> DecodeCookedAsset(const std::string& filePath, const AssetHandle& handle,
+                                              const std::shared_ptr<const CookedBlob>& blob) override;
+
 private:
     bool IsValidTextureExtension(const std::string& extension) const;
 };
@@ -31,10 +89,17 @@ private:
 // Material loader implementation
 class MaterialLoader : public IAssetLoader {
 public:
-    std::shared_ptr<IAsset> LoadAsset(const std::string& filePath, const AssetHandle& handle) override;
+    std::shared_ptr<IAsset> DecodeAsset(const std::string& filePath, const AssetHandle& handle,
+                                        const std::vector<char>& fileData) override;
     bool CanLoadAsset(const std::string& filePath) const override;
     AssetType GetAssetType() const override { return AssetType::Material; }
     
+    // Cooked: the material parameters and texture handles, no JSON
+    uint32_t GetCookVersion() const override { return 1; }
+    bool CookAsset(const IAsset& asset, std::vector<char>& payload) const override;
+    std::shared_ptr<IAsset> DecodeCookedAsset(const std::string& filePath, const AssetHandle& handle,
+                                              const std::shared_ptr<const CookedBlob>& blob) override;
+
 private:
     bool IsMaterialFile(const std::string& filePath) const;
 };
@@ -42,7 +107,8 @@ private:
 // Prefab loader implementation
 class PrefabLoader : public IAssetLoader {
 public:
-    std::shared_ptr<IAsset> LoadAsset(const std::string& filePath, const AssetHandle& handle) override;
+    std::shared_ptr<IAsset> DecodeAsset(const std::string& filePath, const AssetHandle& handle,
+                                        const std::vector<char>& fileData) override;
     bool CanLoadAsset(const std::string& filePath) const override;
     AssetType GetAssetType() const override { return AssetType::Prefab; }
 };
@@ -50,10 +116,11 @@ public:
 // Scene loader implementation
 class SceneLoader : public IAssetLoader {
 public:
-    std::shared_ptr<IAsset> LoadAsset(const std::string& filePath, const AssetHandle& handle) override;
+    std::shared_ptr<IAsset> DecodeAsset(const std::string& filePath, const AssetHandle& handle,
+                                        const std::vector<char>& fileData) override;
     bool CanLoadAsset(const std::string& filePath) const override;
     AssetType GetAssetType() const override { return AssetType::Scene; }
-    
+
 private:
     bool IsSceneFile(const std::string& filePath) const;
 };
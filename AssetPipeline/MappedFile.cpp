@@ -0,0 +1,127 @@
+#include "MappedFile.h"
+#include <fstream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define BGE_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BGE {
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (m_size > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view) {
+            if (mapping) {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            m_size = 0;
+            return false;
+        }
+        m_mappingHandle = mapping;
+        m_data = static_cast<const unsigned char*>(view);
+        m_mapped = true;
+    }
+    m_fileHandle = file;
+#elif defined(BGE_HAS_MMAP)
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    
+    m_size = static_cast<size_t>(info.st_size);
+    if (m_size > 0) {
+        void* view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            close(fd);
+            m_size = 0;
+            return false;
+        }
+        m_data = static_cast<const unsigned char*>(view);
+        m_mapped = true;
+    }
+    close(fd);  // the mapping keeps its own reference
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    m_buffer.resize(static_cast<size_t>(size > 0 ? size : 0));
+    if (size > 0 && !file.read(reinterpret_cast<char*>(m_buffer.data()), size)) {
+        m_buffer.clear();
+        return false;
+    }
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+#endif
+
+    m_open = true;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_mapped) {
+#if defined(_WIN32)
+        UnmapViewOfFile(m_data);
+#elif defined(BGE_HAS_MMAP)
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+    }
+
+#if defined(_WIN32)
+    if (m_mappingHandle) {
+        CloseHandle(m_mappingHandle);
+        m_mappingHandle = nullptr;
+    }
+    if (m_fileHandle) {
+        CloseHandle(m_fileHandle);
+        m_fileHandle = nullptr;
+    }
+#endif
+
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+    m_mapped = false;
+}
+
+} // namespace BGE
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace BGE {
+
+// Read-only view of a whole file, memory-mapped where the platform allows it.
+// The mapping stays valid until Close() or destruction; pages are faulted in
+// on first access, so opening a large file costs no reads.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    bool Open(const std::string& path);
+    void Close();
+    
+    bool IsOpen() const { return m_open; }
+    const unsigned char* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+
+private:
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_open = false;
+    bool m_mapped = false;
+
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+
+    std::vector<unsigned char> m_buffer;    // platforms without mmap
+};
+
+} // namespace BGE
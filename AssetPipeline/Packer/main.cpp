@@ -0,0 +1,119 @@
+// BGEAssetPacker: packs an assets directory into one bundle for shipping builds.
+//
+//   BGEAssetPacker <assetsDir> <output.bgebundle> [--index <AssetIndex.db>] [--compress] [--alignment <bytes>]
+//
+// Handles come from the assets' .meta files, so a bundle can stand in for the
+// loose files without breaking references. Dependencies are read from the
+// assets themselves and merged with any recorded in the editor's index.
+
+#include "AssetBundle.h"
+#include "AssetRegistry.h"
+#include "IAssetLoader.h"
+#include "../../Core/Threading/ThreadPool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace BGE;
+
+namespace {
+
+void PrintUsage() {
+    std::cerr << "Usage: BGEAssetPacker <assetsDir> <output> [--index <AssetIndex.db>] [--compress] [--alignment <bytes>]"
+              << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        PrintUsage();
+        return 1;
+    }
+    
+    std::string assetsDirectory = argv[1];
+    std::string outputPath = argv[2];
+    std::string indexPath;
+    AssetBundleWriter::Options options;
+    for (int i = 3; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--index" && i + 1 < argc) {
+            indexPath = argv[++i];
+        } else if (argument == "--compress") {
+            options.compress = true;
+        } else if (argument == "--alignment" && i + 1 < argc) {
+            options.alignment = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+    
+    if (!std::filesystem::is_directory(assetsDirectory)) {
+        std::cerr << "Not a directory: " << assetsDirectory << std::endl;
+        return 1;
+    }
+    
+    // The scan also gives every asset without a .meta file its handle
+    ThreadPool scanPool;
+    AssetRegistry registry;
+    registry.Initialize(assetsDirectory, indexPath, &scanPool);
+    std::filesystem::path root(registry.GetDatabase().GetAssetsDirectory());
+    
+    // Assets that refer to others; textures never do
+    std::vector<std::unique_ptr<IAssetLoader>> loaders;
+    loaders.push_back(std::make_unique<MaterialLoader>());
+    loaders.push_back(std::make_unique<PrefabLoader>());
+    loaders.push_back(std::make_unique<SceneLoader>());
+    
+    AssetBundleWriter writer;
+    size_t failures = 0;
+    for (const auto& [handle, metadata] : registry.GetAllAssets()) {
+        if (metadata.type == AssetType::Unknown || metadata.type == AssetType::Folder) {
+            continue;
+        }
+        
+        std::string path = registry.GetAssetPath(handle);
+        std::vector<char> data;
+        if (!IAssetLoader::ReadFile(path, data)) {
+            std::cerr << "Could not read " << path << std::endl;
+            failures++;
+            continue;
+        }
+        
+        std::vector<AssetHandle> dependencies = registry.GetDependencies(handle);
+        for (const auto& loader : loaders) {
+            if (loader->GetAssetType() != metadata.type || !loader->CanLoadAsset(path)) {
+                continue;
+            }
+            if (auto asset = loader->DecodeAsset(path, handle, data)) {
+                std::vector<AssetHandle> found;
+                asset->GetDependencies(found);
+                for (const AssetHandle& dependency : found) {
+                    if (std::find(dependencies.begin(), dependencies.end(), dependency) == dependencies.end()) {
+                        dependencies.push_back(dependency);
+                    }
+                }
+            }
+        }
+        
+        std::string relativePath = std::filesystem::path(path).lexically_relative(root).generic_string();
+        writer.AddEntry(handle, metadata.type, relativePath, std::move(data), dependencies);
+    }
+    
+    if (writer.GetEntryCount() == 0) {
+        std::cerr << "No assets found in " << assetsDirectory << std::endl;
+        return 1;
+    }
+    if (!writer.Write(outputPath, options)) {
+        return 1;
+    }
+    registry.Shutdown();
+    
+    std::cout << "Packed " << writer.GetEntryCount() << " assets into " << outputPath << std::endl;
+    return failures == 0 ? 0 : 2;
+}
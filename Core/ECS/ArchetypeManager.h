@@ -5,9 +5,24 @@
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 
 namespace BGE {
 
+// Persistent list of archetypes matching a query signature.
+// Owned by the ArchetypeManager and appended to whenever a new matching
+// archetype is created, so cached queries never rescan the archetype list.
+struct ArchetypeQueryCache {
+    ComponentMask requiredMask;
+    ComponentMask excludedMask;
+    std::vector<uint32_t> archetypeIndices;
+    
+    bool Matches(const ComponentMask& archetypeMask) const {
+        return (archetypeMask & requiredMask) == requiredMask &&
+               (archetypeMask & excludedMask).none();
+    }
+};
+
 class ArchetypeManager {
 public:
     ArchetypeManager() {
@@ -22,6 +37,8 @@ public:
     
     // Find or create archetype with given component mask
     uint32_t GetOrCreateArchetype(const ComponentMask& mask, const std::vector<ComponentTypeID>& types) {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        
         // Check if archetype already exists
         for (size_t i = 0; i < m_archetypes.size(); ++i) {
             if (m_archetypes[i]->GetMask() == mask) {
@@ -36,6 +53,13 @@ public:
         // Update edges for faster transitions
         UpdateArchetypeEdges(index);
         
+        // Append to every persistent query cache this archetype satisfies
+        for (auto& cache : m_queryCaches) {
+            if (cache->Matches(mask)) {
+                cache->archetypeIndices.push_back(index);
+            }
+        }
+        
         return index;
     }
     
@@ -140,9 +164,73 @@ public:
         return matching;
     }
     
+    // Get (or register) the persistent cache for a query signature.
+    // Queries with identical masks share one cache; only a newly registered
+    // signature pays for a scan over the existing archetypes.
+    ArchetypeQueryCache* GetOrCreateQueryCache(const ComponentMask& requiredMask, const ComponentMask& excludedMask) {
+        // Held against GetOrCreateArchetype, which appends to the caches:
+        // queries may register their cache from worker threads
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        
+        for (auto& cache : m_queryCaches) {
+            if (cache->requiredMask == requiredMask && cache->excludedMask == excludedMask) {
+                return cache.get();
+            }
+        }
+        
+        auto cache = std::make_unique<ArchetypeQueryCache>();
+        cache->requiredMask = requiredMask;
+        cache->excludedMask = excludedMask;
+        cache->archetypeIndices = GetArchetypesMatching(requiredMask, excludedMask);
+        
+        m_queryCaches.push_back(std::move(cache));
+        return m_queryCaches.back().get();
+    }
+    
+    // A cache's archetype list is appended to while archetypes are created, possibly on
+    // another thread, so readers take a copy under the same lock instead of iterating it
+    void CopyQueryCacheArchetypes(const ArchetypeQueryCache& cache, std::vector<uint32_t>& outIndices) const {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        outIndices.assign(cache.archetypeIndices.begin(), cache.archetypeIndices.end());
+    }
+    
+    size_t GetQueryCacheArchetypeCount(const ArchetypeQueryCache& cache) const {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        return cache.archetypeIndices.size();
+    }
+    
+    size_t GetQueryCacheCount() const {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        return m_queryCaches.size();
+    }
+    
+    // Drop all archetypes but keep registered query caches alive, so cached
+    // queries held by systems stay valid across EntityManager::Clear()
+    void Reset() {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        
+        m_archetypes.clear();
+        m_archetypeEdges.clear();
+        
+        ComponentMask emptyMask;
+        std::vector<ComponentTypeID> emptyTypes;
+        m_archetypes.push_back(std::make_unique<Archetype>(emptyMask, emptyTypes));
+        UpdateArchetypeEdges(0);
+        
+        for (auto& cache : m_queryCaches) {
+            cache->archetypeIndices.clear();
+            if (cache->Matches(emptyMask)) {
+                cache->archetypeIndices.push_back(0);
+            }
+        }
+    }
+    
 private:
     std::vector<std::unique_ptr<Archetype>> m_archetypes;
     std::vector<std::unordered_map<ComponentTypeID, ArchetypeEdge>> m_archetypeEdges;
+    std::vector<std::unique_ptr<ArchetypeQueryCache>> m_queryCaches;
+    // Guards archetype creation and m_queryCaches
+    mutable std::mutex m_cacheMutex;
     
     void UpdateArchetypeEdges(uint32_t newArchetypeIndex) {
         // Ensure edges vector is large enough
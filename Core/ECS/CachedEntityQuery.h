@@ -1,45 +1,16 @@
 #pragma once
 
 #include "EntityQuery.h"
-#include <chrono>
-#include <atomic>
 
 namespace BGE {
 
-// Query cache entry
-struct QueryCacheEntry {
-    std::vector<uint32_t> archetypeIndices;
-    std::chrono::steady_clock::time_point lastUpdate;
-    uint64_t queryVersion;
-    bool valid;
-    
-    QueryCacheEntry() : queryVersion(0), valid(false) {}
-};
-
-// Global query cache version for invalidation
-class QueryCacheManager {
-public:
-    static QueryCacheManager& Instance() {
-        static QueryCacheManager instance;
-        return instance;
-    }
-    
-    void InvalidateAll() {
-        m_globalVersion.fetch_add(1, std::memory_order_release);
-    }
-    
-    uint64_t GetVersion() const {
-        return m_globalVersion.load(std::memory_order_acquire);
-    }
-    
-private:
-    std::atomic<uint64_t> m_globalVersion{0};
-};
-
-// Cached entity query for improved performance
+// Cached entity query backed by a persistent ArchetypeQueryCache.
+// The archetype list is appended to by the ArchetypeManager as matching
+// archetypes are created, so Execute() never rescans and Count() only
+// touches the matched archetypes.
 class CachedEntityQuery : public EntityQuery {
 public:
-    explicit CachedEntityQuery(EntityManager* manager) 
+    explicit CachedEntityQuery(EntityManager* manager)
         : EntityQuery(manager), m_cacheEnabled(true) {}
     
     // Override Execute to use caching
@@ -48,78 +19,91 @@ public:
             return EntityQuery::Execute();
         }
         
-        // Check if cache is valid
-        uint64_t currentVersion = QueryCacheManager::Instance().GetVersion();
-        if (m_cache.valid && m_cache.queryVersion == currentVersion) {
-            // Return cached result
-            return QueryResult(m_cache.archetypeIndices, &m_entityManager->GetArchetypeManager());
-        }
-        
-        // Execute query and cache result
         auto& archetypeManager = m_entityManager->GetArchetypeManager();
-        std::vector<uint32_t> matchingArchetypes = archetypeManager.GetArchetypesMatching(m_requiredMask, m_excludedMask);
+        archetypeManager.CopyQueryCacheArchetypes(*AcquireCache(), m_matched);
         
-        // Apply filters if any
-        if (!m_filters.empty()) {
-            std::vector<uint32_t> filtered;
-            
-            for (uint32_t archetypeIdx : matchingArchetypes) {
-                Archetype* archetype = archetypeManager.GetArchetype(archetypeIdx);
-                if (archetype && archetype->GetEntityCount() > 0) {
-                    // Check if at least one entity passes filters
-                    bool hasMatch = false;
-                    for (size_t i = 0; i < archetype->GetEntityCount() && !hasMatch; ++i) {
-                        if (PassesFilters(archetype, static_cast<uint32_t>(i))) {
-                            hasMatch = true;
-                        }
-                    }
-                    
-                    if (hasMatch) {
-                        filtered.push_back(archetypeIdx);
+        if (m_filters.empty()) {
+            return QueryResult(m_matched, &archetypeManager);
+        }
+        
+        // Filters depend on component data, so they are applied on top of the
+        // structural match every time rather than being cached
+        std::vector<uint32_t> filtered;
+        for (uint32_t archetypeIdx : m_matched) {
+            Archetype* archetype = archetypeManager.GetArchetype(archetypeIdx);
+            if (archetype && archetype->GetEntityCount() > 0) {
+                // Check if at least one entity passes filters
+                bool hasMatch = false;
+                for (size_t i = 0; i < archetype->GetEntityCount() && !hasMatch; ++i) {
+                    if (PassesFilters(archetype, static_cast<uint32_t>(i))) {
+                        hasMatch = true;
                     }
                 }
+                
+                if (hasMatch) {
+                    filtered.push_back(archetypeIdx);
+                }
             }
-            
-            matchingArchetypes = std::move(filtered);
         }
         
-        // Update cache
-        m_cache.archetypeIndices = matchingArchetypes;
-        m_cache.lastUpdate = std::chrono::steady_clock::now();
-        m_cache.queryVersion = currentVersion;
-        m_cache.valid = true;
+        return QueryResult(filtered, &archetypeManager);
+    }
+    
+    // O(matched archetypes) count using per-archetype entity counts
+    size_t Count() override {
+        if (!m_cacheEnabled || !m_filters.empty()) {
+            return EntityQuery::Count();
+        }
         
-        return QueryResult(matchingArchetypes, &archetypeManager);
+        auto& archetypeManager = m_entityManager->GetArchetypeManager();
+        archetypeManager.CopyQueryCacheArchetypes(*AcquireCache(), m_matched);
+        
+        size_t count = 0;
+        for (uint32_t archetypeIdx : m_matched) {
+            const Archetype* archetype = archetypeManager.GetArchetype(archetypeIdx);
+            if (archetype) {
+                count += archetype->GetEntityCount();
+            }
+        }
+        return count;
     }
     
     // Control caching
     void SetCacheEnabled(bool enabled) { m_cacheEnabled = enabled; }
     bool IsCacheEnabled() const { return m_cacheEnabled; }
     
-    // Force cache invalidation
+    // Detach from the shared cache; the next Execute() re-acquires it
     void InvalidateCache() {
-        m_cache.valid = false;
+        m_cache = nullptr;
     }
     
     // Get cache statistics
-    bool IsCacheValid() const { return m_cache.valid; }
-    
-    std::chrono::milliseconds GetCacheAge() const {
-        if (!m_cache.valid) return std::chrono::milliseconds(0);
-        
-        auto now = std::chrono::steady_clock::now();
-        return std::chrono::duration_cast<std::chrono::milliseconds>(now - m_cache.lastUpdate);
+    bool IsCacheValid() const {
+        return m_cache && m_cache->requiredMask == m_requiredMask && m_cache->excludedMask == m_excludedMask;
     }
     
+    size_t GetMatchedArchetypeCount() const {
+        return m_cache ? m_entityManager->GetArchetypeManager().GetQueryCacheArchetypeCount(*m_cache) : 0;
+    }
+
 private:
-    QueryCacheEntry m_cache;
+    const ArchetypeQueryCache* AcquireCache() {
+        // Re-acquire if the query signature changed since the last execution
+        if (!IsCacheValid()) {
+            m_cache = m_entityManager->GetArchetypeManager().GetOrCreateQueryCache(m_requiredMask, m_excludedMask);
+        }
+        return m_cache;
+    }
+    
+    const ArchetypeQueryCache* m_cache = nullptr;
+    std::vector<uint32_t> m_matched;    // snapshot of the cache's archetypes, reused between executions
     bool m_cacheEnabled;
 };
 
 // Query builder with caching support
 class CachedQueryBuilder {
 public:
-    CachedQueryBuilder(EntityManager* manager) 
+    CachedQueryBuilder(EntityManager* manager)
         : m_query(std::make_unique<CachedEntityQuery>(manager)) {}
     
     template<typename T>
@@ -148,9 +132,9 @@ public:
     std::unique_ptr<CachedEntityQuery> Build() {
         return std::move(m_query);
     }
-    
+
 private:
     std::unique_ptr<CachedEntityQuery> m_query;
 };
 
-} // namespace BGE
\ No newline at end of file
+} // namespace BGE
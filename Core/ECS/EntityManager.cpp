@@ -51,6 +51,7 @@ EntityID EntityManager::CreateEntity(const std::string& name) {
     }
     
     m_aliveEntityCount++;
+    RecordStructureChange(entity);
     m_statEntityCreations.fetch_add(1, std::memory_order_relaxed);
     
     return entity;
@@ -93,9 +94,37 @@ void EntityManager::DestroyEntity(EntityID entity) {
     m_freeEntityIndices.push(index);
     
     m_aliveEntityCount--;
+    RecordStructureChange(entity);
     m_statEntityDestructions.fetch_add(1, std::memory_order_relaxed);
 }
 
+void EntityManager::RecordStructureChange(EntityID entity) {
+    // Called with m_mutex held exclusively
+    if (m_structureLog.empty()) {
+        m_structureLog.resize(STRUCTURE_LOG_SIZE);
+    }
+    uint64_t version = m_structureVersion.load(std::memory_order_relaxed) + 1;
+    m_structureLog[(version - 1) % STRUCTURE_LOG_SIZE] = entity;
+    m_structureVersion.store(version, std::memory_order_release);
+}
+
+bool EntityManager::GetStructureChanges(uint64_t sinceVersion, std::vector<EntityID>& outEntities,
+                                        uint64_t& outVersion) const {
+    std::shared_lock lock(m_mutex);
+    uint64_t version = m_structureVersion.load(std::memory_order_relaxed);
+    if (sinceVersion < m_structureLogStart || sinceVersion > version ||
+        version - sinceVersion > STRUCTURE_LOG_SIZE) {
+        return false;
+    }
+    
+    outEntities.clear();
+    for (uint64_t v = sinceVersion + 1; v <= version; ++v) {
+        outEntities.push_back(m_structureLog[(v - 1) % STRUCTURE_LOG_SIZE]);
+    }
+    outVersion = version;
+    return true;
+}
+
 bool EntityManager::IsEntityValid(EntityID entity) const {
     std::shared_lock lock(m_mutex);
     return IsEntityValidUnsafe(entity);
@@ -179,9 +208,11 @@ void EntityManager::Clear() {
         m_freeEntityIndices.pop();
     }
     m_aliveEntityCount = 0;
+    // Too many changes to replay; views rescan instead
+    m_structureLogStart = m_structureVersion.fetch_add(1, std::memory_order_release) + 1;
     
-    // Reset archetype manager
-    m_archetypeManager = ArchetypeManager();
+    // Reset archetype manager (registered query caches survive the reset)
+    m_archetypeManager.Reset();
     
     // Legacy entity cleanup handled by LegacyEntityManagerAdapter
 }
@@ -244,17 +275,23 @@ void EntityManager::MoveEntityComponents(EntityID /*entity*/, const EntityRecord
 
 // Legacy compatibility methods
 std::vector<EntityID> EntityManager::GetAllEntityIDs() const {
-    std::shared_lock lock(m_mutex);
     std::vector<EntityID> entities;
+    GetAllEntityIDs(entities);
+    return entities;
+}
+
+void EntityManager::GetAllEntityIDs(std::vector<EntityID>& outEntities) const {
+    std::shared_lock lock(m_mutex);
+    outEntities.clear();
+    outEntities.reserve(m_aliveEntityCount);
     
+    // Freed slots already carry the generation of the entity that will reuse them,
+    // so only slots with a record hold a live entity
     for (size_t i = 0; i < m_entityGenerations.size(); ++i) {
-        EntityID entity(static_cast<uint32_t>(i), m_entityGenerations[i]);
-        if (IsEntityValidUnsafe(entity)) {
-            entities.push_back(entity);
+        if (m_entityRecords[i].IsValid()) {
+            outEntities.emplace_back(static_cast<uint32_t>(i), m_entityGenerations[i]);
         }
     }
-    
-    return entities;
 }
 
 Entity* EntityManager::GetEntity(uint32_t legacyId) {
@@ -219,6 +219,13 @@ public:
     const std::string& GetEntityName(EntityID entity) const;
     void SetEntityName(EntityID entity, const std::string& name);
     size_t GetEntityCount() const { return m_aliveEntityCount; }
+    // Advances on every entity created or destroyed; views of the entity list compare it to skip rescans
+    uint64_t GetStructureVersion() const { return m_structureVersion.load(std::memory_order_acquire); }
+    // Entities created or destroyed after sinceVersion, oldest first (an entity may appear twice),
+    // and the version they bring a view up to. Returns false when the history doesn't reach back
+    // that far, after Clear() or more than STRUCTURE_LOG_SIZE changes; the view has to rescan.
+    bool GetStructureChanges(uint64_t sinceVersion, std::vector<EntityID>& outEntities, uint64_t& outVersion) const;
+    static constexpr size_t STRUCTURE_LOG_SIZE = 4096;
     
     // Query support
     ArchetypeManager& GetArchetypeManager() { return m_archetypeManager; }
@@ -234,11 +241,13 @@ public:
     
     // Legacy compatibility methods
     std::vector<EntityID> GetAllEntityIDs() const;
+    // Same, into a buffer the caller keeps between frames
+    void GetAllEntityIDs(std::vector<EntityID>& outEntities) const;
     Entity* GetEntity(uint32_t legacyId);
     std::vector<Entity*> GetAllEntities();
     
     // Note: Legacy compatibility is handled by LegacyEntityWrapper and LegacyEntityManagerAdapter
-    
+
 private:
     EntityManager() {
         // Reserve space for initial entities
@@ -250,6 +259,7 @@ private:
     ~EntityManager(); // Defined in .cpp to avoid incomplete type issues
     
     EntityRecord& GetOrCreateRecord(EntityID entity);
+    void RecordStructureChange(EntityID entity);
     void MoveEntityComponents(EntityID entity, const EntityRecord& oldRecord, 
                             Archetype* oldArchetype, Archetype* newArchetype, 
                             uint32_t newRow, ComponentTypeID skipType = INVALID_COMPONENT_TYPE);
@@ -260,6 +270,9 @@ private:
     std::vector<std::string> m_entityNames;
     std::queue<uint32_t> m_freeEntityIndices;
     size_t m_aliveEntityCount = 0;
+    std::atomic<uint64_t> m_structureVersion{0};
+    std::vector<EntityID> m_structureLog;   // ring; version v's entity at (v - 1) % STRUCTURE_LOG_SIZE
+    uint64_t m_structureLogStart = 0;       // oldest version the log can be replayed from
     
     // Archetype management
     ArchetypeManager m_archetypeManager;
@@ -104,6 +104,7 @@ private:
 class EntityQuery {
 public:
     EntityQuery(EntityManager* manager);
+    virtual ~EntityQuery() = default;
     
     // Add required component types
     template<typename T>
@@ -138,7 +139,7 @@ public:
     }
     
     // Execute query and return result
-    QueryResult Execute();
+    virtual QueryResult Execute();
     
     // Execute query with callback (avoids allocation)
     void ForEach(std::function<void(EntityID)> callback);
@@ -222,7 +223,7 @@ public:
     EntityID First();
     
     // Count matching entities
-    size_t Count();
+    virtual size_t Count();
     
     // Clear query parameters
     void Clear() {
@@ -231,7 +232,7 @@ public:
         m_filters.clear();
     }
     
-private:
+protected:
     EntityManager* m_entityManager;
     ComponentMask m_requiredMask;
     ComponentMask m_excludedMask;
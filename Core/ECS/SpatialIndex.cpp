@@ -0,0 +1,603 @@
+#include "SpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+namespace BGE {
+
+SpatialIndex::SpatialIndex(float cellSize)
+    : m_cellSize(cellSize > 0.0f ? cellSize : DEFAULT_CELL_SIZE)
+    , m_invCellSize(1.0f / m_cellSize) {
+}
+
+int32_t SpatialIndex::ToCell(float v) const {
+    // Clamped so far-off or unbounded query extents can't overflow the cell coordinates
+    float cell = std::floor(v * m_invCellSize);
+    return static_cast<int32_t>(std::clamp(cell, -static_cast<float>(CELL_LIMIT), static_cast<float>(CELL_LIMIT)));
+}
+
+uint32_t SpatialIndex::GetOrCreateCell(int32_t cx, int32_t cy) {
+    uint64_t key = MakeCellKey(cx, cy);
+    auto it = m_cellLookup.find(key);
+    if (it != m_cellLookup.end()) {
+        return it->second;
+    }
+    
+    uint32_t index = static_cast<uint32_t>(m_cells.size());
+    Cell cell{cx, cy, {}};
+    if (!m_freeEntryLists.empty()) {
+        cell.entries = std::move(m_freeEntryLists.back());
+        m_freeEntryLists.pop_back();
+    }
+    m_cells.push_back(std::move(cell));
+    m_cellLookup.emplace(key, index);
+    
+    if (m_maxCellX < m_minCellX) {
+        m_minCellX = m_maxCellX = cx;
+        m_minCellY = m_maxCellY = cy;
+    } else {
+        m_minCellX = std::min(m_minCellX, cx);
+        m_maxCellX = std::max(m_maxCellX, cx);
+        m_minCellY = std::min(m_minCellY, cy);
+        m_maxCellY = std::max(m_maxCellY, cy);
+    }
+    
+    return index;
+}
+
+void SpatialIndex::FreeCell(uint32_t cellIndex) {
+    Cell& cell = m_cells[cellIndex];
+    m_cellLookup.erase(MakeCellKey(cell.cx, cell.cy));
+    bool onEdge = cell.cx == m_minCellX || cell.cx == m_maxCellX || cell.cy == m_minCellY || cell.cy == m_maxCellY;
+    if (m_freeEntryLists.size() < MAX_FREE_ENTRY_LISTS) {
+        m_freeEntryLists.push_back(std::move(cell.entries));
+    }
+    
+    // Swap-remove; the entries of the moved cell follow it
+    uint32_t last = static_cast<uint32_t>(m_cells.size() - 1);
+    if (cellIndex != last) {
+        m_cells[cellIndex] = std::move(m_cells[last]);
+        const Cell& moved = m_cells[cellIndex];
+        m_cellLookup[MakeCellKey(moved.cx, moved.cy)] = cellIndex;
+        for (const Entry& entry : moved.entries) {
+            m_locations[entry.entity.GetIndex()].cell = cellIndex;
+        }
+    }
+    m_cells.pop_back();
+    
+    if (m_cells.empty()) {
+        m_maxHalfExtent = 0.0f;
+    }
+    if (onEdge) {
+        RecomputeOccupiedRange();
+    }
+}
+
+void SpatialIndex::RecomputeOccupiedRange() {
+    m_minCellX = m_minCellY = 0;
+    m_maxCellX = m_maxCellY = -1;
+    for (const Cell& cell : m_cells) {
+        if (m_maxCellX < m_minCellX) {
+            m_minCellX = m_maxCellX = cell.cx;
+            m_minCellY = m_maxCellY = cell.cy;
+            continue;
+        }
+        m_minCellX = std::min(m_minCellX, cell.cx);
+        m_maxCellX = std::max(m_maxCellX, cell.cx);
+        m_minCellY = std::min(m_minCellY, cell.cy);
+        m_maxCellY = std::max(m_maxCellY, cell.cy);
+    }
+}
+
+const SpatialIndex::Cell* SpatialIndex::FindCell(int32_t cx, int32_t cy) const {
+    auto it = m_cellLookup.find(MakeCellKey(cx, cy));
+    return it != m_cellLookup.end() ? &m_cells[it->second] : nullptr;
+}
+
+const SpatialIndex::Location* SpatialIndex::FindLocation(EntityID entity) const {
+    uint32_t index = entity.GetIndex();
+    if (index >= m_locations.size()) return nullptr;
+    
+    const Location& location = m_locations[index];
+    if (location.cell == UINT32_MAX) return nullptr;
+    
+    // Reject stale generations that reuse the same index
+    if (GetEntry(location).entity != entity) return nullptr;
+    return &location;
+}
+
+SpatialIndex::Entry& SpatialIndex::GetEntry(const Location& location) {
+    return location.cell == OVERSIZED_CELL ? m_oversized[location.slot] : m_cells[location.cell].entries[location.slot];
+}
+
+const SpatialIndex::Entry& SpatialIndex::GetEntry(const Location& location) const {
+    return location.cell == OVERSIZED_CELL ? m_oversized[location.slot] : m_cells[location.cell].entries[location.slot];
+}
+
+int32_t SpatialIndex::GetLooseCellRadius() const {
+    return static_cast<int32_t>(std::ceil(m_maxHalfExtent * m_invCellSize));
+}
+
+float SpatialIndex::DistanceSq(const Entry& entry, float x, float y) {
+    float dx = std::max(std::abs(x - entry.x) - entry.halfX, 0.0f);
+    float dy = std::max(std::abs(y - entry.y) - entry.halfY, 0.0f);
+    return dx * dx + dy * dy;
+}
+
+void SpatialIndex::RemoveEntry(const Location& location) {
+    // Copied first: 'location' may be the slot that the swap below rewrites
+    const uint32_t cellIndex = location.cell;
+    const uint32_t slot = location.slot;
+    auto& entries = cellIndex == OVERSIZED_CELL ? m_oversized : m_cells[cellIndex].entries;
+    if (slot + 1 != entries.size()) {
+        entries[slot] = entries.back();
+        m_locations[entries[slot].entity.GetIndex()].slot = slot;
+    }
+    entries.pop_back();
+    
+    if (cellIndex != OVERSIZED_CELL && entries.empty()) {
+        FreeCell(cellIndex);
+    }
+}
+
+void SpatialIndex::Place(EntityID entity, const Entry& entry) {
+    Location& location = m_locations[entity.GetIndex()];
+    if (IsOversized(entry)) {
+        location.cell = OVERSIZED_CELL;
+        location.slot = static_cast<uint32_t>(m_oversized.size());
+        m_oversized.push_back(entry);
+        return;
+    }
+    
+    uint32_t cellIndex = GetOrCreateCell(ToCell(entry.x), ToCell(entry.y));
+    auto& entries = m_cells[cellIndex].entries;
+    location.cell = cellIndex;
+    location.slot = static_cast<uint32_t>(entries.size());
+    entries.push_back(entry);
+    
+    m_maxHalfExtent = std::max(m_maxHalfExtent, std::max(entry.halfX, entry.halfY));
+}
+
+void SpatialIndex::Insert(EntityID entity, const Vector2& position, const Vector2& halfExtents, uint32_t layerMask) {
+    if (!entity.IsValid()) return;
+    
+    if (FindLocation(entity)) {
+        Update(entity, position, halfExtents);
+        SetLayerMask(entity, layerMask);
+        return;
+    }
+    
+    uint32_t index = entity.GetIndex();
+    if (index >= m_locations.size()) {
+        m_locations.resize(index + 1);
+    } else if (m_locations[index].cell != UINT32_MAX) {
+        // Index still held by a destroyed generation
+        Location stale = m_locations[index];
+        m_locations[index] = Location();
+        RemoveEntry(stale);
+        m_entityCount--;
+    }
+    
+    Entry entry{position.x, position.y, std::abs(halfExtents.x), std::abs(halfExtents.y), entity, layerMask};
+    Place(entity, entry);
+    m_entityCount++;
+}
+
+void SpatialIndex::Update(EntityID entity, const Vector2& position, const Vector2& halfExtents) {
+    const Location* location = FindLocation(entity);
+    if (!location) {
+        Insert(entity, position, halfExtents);
+        return;
+    }
+    
+    Entry entry = GetEntry(*location);
+    entry.halfX = std::abs(halfExtents.x);
+    entry.halfY = std::abs(halfExtents.y);
+    if (IsOversized(entry) != (location->cell == OVERSIZED_CELL)) {
+        // Grew past or shrank below a cell: moves between the grid and the oversized list
+        entry.x = position.x;
+        entry.y = position.y;
+        RemoveEntry(*location);
+        Place(entity, entry);
+        return;
+    }
+    
+    GetEntry(*location) = entry;
+    if (location->cell != OVERSIZED_CELL) {
+        m_maxHalfExtent = std::max(m_maxHalfExtent, std::max(entry.halfX, entry.halfY));
+    }
+    Update(entity, position);
+}
+
+void SpatialIndex::Update(EntityID entity, const Vector2& position) {
+    const Location* location = FindLocation(entity);
+    if (!location) {
+        Insert(entity, position);
+        return;
+    }
+    
+    int32_t cx = ToCell(position.x);
+    int32_t cy = ToCell(position.y);
+    
+    if (location->cell == OVERSIZED_CELL ||
+        (m_cells[location->cell].cx == cx && m_cells[location->cell].cy == cy)) {
+        // Same cell: update the inline position only
+        Entry& entry = GetEntry(*location);
+        entry.x = position.x;
+        entry.y = position.y;
+        return;
+    }
+    
+    Entry entry = GetEntry(*location);
+    entry.x = position.x;
+    entry.y = position.y;
+    RemoveEntry(*location);
+    Place(entity, entry);
+}
+
+void SpatialIndex::Remove(EntityID entity) {
+    const Location* location = FindLocation(entity);
+    if (!location) return;
+    
+    Location removed = *location;
+    m_locations[entity.GetIndex()] = Location();
+    RemoveEntry(removed);
+    m_entityCount--;
+}
+
+bool SpatialIndex::Contains(EntityID entity) const {
+    return FindLocation(entity) != nullptr;
+}
+
+void SpatialIndex::SetLayerMask(EntityID entity, uint32_t layerMask) {
+    const Location* location = FindLocation(entity);
+    if (location) {
+        GetEntry(*location).layerMask = layerMask;
+    }
+}
+
+bool SpatialIndex::TryGetBounds(EntityID entity, SpatialBounds& bounds) const {
+    const Location* location = FindLocation(entity);
+    if (!location) return false;
+    
+    const Entry& entry = GetEntry(*location);
+    bounds = SpatialBounds::FromCenter(Vector2(entry.x, entry.y), Vector2(entry.halfX, entry.halfY));
+    return true;
+}
+
+void SpatialIndex::UpdateBatch(const std::vector<SpatialUpdate>& updates) {
+    for (const SpatialUpdate& update : updates) {
+        Update(update.entity, update.position, update.halfExtents);
+    }
+}
+
+void SpatialIndex::Clear() {
+    m_cells.clear();
+    m_cellLookup.clear();
+    m_freeEntryLists.clear();
+    m_oversized.clear();
+    m_locations.clear();
+    m_entityCount = 0;
+    m_maxHalfExtent = 0.0f;
+    m_minCellX = m_minCellY = 0;
+    m_maxCellX = m_maxCellY = -1;
+}
+
+bool SpatialIndex::GetCellRange(float minX, float minY, float maxX, float maxY, CellRange& range) const {
+    if (m_cells.empty()) return false;
+    
+    range.minX = std::max(ToCell(minX - m_maxHalfExtent), m_minCellX);
+    range.minY = std::max(ToCell(minY - m_maxHalfExtent), m_minCellY);
+    range.maxX = std::min(ToCell(maxX + m_maxHalfExtent), m_maxCellX);
+    range.maxY = std::min(ToCell(maxY + m_maxHalfExtent), m_maxCellY);
+    return range.minX <= range.maxX && range.minY <= range.maxY;
+}
+
+template<typename Fn>
+void SpatialIndex::ForEachCell(const CellRange& range, Fn&& fn) const {
+    uint64_t width = static_cast<uint64_t>(range.maxX - range.minX) + 1;
+    uint64_t height = static_cast<uint64_t>(range.maxY - range.minY) + 1;
+    if (width * height > m_cells.size()) {
+        // A wide query over a sparse grid: cheaper to filter the occupied cells
+        for (const Cell& cell : m_cells) {
+            if (cell.cx >= range.minX && cell.cx <= range.maxX && cell.cy >= range.minY && cell.cy <= range.maxY) {
+                fn(cell);
+            }
+        }
+        return;
+    }
+    
+    for (int32_t cy = range.minY; cy <= range.maxY; ++cy) {
+        for (int32_t cx = range.minX; cx <= range.maxX; ++cx) {
+            if (const Cell* cell = FindCell(cx, cy)) {
+                fn(*cell);
+            }
+        }
+    }
+}
+
+void SpatialIndex::QueryRadius(const Vector2& center, float radius, std::vector<EntityID>& results,
+                               uint32_t layerMask) const {
+    if (m_entityCount == 0 || radius < 0.0f) return;
+    
+    float radiusSq = radius * radius;
+    auto test = [&](const Entry& entry) {
+        if ((entry.layerMask & layerMask) && DistanceSq(entry, center.x, center.y) <= radiusSq) {
+            results.push_back(entry.entity);
+        }
+    };
+    
+    for (const Entry& entry : m_oversized) {
+        test(entry);
+    }
+    
+    CellRange range;
+    if (!GetCellRange(center.x - radius, center.y - radius, center.x + radius, center.y + radius, range)) return;
+    ForEachCell(range, [&](const Cell& cell) {
+        for (const Entry& entry : cell.entries) {
+            test(entry);
+        }
+    });
+}
+
+void SpatialIndex::QueryAABB(const SpatialBounds& bounds, std::vector<EntityID>& results, uint32_t layerMask) const {
+    if (m_entityCount == 0) return;
+    
+    auto test = [&](const Entry& entry) {
+        if ((entry.layerMask & layerMask) &&
+            entry.x - entry.halfX <= bounds.max.x && entry.x + entry.halfX >= bounds.min.x &&
+            entry.y - entry.halfY <= bounds.max.y && entry.y + entry.halfY >= bounds.min.y) {
+            results.push_back(entry.entity);
+        }
+    };
+    
+    for (const Entry& entry : m_oversized) {
+        test(entry);
+    }
+    
+    CellRange range;
+    if (!GetCellRange(bounds.min.x, bounds.min.y, bounds.max.x, bounds.max.y, range)) return;
+    ForEachCell(range, [&](const Cell& cell) {
+        for (const Entry& entry : cell.entries) {
+            test(entry);
+        }
+    });
+}
+
+void SpatialIndex::QueryKNearest(const Vector2& center, size_t k, std::vector<EntityID>& results,
+                                 float maxDistance, uint32_t layerMask) const {
+    if (m_entityCount == 0 || k == 0) return;
+    
+    // Max-heap of the best k candidates by squared distance
+    using Candidate = std::pair<float, EntityID>;
+    auto compare = [](const Candidate& a, const Candidate& b) { return a.first < b.first; };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(compare)> best(compare);
+    
+    const float maxDistanceSq = maxDistance < std::sqrt(std::numeric_limits<float>::max())
+        ? maxDistance * maxDistance : std::numeric_limits<float>::max();
+    
+    auto visitEntry = [&](const Entry& entry) {
+        if (!(entry.layerMask & layerMask)) return;
+        
+        float distSq = DistanceSq(entry, center.x, center.y);
+        if (distSq > maxDistanceSq) return;
+        
+        if (best.size() < k) {
+            best.emplace(distSq, entry.entity);
+        } else if (distSq < best.top().first) {
+            best.pop();
+            best.emplace(distSq, entry.entity);
+        }
+    };
+    
+    auto visitCell = [&](int32_t cx, int32_t cy) {
+        if (const Cell* cell = FindCell(cx, cy)) {
+            for (const Entry& entry : cell->entries) {
+                visitEntry(entry);
+            }
+        }
+    };
+    
+    for (const Entry& entry : m_oversized) {
+        visitEntry(entry);
+    }
+    
+    if (!m_cells.empty()) {
+        const int32_t ccx = ToCell(center.x);
+        const int32_t ccy = ToCell(center.y);
+        
+        // Rings short of or beyond the occupied range cannot contain anything
+        const int32_t minRing = std::max({ m_minCellX - ccx, ccx - m_maxCellX, m_minCellY - ccy, ccy - m_maxCellY, 0 });
+        const int32_t maxRing = std::max({ std::abs(ccx - m_minCellX), std::abs(ccx - m_maxCellX),
+                                           std::abs(ccy - m_minCellY), std::abs(ccy - m_maxCellY) });
+        
+        size_t lookups = 0;
+        for (int32_t ring = minRing; ring <= maxRing; ++ring) {
+            // Anything homed in this ring is at least this far from the query point
+            float ringDistance = (ring - 1) * m_cellSize - m_maxHalfExtent;
+            if (ringDistance > 0.0f) {
+                float ringDistanceSq = ringDistance * ringDistance;
+                if (ringDistanceSq > maxDistanceSq) break;
+                if (best.size() == k && ringDistanceSq > best.top().first) break;
+            }
+            
+            if (ring == 0) {
+                visitCell(ccx, ccy);
+                continue;
+            }
+            
+            // Only the stretch of each side inside the occupied range
+            const int32_t rowMinX = std::max(ccx - ring, m_minCellX), rowMaxX = std::min(ccx + ring, m_maxCellX);
+            const int32_t colMinY = std::max(ccy - ring + 1, m_minCellY), colMaxY = std::min(ccy + ring - 1, m_maxCellY);
+            lookups += 2 * static_cast<size_t>(std::max(rowMaxX - rowMinX + 1, 0)) +
+                       2 * static_cast<size_t>(std::max(colMaxY - colMinY + 1, 0));
+            if (lookups > m_cells.size()) {
+                // Sparse grid: the rings have cost more lookups than there are occupied
+                // cells, so visit the cells not covered yet directly
+                for (const Cell& cell : m_cells) {
+                    if (std::max(std::abs(cell.cx - ccx), std::abs(cell.cy - ccy)) < ring) continue;
+                    for (const Entry& entry : cell.entries) {
+                        visitEntry(entry);
+                    }
+                }
+                break;
+            }
+            
+            for (int32_t row : { ccy - ring, ccy + ring }) {
+                if (row < m_minCellY || row > m_maxCellY) continue;
+                for (int32_t x = rowMinX; x <= rowMaxX; ++x) {
+                    visitCell(x, row);
+                }
+            }
+            for (int32_t column : { ccx - ring, ccx + ring }) {
+                if (column < m_minCellX || column > m_maxCellX) continue;
+                for (int32_t y = colMinY; y <= colMaxY; ++y) {
+                    visitCell(column, y);
+                }
+            }
+        }
+    }
+    
+    size_t start = results.size();
+    results.resize(start + best.size());
+    for (size_t i = results.size(); i > start; --i) {
+        results[i - 1] = best.top().second;
+        best.pop();
+    }
+}
+
+namespace {
+
+// Slab test of a ray against a box, narrowing [tMin, tMax] to the part inside it
+bool ClipRay(const float origin[2], const float dir[2], const float lo[2], const float hi[2], float& tMin, float& tMax) {
+    for (int axis = 0; axis < 2; ++axis) {
+        if (std::abs(dir[axis]) < 1e-8f) {
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) return false;
+            continue;
+        }
+        
+        float inv = 1.0f / dir[axis];
+        float t1 = (lo[axis] - origin[axis]) * inv;
+        float t2 = (hi[axis] - origin[axis]) * inv;
+        if (t1 > t2) std::swap(t1, t2);
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax) return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+bool SpatialIndex::Raycast(const Vector2& origin, const Vector2& direction, float maxDistance,
+                           SpatialRayHit& hit, uint32_t layerMask) const {
+    if (m_entityCount == 0) return false;
+    
+    float length = direction.Length();
+    if (length <= 0.0f) return false;
+    Vector2 dir = direction / length;
+    const float o[2] = { origin.x, origin.y };
+    const float d[2] = { dir.x, dir.y };
+    
+    float bestT = maxDistance;
+    bool found = false;
+    
+    auto testEntry = [&](const Entry& entry) {
+        if (!(entry.layerMask & layerMask)) return;
+        
+        float tMin = 0.0f;
+        float tMax = bestT;
+        const float lo[2] = { entry.x - entry.halfX, entry.y - entry.halfY };
+        const float hi[2] = { entry.x + entry.halfX, entry.y + entry.halfY };
+        if (ClipRay(o, d, lo, hi, tMin, tMax) && tMin <= bestT) {
+            bestT = tMin;
+            hit.entity = entry.entity;
+            found = true;
+        }
+    };
+    
+    auto testCell = [&](int32_t cx, int32_t cy) {
+        if (const Cell* cell = FindCell(cx, cy)) {
+            for (const Entry& entry : cell->entries) {
+                testEntry(entry);
+            }
+        }
+    };
+    
+    for (const Entry& entry : m_oversized) {
+        testEntry(entry);
+    }
+    
+    // Every grid entry lies within the occupied cells grown by the loose radius,
+    // so the walk runs over the part of the ray inside that area only
+    const int32_t loose = GetLooseCellRadius();
+    const int32_t areaMinX = m_minCellX - loose, areaMaxX = m_maxCellX + loose;
+    const int32_t areaMinY = m_minCellY - loose, areaMaxY = m_maxCellY + loose;
+    const float areaLo[2] = { areaMinX * m_cellSize, areaMinY * m_cellSize };
+    const float areaHi[2] = { (areaMaxX + 1) * m_cellSize, (areaMaxY + 1) * m_cellSize };
+    float tStart = 0.0f;
+    float tEnd = bestT;
+    const bool crossesGrid = !m_cells.empty() && ClipRay(o, d, areaLo, areaHi, tStart, tEnd);
+    // Cells the walk would step through, against testing every occupied cell outright
+    const float walkCells = (tEnd - tStart) * m_invCellSize * (std::abs(dir.x) + std::abs(dir.y)) * (2 * loose + 1);
+    if (crossesGrid && walkCells > static_cast<float>(m_cells.size())) {
+        for (const Cell& cell : m_cells) {
+            for (const Entry& entry : cell.entries) {
+                testEntry(entry);
+            }
+        }
+    } else if (crossesGrid) {
+        // Grid DDA along the ray. Because cells are loose, each step also covers
+        // the neighbourhood within the loose radius; on a monotone cell path only
+        // the newly exposed row/column of that neighbourhood needs visiting.
+        Vector2 entry = origin + dir * tStart;
+        int32_t cx = std::clamp(ToCell(entry.x), areaMinX, areaMaxX);
+        int32_t cy = std::clamp(ToCell(entry.y), areaMinY, areaMaxY);
+        const int32_t stepX = dir.x > 0.0f ? 1 : (dir.x < 0.0f ? -1 : 0);
+        const int32_t stepY = dir.y > 0.0f ? 1 : (dir.y < 0.0f ? -1 : 0);
+        
+        const float inf = std::numeric_limits<float>::max();
+        float tDeltaX = stepX != 0 ? m_cellSize / std::abs(dir.x) : inf;
+        float tDeltaY = stepY != 0 ? m_cellSize / std::abs(dir.y) : inf;
+        float nextBoundaryX = (cx + (stepX > 0 ? 1 : 0)) * m_cellSize;
+        float nextBoundaryY = (cy + (stepY > 0 ? 1 : 0)) * m_cellSize;
+        float tMaxX = stepX != 0 ? tStart + (nextBoundaryX - entry.x) / dir.x : inf;
+        float tMaxY = stepY != 0 ? tStart + (nextBoundaryY - entry.y) / dir.y : inf;
+        
+        for (int32_t y = cy - loose; y <= cy + loose; ++y) {
+            for (int32_t x = cx - loose; x <= cx + loose; ++x) {
+                testCell(x, y);
+            }
+        }
+        
+        while (true) {
+            float tEnter = std::min(tMaxX, tMaxY);
+            // Any hit beyond this point would have been found in an earlier neighbourhood
+            if (tEnter > bestT || tEnter > tEnd) break;
+            
+            if (tMaxX < tMaxY) {
+                cx += stepX;
+                tMaxX += tDeltaX;
+                int32_t column = cx + stepX * loose;
+                for (int32_t y = cy - loose; y <= cy + loose; ++y) {
+                    testCell(column, y);
+                }
+            } else {
+                cy += stepY;
+                tMaxY += tDeltaY;
+                int32_t row = cy + stepY * loose;
+                for (int32_t x = cx - loose; x <= cx + loose; ++x) {
+                    testCell(x, row);
+                }
+            }
+        }
+    }
+    
+    if (found) {
+        hit.distance = bestT;
+        hit.point = origin + dir * bestT;
+    }
+    return found;
+}
+
+} // namespace BGE
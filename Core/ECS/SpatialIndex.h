@@ -1,288 +1,185 @@
 #pragma once
 
 #include "EntityID.h"
-#include "Components/HierarchyComponent.h"
-#include "../Logger.h"
+#include "../Math/Vector2.h"
 #include <vector>
-#include <unordered_map>
 #include <algorithm>
-#include <cmath>
+#include <unordered_map>
+#include <cstdint>
+#include <limits>
 
 namespace BGE {
 
-// Axis-aligned bounding box
-struct AABB {
-    float minX, minY, minZ;
-    float maxX, maxY, maxZ;
-    
-    AABB() : minX(0), minY(0), minZ(0), maxX(0), maxY(0), maxZ(0) {}
+// 2D axis-aligned bounding box
+struct SpatialBounds {
+    Vector2 min;
+    Vector2 max;
     
-    AABB(float x, float y, float z, float radius)
-        : minX(x - radius), minY(y - radius), minZ(z - radius)
-        , maxX(x + radius), maxY(y + radius), maxZ(z + radius) {}
+    SpatialBounds() = default;
+    SpatialBounds(const Vector2& minPoint, const Vector2& maxPoint) : min(minPoint), max(maxPoint) {}
     
-    bool Intersects(const AABB& other) const {
-        return (minX <= other.maxX && maxX >= other.minX) &&
-               (minY <= other.maxY && maxY >= other.minY) &&
-               (minZ <= other.maxZ && maxZ >= other.minZ);
+    static SpatialBounds FromCenter(const Vector2& center, const Vector2& halfExtents) {
+        return SpatialBounds(center - halfExtents, center + halfExtents);
     }
     
-    bool Contains(float x, float y, float z) const {
-        return x >= minX && x <= maxX &&
-               y >= minY && y <= maxY &&
-               z >= minZ && z <= maxZ;
+    bool Intersects(const SpatialBounds& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y;
     }
     
-    float GetCenterX() const { return (minX + maxX) * 0.5f; }
-    float GetCenterY() const { return (minY + maxY) * 0.5f; }
-    float GetCenterZ() const { return (minZ + maxZ) * 0.5f; }
+    bool Contains(const Vector2& point) const {
+        return point.x >= min.x && point.x <= max.x &&
+               point.y >= min.y && point.y <= max.y;
+    }
+};
+
+// Positional update for batched index maintenance (e.g. from TransformSystem change lists)
+struct SpatialUpdate {
+    EntityID entity;
+    Vector2 position;
+    Vector2 halfExtents;
+};
+
+struct SpatialRayHit {
+    EntityID entity = INVALID_ENTITY;
+    float distance = 0.0f;
+    Vector2 point;
 };
 
-// Spatial hash grid for efficient spatial queries
-class SpatialHashGrid {
+// Loose 2D grid spatial index over entity bounds (used by scene picking).
+// Each entity lives in the cell containing its center, with position and
+// extents stored inline in the cell; queries widen their cell range by the
+// largest extent in the grid and then filter exactly against the stored
+// bounds. Entities wider than a cell are kept in a separate list that every
+// query tests directly, so one large sprite doesn't widen all queries.
+// Queries only visit cells inside the occupied range, and cells are freed
+// once empty. Insert, move and remove are O(1) (swap-remove within a cell).
+class SpatialIndex {
 public:
-    static constexpr float DEFAULT_CELL_SIZE = 10.0f;
-    
-    explicit SpatialHashGrid(float cellSize = DEFAULT_CELL_SIZE) 
-        : m_cellSize(cellSize), m_invCellSize(1.0f / cellSize) {}
-    
-    // Insert entity at position
-    void Insert(EntityID entity, float x, float y, float z) {
-        int64_t cellKey = GetCellKey(x, y, z);
-        m_cells[cellKey].push_back(entity);
-        m_entityCells[entity] = cellKey;
+    static constexpr float DEFAULT_CELL_SIZE = 32.0f;
+    static constexpr uint32_t ALL_LAYERS = 0xFFFFFFFFu;
+    
+    explicit SpatialIndex(float cellSize = DEFAULT_CELL_SIZE);
+    
+    // Single-entity maintenance
+    void Insert(EntityID entity, const Vector2& position, const Vector2& halfExtents = Vector2(0.0f, 0.0f),
+                uint32_t layerMask = ALL_LAYERS);
+    void Update(EntityID entity, const Vector2& position, const Vector2& halfExtents);
+    void Update(EntityID entity, const Vector2& position);
+    void Remove(EntityID entity);
+    bool Contains(EntityID entity) const;
+    void SetLayerMask(EntityID entity, uint32_t layerMask);
+    
+    // Batched maintenance; entities not yet indexed are inserted
+    void UpdateBatch(const std::vector<SpatialUpdate>& updates);
+    
+    // Queries append to 'results' and only report entities whose stored bounds
+    // actually satisfy the query (no cell-level false positives)
+    void QueryRadius(const Vector2& center, float radius, std::vector<EntityID>& results,
+                     uint32_t layerMask = ALL_LAYERS) const;
+    void QueryAABB(const SpatialBounds& bounds, std::vector<EntityID>& results,
+                   uint32_t layerMask = ALL_LAYERS) const;
+    // k nearest entities ordered by distance (to their bounds), within maxDistance
+    void QueryKNearest(const Vector2& center, size_t k, std::vector<EntityID>& results,
+                       float maxDistance = std::numeric_limits<float>::max(),
+                       uint32_t layerMask = ALL_LAYERS) const;
+    // Closest hit along a ray; direction need not be normalized
+    bool Raycast(const Vector2& origin, const Vector2& direction, float maxDistance, SpatialRayHit& hit,
+                 uint32_t layerMask = ALL_LAYERS) const;
+    
+    // Convenience overloads returning by value
+    std::vector<EntityID> QueryRadius(const Vector2& center, float radius) const {
+        std::vector<EntityID> results;
+        QueryRadius(center, radius, results);
+        return results;
     }
     
-    // Update entity position
-    void Update(EntityID entity, float x, float y, float z) {
-        // Remove from old cell
-        auto it = m_entityCells.find(entity);
-        if (it != m_entityCells.end()) {
-            int64_t oldCell = it->second;
-            auto& oldCellEntities = m_cells[oldCell];
-            oldCellEntities.erase(
-                std::remove(oldCellEntities.begin(), oldCellEntities.end(), entity),
-                oldCellEntities.end()
-            );
-            
-            if (oldCellEntities.empty()) {
-                m_cells.erase(oldCell);
-            }
-        }
-        
-        // Insert into new cell
-        Insert(entity, x, y, z);
+    std::vector<EntityID> QueryAABB(const SpatialBounds& bounds) const {
+        std::vector<EntityID> results;
+        QueryAABB(bounds, results);
+        return results;
     }
     
-    // Remove entity
-    void Remove(EntityID entity) {
-        auto it = m_entityCells.find(entity);
-        if (it != m_entityCells.end()) {
-            int64_t cellKey = it->second;
-            auto& cellEntities = m_cells[cellKey];
-            cellEntities.erase(
-                std::remove(cellEntities.begin(), cellEntities.end(), entity),
-                cellEntities.end()
-            );
-            
-            if (cellEntities.empty()) {
-                m_cells.erase(cellKey);
-            }
-            
-            m_entityCells.erase(it);
-        }
-    }
-    
-    // Query entities within radius
-    std::vector<EntityID> QueryRadius(float x, float y, float z, float radius) const {
-        std::vector<EntityID> result;
-        
-        // Calculate cell range to check
-        int minCellX = static_cast<int>((x - radius) * m_invCellSize);
-        int maxCellX = static_cast<int>((x + radius) * m_invCellSize);
-        int minCellY = static_cast<int>((y - radius) * m_invCellSize);
-        int maxCellY = static_cast<int>((y + radius) * m_invCellSize);
-        int minCellZ = static_cast<int>((z - radius) * m_invCellSize);
-        int maxCellZ = static_cast<int>((z + radius) * m_invCellSize);
-        
-        float radiusSq = radius * radius;
-        
-        // Check all cells in range
-        for (int cx = minCellX; cx <= maxCellX; ++cx) {
-            for (int cy = minCellY; cy <= maxCellY; ++cy) {
-                for (int cz = minCellZ; cz <= maxCellZ; ++cz) {
-                    int64_t cellKey = MakeCellKey(cx, cy, cz);
-                    auto cellIt = m_cells.find(cellKey);
-                    if (cellIt != m_cells.end()) {
-                        // Add entities within radius
-                        for (EntityID entity : cellIt->second) {
-                            // Would need position lookup here - simplified for now
-                            result.push_back(entity);
-                        }
-                    }
-                }
-            }
-        }
-        
-        return result;
-    }
-    
-    // Query entities within AABB
-    std::vector<EntityID> QueryAABB(const AABB& bounds) const {
-        std::vector<EntityID> result;
-        
-        // Calculate cell range
-        int minCellX = static_cast<int>(bounds.minX * m_invCellSize);
-        int maxCellX = static_cast<int>(bounds.maxX * m_invCellSize);
-        int minCellY = static_cast<int>(bounds.minY * m_invCellSize);
-        int maxCellY = static_cast<int>(bounds.maxY * m_invCellSize);
-        int minCellZ = static_cast<int>(bounds.minZ * m_invCellSize);
-        int maxCellZ = static_cast<int>(bounds.maxZ * m_invCellSize);
-        
-        // Check all cells in range
-        for (int cx = minCellX; cx <= maxCellX; ++cx) {
-            for (int cy = minCellY; cy <= maxCellY; ++cy) {
-                for (int cz = minCellZ; cz <= maxCellZ; ++cz) {
-                    int64_t cellKey = MakeCellKey(cx, cy, cz);
-                    auto cellIt = m_cells.find(cellKey);
-                    if (cellIt != m_cells.end()) {
-                        for (EntityID entity : cellIt->second) {
-                            result.push_back(entity);
-                        }
-                    }
-                }
-            }
-        }
-        
-        return result;
-    }
+    bool TryGetBounds(EntityID entity, SpatialBounds& bounds) const;
     
-    // Clear all data
-    void Clear() {
-        m_cells.clear();
-        m_entityCells.clear();
-    }
+    void Clear();
     
-    // Get statistics
+    // Statistics
+    size_t GetEntityCount() const { return m_entityCount; }
     size_t GetCellCount() const { return m_cells.size(); }
-    size_t GetEntityCount() const { return m_entityCells.size(); }
-    
-private:
-    int64_t GetCellKey(float x, float y, float z) const {
-        int cellX = static_cast<int>(x * m_invCellSize);
-        int cellY = static_cast<int>(y * m_invCellSize);
-        int cellZ = static_cast<int>(z * m_invCellSize);
-        return MakeCellKey(cellX, cellY, cellZ);
-    }
-    
-    int64_t MakeCellKey(int x, int y, int z) const {
-        // Pack 3D coordinates into 64-bit key
-        return (static_cast<int64_t>(x) << 42) | 
-               (static_cast<int64_t>(y) << 21) | 
-               static_cast<int64_t>(z);
-    }
-    
-    float m_cellSize;
-    float m_invCellSize;
-    std::unordered_map<int64_t, std::vector<EntityID>> m_cells;
-    std::unordered_map<EntityID, int64_t, EntityIDHash> m_entityCells;
-};
+    size_t GetOversizedCount() const { return m_oversized.size(); }
+    float GetCellSize() const { return m_cellSize; }
+    float GetMaxHalfExtent() const { return m_maxHalfExtent; }
 
-// Octree node for hierarchical spatial indexing
-template<size_t MaxEntitiesPerNode = 8>
-class OctreeNode {
-public:
-    OctreeNode(const AABB& bounds) : m_bounds(bounds), m_isLeaf(true) {}
+private:
+    struct Entry {
+        float x, y;
+        float halfX, halfY;
+        EntityID entity;
+        uint32_t layerMask;
+    };
     
-    void Insert(EntityID entity, float x, float y, float z) {
-        if (m_isLeaf) {
-            m_entities.push_back({entity, x, y, z});
-            
-            if (m_entities.size() > MaxEntitiesPerNode && m_bounds.maxX - m_bounds.minX > 1.0f) {
-                Subdivide();
-            }
-        } else {
-            // Insert into appropriate child
-            int childIndex = GetChildIndex(x, y, z);
-            if (childIndex >= 0 && m_children[childIndex]) {
-                m_children[childIndex]->Insert(entity, x, y, z);
-            }
-        }
-    }
+    struct Cell {
+        int32_t cx, cy;
+        std::vector<Entry> entries;
+    };
     
-    void Query(const AABB& queryBounds, std::vector<EntityID>& results) const {
-        if (!m_bounds.Intersects(queryBounds)) {
-            return;
-        }
-        
-        if (m_isLeaf) {
-            for (const auto& entry : m_entities) {
-                if (queryBounds.Contains(entry.x, entry.y, entry.z)) {
-                    results.push_back(entry.entity);
-                }
-            }
-        } else {
-            for (const auto& child : m_children) {
-                if (child) {
-                    child->Query(queryBounds, results);
-                }
-            }
-        }
-    }
+    struct Location {
+        uint32_t cell = UINT32_MAX;     // OVERSIZED_CELL: slot indexes m_oversized
+        uint32_t slot = UINT32_MAX;
+    };
     
-private:
-    struct EntityEntry {
-        EntityID entity;
-        float x, y, z;
+    // Inclusive cell range of a query, already clipped to the occupied range
+    struct CellRange {
+        int32_t minX, minY, maxX, maxY;
     };
     
-    void Subdivide() {
-        float cx = m_bounds.GetCenterX();
-        float cy = m_bounds.GetCenterY();
-        float cz = m_bounds.GetCenterZ();
-        
-        // Create 8 children
-        for (int i = 0; i < 8; ++i) {
-            AABB childBounds;
-            childBounds.minX = (i & 1) ? cx : m_bounds.minX;
-            childBounds.maxX = (i & 1) ? m_bounds.maxX : cx;
-            childBounds.minY = (i & 2) ? cy : m_bounds.minY;
-            childBounds.maxY = (i & 2) ? m_bounds.maxY : cy;
-            childBounds.minZ = (i & 4) ? cz : m_bounds.minZ;
-            childBounds.maxZ = (i & 4) ? m_bounds.maxZ : cz;
-            
-            m_children[i] = std::make_unique<OctreeNode>(childBounds);
-        }
-        
-        // Move entities to children
-        for (const auto& entry : m_entities) {
-            int childIndex = GetChildIndex(entry.x, entry.y, entry.z);
-            if (childIndex >= 0) {
-                m_children[childIndex]->Insert(entry.entity, entry.x, entry.y, entry.z);
-            }
-        }
-        
-        m_entities.clear();
-        m_isLeaf = false;
-    }
+    static constexpr uint32_t OVERSIZED_CELL = UINT32_MAX - 1;
+    // Keeps cell coordinates, and differences between them, within int32_t
+    static constexpr int32_t CELL_LIMIT = 1 << 29;
+    static constexpr size_t MAX_FREE_ENTRY_LISTS = 64;
     
-    int GetChildIndex(float x, float y, float z) const {
-        float cx = m_bounds.GetCenterX();
-        float cy = m_bounds.GetCenterY();
-        float cz = m_bounds.GetCenterZ();
-        
-        int index = 0;
-        if (x >= cx) index |= 1;
-        if (y >= cy) index |= 2;
-        if (z >= cz) index |= 4;
-        
-        return index;
+    int32_t ToCell(float v) const;
+    static uint64_t MakeCellKey(int32_t cx, int32_t cy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
     }
     
-    AABB m_bounds;
-    bool m_isLeaf;
-    std::vector<EntityEntry> m_entities;
-    std::unique_ptr<OctreeNode> m_children[8];
+    uint32_t GetOrCreateCell(int32_t cx, int32_t cy);
+    void FreeCell(uint32_t cellIndex);
+    void RecomputeOccupiedRange();
+    const Cell* FindCell(int32_t cx, int32_t cy) const;
+    const Location* FindLocation(EntityID entity) const;
+    Entry& GetEntry(const Location& location);
+    const Entry& GetEntry(const Location& location) const;
+    void RemoveEntry(const Location& location);
+    void Place(EntityID entity, const Entry& entry);
+    int32_t GetLooseCellRadius() const;
+    bool IsOversized(const Entry& entry) const { return std::max(entry.halfX, entry.halfY) > m_cellSize; }
+    
+    // Cells whose entries may overlap [minX, maxX] x [minY, maxY]; false if none can
+    bool GetCellRange(float minX, float minY, float maxX, float maxY, CellRange& range) const;
+    // Visits the occupied cells in the range, by lookup or by scanning the cell
+    // list, whichever is shorter
+    template<typename Fn>
+    void ForEachCell(const CellRange& range, Fn&& fn) const;
+    
+    // Distance from a point to an entry's bounds (0 if inside)
+    static float DistanceSq(const Entry& entry, float x, float y);
+    
+    float m_cellSize;
+    float m_invCellSize;
+    float m_maxHalfExtent = 0.0f;       // over grid entries only, so at most m_cellSize
+    size_t m_entityCount = 0;
+    
+    // Occupied cell coordinate range; clips every query
+    int32_t m_minCellX = 0, m_maxCellX = -1;
+    int32_t m_minCellY = 0, m_maxCellY = -1;
+    
+    std::vector<Cell> m_cells;
+    std::unordered_map<uint64_t, uint32_t> m_cellLookup;
+    std::vector<std::vector<Entry>> m_freeEntryLists; // storage of freed cells, reused by new ones
+    std::vector<Entry> m_oversized;
+    std::vector<Location> m_locations; // indexed by EntityID::GetIndex()
 };
 
-} // namespace BGE
\ No newline at end of file
+} // namespace BGE
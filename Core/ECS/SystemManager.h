@@ -2,6 +2,7 @@
 
 #include "System.h"
 #include "../Logger.h"
+#include "../Profiling/Profiler.h"
 #include <vector>
 #include <unordered_map>
 #include <memory>
@@ -46,6 +47,10 @@ public:
             systemPtr->OnStart();
         }
         
+        // Interned once rather than every update; the profiler keeps the name
+        // alive in case the system is unregistered before a capture is exported
+        m_profileNames[systemPtr] = Profiler::Instance().InternName(systemPtr->GetName());
+        
         BGE_LOG_INFO("SystemManager", "Registered system: " + std::string(systemPtr->GetName()));
         
         return systemPtr;
@@ -75,6 +80,7 @@ public:
             BGE_LOG_INFO("SystemManager", "Unregistered system: " + std::string(system->GetName()));
             
             // Remove from map
+            m_profileNames.erase(system);
             m_systems.erase(it);
         }
     }
@@ -102,9 +108,16 @@ public:
     // Update specific stage
     void UpdateStage(SystemStage stage, float deltaTime) {
         // TODO: Add parallel execution support for SystemMode::Parallel
+        static constexpr const char* STAGE_ZONES[] = {
+            "SystemStage::PreUpdate", "SystemStage::Update", "SystemStage::LateUpdate",
+            "SystemStage::PreRender", "SystemStage::PostRender"
+        };
+        static_assert(sizeof(STAGE_ZONES) / sizeof(STAGE_ZONES[0]) == static_cast<size_t>(SystemStage::Count));
+        BGE_PROFILE_SCOPE(STAGE_ZONES[static_cast<uint32_t>(stage)]);
         
         for (System* system : m_orderedSystems) {
             if (system->IsEnabled() && system->GetStage() == stage) {
+                BGE_PROFILE_SCOPE(m_profileNames[system]);
                 system->Update(deltaTime);
             }
         }
@@ -135,6 +148,7 @@ public:
         
         m_orderedSystems.clear();
         m_systems.clear();
+        m_profileNames.clear();
         m_needsSort = false;
     }
     
@@ -161,6 +175,7 @@ private:
     
     std::unordered_map<std::type_index, std::unique_ptr<System>> m_systems;
     std::vector<System*> m_orderedSystems;
+    std::unordered_map<const System*, const char*> m_profileNames; // Interned zone names
     bool m_needsSort = false;
 };
 
@@ -6,6 +6,8 @@
 #include "Events.h"
 #include "Logger.h"
 #include "ConfigManager.h"
+#include "Profiling/Profiler.h"
+#include "Memory/FrameArena.h"
 #include "Entity.h"
 #include "ECS/EntityManager.h"
 #include "ECS/Components/CoreComponents.h"
@@ -61,12 +63,21 @@ bool Engine::Initialize(const EngineConfig& config) {
         }
     }
     
+    // The main loop runs on this thread, so it dispatches events; the bus may have been
+    // created earlier on another thread by a static initialiser or a service
+    EventBus::Instance().SetDispatchThread();
+    
     // Initialize services
     if (!InitializeServices()) {
         BGE_LOG_ERROR("Engine", "Failed to initialize core services");
         return false;
     }
     
+    // Frame temporaries are reclaimed, and their statistics reported, once per frame
+    EventBus::Instance().Subscribe<FrameEndEvent>([](const FrameEndEvent&) {
+        FrameArena::EndFrame();
+    });
+    
     m_initialized = true;
     
     // Fire engine initialized event
@@ -101,8 +112,12 @@ bool Engine::InitializeServices() {
         // Register SystemManager as a service
         auto& systemManager = SystemManager::Instance();
         
-        // Register core systems
-        systemManager.RegisterSystem<TransformSystem>(std::make_shared<TransformSystem>());
+        // Register core systems; deep hierarchy levels share the simulation's worker pool
+        auto transformSystem = std::make_shared<TransformSystem>();
+        if (auto world = ServiceLocator::Instance().GetService<SimulationWorld>()) {
+            transformSystem->SetThreadPool(world->GetThreadPool());
+        }
+        systemManager.RegisterSystem<TransformSystem>(transformSystem);
         BGE_LOG_INFO("Engine", "TransformSystem registered.");
         
         // Register core ECS components
@@ -182,7 +197,7 @@ void Engine::RegisterCoreServices() {
 
   // Initialize and register ParticleSystem
   auto particleSystem = std::make_shared<ParticleSystem>();
-  if (particleSystem && particleSystem->Initialize()) { // Default pool size
+  if (particleSystem && particleSystem->Initialize(25000)) { // Performance spec ceiling; only live particles cost per frame
       serviceLocator.RegisterService<ParticleSystem>(particleSystem);
       BGE_LOG_INFO("Engine", "ParticleSystem service registered");
   } else {
@@ -269,8 +284,11 @@ void Engine::MainLoop() {
     const float targetFrameTime = 1.0f / targetFPS;
     
     auto input = ServiceLocator::Instance().GetService<InputManager>();
+    BGE_PROFILE_THREAD("Main");
+    FrameArena::SetMainThread();
     
     while (m_running && !m_window->ShouldClose()) {
+        BGE_PROFILE_FRAME_BEGIN();
         auto frameStartTime = std::chrono::high_resolution_clock::now();
         auto deltaTime = std::chrono::duration<float>(frameStartTime - lastTime).count();
         lastTime = frameStartTime;
@@ -281,14 +299,20 @@ void Engine::MainLoop() {
         EventBus::Instance().Publish(FrameStartEvent{m_deltaTime, m_frameCount});
         
         // Poll events
-        m_window->PollEvents();
-        if (input) {
-            input->Update();
+        {
+            BGE_PROFILE_SCOPE("Engine::PollEvents");
+            m_window->PollEvents();
+            if (input) {
+                input->Update();
+            }
         }
         
         // Update application
         Update(m_deltaTime);
         
+        // Deliver events queued by worker threads (and deferred ones) before rendering
+        EventBus::Instance().DispatchDeferred();
+        
         // Render
         BGE_LOG_TRACE("Engine", "Main loop - calling Render()");
         Render();
@@ -296,10 +320,14 @@ void Engine::MainLoop() {
         
         // Present
         BGE_LOG_TRACE("Engine", "Main loop - calling SwapBuffers()");
-        m_window->SwapBuffers();
+        {
+            BGE_PROFILE_SCOPE("Engine::SwapBuffers");
+            m_window->SwapBuffers();
+        }
         BGE_LOG_TRACE("Engine", "Main loop - SwapBuffers() completed");
         
         ++m_frameCount;
+        BGE_PROFILE_FRAME_END();
         
         // Calculate frame time
         auto frameEndTime = std::chrono::high_resolution_clock::now();
@@ -319,10 +347,12 @@ void Engine::MainLoop() {
 }
 
 void Engine::Update(float deltaTime) {
+    BGE_PROFILE_SCOPE("Engine::Update");
     auto& serviceLocator = ServiceLocator::Instance();
     
     // Update application
     if (m_application) {
+        BGE_PROFILE_SCOPE("Application::Update");
         m_application->Update(deltaTime);
     }
     
@@ -333,6 +363,7 @@ void Engine::Update(float deltaTime) {
     
     // Update audio system
     if (auto audio = serviceLocator.GetService<AudioSystem>()) {
+        BGE_PROFILE_SCOPE("AudioSystem::Update");
         audio->Update(deltaTime);
     }
 
@@ -341,6 +372,7 @@ void Engine::Update(float deltaTime) {
 
     // Update Particle System
     if (auto ps = serviceLocator.GetService<ParticleSystem>()) {
+        BGE_PROFILE_SCOPE("ParticleSystem::Update");
         ps->Update(deltaTime);
     }
 
@@ -358,6 +390,7 @@ void Engine::Update(float deltaTime) {
 }
 
 void Engine::Render() {
+    BGE_PROFILE_SCOPE("Engine::Render");
     auto& serviceLocator = ServiceLocator::Instance();
     auto renderer = serviceLocator.GetService<Renderer>();
     auto world = serviceLocator.GetService<SimulationWorld>();
@@ -371,7 +404,8 @@ void Engine::Render() {
         return;
     }
     
-    BGE_LOG_TRACE("Engine", "Render() call #" + std::to_string(renderCallCounter) + " - Starting BeginFrame()");
+    BGE_LOG_TRACE_FMT("Engine", "Render() call #{} - Starting BeginFrame()", renderCallCounter);
+    renderer->NewFrame();
     renderer->BeginFrame();
     BGE_LOG_TRACE("Engine", "BeginFrame() completed");
     
@@ -397,6 +431,7 @@ void Engine::Render() {
     
     // Render application (including UI)
     if (m_application) {
+        BGE_PROFILE_SCOPE("Application::Render");
         BGE_LOG_TRACE("Engine", "Calling application Render()");
         m_application->Render();
         BGE_LOG_TRACE("Engine", "Application Render() completed");
@@ -404,13 +439,9 @@ void Engine::Render() {
         BGE_LOG_ERROR("Engine", "No application available for rendering!");
     }
 
-    // Render particles (via Renderer facade)
-    BGE_LOG_TRACE("Engine", "Calling RenderParticles()");
-    renderer->RenderParticles();
-    BGE_LOG_TRACE("Engine", "RenderParticles() completed");
-    
     // End UI frame and render UI
     if (ui) {
+        BGE_PROFILE_SCOPE("UISystem::EndFrame");
         BGE_LOG_TRACE("Engine", "Starting UI EndFrame()");
         ui->EndFrame();
         BGE_LOG_TRACE("Engine", "UI EndFrame() completed");
@@ -418,7 +449,7 @@ void Engine::Render() {
     
     BGE_LOG_TRACE("Engine", "Starting renderer EndFrame()");
     renderer->EndFrame();
-    BGE_LOG_TRACE("Engine", "Render() call #" + std::to_string(renderCallCounter) + " completed");
+    BGE_LOG_TRACE_FMT("Engine", "Render() call #{} completed", renderCallCounter);
 }
 
 void Engine::RegisterShutdownCallback(ShutdownCallback callback) {
@@ -1,14 +1,257 @@
 #include "EventBus.h"
+#include <algorithm>
 
 namespace BGE {
 
+namespace Detail {
+
+EventTypeID NextEventTypeID() {
+    static std::atomic<EventTypeID> nextId{0};
+    return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace Detail
+
+namespace {
+
+thread_local void* t_deferredQueue = nullptr;
+
+} // anonymous namespace
+
+void EventSubscription::Reset() {
+    if (m_bus && m_token.IsValid()) {
+        m_bus->Unsubscribe(m_token);
+    }
+    m_bus = nullptr;
+    m_token = SubscriptionToken{};
+}
+
 EventBus& EventBus::Instance() {
     static EventBus instance;
     return instance;
 }
 
+EventBus::EventBus()
+    : m_dispatchThread(std::this_thread::get_id()) {
+}
+
+EventBus::~EventBus() {
+    Clear();
+}
+
+SubscriptionToken EventBus::AddHandler(EventTypeID type, InvokeFunction invoke, void* target, DestroyFunction destroy) {
+    if (type >= m_handlers.size()) {
+        m_handlers.resize(type + 1);
+    }
+    
+    HandlerSlot slot;
+    slot.invoke = invoke;
+    slot.target = target;
+    slot.destroy = destroy;
+    slot.id = m_nextHandlerId++;
+    m_handlers[type].slots.push_back(slot);
+    return SubscriptionToken{type, slot.id};
+}
+
+bool EventBus::Unsubscribe(SubscriptionToken token) {
+    if (!token.IsValid() || token.type >= m_handlers.size()) {
+        return false;
+    }
+    
+    HandlerList& list = m_handlers[token.type];
+    auto it = std::find_if(list.slots.begin(), list.slots.end(), [&token](const HandlerSlot& slot) {
+        return slot.id == token.id && slot.invoke;
+    });
+    if (it == list.slots.end()) {
+        return false;
+    }
+    
+    // Mid-dispatch the slot is only disabled; Compact() removes it once the dispatch unwinds
+    if (list.dispatchDepth > 0) {
+        it->invoke = nullptr;
+        list.hasRemoved = true;
+        return true;
+    }
+    
+    if (it->destroy) {
+        it->destroy(it->target);
+    }
+    list.slots.erase(it);
+    return true;
+}
+
+void EventBus::Dispatch(EventTypeID type, const void* event) {
+    if (type >= m_handlers.size() || m_handlers[type].slots.empty()) {
+        return;
+    }
+    
+    // Handlers may subscribe (growing the arrays) while we iterate, so index afresh each call;
+    // handlers added during this dispatch first see the next event
+    size_t count = m_handlers[type].slots.size();
+    m_handlers[type].dispatchDepth++;
+    for (size_t i = 0; i < count; ++i) {
+        HandlerSlot slot = m_handlers[type].slots[i];
+        if (slot.invoke) {
+            slot.invoke(slot.target, event);
+        }
+    }
+    
+    HandlerList& list = m_handlers[type];
+    if (--list.dispatchDepth == 0 && list.hasRemoved) {
+        Compact(list);
+    }
+}
+
+void EventBus::Compact(HandlerList& list) {
+    auto removed = std::stable_partition(list.slots.begin(), list.slots.end(), [](const HandlerSlot& slot) {
+        return slot.invoke != nullptr;
+    });
+    for (auto it = removed; it != list.slots.end(); ++it) {
+        if (it->destroy) {
+            it->destroy(it->target);
+        }
+    }
+    list.slots.erase(removed, list.slots.end());
+    list.hasRemoved = false;
+}
+
+size_t EventBus::GetHandlerCount(EventTypeID type) const {
+    if (type >= m_handlers.size()) {
+        return 0;
+    }
+    const auto& slots = m_handlers[type].slots;
+    return static_cast<size_t>(std::count_if(slots.begin(), slots.end(), [](const HandlerSlot& slot) {
+        return slot.invoke != nullptr;
+    }));
+}
+
+EventBus::DeferredQueue* EventBus::GetThreadQueue() {
+    if (t_deferredQueue) {
+        return static_cast<DeferredQueue*>(t_deferredQueue);
+    }
+    
+    // First event from this thread: register its queue. The queue outlives the
+    // thread so events it queued just before exiting are still delivered.
+    auto queue = std::make_unique<DeferredQueue>();
+    queue->blocks.push_back(std::make_unique<DeferredBlock>());
+    queue->head = queue->blocks.back().get();
+    queue->tail.store(queue->head, std::memory_order_relaxed);
+    
+    std::lock_guard<std::mutex> lock(m_queuesMutex);
+    t_deferredQueue = queue.get();
+    m_queues.push_back(std::move(queue));
+    return static_cast<DeferredQueue*>(t_deferredQueue);
+}
+
+EventBus::DeferredBlock* EventBus::AcquireBlock(DeferredQueue& queue) {
+    // Only this thread pops and the consumer only pushes, so a popped node cannot be recycled under us
+    DeferredBlock* block = queue.freeBlocks.load(std::memory_order_acquire);
+    while (block && !queue.freeBlocks.compare_exchange_weak(block, block->next.load(std::memory_order_relaxed),
+                                                            std::memory_order_acquire, std::memory_order_acquire)) {
+    }
+    
+    if (!block) {
+        auto fresh = std::make_unique<DeferredBlock>();
+        block = fresh.get();
+        std::lock_guard<std::mutex> lock(queue.blocksMutex);
+        queue.blocks.push_back(std::move(fresh));
+    }
+    block->next.store(nullptr, std::memory_order_relaxed);
+    block->written.store(0, std::memory_order_relaxed);
+    block->read = 0;
+    return block;
+}
+
+void* EventBus::BeginDeferred(size_t eventSize) {
+    DeferredQueue* queue = GetThreadQueue();
+    DeferredBlock* block = queue->tail.load(std::memory_order_relaxed);
+    size_t recordSize = RecordSize(eventSize);
+    
+    uint32_t offset = block->written.load(std::memory_order_relaxed);
+    if (offset + recordSize > BLOCK_SIZE) {
+        // Link a fresh block; the consumer finishes the old one before following the link
+        DeferredBlock* next = AcquireBlock(*queue);
+        block->next.store(next, std::memory_order_release);
+        queue->tail.store(next, std::memory_order_release);
+        block = next;
+        offset = 0;
+    }
+    
+    auto* header = new (block->data + offset) DeferredHeader();
+    header->size = static_cast<uint32_t>(recordSize);
+    return header;
+}
+
+void EventBus::EndDeferred(void* record, size_t eventSize) {
+    auto* queue = static_cast<DeferredQueue*>(t_deferredQueue);
+    DeferredBlock* block = queue->tail.load(std::memory_order_relaxed);
+    uint32_t offset = static_cast<uint32_t>(static_cast<unsigned char*>(record) - block->data);
+    block->written.store(offset + static_cast<uint32_t>(RecordSize(eventSize)), std::memory_order_release);
+}
+
+void EventBus::DrainQueue(DeferredQueue& queue, bool deliver) {
+    // Stop at what was published when we started, so handlers that enqueue cannot keep us here
+    DeferredBlock* lastBlock = queue.tail.load(std::memory_order_acquire);
+    uint32_t lastWritten = lastBlock->written.load(std::memory_order_acquire);
+    
+    DeferredBlock* block = queue.head;
+    while (true) {
+        uint32_t limit = block == lastBlock ? lastWritten : block->written.load(std::memory_order_acquire);
+        while (block->read < limit) {
+            auto* header = reinterpret_cast<DeferredHeader*>(block->data + block->read);
+            void* event = header + 1;
+            if (deliver) {
+                Dispatch(header->type, event);
+            }
+            if (header->destroy) {
+                header->destroy(event);
+            }
+            block->read += header->size;
+        }
+        
+        if (block == lastBlock) {
+            break;
+        }
+        
+        // Finished with this block: hand it back to the producer
+        DeferredBlock* next = block->next.load(std::memory_order_acquire);
+        queue.head = next;
+        DeferredBlock* top = queue.freeBlocks.load(std::memory_order_relaxed);
+        do {
+            block->next.store(top, std::memory_order_relaxed);
+        } while (!queue.freeBlocks.compare_exchange_weak(top, block, std::memory_order_release, std::memory_order_relaxed));
+        block = next;
+    }
+}
+
+void EventBus::DispatchDeferred() {
+    {
+        std::lock_guard<std::mutex> lock(m_queuesMutex);
+        m_dispatchQueues.clear();
+        for (auto& queue : m_queues) {
+            m_dispatchQueues.push_back(queue.get());
+        }
+    }
+    
+    for (size_t i = 0; i < m_dispatchQueues.size(); ++i) {
+        DrainQueue(*m_dispatchQueues[i], true);
+    }
+}
+
 void EventBus::Clear() {
+    for (HandlerList& list : m_handlers) {
+        for (HandlerSlot& slot : list.slots) {
+            if (slot.destroy) {
+                slot.destroy(slot.target);
+            }
+        }
+    }
     m_handlers.clear();
+    
+    std::lock_guard<std::mutex> lock(m_queuesMutex);
+    for (auto& queue : m_queues) {
+        DrainQueue(*queue, false);
+    }
 }
 
-} // namespace BGE
\ No newline at end of file
+} // namespace BGE
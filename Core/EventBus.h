@@ -1,13 +1,85 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <vector>
-#include <unordered_map>
-#include <typeindex>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace BGE {
 
+using EventTypeID = uint32_t;
+constexpr EventTypeID INVALID_EVENT_TYPE = UINT32_MAX;
+
+namespace Detail {
+EventTypeID NextEventTypeID();
+}
+
+// Dense per-type index, assigned once per event type and used to index the handler table
+template<typename EventType>
+EventTypeID GetEventTypeID() {
+    static const EventTypeID id = Detail::NextEventTypeID();
+    return id;
+}
+
+// Identifies one subscription for Unsubscribe()
+struct SubscriptionToken {
+    EventTypeID type = INVALID_EVENT_TYPE;
+    uint32_t id = 0;
+    
+    bool IsValid() const { return type != INVALID_EVENT_TYPE; }
+};
+
+class EventBus;
+
+// Unsubscribes when destroyed; keep one per subscription whose handler captures an object
+class EventSubscription {
+public:
+    EventSubscription() = default;
+    EventSubscription(EventBus* bus, SubscriptionToken token) : m_bus(bus), m_token(token) {}
+    ~EventSubscription() { Reset(); }
+    
+    EventSubscription(EventSubscription&& other) noexcept
+        : m_bus(std::exchange(other.m_bus, nullptr)), m_token(std::exchange(other.m_token, SubscriptionToken{})) {}
+    EventSubscription& operator=(EventSubscription&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            m_bus = std::exchange(other.m_bus, nullptr);
+            m_token = std::exchange(other.m_token, SubscriptionToken{});
+        }
+        return *this;
+    }
+    EventSubscription(const EventSubscription&) = delete;
+    EventSubscription& operator=(const EventSubscription&) = delete;
+    
+    void Reset();
+    SubscriptionToken GetToken() const { return m_token; }
+
+private:
+    EventBus* m_bus = nullptr;
+    SubscriptionToken m_token;
+};
+
+// Type-indexed publish/subscribe.
+//
+// Handlers live in one contiguous array per event type, indexed by
+// GetEventTypeID(), and are called through a plain function pointer plus
+// target: member functions bind without allocating, other callables are
+// allocated once at Subscribe(). Subscribe, Unsubscribe and immediate
+// dispatch belong to the dispatch thread (the one that created the bus, see
+// SetDispatchThread()); handlers may subscribe or unsubscribe while an event
+// is being dispatched.
+//
+// Any thread can Enqueue() an event. Each thread appends to its own queue of
+// recycled blocks without taking a lock, and DispatchDeferred() delivers the
+// queued events on the dispatch thread, in order per thread. Publish() from
+// another thread is deferred the same way.
 class EventBus {
 public:
     static EventBus& Instance();
@@ -15,50 +87,150 @@ public:
     template<typename EventType>
     using EventHandler = std::function<void(const EventType&)>;
     
-    template<typename EventType>
-    void Subscribe(EventHandler<EventType> handler) {
-        auto typeId = std::type_index(typeid(EventType));
-        auto& handlers = m_handlers[typeId];
-        handlers.push_back(std::make_shared<HandlerWrapper<EventType>>(handler));
+    // Any callable taking const EventType&
+    template<typename EventType, typename Handler>
+    SubscriptionToken Subscribe(Handler&& handler) {
+        using Callable = std::decay_t<Handler>;
+        static_assert(std::is_invocable_v<Callable&, const EventType&>, "Handler must accept const EventType&");
+        auto* callable = new Callable(std::forward<Handler>(handler));
+        return AddHandler(GetEventTypeID<EventType>(), &InvokeCallable<EventType, Callable>, callable,
+                          &DestroyCallable<Callable>);
+    }
+    
+    // Member function delegate: Subscribe<FrameStartEvent, &Editor::OnFrameStart>(this)
+    template<typename EventType, auto Method, typename Class>
+    SubscriptionToken Subscribe(Class* instance) {
+        return AddHandler(GetEventTypeID<EventType>(), &InvokeMethod<EventType, Method, Class>, instance, nullptr);
     }
     
+    bool Unsubscribe(SubscriptionToken token);
+    
+    // Delivers immediately on the dispatch thread; deferred when called from any other thread
     template<typename EventType>
     void Publish(const EventType& event) {
-        auto typeId = std::type_index(typeid(EventType));
-        auto it = m_handlers.find(typeId);
-        if (it != m_handlers.end()) {
-            for (auto& handler : it->second) {
-                handler->Call(&event);
-            }
+        if (std::this_thread::get_id() != m_dispatchThread) {
+            Enqueue(event);
+            return;
         }
+        Dispatch(GetEventTypeID<EventType>(), &event);
     }
     
+    // Queues the event for the next DispatchDeferred(); safe from any thread
+    template<typename EventType>
+    void Enqueue(EventType&& event) {
+        using Stored = std::decay_t<EventType>;
+        static_assert(alignof(Stored) <= RECORD_ALIGNMENT, "Over-aligned events cannot be deferred");
+        static_assert(sizeof(Stored) + sizeof(DeferredHeader) <= BLOCK_SIZE, "Event too large to defer");
+        
+        void* storage = BeginDeferred(sizeof(Stored));
+        auto* header = static_cast<DeferredHeader*>(storage);
+        header->type = GetEventTypeID<Stored>();
+        header->destroy = std::is_trivially_destructible_v<Stored> ? nullptr : &DestroyEvent<Stored>;
+        new (header + 1) Stored(std::forward<EventType>(event));
+        EndDeferred(storage, sizeof(Stored));
+    }
+    
+    // Delivers events queued so far, thread by thread; events queued by the handlers wait for the next call
+    void DispatchDeferred();
+    
+    // Makes the calling thread the one that dispatches
+    void SetDispatchThread() { m_dispatchThread = std::this_thread::get_id(); }
+    
+    template<typename EventType>
+    size_t GetHandlerCount() const { return GetHandlerCount(GetEventTypeID<EventType>()); }
+    size_t GetHandlerCount(EventTypeID type) const;
+    
+    // Drops every handler and discards queued events
     void Clear();
     
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;    // bytes per deferred queue block
+    static constexpr size_t RECORD_ALIGNMENT = alignof(std::max_align_t);
+
 private:
-    EventBus() = default;
-    ~EventBus() = default;
+    using InvokeFunction = void (*)(void* target, const void* event);
+    using DestroyFunction = void (*)(void* target);
     
-    class HandlerWrapperBase {
-    public:
-        virtual ~HandlerWrapperBase() = default;
-        virtual void Call(const void* event) = 0;
+    struct HandlerSlot {
+        InvokeFunction invoke = nullptr;    // nullptr once unsubscribed during dispatch
+        void* target = nullptr;
+        DestroyFunction destroy = nullptr;  // frees owned callables
+        uint32_t id = 0;
     };
     
-    template<typename EventType>
-    class HandlerWrapper : public HandlerWrapperBase {
-    public:
-        HandlerWrapper(EventHandler<EventType> handler) : m_handler(handler) {}
-        
-        void Call(const void* event) override {
-            m_handler(*static_cast<const EventType*>(event));
-        }
-        
-    private:
-        EventHandler<EventType> m_handler;
+    struct HandlerList {
+        std::vector<HandlerSlot> slots;
+        uint32_t dispatchDepth = 0;
+        bool hasRemoved = false;
     };
     
-    std::unordered_map<std::type_index, std::vector<std::shared_ptr<HandlerWrapperBase>>> m_handlers;
+    // Precedes each deferred event; the event follows at RECORD_ALIGNMENT
+    struct alignas(RECORD_ALIGNMENT) DeferredHeader {
+        DestroyFunction destroy = nullptr;
+        uint32_t size = 0;                  // whole record, header included
+        EventTypeID type = INVALID_EVENT_TYPE;
+    };
+    
+    struct DeferredBlock {
+        std::atomic<DeferredBlock*> next{nullptr};
+        std::atomic<uint32_t> written{0};   // published by the producer
+        uint32_t read = 0;                  // consumer only
+        alignas(RECORD_ALIGNMENT) unsigned char data[BLOCK_SIZE];
+    };
+    
+    // Single-producer queue owned by one thread, consumed by the dispatch thread
+    struct DeferredQueue {
+        DeferredBlock* head = nullptr;      // consumer
+        std::atomic<DeferredBlock*> tail{nullptr};
+        std::atomic<DeferredBlock*> freeBlocks{nullptr}; // recycled by the consumer, reused by the producer
+        std::vector<std::unique_ptr<DeferredBlock>> blocks;
+        std::mutex blocksMutex;             // guards `blocks`, only touched when a new block is allocated
+    };
+    
+    EventBus();
+    ~EventBus();
+    
+    SubscriptionToken AddHandler(EventTypeID type, InvokeFunction invoke, void* target, DestroyFunction destroy);
+    void Dispatch(EventTypeID type, const void* event);
+    void Compact(HandlerList& list);
+    
+    DeferredQueue* GetThreadQueue();
+    void* BeginDeferred(size_t eventSize);
+    void EndDeferred(void* record, size_t eventSize);
+    DeferredBlock* AcquireBlock(DeferredQueue& queue);
+    void DrainQueue(DeferredQueue& queue, bool deliver);
+    
+    static size_t RecordSize(size_t eventSize) {
+        size_t size = sizeof(DeferredHeader) + eventSize;
+        return (size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+    }
+    
+    template<typename EventType, typename Callable>
+    static void InvokeCallable(void* target, const void* event) {
+        (*static_cast<Callable*>(target))(*static_cast<const EventType*>(event));
+    }
+    
+    template<typename Callable>
+    static void DestroyCallable(void* target) {
+        delete static_cast<Callable*>(target);
+    }
+    
+    template<typename EventType, auto Method, typename Class>
+    static void InvokeMethod(void* target, const void* event) {
+        (static_cast<Class*>(target)->*Method)(*static_cast<const EventType*>(event));
+    }
+    
+    template<typename EventType>
+    static void DestroyEvent(void* event) {
+        static_cast<EventType*>(event)->~EventType();
+    }
+    
+    std::vector<HandlerList> m_handlers;    // indexed by EventTypeID
+    uint32_t m_nextHandlerId = 1;
+    std::thread::id m_dispatchThread;
+    
+    std::vector<std::unique_ptr<DeferredQueue>> m_queues;
+    std::mutex m_queuesMutex;               // registration only
+    std::vector<DeferredQueue*> m_dispatchQueues;
 };
 
-} // namespace BGE
\ No newline at end of file
+} // namespace BGE
@@ -69,6 +69,24 @@ struct EntityVisibilityChangedEvent {
         : entityId(id), isVisible(visible) {}
 };
 
+// Entity created, destroyed, moved to another parent or renamed by an editor tool.
+// Lets the hierarchy view patch its tree instead of rescanning every entity. It
+// notices creations and destructions on its own by the next frame, but renames and
+// reparenting reach it only through this event. Publish it once the entity's
+// components are in place (after DestroyEntity for Destroyed).
+struct EntityHierarchyChangedEvent {
+    enum Change {
+        Created,
+        Destroyed,
+        Reparented,
+        Renamed
+    } change;
+    EntityID entityId;
+    
+    EntityHierarchyChangedEvent(Change what, EntityID id)
+        : change(what), entityId(id) {}
+};
+
 // AssetSelectionChangedEvent is now defined in AssetTypes.h
 
 // Material hover event for material inspector tooltip
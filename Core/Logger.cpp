@@ -1,26 +1,93 @@
 #include "Logger.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <ctime>
 #include <iostream>
 
 namespace BGE {
 
+std::atomic<int> Logger::s_logLevel{static_cast<int>(LogLevel::INFO)};
+
+namespace {
+
+// Marks a record that is written by the calling thread instead of the queue
+constexpr uint64_t SYNCHRONOUS_POSITION = UINT64_MAX;
+
+std::tm ToLocalTime(std::time_t time) {
+    std::tm result{};
+#ifdef _WIN32
+    localtime_s(&result, &time);
+#else
+    localtime_r(&time, &result);
+#endif
+    return result;
+}
+
+template<typename T>
+T ReadValue(const char*& cursor) {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+} // anonymous namespace
+
 Logger& Logger::Instance() {
     static Logger instance;
     return instance;
 }
 
+Logger::Logger()
+    : m_records(std::make_unique<LogRecord[]>(QUEUE_CAPACITY)) {
+    static_assert((QUEUE_CAPACITY & (QUEUE_CAPACITY - 1)) == 0, "QUEUE_CAPACITY must be a power of two");
+    static_assert(MAX_CATEGORY_LENGTH < PAYLOAD_SIZE / 2, "Category must leave room for the message");
+    for (size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+        m_records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+Logger::~Logger() {
+    Shutdown();
+}
+
 void Logger::Initialize(const std::string& logFilePath, LogLevel level) {
-    m_logLevel = level;
+    SetLogLevel(level);
     
-    if (!logFilePath.empty()) {
-        m_logFile = std::make_unique<std::ofstream>(logFilePath, std::ios::app);
-        m_fileOutput = m_logFile->is_open();
-        if (!m_fileOutput) {
-            std::cerr << "Failed to open log file: " << logFilePath << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(m_outputMutex);
+        if (!logFilePath.empty()) {
+            m_logFile = std::make_unique<std::ofstream>(logFilePath, std::ios::app);
+            m_fileOutput = m_logFile->is_open();
+            if (!m_fileOutput) {
+                std::cerr << "Failed to open log file: " << logFilePath << std::endl;
+            }
         }
     }
+    
+    if (!m_running.exchange(true)) {
+        m_writer = std::thread(&Logger::WriterThread, this);
+    }
 }
 
 void Logger::Shutdown() {
+    if (m_running.exchange(false)) {
+        m_wake.notify_one();
+        if (m_writer.joinable()) {
+            m_writer.join();
+        }
+        // Producers that saw the queue running may still be claiming or filling slots;
+        // once they have all committed, drain everything up to m_enqueuePos
+        while (m_activeProducers.load(std::memory_order_acquire) > 0) {
+            if (Drain() == 0) {
+                std::this_thread::yield();
+            }
+        }
+        Drain();
+    }
+    
+    std::lock_guard<std::mutex> lock(m_outputMutex);
     if (m_logFile) {
         m_logFile->close();
         m_logFile.reset();
@@ -28,69 +95,346 @@ void Logger::Shutdown() {
     m_fileOutput = false;
 }
 
-void Logger::Log(LogLevel level, const std::string& category, const std::string& message) {
-    if (level < m_logLevel) {
+void Logger::Log(LogLevel level, std::string_view category, std::string_view message) {
+    uint64_t position = 0;
+    LogRecord* record = BeginRecord(level, category, position);
+    if (!record) {
         return;
     }
     
-    std::string timestamp = GetTimestamp();
-    std::string levelStr = LogLevelToString(level);
-    
-    std::ostringstream oss;
-    oss << "[" << timestamp << "] [" << levelStr << "] [" << category << "] " << message;
-    std::string logMessage = oss.str();
-    
-    if (m_consoleOutput) {
-        if (level >= LogLevel::ERROR) {
-            std::cerr << logMessage << std::endl;
-        } else {
-            std::cout << logMessage << std::endl;
-        }
-    }
-    
-    if (m_fileOutput && m_logFile) {
-        *m_logFile << logMessage << std::endl;
-        m_logFile->flush();
+    if (message.size() <= PAYLOAD_SIZE - record->size) {
+        std::memcpy(record->payload + record->size, message.data(), message.size());
+        record->size = static_cast<uint16_t>(record->size + message.size());
+    } else {
+        record->overflow = new std::string(message);
+        m_overflowed.fetch_add(1, std::memory_order_relaxed);
     }
+    CommitRecord(record, position);
 }
 
-void Logger::Trace(const std::string& category, const std::string& message) {
+void Logger::Trace(std::string_view category, std::string_view message) {
     Log(LogLevel::TRACE, category, message);
 }
 
-void Logger::Debug(const std::string& category, const std::string& message) {
+void Logger::Debug(std::string_view category, std::string_view message) {
     Log(LogLevel::DEBUG, category, message);
 }
 
-void Logger::Info(const std::string& category, const std::string& message) {
+void Logger::Info(std::string_view category, std::string_view message) {
     Log(LogLevel::INFO, category, message);
 }
 
-void Logger::Warning(const std::string& category, const std::string& message) {
+void Logger::Warning(std::string_view category, std::string_view message) {
     Log(LogLevel::WARNING, category, message);
 }
 
-void Logger::Error(const std::string& category, const std::string& message) {
+void Logger::Error(std::string_view category, std::string_view message) {
     Log(LogLevel::ERROR, category, message);
 }
 
-void Logger::Critical(const std::string& category, const std::string& message) {
+void Logger::Critical(std::string_view category, std::string_view message) {
     Log(LogLevel::CRITICAL, category, message);
 }
 
-std::string Logger::GetTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
+Logger::LogRecord* Logger::BeginRecord(LogLevel level, std::string_view category, uint64_t& position) {
+    if (!IsEnabled(level)) {
+        return nullptr;
+    }
     
-    std::ostringstream oss;
-    oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    oss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    return oss.str();
+    LogRecord* record = nullptr;
+    // Registered before checking m_running, so Shutdown either sees us or we see it stopped
+    m_activeProducers.fetch_add(1, std::memory_order_seq_cst);
+    if (m_running.load(std::memory_order_seq_cst)) {
+        // Vyukov bounded queue: claim the slot whose sequence matches our position
+        uint64_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        while (!record) {
+            LogRecord& slot = m_records[pos & (QUEUE_CAPACITY - 1)];
+            uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+            if (difference == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    record = &slot;
+                    position = pos;
+                }
+            } else if (difference < 0) {
+                // Full: verbose levels are dropped, everything else waits for the writer
+                if (level < LogLevel::INFO) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    m_activeProducers.fetch_sub(1, std::memory_order_release);
+                    return nullptr;
+                }
+                // Nobody will drain the queue once Shutdown has begun; write it ourselves
+                if (!m_running.load(std::memory_order_acquire)) {
+                    break;
+                }
+                m_wake.notify_one();
+                std::this_thread::yield();
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    if (!record) {
+        m_activeProducers.fetch_sub(1, std::memory_order_release);
+        thread_local LogRecord scratch;
+        record = &scratch;
+        position = SYNCHRONOUS_POSITION;
+    }
+    
+    size_t categoryLength = std::min(category.size(), MAX_CATEGORY_LENGTH);
+    record->timestamp = Now();
+    record->level = level;
+    record->format = nullptr;
+    record->overflow = nullptr;
+    record->payload[0] = static_cast<char>(categoryLength);
+    std::memcpy(record->payload + 1, category.data(), categoryLength);
+    record->size = static_cast<uint16_t>(1 + categoryLength);
+    return record;
+}
+
+void Logger::CommitRecord(LogRecord* record, uint64_t position) {
+    if (position == SYNCHRONOUS_POSITION) {
+        std::string line;
+        std::string stdoutBatch;
+        std::string fileBatch;
+        std::lock_guard<std::mutex> lock(m_outputMutex);
+        FormatRecord(*record, line);
+        WriteLine(record->level, line, stdoutBatch, fileBatch);
+        WriteBatches(stdoutBatch, fileBatch);
+        delete record->overflow;
+        record->overflow = nullptr;
+        m_written.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    LogLevel level = record->level;
+    record->sequence.store(position + 1, std::memory_order_release);
+    m_queued.fetch_add(1, std::memory_order_relaxed);
+    m_activeProducers.fetch_sub(1, std::memory_order_release);
+    
+    // Pairs with the fence in WriterThread so one side always sees the other
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writerIdle.load(std::memory_order_relaxed)) {
+        m_wake.notify_one();
+    }
+    
+    if (level == LogLevel::CRITICAL) {
+        Flush();
+    }
+}
+
+void Logger::Flush() {
+    uint64_t target = m_enqueuePos.load(std::memory_order_acquire);
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    while (m_running.load(std::memory_order_acquire) && m_dequeuePos.load(std::memory_order_acquire) < target) {
+        m_wake.notify_one();
+        m_drained.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
+
+LoggerStats Logger::GetStats() const {
+    LoggerStats stats;
+    stats.messagesQueued = m_queued.load(std::memory_order_relaxed);
+    stats.messagesWritten = m_written.load(std::memory_order_relaxed);
+    stats.messagesDropped = m_dropped.load(std::memory_order_relaxed);
+    stats.messagesOverflowed = m_overflowed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Logger::WriterThread() {
+    while (m_running.load(std::memory_order_acquire)) {
+        if (Drain() > 0) {
+            continue;
+        }
+        
+        m_writerIdle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        
+        // Re-check after announcing we are idle; a producer that missed the flag is seen here
+        uint64_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        bool pending = m_records[pos & (QUEUE_CAPACITY - 1)].sequence.load(std::memory_order_acquire) == pos + 1;
+        if (!pending && m_running.load(std::memory_order_acquire)) {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wake.wait_for(lock, std::chrono::milliseconds(50));
+        }
+        m_writerIdle.store(false, std::memory_order_relaxed);
+    }
+    Drain();
 }
 
-std::string Logger::LogLevelToString(LogLevel level) {
+size_t Logger::Drain() {
+    std::string line;
+    std::string stdoutBatch;
+    std::string fileBatch;
+    size_t count = 0;
+    
+    std::lock_guard<std::mutex> lock(m_outputMutex);
+    uint64_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+        LogRecord& record = m_records[pos & (QUEUE_CAPACITY - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != pos + 1) {
+            break;
+        }
+        
+        line.clear();
+        FormatRecord(record, line);
+        WriteLine(record.level, line, stdoutBatch, fileBatch);
+        delete record.overflow;
+        record.overflow = nullptr;
+        
+        // Hand the slot back to producers for the next lap
+        record.sequence.store(pos + QUEUE_CAPACITY, std::memory_order_release);
+        ++pos;
+        ++count;
+    }
+    
+    uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_reportedDropped) {
+        line = "[";
+        AppendTimestamp(Now(), line);
+        line += "] [WARN] [Logger] " + std::to_string(dropped - m_reportedDropped) + " messages dropped (queue full)";
+        WriteLine(LogLevel::WARNING, line, stdoutBatch, fileBatch);
+        m_reportedDropped = dropped;
+    }
+    
+    if (count > 0 || !stdoutBatch.empty() || !fileBatch.empty()) {
+        WriteBatches(stdoutBatch, fileBatch);
+        m_written.fetch_add(count, std::memory_order_relaxed);
+        m_dequeuePos.store(pos, std::memory_order_release);
+        m_drained.notify_all();
+    }
+    return count;
+}
+
+void Logger::FormatRecord(const LogRecord& record, std::string& out) {
+    size_t categoryLength = static_cast<uint8_t>(record.payload[0]);
+    const char* cursor = record.payload + 1 + categoryLength;
+    const char* end = record.payload + record.size;
+    
+    out += '[';
+    AppendTimestamp(record.timestamp, out);
+    out += "] [";
+    out += LogLevelToString(record.level);
+    out += "] [";
+    out.append(record.payload + 1, categoryLength);
+    out += "] ";
+    
+    if (record.overflow) {
+        out += *record.overflow;
+        return;
+    }
+    if (!record.format) {
+        out.append(cursor, end);
+        return;
+    }
+    
+    // Substitute the encoded arguments into the {} placeholders
+    char number[64];
+    for (const char* f = record.format; *f; ++f) {
+        if ((f[0] == '{' && f[1] == '{') || (f[0] == '}' && f[1] == '}')) {
+            out += *f++;
+            continue;
+        }
+        if (f[0] != '{' || f[1] != '}') {
+            out += *f;
+            continue;
+        }
+        ++f;
+        if (cursor >= end) {
+            out += "{}";
+            continue;
+        }
+        
+        switch (static_cast<ArgType>(*cursor++)) {
+            case ArgType::Bool:
+                out += ReadValue<uint8_t>(cursor) ? "true" : "false";
+                break;
+            case ArgType::Char:
+                out += ReadValue<char>(cursor);
+                break;
+            case ArgType::Int:
+                std::snprintf(number, sizeof(number), "%" PRId64, ReadValue<int64_t>(cursor));
+                out += number;
+                break;
+            case ArgType::UInt:
+                std::snprintf(number, sizeof(number), "%" PRIu64, ReadValue<uint64_t>(cursor));
+                out += number;
+                break;
+            case ArgType::Double:
+                std::snprintf(number, sizeof(number), "%g", ReadValue<double>(cursor));
+                out += number;
+                break;
+            case ArgType::String: {
+                uint16_t length = ReadValue<uint16_t>(cursor);
+                out.append(cursor, length);
+                cursor += length;
+                break;
+            }
+            case ArgType::Pointer:
+                std::snprintf(number, sizeof(number), "0x%" PRIx64, ReadValue<uint64_t>(cursor));
+                out += number;
+                break;
+        }
+    }
+}
+
+void Logger::WriteLine(LogLevel level, const std::string& line, std::string& stdoutBatch, std::string& fileBatch) {
+    if (m_consoleOutput.load(std::memory_order_relaxed)) {
+        if (level >= LogLevel::ERROR) {
+            // Keep stdout and stderr in order
+            if (!stdoutBatch.empty()) {
+                std::cout.write(stdoutBatch.data(), static_cast<std::streamsize>(stdoutBatch.size()));
+                std::cout.flush();
+                stdoutBatch.clear();
+            }
+            std::cerr << line << std::endl;
+        } else {
+            stdoutBatch += line;
+            stdoutBatch += '\n';
+        }
+    }
+    
+    if (m_fileOutput.load(std::memory_order_relaxed) && m_logFile) {
+        fileBatch += line;
+        fileBatch += '\n';
+    }
+}
+
+void Logger::WriteBatches(const std::string& stdoutBatch, const std::string& fileBatch) {
+    if (!stdoutBatch.empty()) {
+        std::cout.write(stdoutBatch.data(), static_cast<std::streamsize>(stdoutBatch.size()));
+        std::cout.flush();
+    }
+    if (!fileBatch.empty() && m_logFile) {
+        m_logFile->write(fileBatch.data(), static_cast<std::streamsize>(fileBatch.size()));
+        m_logFile->flush();
+    }
+}
+
+void Logger::AppendTimestamp(int64_t timestamp, std::string& out) {
+    int64_t seconds = timestamp / 1000000000;
+    int64_t milliseconds = (timestamp / 1000000) % 1000;
+    
+    // Records arrive in order, so the calendar part rarely changes between them
+    if (seconds != m_cachedSecond) {
+        std::tm local = ToLocalTime(static_cast<std::time_t>(seconds));
+        std::strftime(m_cachedTimestamp, sizeof(m_cachedTimestamp), "%Y-%m-%d %H:%M:%S", &local);
+        m_cachedSecond = seconds;
+    }
+    
+    char fraction[8];
+    std::snprintf(fraction, sizeof(fraction), ".%03d", static_cast<int>(milliseconds));
+    out += m_cachedTimestamp;
+    out += fraction;
+}
+
+int64_t Logger::Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+const char* Logger::LogLevelToString(LogLevel level) {
     switch (level) {
         case LogLevel::TRACE: return "TRACE";
         case LogLevel::DEBUG: return "DEBUG";
@@ -102,4 +446,30 @@ std::string Logger::LogLevelToString(LogLevel level) {
     }
 }
 
-} // namespace BGE
\ No newline at end of file
+bool Logger::ArgEncoder::Put(ArgType type, const void* bytes, size_t count) {
+    if (m_full || m_offset + 1 + count > PAYLOAD_SIZE) {
+        m_full = true;
+        return false;
+    }
+    m_data[m_offset++] = static_cast<char>(type);
+    std::memcpy(m_data + m_offset, bytes, count);
+    m_offset += count;
+    return true;
+}
+
+void Logger::ArgEncoder::PutString(const char* text, size_t length) {
+    // Long strings are cut to whatever room is left
+    const size_t header = 1 + sizeof(uint16_t);
+    if (m_full || m_offset + header > PAYLOAD_SIZE) {
+        m_full = true;
+        return;
+    }
+    uint16_t stored = static_cast<uint16_t>(std::min(length, PAYLOAD_SIZE - m_offset - header));
+    m_data[m_offset++] = static_cast<char>(ArgType::String);
+    std::memcpy(m_data + m_offset, &stored, sizeof(stored));
+    m_offset += sizeof(stored);
+    std::memcpy(m_data + m_offset, text, stored);
+    m_offset += stored;
+}
+
+} // namespace BGE
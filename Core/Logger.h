@@ -1,11 +1,24 @@
 #pragma once
 
-#include <string>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
 #include <memory>
+#include <mutex>
 #include <sstream>
-#include <chrono>
-#include <iomanip>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+// Levels below this are compiled out of the BGE_LOG_* macros entirely (0 = TRACE ... 5 = CRITICAL)
+#ifndef BGE_LOG_MIN_LEVEL
+    #define BGE_LOG_MIN_LEVEL 0
+#endif
 
 namespace BGE {
 
@@ -18,6 +31,27 @@ enum class LogLevel {
     CRITICAL = 5
 };
 
+struct LoggerStats {
+    uint64_t messagesQueued = 0;
+    uint64_t messagesWritten = 0;
+    uint64_t messagesDropped = 0;   // queue was full (TRACE and DEBUG only)
+    uint64_t messagesOverflowed = 0; // too large for a queue slot, moved through the heap
+};
+
+// Logger with an asynchronous writer.
+//
+// Callers copy their record into a fixed-size slot of a bounded lock-free
+// multi-producer queue; a background thread formats the records and writes
+// them to the console and log file in batches. The BGE_LOG_* macros check the
+// level before their arguments are evaluated, so disabled levels cost one
+// relaxed load. The BGE_LOG_*_FMT macros go further and defer formatting to
+// the writer thread: arguments are stored in binary and substituted into the
+// "{}" placeholders of the format string, which must be a string literal.
+//
+// Before Initialize() and after Shutdown() records are written synchronously.
+// When the queue is full TRACE and DEBUG records are dropped (and counted)
+// while INFO and above wait for space; CRITICAL returns only once the record
+// has been written.
 class Logger {
 public:
     static Logger& Instance();
@@ -25,39 +59,198 @@ public:
     void Initialize(const std::string& logFilePath = "", LogLevel level = LogLevel::INFO);
     void Shutdown();
     
-    void Log(LogLevel level, const std::string& category, const std::string& message);
+    void Log(LogLevel level, std::string_view category, std::string_view message);
+    
+    // Deferred formatting; format must outlive the logger (a string literal)
+    template<typename... Args>
+    void Logf(LogLevel level, std::string_view category, const char* format, const Args&... args);
+    
+    void Trace(std::string_view category, std::string_view message);
+    void Debug(std::string_view category, std::string_view message);
+    void Info(std::string_view category, std::string_view message);
+    void Warning(std::string_view category, std::string_view message);
+    void Error(std::string_view category, std::string_view message);
+    void Critical(std::string_view category, std::string_view message);
+    
+    static bool IsEnabled(LogLevel level) {
+        return static_cast<int>(level) >= s_logLevel.load(std::memory_order_relaxed);
+    }
+    void SetLogLevel(LogLevel level) { s_logLevel.store(static_cast<int>(level), std::memory_order_relaxed); }
+    LogLevel GetLogLevel() const { return static_cast<LogLevel>(s_logLevel.load(std::memory_order_relaxed)); }
     
-    void Trace(const std::string& category, const std::string& message);
-    void Debug(const std::string& category, const std::string& message);
-    void Info(const std::string& category, const std::string& message);
-    void Warning(const std::string& category, const std::string& message);
-    void Error(const std::string& category, const std::string& message);
-    void Critical(const std::string& category, const std::string& message);
+    void EnableConsoleOutput(bool enable) { m_consoleOutput.store(enable, std::memory_order_relaxed); }
+    void EnableFileOutput(bool enable) { m_fileOutput.store(enable, std::memory_order_relaxed); }
     
-    void SetLogLevel(LogLevel level) { m_logLevel = level; }
-    LogLevel GetLogLevel() const { return m_logLevel; }
+    // Blocks until everything queued so far has been written
+    void Flush();
     
-    void EnableConsoleOutput(bool enable) { m_consoleOutput = enable; }
-    void EnableFileOutput(bool enable) { m_fileOutput = enable; }
+    LoggerStats GetStats() const;
     
+    static constexpr size_t QUEUE_CAPACITY = 4096;     // slots, power of two
+    static constexpr size_t PAYLOAD_SIZE = 208;        // category + message or encoded arguments
+    static constexpr size_t MAX_CATEGORY_LENGTH = 63;
+
 private:
-    Logger() = default;
-    ~Logger() = default;
+    // Tags for the binary argument encoding used by Logf
+    enum class ArgType : uint8_t {
+        Bool, Char, Int, UInt, Double, String, Pointer
+    };
+    
+    // One queue slot. sequence follows Vyukov's bounded queue: it equals the
+    // slot's position when free and position + 1 once a producer published it.
+    struct alignas(64) LogRecord {
+        std::atomic<uint64_t> sequence{0};
+        int64_t timestamp = 0;              // system_clock nanoseconds
+        const char* format = nullptr;       // nullptr for plain text
+        std::string* overflow = nullptr;    // message that did not fit the payload
+        LogLevel level = LogLevel::INFO;
+        uint16_t size = 0;
+        char payload[PAYLOAD_SIZE];         // [category length][category][message or arguments]
+    };
+    
+    // Appends tagged arguments to a record payload, stopping at the first one that does not fit
+    class ArgEncoder {
+    public:
+        ArgEncoder(char* data, size_t offset) : m_data(data), m_offset(offset) {}
+        
+        template<typename T>
+        void Encode(const T& value);
+        size_t GetSize() const { return m_offset; }
     
-    std::string GetTimestamp();
-    std::string LogLevelToString(LogLevel level);
+    private:
+        bool Put(ArgType type, const void* bytes, size_t count);
+        void PutString(const char* text, size_t length);
+        
+        char* m_data;
+        size_t m_offset;
+        bool m_full = false;
+    };
     
-    LogLevel m_logLevel = LogLevel::INFO;
-    bool m_consoleOutput = true;
-    bool m_fileOutput = false;
+    Logger();
+    ~Logger();
+    
+    LogRecord* BeginRecord(LogLevel level, std::string_view category, uint64_t& position);
+    void CommitRecord(LogRecord* record, uint64_t position);
+    
+    void WriterThread();
+    size_t Drain();
+    void FormatRecord(const LogRecord& record, std::string& out);
+    void WriteLine(LogLevel level, const std::string& line, std::string& stdoutBatch, std::string& fileBatch);
+    void WriteBatches(const std::string& stdoutBatch, const std::string& fileBatch);
+    void AppendTimestamp(int64_t timestamp, std::string& out);
+    static const char* LogLevelToString(LogLevel level);
+    static int64_t Now();
+    
+    static std::atomic<int> s_logLevel;
+    
+    std::atomic<bool> m_consoleOutput{true};
+    std::atomic<bool> m_fileOutput{false};
     std::unique_ptr<std::ofstream> m_logFile;
+    
+    // Queue; producers claim slots by position, the writer consumes them in order
+    std::unique_ptr<LogRecord[]> m_records;
+    alignas(64) std::atomic<uint64_t> m_enqueuePos{0};
+    alignas(64) std::atomic<uint64_t> m_dequeuePos{0};
+    alignas(64) std::atomic<uint32_t> m_activeProducers{0}; // between the m_running check and commit
+    
+    std::thread m_writer;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_writerIdle{false};
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_drained;
+    
+    // Guards the log file and the cached timestamp; held by whichever thread is writing
+    std::mutex m_outputMutex;
+    int64_t m_cachedSecond = -1;
+    char m_cachedTimestamp[32] = {};
+    
+    std::atomic<uint64_t> m_queued{0};
+    std::atomic<uint64_t> m_written{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_overflowed{0};
+    uint64_t m_reportedDropped = 0;         // writer thread only
 };
 
-#define BGE_LOG_TRACE(category, message) BGE::Logger::Instance().Trace(category, message)
-#define BGE_LOG_DEBUG(category, message) BGE::Logger::Instance().Debug(category, message)
-#define BGE_LOG_INFO(category, message) BGE::Logger::Instance().Info(category, message)
-#define BGE_LOG_WARNING(category, message) BGE::Logger::Instance().Warning(category, message)
-#define BGE_LOG_ERROR(category, message) BGE::Logger::Instance().Error(category, message)
-#define BGE_LOG_CRITICAL(category, message) BGE::Logger::Instance().Critical(category, message)
+template<typename T>
+void Logger::ArgEncoder::Encode(const T& value) {
+    using Type = std::decay_t<T>;
+    if constexpr (std::is_same_v<Type, bool>) {
+        uint8_t byte = value ? 1 : 0;
+        Put(ArgType::Bool, &byte, 1);
+    } else if constexpr (std::is_same_v<Type, char>) {
+        Put(ArgType::Char, &value, 1);
+    } else if constexpr (std::is_enum_v<Type>) {
+        int64_t number = static_cast<int64_t>(value);
+        Put(ArgType::Int, &number, sizeof(number));
+    } else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+        int64_t number = value;
+        Put(ArgType::Int, &number, sizeof(number));
+    } else if constexpr (std::is_integral_v<Type>) {
+        uint64_t number = value;
+        Put(ArgType::UInt, &number, sizeof(number));
+    } else if constexpr (std::is_floating_point_v<Type>) {
+        double number = value;
+        Put(ArgType::Double, &number, sizeof(number));
+    } else if constexpr (std::is_array_v<T>) {
+        PutString(value, std::strlen(value));
+    } else if constexpr (std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>) {
+        const char* text = value ? value : "(null)";
+        PutString(text, std::strlen(text));
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        std::string_view text = value;
+        PutString(text.data(), text.size());
+    } else if constexpr (std::is_pointer_v<Type>) {
+        uint64_t address = reinterpret_cast<uintptr_t>(value);
+        Put(ArgType::Pointer, &address, sizeof(address));
+    } else {
+        static_assert(sizeof(Type) == 0, "Unsupported argument type for deferred log formatting");
+    }
+}
+
+template<typename... Args>
+void Logger::Logf(LogLevel level, std::string_view category, const char* format, const Args&... args) {
+    uint64_t position = 0;
+    LogRecord* record = BeginRecord(level, category, position);
+    if (!record) {
+        return;
+    }
+    
+    ArgEncoder encoder(record->payload, record->size);
+    (encoder.Encode(args), ...);
+    record->format = format;
+    record->size = static_cast<uint16_t>(encoder.GetSize());
+    CommitRecord(record, position);
+}
+
+} // namespace BGE
+
+// The message expression is only evaluated when the level is enabled
+#define BGE_LOG_AT(level, category, message) \
+    do { \
+        if (static_cast<int>(level) >= BGE_LOG_MIN_LEVEL && ::BGE::Logger::IsEnabled(level)) { \
+            ::BGE::Logger::Instance().Log(level, category, message); \
+        } \
+    } while (0)
+
+// Deferred formatting: BGE_LOG_INFO_FMT("World", "Size {}x{}", width, height)
+#define BGE_LOG_FMT_AT(level, category, ...) \
+    do { \
+        if (static_cast<int>(level) >= BGE_LOG_MIN_LEVEL && ::BGE::Logger::IsEnabled(level)) { \
+            ::BGE::Logger::Instance().Logf(level, category, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define BGE_LOG_TRACE(category, message) BGE_LOG_AT(::BGE::LogLevel::TRACE, category, message)
+#define BGE_LOG_DEBUG(category, message) BGE_LOG_AT(::BGE::LogLevel::DEBUG, category, message)
+#define BGE_LOG_INFO(category, message) BGE_LOG_AT(::BGE::LogLevel::INFO, category, message)
+#define BGE_LOG_WARNING(category, message) BGE_LOG_AT(::BGE::LogLevel::WARNING, category, message)
+#define BGE_LOG_ERROR(category, message) BGE_LOG_AT(::BGE::LogLevel::ERROR, category, message)
+#define BGE_LOG_CRITICAL(category, message) BGE_LOG_AT(::BGE::LogLevel::CRITICAL, category, message)
 
-} // namespace BGE
\ No newline at end of file
+#define BGE_LOG_TRACE_FMT(category, ...) BGE_LOG_FMT_AT(::BGE::LogLevel::TRACE, category, __VA_ARGS__)
+#define BGE_LOG_DEBUG_FMT(category, ...) BGE_LOG_FMT_AT(::BGE::LogLevel::DEBUG, category, __VA_ARGS__)
+#define BGE_LOG_INFO_FMT(category, ...) BGE_LOG_FMT_AT(::BGE::LogLevel::INFO, category, __VA_ARGS__)
+#define BGE_LOG_WARNING_FMT(category, ...) BGE_LOG_FMT_AT(::BGE::LogLevel::WARNING, category, __VA_ARGS__)
+#define BGE_LOG_ERROR_FMT(category, ...) BGE_LOG_FMT_AT(::BGE::LogLevel::ERROR, category, __VA_ARGS__)
+#define BGE_LOG_CRITICAL_FMT(category, ...) BGE_LOG_FMT_AT(::BGE::LogLevel::CRITICAL, category, __VA_ARGS__)
@@ -0,0 +1,131 @@
+#include "MathBatch.h"
+
+namespace BGE {
+
+namespace MathBatch {
+
+void TransformPoints(const Matrix4& matrix, const Vector3* points, Vector3* out, size_t count) {
+#if defined(BGE_SIMD_SSE)
+    const __m128 c0 = _mm_loadu_ps(matrix.m);
+    const __m128 c1 = _mm_loadu_ps(matrix.m + 4);
+    const __m128 c2 = _mm_loadu_ps(matrix.m + 8);
+    const __m128 c3 = _mm_loadu_ps(matrix.m + 12);
+    
+    for (size_t i = 0; i < count; ++i) {
+        __m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(points[i].x)), c3);
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(points[i].y)));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(points[i].z)));
+        
+        // Vector3 is 12 bytes, so store xy + z rather than a full 16-byte write
+        _mm_storel_pi(reinterpret_cast<__m64*>(&out[i].x), r);
+        _mm_store_ss(&out[i].z, _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 2, 2)));
+    }
+#else
+    const float* m = matrix.m;
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3 p = points[i];
+        out[i] = Vector3(
+            m[0] * p.x + m[4] * p.y + m[8]  * p.z + m[12],
+            m[1] * p.x + m[5] * p.y + m[9]  * p.z + m[13],
+            m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]
+        );
+    }
+#endif
+}
+
+void TransformPoints2D(const Matrix4& matrix, const Vector2* points, Vector2* out, size_t count) {
+    const float* m = matrix.m;
+    size_t i = 0;
+
+#if defined(BGE_SIMD_SSE)
+    // Two points per iteration: (x0, y0, x1, y1)
+    const __m128 c0 = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+    const __m128 c1 = _mm_setr_ps(m[4], m[5], m[4], m[5]);
+    const __m128 t = _mm_setr_ps(m[12], m[13], m[12], m[13]);
+    
+    for (; i + 2 <= count; i += 2) {
+        __m128 p = _mm_loadu_ps(&points[i].x);
+        __m128 xs = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 ys = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, xs), _mm_mul_ps(c1, ys)), t);
+        _mm_storeu_ps(&out[i].x, r);
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const Vector2 p = points[i];
+        out[i] = Vector2(m[0] * p.x + m[4] * p.y + m[12],
+                         m[1] * p.x + m[5] * p.y + m[13]);
+    }
+}
+
+void MultiplyMatrices(const Matrix4* lhs, const Matrix4* rhs, Matrix4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        SIMD::Mat4Mul(lhs[i].m, rhs[i].m, out[i].m);
+    }
+}
+
+void MultiplyMatrices(const Matrix4& lhs, const Matrix4* rhs, Matrix4* out, size_t count) {
+#if defined(BGE_SIMD_SSE)
+    // Keep the shared left-hand columns in registers across the whole batch
+    const __m128 a0 = _mm_loadu_ps(lhs.m);
+    const __m128 a1 = _mm_loadu_ps(lhs.m + 4);
+    const __m128 a2 = _mm_loadu_ps(lhs.m + 8);
+    const __m128 a3 = _mm_loadu_ps(lhs.m + 12);
+    
+    for (size_t i = 0; i < count; ++i) {
+        const float* b = rhs[i].m;
+        float* dst = out[i].m;
+        for (int j = 0; j < 4; ++j) {
+            __m128 col = _mm_loadu_ps(b + j * 4);
+            __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(col, col, _MM_SHUFFLE(0, 0, 0, 0)));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_shuffle_ps(col, col, _MM_SHUFFLE(1, 1, 1, 1))));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_shuffle_ps(col, col, _MM_SHUFFLE(2, 2, 2, 2))));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_shuffle_ps(col, col, _MM_SHUFFLE(3, 3, 3, 3))));
+            _mm_storeu_ps(dst + j * 4, r);
+        }
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        SIMD::Mat4MulScalar(lhs.m, rhs[i].m, out[i].m);
+    }
+#endif
+}
+
+void ComposeTRS(const Vector3* positions, const Quaternion* rotations, const Vector3* scales,
+                Matrix4* out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const Quaternion& q = rotations[i];
+        const Vector3& s = scales[i];
+        const Vector3& p = positions[i];
+        float* m = out[i].m;
+        
+        float x2 = q.x * q.x, y2 = q.y * q.y, z2 = q.z * q.z;
+        float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+        
+        m[0]  = (1.0f - 2.0f * (y2 + z2)) * s.x;
+        m[1]  = 2.0f * (xy + wz) * s.x;
+        m[2]  = 2.0f * (xz - wy) * s.x;
+        m[3]  = 0.0f;
+        
+        m[4]  = 2.0f * (xy - wz) * s.y;
+        m[5]  = (1.0f - 2.0f * (x2 + z2)) * s.y;
+        m[6]  = 2.0f * (yz + wx) * s.y;
+        m[7]  = 0.0f;
+        
+        m[8]  = 2.0f * (xz + wy) * s.z;
+        m[9]  = 2.0f * (yz - wx) * s.z;
+        m[10] = (1.0f - 2.0f * (x2 + y2)) * s.z;
+        m[11] = 0.0f;
+        
+        m[12] = p.x;
+        m[13] = p.y;
+        m[14] = p.z;
+        m[15] = 1.0f;
+    }
+}
+
+} // namespace MathBatch
+
+} // namespace BGE
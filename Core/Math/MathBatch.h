@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Matrix4.h"
+#include "Quaternion.h"
+#include <cstddef>
+
+namespace BGE {
+
+// Batch math entry points for loops over many matrices or points. Nothing in the
+// engine calls these yet; TransformSystem recomputes only dirty nodes, each against its
+// own parent, so it stays on the per-matrix operators. Inputs and outputs may not alias
+// unless noted.
+namespace MathBatch {
+    // out[i] = matrix * (points[i], 1); affine, no perspective divide. In-place allowed.
+    void TransformPoints(const Matrix4& matrix, const Vector3* points, Vector3* out, size_t count);
+    void TransformPoints2D(const Matrix4& matrix, const Vector2* points, Vector2* out, size_t count);
+    
+    // out[i] = lhs[i] * rhs[i]
+    void MultiplyMatrices(const Matrix4* lhs, const Matrix4* rhs, Matrix4* out, size_t count);
+    
+    // out[i] = lhs * rhs[i] (e.g. parent world * child locals)
+    void MultiplyMatrices(const Matrix4& lhs, const Matrix4* rhs, Matrix4* out, size_t count);
+    
+    // out[i] = TRS(positions[i], rotations[i], scales[i])
+    void ComposeTRS(const Vector3* positions, const Quaternion* rotations, const Vector3* scales,
+                    Matrix4* out, size_t count);
+}
+
+} // namespace BGE
@@ -7,6 +7,18 @@ Matrix4 Matrix4::Rotation(const Quaternion& q) {
     return q.ToMatrix();
 }
 
+Matrix4 Matrix4::TRS(const Vector3& position, const Quaternion& rotation, const Vector3& scale) {
+    // Rotation columns scaled per axis, translation in the last column
+    Matrix4 mat = rotation.ToMatrix();
+    mat.m[0] *= scale.x; mat.m[1] *= scale.x; mat.m[2]  *= scale.x;
+    mat.m[4] *= scale.y; mat.m[5] *= scale.y; mat.m[6]  *= scale.y;
+    mat.m[8] *= scale.z; mat.m[9] *= scale.z; mat.m[10] *= scale.z;
+    mat.m[12] = position.x;
+    mat.m[13] = position.y;
+    mat.m[14] = position.z;
+    return mat;
+}
+
 void Matrix4::Decompose(Vector3& translation, Quaternion& rotation, Vector3& scale) const {
     // Extract translation
     translation = GetTranslation();
@@ -0,0 +1,219 @@
+#pragma once
+
+// SIMD backend selection for the math library.
+// Define BGE_MATH_FORCE_SCALAR to disable intrinsics entirely.
+#if !defined(BGE_MATH_FORCE_SCALAR)
+    #if defined(__AVX__)
+        #define BGE_SIMD_AVX 1
+    #endif
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define BGE_SIMD_SSE 1
+    #endif
+#endif
+
+#if defined(BGE_SIMD_AVX)
+    #include <immintrin.h>
+#elif defined(BGE_SIMD_SSE)
+    #include <emmintrin.h>
+#endif
+
+namespace BGE {
+
+namespace SIMD {
+    inline const char* GetBackendName() {
+#if defined(BGE_SIMD_AVX)
+        return "AVX";
+#elif defined(BGE_SIMD_SSE)
+        return "SSE2";
+#else
+        return "Scalar";
+#endif
+    }
+    
+    // Scalar reference kernels (always available, used as fallback and for validation)
+    // All matrices are 16 floats in column-major order.
+    inline void Mat4MulScalar(const float* a, const float* b, float* out) {
+        for (int j = 0; j < 4; ++j) {
+            for (int i = 0; i < 4; ++i) {
+                out[i + j * 4] = a[i] * b[j * 4] + a[i + 4] * b[1 + j * 4] +
+                                 a[i + 8] * b[2 + j * 4] + a[i + 12] * b[3 + j * 4];
+            }
+        }
+    }
+    
+    // General inverse via cross products of the column vectors (Lengyel).
+    // Returns false (and leaves out untouched) for singular matrices.
+    inline bool Mat4InverseScalar(const float* m, float* out) {
+        const float a[3] = { m[0], m[1], m[2] };
+        const float b[3] = { m[4], m[5], m[6] };
+        const float c[3] = { m[8], m[9], m[10] };
+        const float d[3] = { m[12], m[13], m[14] };
+        const float x = m[3], y = m[7], z = m[11], w = m[15];
+        
+        auto cross = [](const float* p, const float* q, float* r) {
+            r[0] = p[1] * q[2] - p[2] * q[1];
+            r[1] = p[2] * q[0] - p[0] * q[2];
+            r[2] = p[0] * q[1] - p[1] * q[0];
+        };
+        auto dot = [](const float* p, const float* q) {
+            return p[0] * q[0] + p[1] * q[1] + p[2] * q[2];
+        };
+        
+        float s[3], t[3], u[3], v[3];
+        cross(a, b, s);
+        cross(c, d, t);
+        for (int i = 0; i < 3; ++i) {
+            u[i] = a[i] * y - b[i] * x;
+            v[i] = c[i] * w - d[i] * z;
+        }
+        
+        float det = dot(s, v) + dot(t, u);
+        if (det == 0.0f) {
+            return false;
+        }
+        
+        float invDet = 1.0f / det;
+        for (int i = 0; i < 3; ++i) {
+            s[i] *= invDet; t[i] *= invDet; u[i] *= invDet; v[i] *= invDet;
+        }
+        
+        // r0..r3 are the rows of the inverse
+        float r0[3], r1[3], r2[3], r3[3];
+        cross(b, v, r0);
+        cross(v, a, r1);
+        cross(d, u, r2);
+        cross(u, c, r3);
+        for (int i = 0; i < 3; ++i) {
+            r0[i] += t[i] * y;
+            r1[i] -= t[i] * x;
+            r2[i] += s[i] * w;
+            r3[i] -= s[i] * z;
+        }
+        
+        out[0] = r0[0]; out[4] = r0[1]; out[8]  = r0[2]; out[12] = -dot(b, t);
+        out[1] = r1[0]; out[5] = r1[1]; out[9]  = r1[2]; out[13] =  dot(a, t);
+        out[2] = r2[0]; out[6] = r2[1]; out[10] = r2[2]; out[14] = -dot(d, s);
+        out[3] = r3[0]; out[7] = r3[1]; out[11] = r3[2]; out[15] =  dot(c, s);
+        return true;
+    }
+
+#if defined(BGE_SIMD_SSE)
+    // Broadcast lane i of v
+    #define BGE_SIMD_SPLAT(v, i) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(i, i, i, i))
+    
+    // out = a * b (column j of the result is a linear combination of a's columns)
+    inline void Mat4Mul(const float* a, const float* b, float* out) {
+#if defined(BGE_SIMD_AVX)
+        // Two result columns per iteration: each 128-bit half works on one column
+        __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+        __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+        __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+        __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+        
+        for (int j = 0; j < 4; j += 2) {
+            __m256 cols = _mm256_loadu_ps(b + j * 4);
+            __m256 r = _mm256_mul_ps(a0, _mm256_shuffle_ps(cols, cols, _MM_SHUFFLE(0, 0, 0, 0)));
+            r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_shuffle_ps(cols, cols, _MM_SHUFFLE(1, 1, 1, 1))));
+            r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_shuffle_ps(cols, cols, _MM_SHUFFLE(2, 2, 2, 2))));
+            r = _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_shuffle_ps(cols, cols, _MM_SHUFFLE(3, 3, 3, 3))));
+            _mm256_storeu_ps(out + j * 4, r);
+        }
+#else
+        __m128 a0 = _mm_loadu_ps(a);
+        __m128 a1 = _mm_loadu_ps(a + 4);
+        __m128 a2 = _mm_loadu_ps(a + 8);
+        __m128 a3 = _mm_loadu_ps(a + 12);
+        
+        for (int j = 0; j < 4; ++j) {
+            __m128 col = _mm_loadu_ps(b + j * 4);
+            __m128 r = _mm_mul_ps(a0, BGE_SIMD_SPLAT(col, 0));
+            r = _mm_add_ps(r, _mm_mul_ps(a1, BGE_SIMD_SPLAT(col, 1)));
+            r = _mm_add_ps(r, _mm_mul_ps(a2, BGE_SIMD_SPLAT(col, 2)));
+            r = _mm_add_ps(r, _mm_mul_ps(a3, BGE_SIMD_SPLAT(col, 3)));
+            _mm_storeu_ps(out + j * 4, r);
+        }
+#endif
+    }
+    
+    // 3-lane cross product (lane 3 is zero when both inputs have lane 3 == 0)
+    inline __m128 Cross3(__m128 p, __m128 q) {
+        __m128 pYZX = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 qYZX = _mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 r = _mm_sub_ps(_mm_mul_ps(p, qYZX), _mm_mul_ps(pYZX, q));
+        return _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+    
+    // Horizontal sum of lanes 0..2, broadcast to all lanes
+    inline __m128 Dot3(__m128 p, __m128 q) {
+        __m128 m = _mm_mul_ps(p, q);
+        __m128 sum = _mm_add_ps(BGE_SIMD_SPLAT(m, 0), BGE_SIMD_SPLAT(m, 1));
+        return _mm_add_ps(sum, BGE_SIMD_SPLAT(m, 2));
+    }
+    
+    // Same algorithm as Mat4InverseScalar with the 3D column vectors in SSE registers
+    inline bool Mat4Inverse(const float* m, float* out) {
+        const __m128 mask3 = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        __m128 colA = _mm_loadu_ps(m);
+        __m128 colB = _mm_loadu_ps(m + 4);
+        __m128 colC = _mm_loadu_ps(m + 8);
+        __m128 colD = _mm_loadu_ps(m + 12);
+        
+        __m128 x = BGE_SIMD_SPLAT(colA, 3);
+        __m128 y = BGE_SIMD_SPLAT(colB, 3);
+        __m128 z = BGE_SIMD_SPLAT(colC, 3);
+        __m128 w = BGE_SIMD_SPLAT(colD, 3);
+        
+        __m128 a = _mm_and_ps(colA, mask3);
+        __m128 b = _mm_and_ps(colB, mask3);
+        __m128 c = _mm_and_ps(colC, mask3);
+        __m128 d = _mm_and_ps(colD, mask3);
+        
+        __m128 s = Cross3(a, b);
+        __m128 t = Cross3(c, d);
+        __m128 u = _mm_sub_ps(_mm_mul_ps(a, y), _mm_mul_ps(b, x));
+        __m128 v = _mm_sub_ps(_mm_mul_ps(c, w), _mm_mul_ps(d, z));
+        
+        __m128 det = _mm_add_ps(Dot3(s, v), Dot3(t, u));
+        if (_mm_cvtss_f32(det) == 0.0f) {
+            return false;
+        }
+        
+        __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+        s = _mm_mul_ps(s, invDet);
+        t = _mm_mul_ps(t, invDet);
+        u = _mm_mul_ps(u, invDet);
+        v = _mm_mul_ps(v, invDet);
+        
+        __m128 r0 = _mm_add_ps(Cross3(b, v), _mm_mul_ps(t, y));
+        __m128 r1 = _mm_sub_ps(Cross3(v, a), _mm_mul_ps(t, x));
+        __m128 r2 = _mm_add_ps(Cross3(d, u), _mm_mul_ps(s, w));
+        __m128 r3 = _mm_sub_ps(Cross3(u, c), _mm_mul_ps(s, z));
+        
+        // Place the translation-row terms in lane 3 of each row
+        const __m128 zero = _mm_setzero_ps();
+        __m128 w0 = _mm_sub_ps(zero, Dot3(b, t));
+        __m128 w1 = Dot3(a, t);
+        __m128 w2 = _mm_sub_ps(zero, Dot3(d, s));
+        __m128 w3 = Dot3(c, s);
+        r0 = _mm_or_ps(r0, _mm_andnot_ps(mask3, w0));
+        r1 = _mm_or_ps(r1, _mm_andnot_ps(mask3, w1));
+        r2 = _mm_or_ps(r2, _mm_andnot_ps(mask3, w2));
+        r3 = _mm_or_ps(r3, _mm_andnot_ps(mask3, w3));
+        
+        // Rows -> columns
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(out, r0);
+        _mm_storeu_ps(out + 4, r1);
+        _mm_storeu_ps(out + 8, r2);
+        _mm_storeu_ps(out + 12, r3);
+        return true;
+    }
+    
+    #undef BGE_SIMD_SPLAT
+#else
+    inline void Mat4Mul(const float* a, const float* b, float* out) { Mat4MulScalar(a, b, out); }
+    inline bool Mat4Inverse(const float* m, float* out) { return Mat4InverseScalar(m, out); }
+#endif
+}
+
+} // namespace BGE
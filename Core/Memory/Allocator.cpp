@@ -1,4 +1,5 @@
 #include "Allocator.h"
+#include <cstdint>
 #include <cstdlib>
 
 namespace BGE {
@@ -12,7 +13,13 @@ LinearAllocator::~LinearAllocator() {
 }
 
 void* LinearAllocator::Allocate(size_t size, size_t alignment) {
-    size_t aligned_offset = AlignForward(m_offset, alignment);
+    if (!m_memory) {
+        return nullptr;
+    }
+    
+    // Align the address rather than the offset, so alignments above malloc's are honoured
+    uintptr_t base = reinterpret_cast<uintptr_t>(m_memory);
+    size_t aligned_offset = AlignForward(base + m_offset, alignment) - base;
     
     if (aligned_offset + size > m_size) {
         return nullptr; // Out of memory
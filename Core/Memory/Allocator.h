@@ -21,6 +21,9 @@ public:
     explicit LinearAllocator(size_t size);
     ~LinearAllocator();
     
+    LinearAllocator(const LinearAllocator&) = delete;
+    LinearAllocator& operator=(const LinearAllocator&) = delete;
+    
     void* Allocate(size_t size, size_t alignment = sizeof(void*)) override;
     void Deallocate(void* ptr) override; // No-op for linear allocator
     void Reset() override;
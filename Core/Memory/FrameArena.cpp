@@ -0,0 +1,199 @@
+#include "FrameArena.h"
+#include "../ECS/ECSConfig.h"
+#include "../Logger.h"
+#include "../Profiling/Profiler.h"
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+namespace BGE {
+
+namespace {
+
+struct ArenaRegistry {
+    std::mutex mutex;
+    // Arenas outlive their threads so stats stay readable; a new thread reuses a retired one
+    std::vector<std::unique_ptr<FrameArena>> arenas;
+};
+
+ArenaRegistry& GetRegistry() {
+    static ArenaRegistry registry;
+    return registry;
+}
+
+} // anonymous namespace
+
+// Hands the thread's arena back to the registry when the thread exits
+struct FrameArenaThread {
+    FrameArena* arena = nullptr;
+    
+    ~FrameArenaThread() {
+        if (!arena) return;
+        std::lock_guard<std::mutex> lock(GetRegistry().mutex);
+        if (arena->m_live.load(std::memory_order_acquire) == 0) {
+            arena->ReleaseBlocks();
+        }
+        arena->m_retired = true;
+    }
+};
+
+namespace {
+
+thread_local FrameArenaThread t_arenaThread;
+
+} // anonymous namespace
+
+FrameArena& FrameArena::Get() {
+    if (t_arenaThread.arena) {
+        return *t_arenaThread.arena;
+    }
+    
+    ArenaRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& arena : registry.arenas) {
+        if (arena->m_retired && arena->m_live.load(std::memory_order_acquire) == 0) {
+            arena->m_retired = false;
+            arena->m_mainThread = false;
+            arena->m_blockSize = WORKER_BLOCK_SIZE;
+            arena->ReleaseBlocks();
+            t_arenaThread.arena = arena.get();
+            return *arena;
+        }
+    }
+    
+    registry.arenas.push_back(std::unique_ptr<FrameArena>(new FrameArena(static_cast<uint32_t>(registry.arenas.size()))));
+    t_arenaThread.arena = registry.arenas.back().get();
+    return *t_arenaThread.arena;
+}
+
+void FrameArena::SetMainThread() {
+    FrameArena& arena = Get();
+    arena.m_mainThread = true;
+    arena.m_blockSize = std::max(ECSConfig::Instance().arenaAllocatorSize, WORKER_BLOCK_SIZE);
+}
+
+void FrameArena::EndFrame() {
+    FrameArena& frameArena = Get();
+    if (frameArena.m_live.load(std::memory_order_acquire) == 0) {
+        frameArena.Rewind();
+    } else if (!frameArena.m_warnedHeld) {
+        frameArena.m_warnedHeld = true;
+        BGE_LOG_WARNING("FrameArena", std::to_string(frameArena.GetLiveAllocations()) +
+                        " frame allocations are still alive at the end of the frame");
+    }
+    
+    size_t peakBytes = 0;
+    size_t allocations = 0;
+    size_t capacity = 0;
+    size_t heapBlocks = 0;
+    {
+        ArenaRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto& arena : registry.arenas) {
+            peakBytes += arena->m_framePeak.exchange(arena->GetUsedBytes(), std::memory_order_relaxed);
+            allocations += arena->m_frameAllocations.exchange(0, std::memory_order_relaxed);
+            capacity += arena->GetCapacity();
+            heapBlocks += arena->m_heapBlocks.load(std::memory_order_relaxed);
+        }
+    }
+    
+    Profiler& profiler = Profiler::Instance();
+    profiler.RecordCounter("Frame arena peak (KB)", static_cast<double>(peakBytes) / 1024.0);
+    profiler.RecordCounter("Frame arena allocations", static_cast<double>(allocations));
+    profiler.RecordCounter("Frame arena capacity (KB)", static_cast<double>(capacity) / 1024.0);
+    profiler.RecordCounter("Frame arena heap blocks", static_cast<double>(heapBlocks));
+}
+
+void FrameArena::GetStats(std::vector<FrameArenaStats>& out) {
+    out.clear();
+    ArenaRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& arena : registry.arenas) {
+        FrameArenaStats stats;
+        stats.arenaIndex = arena->m_index;
+        stats.mainThread = arena->m_mainThread;
+        stats.capacity = arena->GetCapacity();
+        stats.peakBytes = arena->m_framePeak.load(std::memory_order_relaxed);
+        stats.allocations = arena->m_frameAllocations.load(std::memory_order_relaxed);
+        stats.liveAllocations = arena->GetLiveAllocations();
+        stats.heapBlocks = arena->m_heapBlocks.load(std::memory_order_relaxed);
+        out.push_back(stats);
+    }
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    // Everything handed out so far is gone: start over instead of growing
+    if (m_live.load(std::memory_order_acquire) == 0 && GetUsedBytes() != 0) {
+        Rewind();
+    }
+    
+    void* ptr = m_blocks.empty() ? nullptr : m_blocks[m_current]->Allocate(bytes, alignment);
+    if (!ptr) {
+        ptr = AllocateFromNewBlock(bytes, alignment);
+    }
+    
+    size_t used = m_usedBefore + m_blocks[m_current]->GetTotalAllocated();
+    m_usedBytes.store(used, std::memory_order_relaxed);
+    m_live.fetch_add(1, std::memory_order_relaxed);
+    m_frameAllocations.fetch_add(1, std::memory_order_relaxed);
+    
+    size_t peak = m_framePeak.load(std::memory_order_relaxed);
+    while (used > peak && !m_framePeak.compare_exchange_weak(peak, used, std::memory_order_relaxed)) {
+    }
+    return ptr;
+}
+
+void FrameArena::do_deallocate(void* ptr, size_t bytes, size_t alignment) {
+    (void)ptr;
+    (void)bytes;
+    (void)alignment;
+    m_live.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void* FrameArena::AllocateFromNewBlock(size_t bytes, size_t alignment) {
+    if (!m_blocks.empty()) {
+        m_usedBefore += m_blocks[m_current]->GetTotalAllocated();
+    }
+    
+    size_t blockSize = std::max(m_blockSize, bytes + alignment);
+    m_blocks.push_back(std::make_unique<LinearAllocator>(blockSize));
+    m_current = m_blocks.size() - 1;
+    m_capacity.fetch_add(blockSize, std::memory_order_relaxed);
+    m_heapBlocks.fetch_add(1, std::memory_order_relaxed);
+    
+    void* ptr = m_blocks[m_current]->Allocate(bytes, alignment);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void FrameArena::Rewind() {
+    if (m_blocks.size() > 1) {
+        // The frame overflowed: one block as large as all of them, so the next one fits
+        size_t total = 0;
+        for (const auto& block : m_blocks) {
+            total += block->GetTotalSize();
+        }
+        ReleaseBlocks();
+        m_blocks.push_back(std::make_unique<LinearAllocator>(total));
+        m_capacity.store(total, std::memory_order_relaxed);
+        m_heapBlocks.fetch_add(1, std::memory_order_relaxed);
+    } else if (!m_blocks.empty()) {
+        m_blocks.front()->Reset();
+    }
+    
+    m_current = 0;
+    m_usedBefore = 0;
+    m_usedBytes.store(0, std::memory_order_relaxed);
+}
+
+void FrameArena::ReleaseBlocks() {
+    m_blocks.clear();
+    m_current = 0;
+    m_usedBefore = 0;
+    m_usedBytes.store(0, std::memory_order_relaxed);
+    m_capacity.store(0, std::memory_order_relaxed);
+}
+
+} // namespace BGE
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Allocator.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace BGE {
+
+struct FrameArenaStats {
+    uint32_t arenaIndex = 0;
+    bool mainThread = false;
+    size_t capacity = 0;            // bytes held in blocks
+    size_t peakBytes = 0;           // most in use at once during the last frame
+    size_t allocations = 0;         // during the last frame
+    size_t liveAllocations = 0;
+    size_t heapBlocks = 0;          // blocks taken from the heap since the arena was created
+};
+
+// Per-thread bump allocator for temporaries that die within the frame.
+//
+// Get() returns the calling thread's arena. Allocating is a pointer bump in
+// the current block, with no lock and no heap call once the arena has grown
+// to the frame's needs. The arena is a std::pmr::memory_resource, so STL
+// containers use it as FrameVector / FrameString. Deallocating only counts:
+// as soon as nothing allocated from an arena is alive, its next allocation
+// starts over at the beginning, and blocks added because the frame
+// overflowed are merged into one so the next frame fits without growing.
+// EndFrame(), run on FrameEndEvent, rewinds the frame loop's arena and
+// reports the frame's allocation statistics to the profiler.
+//
+// Memory from the arena must not be kept past the frame. A container must
+// allocate on the thread that created it, but may be destroyed anywhere.
+class FrameArena : public std::pmr::memory_resource {
+public:
+    // The calling thread's arena
+    static FrameArena& Get();
+    static std::pmr::memory_resource* Resource() { return &Get(); }
+    
+    // Marks the calling thread as the frame loop's; its first block is ECSConfig::arenaAllocatorSize
+    static void SetMainThread();
+    // Frame boundary, on the frame loop's thread
+    static void EndFrame();
+    
+    static void GetStats(std::vector<FrameArenaStats>& out);
+    
+    size_t GetUsedBytes() const { return m_usedBytes.load(std::memory_order_relaxed); }
+    size_t GetCapacity() const { return m_capacity.load(std::memory_order_relaxed); }
+    size_t GetLiveAllocations() const { return m_live.load(std::memory_order_relaxed); }
+    
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+    
+    static constexpr size_t WORKER_BLOCK_SIZE = 256 * 1024;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    friend struct FrameArenaThread;
+    
+    explicit FrameArena(uint32_t index) : m_index(index) {}
+    
+    void* AllocateFromNewBlock(size_t bytes, size_t alignment);
+    void Rewind();
+    void ReleaseBlocks();
+    
+    // Owned by the arena's thread
+    std::vector<std::unique_ptr<LinearAllocator>> m_blocks;
+    size_t m_current = 0;               // block being bumped
+    size_t m_usedBefore = 0;            // bytes used in the blocks before m_current
+    size_t m_blockSize = WORKER_BLOCK_SIZE;
+    bool m_warnedHeld = false;
+    
+    // Read by EndFrame() and GetStats() from the frame loop's thread
+    const uint32_t m_index;
+    bool m_mainThread = false;
+    bool m_retired = false;             // its thread exited; guarded by the registry mutex
+    std::atomic<size_t> m_live{0};      // allocations not yet deallocated, from any thread
+    std::atomic<size_t> m_usedBytes{0};
+    std::atomic<size_t> m_capacity{0};
+    std::atomic<size_t> m_framePeak{0};
+    std::atomic<size_t> m_frameAllocations{0};
+    std::atomic<size_t> m_heapBlocks{0};
+};
+
+// Containers for frame temporaries: FrameVector<EntityID> ids(FrameArena::Resource());
+template<typename T>
+using FrameVector = std::pmr::vector<T>;
+using FrameString = std::pmr::string;
+
+} // namespace BGE
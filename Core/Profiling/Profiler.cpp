@@ -0,0 +1,299 @@
+#include "Profiler.h"
+#include "../Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace BGE {
+
+std::atomic<bool> Profiler::s_enabled{true};
+
+namespace {
+
+thread_local void* t_threadBuffer = nullptr;
+
+const std::chrono::steady_clock::time_point& Epoch() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return epoch;
+}
+
+void WriteJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(*c));
+                    out << escaped;
+                } else {
+                    out << *c;
+                }
+        }
+    }
+    out << '"';
+}
+
+} // anonymous namespace
+
+Profiler& Profiler::Instance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() {
+    Epoch();
+}
+
+uint64_t Profiler::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - Epoch()).count());
+}
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+    if (t_threadBuffer) {
+        return static_cast<ThreadBuffer*>(t_threadBuffer);
+    }
+    
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->ring.resize(RING_CAPACITY);
+    
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    buffer->index = static_cast<uint32_t>(m_threads.size());
+    buffer->name = "Thread " + std::to_string(buffer->index);
+    t_threadBuffer = buffer.get();
+    m_threads.push_back(std::move(buffer));
+    return static_cast<ThreadBuffer*>(t_threadBuffer);
+}
+
+uint32_t Profiler::EnterZone() {
+    return Instance().GetThreadBuffer()->depth++;
+}
+
+void Profiler::LeaveZone(const char* name, uint64_t start, uint32_t depth) {
+    uint64_t end = Now();
+    ThreadBuffer* buffer = Instance().GetThreadBuffer();
+    buffer->depth = depth;
+    
+    // Single writer: publish the slot after filling it
+    uint64_t slot = buffer->written.load(std::memory_order_relaxed);
+    ProfileZone& zone = buffer->ring[slot % RING_CAPACITY];
+    zone.name = name;
+    zone.start = start;
+    zone.end = end;
+    zone.threadIndex = buffer->index;
+    zone.depth = depth;
+    buffer->written.store(slot + 1, std::memory_order_release);
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+    ThreadBuffer* buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    buffer->name = name;
+}
+
+std::string Profiler::GetThreadName(uint32_t threadIndex) const {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    return threadIndex < m_threads.size() ? m_threads[threadIndex]->name : std::string();
+}
+
+uint32_t Profiler::GetThreadCount() const {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    return static_cast<uint32_t>(m_threads.size());
+}
+
+const char* Profiler::InternName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_namesMutex);
+    return m_names.insert(name).first->c_str();
+}
+
+ProfilerStats Profiler::GetStats() const {
+    ProfilerStats stats;
+    stats.zonesRecorded = m_zonesRecorded.load(std::memory_order_relaxed);
+    stats.zonesDropped = m_zonesDropped.load(std::memory_order_relaxed);
+    stats.threadCount = GetThreadCount();
+    return stats;
+}
+
+void Profiler::BeginFrame() {
+    // Recycle the oldest frame's storage when the history is full
+    if (m_history.size() >= m_historySize && !m_history.empty()) {
+        m_current.zones = std::move(m_history.back().zones);
+        m_history.pop_back();
+    }
+    m_current.zones.clear();
+    m_current.counters.clear();
+    m_current.frameIndex = m_frameCounter++;
+    m_current.threadIndex = GetThreadBuffer()->index;
+    m_current.start = Now();
+    m_inFrame = true;
+}
+
+void Profiler::EndFrame() {
+    if (!m_inFrame) return;
+    m_inFrame = false;
+    m_current.end = Now();
+    
+    Collect(m_current);
+    
+    if (m_capturing) {
+        m_captured.push_back(m_current);
+        if (m_captured.size() >= m_captureLimit) {
+            EndCapture();
+        }
+    }
+    
+    m_history.push_front(std::move(m_current));
+    m_current = ProfileFrame();
+}
+
+void Profiler::RecordCounter(const char* name, double value) {
+    if (!IsEnabled()) return;
+    
+    ProfileCounter counter{name, Now(), value};
+    if (m_inFrame) {
+        m_current.counters.push_back(counter);
+        return;
+    }
+    if (m_history.empty()) return;
+    
+    // Frame-end samples (e.g. from FrameEndEvent) describe the frame that just ended
+    ProfileFrame& last = m_history.front();
+    last.counters.push_back(counter);
+    if (!m_captured.empty() && m_captured.back().frameIndex == last.frameIndex) {
+        m_captured.back().counters.push_back(counter);
+    }
+}
+
+void Profiler::Collect(ProfileFrame& frame) {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    for (auto& buffer : m_threads) {
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t read = buffer->read;
+        if (written - read > RING_CAPACITY) {
+            m_zonesDropped.fetch_add(written - read - RING_CAPACITY, std::memory_order_relaxed);
+            read = written - RING_CAPACITY;
+        }
+        
+        size_t first = frame.zones.size();
+        for (uint64_t i = read; i < written; ++i) {
+            frame.zones.push_back(buffer->ring[i % RING_CAPACITY]);
+        }
+        
+        // The owner kept writing while we copied: anything it may have wrapped over is unreliable
+        uint64_t after = buffer->written.load(std::memory_order_acquire);
+        if (after - read > RING_CAPACITY) {
+            uint64_t unreliable = std::min<uint64_t>(after - read - RING_CAPACITY, written - read);
+            frame.zones.erase(frame.zones.begin() + first, frame.zones.begin() + first + unreliable);
+            m_zonesDropped.fetch_add(unreliable, std::memory_order_relaxed);
+        }
+        
+        // Zones are written when they close, so parents follow their children; order by start
+        std::sort(frame.zones.begin() + first, frame.zones.end(), [](const ProfileZone& a, const ProfileZone& b) {
+            return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+        });
+        
+        m_zonesRecorded.fetch_add(written - read, std::memory_order_relaxed);
+        buffer->read = written;
+    }
+}
+
+const ProfileFrame* Profiler::GetFrame(size_t framesAgo) const {
+    return framesAgo < m_history.size() ? &m_history[framesAgo] : nullptr;
+}
+
+void Profiler::SetHistorySize(size_t frames) {
+    m_historySize = std::max<size_t>(frames, 1);
+    while (m_history.size() > m_historySize) {
+        m_history.pop_back();
+    }
+}
+
+void Profiler::BeginCapture(size_t maxFrames) {
+    m_captured.clear();
+    m_captureLimit = std::max<size_t>(maxFrames, 1);
+    m_capturing = true;
+    BGE_LOG_INFO("Profiler", "Capture started (up to " + std::to_string(m_captureLimit) + " frames)");
+}
+
+void Profiler::EndCapture() {
+    if (!m_capturing) return;
+    m_capturing = false;
+    BGE_LOG_INFO("Profiler", "Capture stopped with " + std::to_string(m_captured.size()) + " frames");
+}
+
+bool Profiler::ExportChromeTrace(const std::string& filePath) const {
+    std::ofstream out(filePath, std::ios::binary);
+    if (!out) {
+        BGE_LOG_ERROR("Profiler", "Failed to open trace file: " + filePath);
+        return false;
+    }
+    
+    // Oldest frame first
+    std::vector<const ProfileFrame*> frames;
+    if (!m_captured.empty()) {
+        for (const ProfileFrame& frame : m_captured) frames.push_back(&frame);
+    } else {
+        for (auto it = m_history.rbegin(); it != m_history.rend(); ++it) frames.push_back(&*it);
+    }
+    
+    // Timestamps are microseconds in the trace_event format
+    char number[64];
+    auto micros = [&number](uint64_t nanoseconds) {
+        std::snprintf(number, sizeof(number), "%.3f", static_cast<double>(nanoseconds) / 1000.0);
+        return number;
+    };
+    
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&out, &first]() {
+        if (!first) out << ",\n";
+        first = false;
+    };
+    
+    uint32_t threadCount = GetThreadCount();
+    for (uint32_t thread = 0; thread < threadCount; ++thread) {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":";
+        WriteJsonString(out, GetThreadName(thread).c_str());
+        out << "}}";
+    }
+    
+    for (const ProfileFrame* frame : frames) {
+        separator();
+        out << "{\"name\":\"Frame " << frame->frameIndex << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":" << frame->threadIndex
+            << ",\"ts\":" << micros(frame->start);
+        out << ",\"dur\":" << micros(frame->end - frame->start) << "}";
+        
+        for (const ProfileZone& zone : frame->zones) {
+            separator();
+            out << "{\"name\":";
+            WriteJsonString(out, zone.name);
+            out << ",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":" << zone.threadIndex << ",\"ts\":" << micros(zone.start);
+            out << ",\"dur\":" << micros(zone.end - zone.start) << "}";
+        }
+        
+        for (const ProfileCounter& counter : frame->counters) {
+            separator();
+            out << "{\"name\":";
+            WriteJsonString(out, counter.name);
+            out << ",\"cat\":\"counter\",\"ph\":\"C\",\"pid\":1,\"ts\":" << micros(counter.time);
+            out << ",\"args\":{\"value\":" << counter.value << "}}";
+        }
+    }
+    out << "\n]}\n";
+    
+    if (!out) {
+        BGE_LOG_ERROR("Profiler", "Failed to write trace file: " + filePath);
+        return false;
+    }
+    BGE_LOG_INFO("Profiler", "Exported " + std::to_string(frames.size()) + " frames to " + filePath);
+    return true;
+}
+
+} // namespace BGE
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace BGE {
+
+// One timed scope. Times are nanoseconds since the profiler started.
+struct ProfileZone {
+    const char* name = nullptr;     // static or interned, outlives the profiler data
+    uint64_t start = 0;
+    uint64_t end = 0;
+    uint32_t threadIndex = 0;
+    uint32_t depth = 0;             // nesting level on its thread
+};
+
+// A sampled value, such as memory in use, drawn as a counter track in the trace
+struct ProfileCounter {
+    const char* name = nullptr;     // static or interned, like zone names
+    uint64_t time = 0;
+    double value = 0.0;
+};
+
+struct ProfileFrame {
+    uint64_t frameIndex = 0;
+    uint64_t start = 0;
+    uint64_t end = 0;
+    uint32_t threadIndex = 0;       // thread that ran the frame loop
+    std::vector<ProfileZone> zones; // grouped by thread, ordered by start time
+    std::vector<ProfileCounter> counters;
+    
+    double GetDurationMs() const { return static_cast<double>(end - start) / 1.0e6; }
+};
+
+struct ProfilerStats {
+    uint64_t zonesRecorded = 0;
+    uint64_t zonesDropped = 0;      // overwritten before the frame collected them
+    uint32_t threadCount = 0;
+};
+
+// Frame profiler with hierarchical scoped zones.
+//
+// Zones are written by their own thread into a fixed-size ring buffer, with no
+// locks on the recording path. EndFrame() (main thread) drains every thread's
+// ring into the frame history; while a capture is running, frames are also
+// kept for export as Chrome trace_event JSON (chrome://tracing, Perfetto).
+// History and capture accessors are meant for the main thread.
+class Profiler {
+public:
+    static Profiler& Instance();
+    
+    static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    void SetEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+    
+    // Frame boundaries; EndFrame() collects the zones recorded since the last call
+    void BeginFrame();
+    void EndFrame();
+    
+    // Recent frames, 0 = most recently completed
+    size_t GetFrameCount() const { return m_history.size(); }
+    const ProfileFrame* GetFrame(size_t framesAgo) const;
+    void SetHistorySize(size_t frames);
+    
+    // Capture a run of frames for export
+    void BeginCapture(size_t maxFrames = DEFAULT_CAPTURE_FRAMES);
+    void EndCapture();
+    bool IsCapturing() const { return m_capturing; }
+    size_t GetCapturedFrameCount() const { return m_captured.size(); }
+    // Writes the capture, or the frame history when nothing was captured
+    bool ExportChromeTrace(const std::string& filePath) const;
+    
+    // Names the calling thread in the trace and the flame chart
+    void SetThreadName(const std::string& name);
+    std::string GetThreadName(uint32_t threadIndex) const;
+    uint32_t GetThreadCount() const;
+    
+    // Samples a counter into the current frame; between frames, into the frame that just ended.
+    // Main thread only.
+    void RecordCounter(const char* name, double value);
+    
+    // Stable storage for zone names built at runtime
+    const char* InternName(const std::string& name);
+    
+    ProfilerStats GetStats() const;
+    
+    // Nanoseconds since the profiler started
+    static uint64_t Now();
+    
+    // Recording path used by ProfileScope
+    static uint32_t EnterZone();
+    static void LeaveZone(const char* name, uint64_t start, uint32_t depth);
+    
+    static constexpr size_t RING_CAPACITY = 16384;          // zones per thread between frames
+    static constexpr size_t DEFAULT_HISTORY_FRAMES = 300;
+    static constexpr size_t DEFAULT_CAPTURE_FRAMES = 1800;
+
+private:
+    struct ThreadBuffer {
+        std::vector<ProfileZone> ring;
+        std::atomic<uint64_t> written{0};
+        uint64_t read = 0;              // owned by the collecting thread
+        uint32_t depth = 0;             // owned by the recording thread
+        uint32_t index = 0;
+        std::string name;
+    };
+    
+    Profiler();
+    ThreadBuffer* GetThreadBuffer();
+    void Collect(ProfileFrame& frame);
+    
+    static std::atomic<bool> s_enabled;
+    
+    // Buffers stay alive after their thread exits so late zones can still be read
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+    mutable std::mutex m_threadsMutex;
+    
+    std::unordered_set<std::string> m_names;
+    std::mutex m_namesMutex;
+    
+    std::deque<ProfileFrame> m_history;
+    size_t m_historySize = DEFAULT_HISTORY_FRAMES;
+    std::vector<ProfileFrame> m_captured;
+    size_t m_captureLimit = DEFAULT_CAPTURE_FRAMES;
+    bool m_capturing = false;
+    
+    ProfileFrame m_current;
+    bool m_inFrame = false;
+    uint64_t m_frameCounter = 0;
+    
+    std::atomic<uint64_t> m_zonesRecorded{0};
+    std::atomic<uint64_t> m_zonesDropped{0};
+};
+
+// Times the enclosing scope. Use through the BGE_PROFILE_* macros.
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) {
+        if (Profiler::IsEnabled()) {
+            m_name = name;
+            m_depth = Profiler::EnterZone();
+            m_start = Profiler::Now();
+        }
+    }
+    
+    ProfileScope(const std::string& name, bool /*dynamic*/) {
+        if (Profiler::IsEnabled()) {
+            m_name = Profiler::Instance().InternName(name);
+            m_depth = Profiler::EnterZone();
+            m_start = Profiler::Now();
+        }
+    }
+    
+    ~ProfileScope() {
+        if (m_name) {
+            Profiler::LeaveZone(m_name, m_start, m_depth);
+        }
+    }
+    
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name = nullptr;
+    uint64_t m_start = 0;
+    uint32_t m_depth = 0;
+};
+
+} // namespace BGE
+
+// Zones compile away entirely unless BGE_PROFILING_ENABLED is defined
+#if defined(BGE_PROFILING_ENABLED)
+    #define BGE_PROFILE_CONCAT_INNER(a, b) a##b
+    #define BGE_PROFILE_CONCAT(a, b) BGE_PROFILE_CONCAT_INNER(a, b)
+    // name must be a string literal or otherwise outlive the profiler
+    #define BGE_PROFILE_SCOPE(name) ::BGE::ProfileScope BGE_PROFILE_CONCAT(bgeProfileScope, __LINE__)(name)
+    #define BGE_PROFILE_FUNCTION() BGE_PROFILE_SCOPE(__func__)
+    // name is a std::string, interned on first use
+    #define BGE_PROFILE_SCOPE_DYNAMIC(name) ::BGE::ProfileScope BGE_PROFILE_CONCAT(bgeProfileScope, __LINE__)(name, true)
+    #define BGE_PROFILE_FRAME_BEGIN() ::BGE::Profiler::Instance().BeginFrame()
+    #define BGE_PROFILE_FRAME_END() ::BGE::Profiler::Instance().EndFrame()
+    #define BGE_PROFILE_THREAD(name) ::BGE::Profiler::Instance().SetThreadName(name)
+#else
+    #define BGE_PROFILE_SCOPE(name) ((void)0)
+    #define BGE_PROFILE_FUNCTION() ((void)0)
+    #define BGE_PROFILE_SCOPE_DYNAMIC(name) ((void)0)
+    #define BGE_PROFILE_FRAME_BEGIN() ((void)0)
+    #define BGE_PROFILE_FRAME_END() ((void)0)
+    #define BGE_PROFILE_THREAD(name) ((void)0)
+#endif
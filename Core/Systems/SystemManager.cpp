@@ -1,5 +1,6 @@
 #include "SystemManager.h"
 #include "../Logger.h"
+#include "../Profiling/Profiler.h"
 
 namespace BGE {
 
@@ -13,8 +14,10 @@ SystemManager::~SystemManager() {
 }
 
 void SystemManager::UpdateSystems(float deltaTime) {
+    BGE_PROFILE_SCOPE("SystemManager::UpdateSystems");
     for (auto& system : m_orderedSystems) {
         if (system->IsEnabled()) {
+            BGE_PROFILE_SCOPE(m_profileNames[system.get()]);
             system->Update(deltaTime);
         }
     }
@@ -34,6 +37,13 @@ void SystemManager::Clear() {
     
     m_systems.clear();
     m_orderedSystems.clear();
+    m_profileNames.clear();
+}
+
+void SystemManager::InternProfileName(const ISystem* system) {
+    // Interned once rather than every update; the profiler keeps the name
+    // alive in case the system is unregistered before a capture is exported
+    m_profileNames[system] = Profiler::Instance().InternName(system->GetName());
 }
 
 void SystemManager::SortSystemsByPriority() {
@@ -27,6 +27,7 @@ public:
         
         // Initialize the system
         system->Initialize();
+        InternProfileName(system.get());
     }
     
     // System retrieval
@@ -47,6 +48,7 @@ public:
         auto it = m_systems.find(typeId);
         if (it != m_systems.end()) {
             it->second->Shutdown();
+            m_profileNames.erase(it->second.get());
             m_systems.erase(it);
             
             // Remove from ordered list
@@ -80,9 +82,11 @@ private:
     ~SystemManager();
     
     void SortSystemsByPriority();
+    void InternProfileName(const ISystem* system);
     
     std::unordered_map<std::type_index, std::shared_ptr<ISystem>> m_systems;
     std::vector<std::shared_ptr<ISystem>> m_orderedSystems;
+    std::unordered_map<const ISystem*, const char*> m_profileNames; // Interned zone names
 };
 
 } // namespace BGE
\ No newline at end of file
@@ -1,109 +1,280 @@
 #include "TransformSystem.h"
-#include "../Entity.h"
 #include "../ECS/EntityManager.h"
-#include "../ECS/EntityQuery.h"
+#include "../Threading/ThreadPool.h"
 #include "../Logger.h"
+#include <algorithm>
 
 namespace BGE {
 
+namespace {
+
+bool SameLocalTRS(const Vector3& aPos, const Quaternion& aRot, const Vector3& aScale,
+                  const Vector3& bPos, const Quaternion& bRot, const Vector3& bScale) {
+    return aPos.x == bPos.x && aPos.y == bPos.y && aPos.z == bPos.z &&
+           aRot.x == bRot.x && aRot.y == bRot.y && aRot.z == bRot.z && aRot.w == bRot.w &&
+           aScale.x == bScale.x && aScale.y == bScale.y && aScale.z == bScale.z;
+}
+
+} // anonymous namespace
+
 void TransformSystem::Initialize() {
     BGE_LOG_INFO("TransformSystem", "Initializing Transform System");
-    CacheTransformEntities();
+    
+    CachedQueryBuilder builder(&EntityManager::Instance());
+    m_query = builder.With<TransformComponent>().Build();
+    m_hierarchyDirty = true;
 }
 
 void TransformSystem::Update(float deltaTime) {
     (void)deltaTime; // Suppress unused parameter warning
-    if (!IsEnabled()) return;
+    if (!IsEnabled() || !m_query) return;
+    
+    // Refresh component pointers; rebuild the sorted order on structural changes
+    if (GatherTransforms() || m_hierarchyDirty) {
+        RebuildHierarchy();
+    }
     
-    // Update all transform hierarchies
-    for (Entity* entity : m_transformEntities) {
-        if (!entity->IsActive()) continue;
+    // Linear pass, one depth level at a time. Nodes within a level only read
+    // their parent's (already final) world matrix, so a level can be split
+    // across worker threads.
+    for (size_t level = 0; level + 1 < m_levelOffsets.size(); ++level) {
+        size_t begin = m_levelOffsets[level];
+        size_t end = m_levelOffsets[level + 1];
         
-        TransformComponent* transform = entity->GetComponent<TransformComponent>();
-        if (!transform || transform->parent != INVALID_ENTITY) {
-            continue; // Skip if no transform or has parent (will be updated by parent)
+        if (m_threadPool && end - begin >= m_parallelThreshold) {
+            size_t grain = std::max<size_t>(256, (end - begin) / (m_threadPool->GetThreadCount() * 4 + 1));
+            size_t chunkCount = (end - begin + grain - 1) / grain;
+            m_threadPool->ParallelFor(0, chunkCount, [this, begin, end, grain](size_t chunk) {
+                size_t chunkBegin = begin + chunk * grain;
+                PropagateLevel(chunkBegin, std::min(chunkBegin + grain, end));
+            });
+        } else {
+            PropagateLevel(begin, end);
+        }
+    }
+    
+    m_changedEntities.clear();
+    for (size_t node = 0; node < m_dirty.size(); ++node) {
+        if (m_dirty[node]) {
+            m_changedEntities.push_back(m_entities[node]);
         }
-        
-        // Update root entities and their children
-        UpdateTransformHierarchy(entity);
     }
 }
 
 void TransformSystem::Shutdown() {
     BGE_LOG_INFO("TransformSystem", "Shutting down Transform System");
-    m_transformEntities.clear();
+    m_query.reset();
+    m_entities.clear();
+    m_parentNodes.clear();
+    m_parentRefs.clear();
+    m_transforms.clear();
+    m_localInputs.clear();
+    m_worldMatrices.clear();
+    m_dirty.clear();
+    m_levelOffsets.clear();
+    m_transformByEntity.clear();
+    m_nodeByEntity.clear();
+    m_gathered.clear();
+    m_changedEntities.clear();
+}
+
+void TransformSystem::GetSpatialUpdates(std::vector<SpatialUpdate>& updates) const {
+    updates.reserve(updates.size() + m_changedEntities.size());
+    for (EntityID entity : m_changedEntities) {
+        const Matrix4& world = m_worldMatrices[m_nodeByEntity[entity.GetIndex()]];
+        Vector3 translation = world.GetTranslation();
+        Vector3 scale = world.GetScale();
+        updates.push_back(SpatialUpdate{entity, Vector2(translation.x, translation.y),
+                                        Vector2(scale.x * 0.5f, scale.y * 0.5f)});
+    }
 }
 
-void TransformSystem::UpdateTransformHierarchy(Entity* entity) {
-    if (!entity) return;
+void TransformSystem::MarkDirty(EntityID entity) {
+    uint32_t index = entity.GetIndex();
+    if (index < m_nodeByEntity.size() && m_nodeByEntity[index] != NO_PARENT) {
+        m_localInputs[m_nodeByEntity[index]].valid = false;
+    }
+}
+
+bool TransformSystem::GatherTransforms() {
+    auto& archetypeManager = EntityManager::Instance().GetArchetypeManager();
+    QueryResult result = m_query->Execute();
+    
+    std::fill(m_transformByEntity.begin(), m_transformByEntity.end(), nullptr);
+    m_gathered.clear();
+    
+    // Walk matched archetypes directly so component pointers are fetched per
+    // archetype column instead of per-entity EntityManager lookups
+    for (uint32_t archetypeIdx : result.GetArchetypeIndices()) {
+        Archetype* archetype = archetypeManager.GetArchetype(archetypeIdx);
+        if (!archetype || archetype->GetEntityCount() == 0) continue;
+        
+        auto* storage = archetype->GetComponentStorage<TransformComponent>();
+        if (!storage) continue;
+        
+        const auto& entities = archetype->GetEntities();
+        size_t count = std::min(entities.size(), storage->Size());
+        for (size_t row = 0; row < count; ++row) {
+            uint32_t index = entities[row].GetIndex();
+            if (index >= m_transformByEntity.size()) {
+                m_transformByEntity.resize(index + 1, nullptr);
+            }
+            m_transformByEntity[index] = &storage->Get(row);
+            m_gathered.push_back(entities[row]);
+        }
+    }
     
-    TransformComponent* transform = entity->GetComponent<TransformComponent>();
-    if (!transform) return;
+    if (m_gathered.size() != m_entities.size()) {
+        return true;
+    }
     
-    // Calculate world transform
-    Matrix4 worldTransform = CalculateWorldTransform(transform, entity);
-    transform->worldTransform = worldTransform;
+    // Same population size: verify identity and parent references, refreshing
+    // component pointers (archetype moves invalidate them) along the way
+    for (EntityID entity : m_gathered) {
+        uint32_t index = entity.GetIndex();
+        if (index >= m_nodeByEntity.size() || m_nodeByEntity[index] == NO_PARENT) {
+            return true;
+        }
+        
+        uint32_t node = m_nodeByEntity[index];
+        TransformComponent* transform = m_transformByEntity[index];
+        if (m_entities[node] != entity || m_parentRefs[node] != transform->parent) {
+            return true;
+        }
+        
+        m_transforms[node] = transform;
+    }
     
-    // Update children
-    UpdateChildTransforms(entity, worldTransform);
+    return false;
 }
 
-Matrix4 TransformSystem::CalculateWorldTransform(const TransformComponent* transform, Entity* entity) {
-    (void)entity; // Suppress unused parameter warning
+void TransformSystem::RebuildHierarchy() {
+    const size_t count = m_gathered.size();
+    constexpr uint32_t VISITING = NO_PARENT - 1;
     
-    // Use the new GetLocalTransform method which uses 3D rotation
-    Matrix4 localTransform = transform->GetLocalTransform();
+    // Resolve parents against the gathered set; parents without a transform
+    // (or destroyed parents) make the node a root
+    std::vector<uint32_t> gatheredByEntity(m_transformByEntity.size(), NO_PARENT);
+    for (size_t i = 0; i < count; ++i) {
+        gatheredByEntity[m_gathered[i].GetIndex()] = static_cast<uint32_t>(i);
+    }
+    
+    std::vector<uint32_t> parentOf(count, NO_PARENT);
+    for (size_t i = 0; i < count; ++i) {
+        EntityID parent = m_transformByEntity[m_gathered[i].GetIndex()]->parent;
+        if (parent == INVALID_ENTITY) continue;
+        
+        uint32_t parentIndex = parent.GetIndex();
+        if (parentIndex < gatheredByEntity.size() && gatheredByEntity[parentIndex] != NO_PARENT &&
+            m_gathered[gatheredByEntity[parentIndex]] == parent) {
+            parentOf[i] = gatheredByEntity[parentIndex];
+        }
+    }
     
-    // If has parent, multiply by parent's world transform
-    if (transform->parent != INVALID_ENTITY) {
-        auto& entityManager = EntityManager::Instance();
-        TransformComponent* parentTransform = entityManager.GetComponent<TransformComponent>(transform->parent);
-        if (parentTransform) {
-            return parentTransform->worldTransform * localTransform;
+    // Compute depths iteratively (no recursion for deep hierarchies)
+    std::vector<uint32_t> depth(count, NO_PARENT);
+    std::vector<uint32_t> chain;
+    uint32_t maxDepth = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (depth[i] != NO_PARENT) continue;
+        
+        chain.clear();
+        uint32_t current = static_cast<uint32_t>(i);
+        while (true) {
+            chain.push_back(current);
+            depth[current] = VISITING;
+            
+            uint32_t parent = parentOf[current];
+            if (parent == NO_PARENT) break;
+            if (depth[parent] == VISITING) {
+                // Break the cycle at the node that closes it
+                BGE_LOG_WARNING("TransformSystem", "Cycle detected in transform hierarchy");
+                parentOf[current] = NO_PARENT;
+                break;
+            }
+            if (depth[parent] != NO_PARENT) break;
+            current = parent;
+        }
+        
+        uint32_t top = chain.back();
+        uint32_t d = parentOf[top] != NO_PARENT ? depth[parentOf[top]] + 1 : 0;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            depth[*it] = d++;
         }
+        maxDepth = std::max(maxDepth, d - 1);
+    }
+    
+    // Counting sort by depth gives parent-before-child order
+    m_levelOffsets.assign(count > 0 ? maxDepth + 2 : 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        m_levelOffsets[depth[i] + 1]++;
+    }
+    for (size_t level = 1; level < m_levelOffsets.size(); ++level) {
+        m_levelOffsets[level] += m_levelOffsets[level - 1];
+    }
+    
+    std::vector<uint32_t> nodeOf(count);
+    std::vector<size_t> cursor(m_levelOffsets.begin(), m_levelOffsets.end());
+    for (size_t i = 0; i < count; ++i) {
+        nodeOf[i] = static_cast<uint32_t>(cursor[depth[i]]++);
+    }
+    
+    m_entities.resize(count);
+    m_parentNodes.resize(count);
+    m_parentRefs.resize(count);
+    m_transforms.resize(count);
+    m_worldMatrices.resize(count);
+    m_localInputs.assign(count, LocalTRS{});
+    m_dirty.assign(count, 0);
+    m_nodeByEntity.assign(m_transformByEntity.size(), NO_PARENT);
+    
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t node = nodeOf[i];
+        TransformComponent* transform = m_transformByEntity[m_gathered[i].GetIndex()];
+        m_entities[node] = m_gathered[i];
+        m_parentNodes[node] = parentOf[i] != NO_PARENT ? nodeOf[parentOf[i]] : NO_PARENT;
+        m_parentRefs[node] = transform->parent;
+        m_transforms[node] = transform;
+        m_nodeByEntity[m_gathered[i].GetIndex()] = node;
     }
     
-    return localTransform;
+    m_hierarchyDirty = false;
+    
+    BGE_LOG_DEBUG("TransformSystem", "Rebuilt transform hierarchy: " + std::to_string(count) +
+                  " nodes, " + std::to_string(GetDepthCount()) + " levels");
 }
 
-void TransformSystem::CacheTransformEntities() {
-    m_transformEntities.clear();
-    auto& entityManager = EntityManager::Instance();
-    
-    // Query all entities with transform component and create Entity wrappers
-    EntityQuery query(&entityManager);
-    query.With<TransformComponent>().ForEach([&](EntityID id) {
-        // For compatibility, create Entity wrapper objects
-        auto entity = new Entity(id.id, entityManager.GetEntityName(id));
-        m_transformEntities.push_back(entity);
-    });
-    
-    BGE_LOG_DEBUG("TransformSystem", "Cached " + std::to_string(m_transformEntities.size()) + " transform entities");
+void TransformSystem::PropagateLevel(size_t begin, size_t end) {
+    for (size_t node = begin; node < end; ++node) {
+        m_dirty[node] = UpdateNode(node) ? 1 : 0;
+    }
 }
 
-void TransformSystem::UpdateChildTransforms(Entity* parent, const Matrix4& parentWorldTransform) {
-    if (!parent) return;
-    
-    auto& entityManager = EntityManager::Instance();
-    EntityID parentId(parent->GetID());
-    TransformComponent* parentTransform = entityManager.GetComponent<TransformComponent>(parentId);
-    if (!parentTransform) return;
+bool TransformSystem::UpdateNode(size_t node) {
+    TransformComponent* transform = m_transforms[node];
+    LocalTRS& cached = m_localInputs[node];
+    uint32_t parentNode = m_parentNodes[node];
     
-    // Update all children
-    for (EntityID childID : parentTransform->children) {
-        if (!entityManager.IsEntityValid(childID)) continue;
-        
-        TransformComponent* childTransform = entityManager.GetComponent<TransformComponent>(childID);
-        if (!childTransform) continue;
-        
-        // Calculate child's world transform using 3D rotation
-        Matrix4 childLocalTransform = childTransform->GetLocalTransform();
-        childTransform->worldTransform = parentWorldTransform * childLocalTransform;
-        
-        // Recursively update this child's children (create temporary Entity wrapper)
-        Entity tempChild(childID.id, "");
-        UpdateChildTransforms(&tempChild, childTransform->worldTransform);
+    bool parentDirty = parentNode != NO_PARENT && m_dirty[parentNode];
+    bool localDirty = !cached.valid ||
+                      !SameLocalTRS(transform->position, transform->rotation3D, transform->scale,
+                                    cached.position, cached.rotation, cached.scale);
+    if (!parentDirty && !localDirty) {
+        return false;
     }
+    
+    cached.position = transform->position;
+    cached.rotation = transform->rotation3D;
+    cached.scale = transform->scale;
+    cached.valid = true;
+    
+    Matrix4 localTransform = transform->GetLocalTransform();
+    m_worldMatrices[node] = parentNode != NO_PARENT
+        ? m_worldMatrices[parentNode] * localTransform
+        : localTransform;
+    transform->worldTransform = m_worldMatrices[node];
+    
+    return true;
 }
 
-} // namespace BGE
\ No newline at end of file
+} // namespace BGE
@@ -2,11 +2,19 @@
 
 #include "ISystem.h"
 #include "../Components.h"
+#include "../ECS/CachedEntityQuery.h"
+#include "../ECS/SpatialIndex.h"
 #include <vector>
+#include <memory>
 
 namespace BGE {
 
-// Example system that updates transform hierarchies
+class ThreadPool;
+
+// Propagates world transforms through the entity hierarchy.
+// Transforms are kept in a flat, depth-sorted (parent-before-child) order so
+// world matrices are computed in a single linear pass; only nodes whose local
+// transform changed, or whose ancestor changed, are recomputed.
 class TransformSystem : public ISystem {
 public:
     TransformSystem() = default;
@@ -24,15 +32,66 @@ public:
     std::string GetName() const override { return "TransformSystem"; }
     SystemPriority GetPriority() const override { return SystemPriority::Movement; }
     
-    // Transform-specific operations
-    void UpdateTransformHierarchy(Entity* entity);
-    Matrix4 CalculateWorldTransform(const TransformComponent* transform, Entity* entity);
+    // Optional: depth levels larger than the threshold are split across the pool
+    void SetThreadPool(ThreadPool* threadPool) { m_threadPool = threadPool; }
+    void SetParallelThreshold(size_t nodesPerLevel) { m_parallelThreshold = nodesPerLevel; }
+    
+    // Force recomputation of an entity's subtree on the next update
+    void MarkDirty(EntityID entity);
+    // Force the depth-sorted order to be rebuilt on the next update
+    void MarkHierarchyDirty() { m_hierarchyDirty = true; }
+    
+    // Statistics
+    size_t GetNodeCount() const { return m_entities.size(); }
+    size_t GetDepthCount() const { return m_levelOffsets.empty() ? 0 : m_levelOffsets.size() - 1; }
+    size_t GetLastUpdatedCount() const { return m_changedEntities.size(); }
     
+    // Entities whose world transform was recomputed during the last update
+    const std::vector<EntityID>& GetChangedEntities() const { return m_changedEntities; }
+    
+    // Change list as spatial index updates (world translation, half of world scale as extents)
+    void GetSpatialUpdates(std::vector<SpatialUpdate>& updates) const;
+
 private:
-    std::vector<Entity*> m_transformEntities;
+    // Local TRS inputs cached per node for change detection
+    struct LocalTRS {
+        Vector3 position;
+        Quaternion rotation;
+        Vector3 scale;
+        bool valid = false;
+    };
+    
+    static constexpr uint32_t NO_PARENT = UINT32_MAX;
+    
+    bool GatherTransforms();
+    void RebuildHierarchy();
+    void PropagateLevel(size_t begin, size_t end);
+    bool UpdateNode(size_t node);
+    
+    std::unique_ptr<CachedEntityQuery> m_query;
+    ThreadPool* m_threadPool = nullptr;
+    size_t m_parallelThreshold = 4096;
+    
+    // Depth-sorted node arrays (index = node)
+    std::vector<EntityID> m_entities;
+    std::vector<uint32_t> m_parentNodes;
+    std::vector<EntityID> m_parentRefs;
+    std::vector<TransformComponent*> m_transforms;
+    std::vector<LocalTRS> m_localInputs;
+    std::vector<Matrix4> m_worldMatrices;
+    std::vector<uint8_t> m_dirty;
+    
+    // m_levelOffsets[d]..m_levelOffsets[d + 1] is the node range at depth d
+    std::vector<size_t> m_levelOffsets;
+    
+    // Entity index -> component pointer / node index, refreshed every update
+    std::vector<TransformComponent*> m_transformByEntity;
+    std::vector<uint32_t> m_nodeByEntity;
+    std::vector<EntityID> m_gathered;
+    
+    std::vector<EntityID> m_changedEntities;
     
-    void CacheTransformEntities();
-    void UpdateChildTransforms(Entity* parent, const Matrix4& parentWorldTransform);
+    bool m_hierarchyDirty = true;
 };
 
-} // namespace BGE
\ No newline at end of file
+} // namespace BGE
@@ -1,4 +1,5 @@
 #include "ThreadPool.h"
+#include "../Profiling/Profiler.h"
 #include <algorithm>
 
 namespace BGE {
@@ -11,17 +12,14 @@ ThreadPool::ThreadPool(size_t numThreads) {
         if (numThreads == 0) numThreads = 4; // Fallback
     }
     
-    InitializeThreads();
+    InitializeThreads(numThreads);
 }
 
 ThreadPool::~ThreadPool() {
     Shutdown();
 }
 
-void ThreadPool::InitializeThreads() {
-    size_t numThreads = std::thread::hardware_concurrency();
-    if (numThreads == 0) numThreads = 4;
-    
+void ThreadPool::InitializeThreads(size_t numThreads) {
     for (size_t i = 0; i < numThreads; ++i) {
         m_threads.emplace_back(&ThreadPool::WorkerThread, this, i);
     }
@@ -29,6 +27,7 @@ void ThreadPool::InitializeThreads() {
 
 void ThreadPool::WorkerThread(size_t threadId) {
     t_threadId = threadId;
+    BGE_PROFILE_THREAD("Worker " + std::to_string(threadId));
     
     while (!m_shutdown.load()) {
         std::function<void()> task;
@@ -51,7 +50,10 @@ void ThreadPool::WorkerThread(size_t threadId) {
         }
         
         if (task) {
-            task();
+            {
+                BGE_PROFILE_SCOPE("ThreadPool::Task");
+                task();
+            }
             --m_activeTasks;
             ++m_completedTasks;
             m_finished.notify_all();
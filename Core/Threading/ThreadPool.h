@@ -53,7 +53,7 @@ public:
     
 private:
     void WorkerThread(size_t threadId);
-    void InitializeThreads();
+    void InitializeThreads(size_t numThreads);
     void StopAllThreads();
     
     // Thread management
@@ -0,0 +1,426 @@
+#include "HierarchyTreeModel.h"
+#include "../Components.h"
+#include "../ECS/EntityManager.h"
+#include "../Profiling/Profiler.h"
+#include <algorithm>
+#include <cctype>
+
+namespace BGE {
+
+namespace {
+
+const std::vector<EntityID> NO_CHILDREN;
+
+std::string ToLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+} // anonymous namespace
+
+void HierarchyTreeModel::Sync() {
+    auto& entityManager = EntityManager::Instance();
+    if (m_built && entityManager.GetStructureVersion() == m_structureVersion) {
+        return;
+    }
+    
+    uint64_t version = 0;
+    if (m_built && entityManager.GetStructureChanges(m_structureVersion, m_structureChanges, version)) {
+        m_structureVersion = version;
+        ApplyStructureChanges(m_structureChanges);
+    } else {
+        Rebuild();
+    }
+}
+
+void HierarchyTreeModel::Rebuild() {
+    BGE_PROFILE_SCOPE("HierarchyTreeModel::Rebuild");
+    auto& entityManager = EntityManager::Instance();
+    
+    // Read the version first: anything created during the scan then shows up as a mismatch
+    m_structureVersion = entityManager.GetStructureVersion();
+    std::vector<EntityID> entities;
+    entityManager.GetAllEntityIDs(entities);
+    
+    std::vector<EntityID> previousRoots = std::move(m_roots);
+    m_roots.clear();
+    m_nodes.clear();
+    m_searchEntries.clear();
+    m_nodes.reserve(entities.size());
+    m_searchEntries.reserve(entities.size());
+    
+    for (EntityID entity : entities) {
+        Node& node = m_nodes[entity];
+        node.parent = ReadParent(entity);
+        node.name = ReadName(entity);
+        SetSearchName(node, entity);
+    }
+    
+    // Parents that are gone leave their children at the top level
+    for (auto& [entity, node] : m_nodes) {
+        if (node.parent != INVALID_ENTITY && !m_nodes.count(node.parent)) {
+            node.parent = INVALID_ENTITY;
+        }
+    }
+    for (EntityID entity : entities) {
+        RefreshChildren(entity);
+    }
+    
+    // Roots keep the order they had, new ones follow in creation order
+    std::unordered_set<EntityID> placed;
+    for (EntityID root : previousRoots) {
+        auto it = m_nodes.find(root);
+        if (it != m_nodes.end() && it->second.parent == INVALID_ENTITY && placed.insert(root).second) {
+            m_roots.push_back(root);
+        }
+    }
+    for (EntityID entity : entities) {
+        if (m_nodes[entity].parent == INVALID_ENTITY && !placed.count(entity)) {
+            m_roots.push_back(entity);
+        }
+    }
+    
+    for (auto it = m_expanded.begin(); it != m_expanded.end();) {
+        it = m_nodes.count(*it) ? std::next(it) : m_expanded.erase(it);
+    }
+    
+    m_built = true;
+    m_filterDirty = !m_filter.empty();
+    m_rowsDirty = true;
+}
+
+void HierarchyTreeModel::Apply(const EntityHierarchyChangedEvent& event) {
+    if (!m_built) {
+        return;     // the first Sync() reads everything anyway
+    }
+    
+    EntityID entity = event.entityId;
+    auto it = m_nodes.find(entity);
+    switch (event.change) {
+        case EntityHierarchyChangedEvent::Created:
+            // Already known when a rescan ran between the change and the event
+            if (it != m_nodes.end() || !EntityManager::Instance().IsEntityValid(entity)) {
+                return;
+            }
+            AddNode(entity);
+            break;
+        
+        case EntityHierarchyChangedEvent::Destroyed:
+            if (it == m_nodes.end()) {
+                return;
+            }
+            RemoveNode(entity);
+            break;
+        
+        case EntityHierarchyChangedEvent::Reparented:
+            if (it == m_nodes.end()) {
+                return;
+            }
+            Detach(entity);
+            it->second.parent = ReadParent(entity);
+            Attach(entity);
+            break;
+        
+        case EntityHierarchyChangedEvent::Renamed:
+            if (it == m_nodes.end()) {
+                return;
+            }
+            it->second.name = ReadName(entity);
+            SetSearchName(it->second, entity);
+            break;
+    }
+    
+    m_filterDirty = !m_filter.empty();
+    m_rowsDirty = true;
+}
+
+EntityID HierarchyTreeModel::GetParent(EntityID entity) const {
+    auto it = m_nodes.find(entity);
+    return it != m_nodes.end() ? it->second.parent : INVALID_ENTITY;
+}
+
+const std::vector<EntityID>& HierarchyTreeModel::GetChildren(EntityID entity) const {
+    auto it = m_nodes.find(entity);
+    return it != m_nodes.end() ? it->second.children : NO_CHILDREN;
+}
+
+const std::string* HierarchyTreeModel::FindName(EntityID entity) const {
+    auto it = m_nodes.find(entity);
+    return it != m_nodes.end() ? &it->second.name : nullptr;
+}
+
+void HierarchyTreeModel::SetRootOrder(const std::vector<EntityID>& order) {
+    std::unordered_set<EntityID> placed;
+    std::vector<EntityID> roots;
+    roots.reserve(m_roots.size());
+    for (EntityID entity : order) {
+        auto it = m_nodes.find(entity);
+        if (it != m_nodes.end() && it->second.parent == INVALID_ENTITY && placed.insert(entity).second) {
+            roots.push_back(entity);
+        }
+    }
+    for (EntityID root : m_roots) {
+        if (!placed.count(root)) {
+            roots.push_back(root);
+        }
+    }
+    m_roots = std::move(roots);
+    m_rowsDirty = true;
+}
+
+void HierarchyTreeModel::SetExpanded(EntityID entity, bool expanded) {
+    bool changed = expanded ? m_expanded.insert(entity).second : m_expanded.erase(entity) > 0;
+    if (changed) {
+        m_rowsDirty = true;
+    }
+}
+
+void HierarchyTreeModel::SetFilter(const std::string& query) {
+    std::string filter = ToLower(query);
+    if (filter == m_filter && !m_filterDirty) {
+        return;
+    }
+    
+    // Typing more characters only narrows the previous matches
+    bool narrowing = !m_filter.empty() && !m_filterDirty && filter.find(m_filter) != std::string::npos;
+    m_filter = std::move(filter);
+    ApplyFilter(narrowing);
+}
+
+const std::vector<HierarchyRow>& HierarchyTreeModel::GetRows() {
+    if (m_filterDirty) {
+        ApplyFilter(false);
+    }
+    if (m_rowsDirty) {
+        FlattenRows();
+    }
+    return m_rows;
+}
+
+bool HierarchyTreeModel::FindRow(EntityID entity, size_t& outIndex) {
+    const auto& rows = GetRows();
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (rows[i].entity == entity) {
+            outIndex = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+EntityID HierarchyTreeModel::ReadParent(EntityID entity) const {
+    auto* transform = EntityManager::Instance().GetComponent<TransformComponent>(entity);
+    return transform ? transform->parent : INVALID_ENTITY;
+}
+
+std::string HierarchyTreeModel::ReadName(EntityID entity) const {
+    auto* nameComponent = EntityManager::Instance().GetComponent<NameComponent>(entity);
+    if (nameComponent && !nameComponent->name.empty()) {
+        return nameComponent->name;
+    }
+    return "Entity " + std::to_string(entity.id);
+}
+
+void HierarchyTreeModel::AddNode(EntityID entity) {
+    Node& node = m_nodes[entity];
+    node.parent = ReadParent(entity);
+    node.name = ReadName(entity);
+    SetSearchName(node, entity);
+    Attach(entity);
+}
+
+void HierarchyTreeModel::ApplyStructureChanges(const std::vector<EntityID>& entities) {
+    BGE_PROFILE_SCOPE("HierarchyTreeModel::ApplyStructureChanges");
+    auto& entityManager = EntityManager::Instance();
+    
+    // Entities the events already patched in or out are skipped here
+    std::vector<EntityID> added;
+    bool removed = false;
+    for (EntityID entity : entities) {
+        bool known = m_nodes.count(entity) > 0;
+        bool alive = entityManager.IsEntityValid(entity);
+        if (known && !alive) {
+            RemoveNode(entity);
+            removed = true;
+        } else if (!known && alive) {
+            Node& node = m_nodes[entity];
+            node.parent = ReadParent(entity);
+            node.name = ReadName(entity);
+            SetSearchName(node, entity);
+            added.push_back(entity);
+        }
+    }
+    if (added.empty() && !removed) {
+        return;
+    }
+    
+    // Attach once every new node exists, so children created before their
+    // parent still find it, and refresh each parent's children only once
+    std::unordered_set<EntityID> parents;
+    for (EntityID entity : added) {
+        Node& node = m_nodes[entity];
+        if (node.parent == INVALID_ENTITY || node.parent == entity || !m_nodes.count(node.parent)) {
+            node.parent = INVALID_ENTITY;
+            m_roots.push_back(entity);
+        } else {
+            parents.insert(node.parent);
+        }
+    }
+    std::unordered_set<EntityID> listed;
+    for (EntityID parent : parents) {
+        RefreshChildren(parent);
+        const auto& children = m_nodes[parent].children;
+        listed.insert(children.begin(), children.end());
+    }
+    // Children their parent's transform doesn't list yet go last, as in Attach()
+    for (EntityID entity : added) {
+        EntityID parent = m_nodes[entity].parent;
+        if (parent != INVALID_ENTITY && listed.insert(entity).second) {
+            m_nodes[parent].children.push_back(entity);
+        }
+    }
+    
+    m_filterDirty = !m_filter.empty();
+    m_rowsDirty = true;
+}
+
+void HierarchyTreeModel::RemoveNode(EntityID entity) {
+    Detach(entity);
+    
+    Node& node = m_nodes[entity];
+    for (EntityID child : node.children) {
+        auto it = m_nodes.find(child);
+        if (it != m_nodes.end()) {
+            it->second.parent = INVALID_ENTITY;
+            m_roots.push_back(child);
+        }
+    }
+    
+    // Swap the last search entry into the freed slot
+    if (node.searchSlot != NO_SEARCH_SLOT) {
+        size_t slot = node.searchSlot;
+        if (slot + 1 != m_searchEntries.size()) {
+            m_searchEntries[slot] = std::move(m_searchEntries.back());
+            m_nodes[m_searchEntries[slot].entity].searchSlot = slot;
+        }
+        m_searchEntries.pop_back();
+    }
+    
+    m_expanded.erase(entity);
+    m_nodes.erase(entity);
+}
+
+void HierarchyTreeModel::Attach(EntityID entity) {
+    Node& node = m_nodes[entity];
+    if (node.parent == INVALID_ENTITY || node.parent == entity || !m_nodes.count(node.parent)) {
+        node.parent = INVALID_ENTITY;
+        m_roots.push_back(entity);
+        return;
+    }
+    
+    RefreshChildren(node.parent);
+    auto& siblings = m_nodes[node.parent].children;
+    if (std::find(siblings.begin(), siblings.end(), entity) == siblings.end()) {
+        siblings.push_back(entity);
+    }
+}
+
+void HierarchyTreeModel::Detach(EntityID entity) {
+    EntityID parent = m_nodes[entity].parent;
+    auto parentIt = m_nodes.find(parent);
+    auto& siblings = parentIt != m_nodes.end() ? parentIt->second.children : m_roots;
+    auto position = std::find(siblings.begin(), siblings.end(), entity);
+    if (position != siblings.end()) {
+        siblings.erase(position);
+    }
+}
+
+void HierarchyTreeModel::RefreshChildren(EntityID parent) {
+    Node& node = m_nodes[parent];
+    node.children.clear();
+    
+    // The transform's list gives the sibling order; keep only children that point back
+    auto* transform = EntityManager::Instance().GetComponent<TransformComponent>(parent);
+    if (!transform) {
+        return;
+    }
+    for (EntityID child : transform->children) {
+        auto it = m_nodes.find(child);
+        if (it != m_nodes.end() && it->second.parent == parent && child != parent) {
+            node.children.push_back(child);
+        }
+    }
+}
+
+void HierarchyTreeModel::SetSearchName(Node& node, EntityID entity) {
+    if (node.searchSlot == NO_SEARCH_SLOT) {
+        node.searchSlot = m_searchEntries.size();
+        m_searchEntries.push_back({ToLower(node.name), entity});
+    } else {
+        m_searchEntries[node.searchSlot].name = ToLower(node.name);
+    }
+}
+
+void HierarchyTreeModel::ApplyFilter(bool fromPreviousMatches) {
+    BGE_PROFILE_SCOPE("HierarchyTreeModel::ApplyFilter");
+    m_matches.clear();
+    m_shown.clear();
+    m_filterDirty = false;
+    m_rowsDirty = true;
+    
+    if (m_filter.empty()) {
+        m_matchList.clear();
+        return;
+    }
+    
+    std::vector<EntityID> matchList;
+    if (fromPreviousMatches) {
+        for (EntityID entity : m_matchList) {
+            auto it = m_nodes.find(entity);
+            if (it != m_nodes.end() && m_searchEntries[it->second.searchSlot].name.find(m_filter) != std::string::npos) {
+                matchList.push_back(entity);
+            }
+        }
+    } else {
+        for (const SearchEntry& entry : m_searchEntries) {
+            if (entry.name.find(m_filter) != std::string::npos) {
+                matchList.push_back(entry.entity);
+            }
+        }
+    }
+    m_matchList = std::move(matchList);
+    
+    // A match brings the path down to it; stop at the first ancestor already shown
+    m_matches.insert(m_matchList.begin(), m_matchList.end());
+    for (EntityID entity : m_matchList) {
+        for (EntityID current = entity; current != INVALID_ENTITY && m_shown.insert(current).second;) {
+            current = m_nodes[current].parent;
+        }
+    }
+}
+
+void HierarchyTreeModel::FlattenRows() {
+    BGE_PROFILE_SCOPE("HierarchyTreeModel::FlattenRows");
+    m_rows.clear();
+    for (EntityID root : m_roots) {
+        AppendRows(root, 0);
+    }
+    m_rowsDirty = false;
+}
+
+void HierarchyTreeModel::AppendRows(EntityID entity, uint32_t depth) {
+    if (!m_filter.empty() && !m_shown.count(entity)) {
+        return;
+    }
+    
+    const Node& node = m_nodes[entity];
+    m_rows.push_back({entity, depth, !node.children.empty()});
+    if (!node.children.empty() && m_expanded.count(entity)) {
+        for (EntityID child : node.children) {
+            AppendRows(child, depth + 1);
+        }
+    }
+}
+
+} // namespace BGE
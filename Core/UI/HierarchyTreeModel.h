@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../ECS/EntityID.h"
+#include "../Events.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace BGE {
+
+// One line of the hierarchy view
+struct HierarchyRow {
+    EntityID entity;
+    uint32_t depth = 0;
+    bool hasChildren = false;
+};
+
+// The entity tree as the hierarchy panel shows it, cached between frames.
+//
+// Parents, children, display names and lower-cased search names are read
+// from the entities once, at Rebuild(), and then patched per entity from
+// EntityHierarchyChangedEvent. Sync() patches in the entities the entity
+// manager reports created or destroyed since the last sync, wherever that
+// happened, and only rescans everything when its history doesn't reach back
+// far enough (after a clear or a very large batch).
+// GetRows() flattens the expanded part of the tree (or the part matching
+// the filter) into a list the panel draws with a clipper, so a frame costs
+// the rows on screen rather than the size of the scene.
+class HierarchyTreeModel {
+public:
+    void Sync();
+    void Rebuild();
+    void Apply(const EntityHierarchyChangedEvent& event);
+    
+    bool Contains(EntityID entity) const { return m_nodes.count(entity) > 0; }
+    size_t GetEntityCount() const { return m_nodes.size(); }
+    EntityID GetParent(EntityID entity) const;
+    const std::vector<EntityID>& GetRoots() const { return m_roots; }
+    const std::vector<EntityID>& GetChildren(EntityID entity) const;
+    // Null for entities the model does not know
+    const std::string* FindName(EntityID entity) const;
+    
+    // Roots listed first keep that order; the others follow in their current order
+    void SetRootOrder(const std::vector<EntityID>& order);
+    
+    bool IsExpanded(EntityID entity) const { return m_expanded.count(entity) > 0; }
+    void SetExpanded(EntityID entity, bool expanded);
+    
+    // Case-insensitive substring filter on display names; empty shows everything.
+    // Matching entities are shown with their ancestors.
+    void SetFilter(const std::string& query);
+    bool HasFilter() const { return !m_filter.empty(); }
+    bool IsMatch(EntityID entity) const { return m_matches.count(entity) > 0; }
+    size_t GetMatchCount() const { return m_matches.size(); }
+    
+    const std::vector<HierarchyRow>& GetRows();
+    // Position of the entity's row in GetRows(), if it has one
+    bool FindRow(EntityID entity, size_t& outIndex);
+
+private:
+    static constexpr size_t NO_SEARCH_SLOT = static_cast<size_t>(-1);
+    
+    struct Node {
+        EntityID parent = INVALID_ENTITY;
+        std::vector<EntityID> children;
+        std::string name;
+        size_t searchSlot = NO_SEARCH_SLOT;
+    };
+    
+    // Lower-cased names in one array, so a filter scans contiguous strings
+    struct SearchEntry {
+        std::string name;
+        EntityID entity;
+    };
+    
+    EntityID ReadParent(EntityID entity) const;
+    std::string ReadName(EntityID entity) const;
+    void AddNode(EntityID entity);
+    void ApplyStructureChanges(const std::vector<EntityID>& entities);
+    void RemoveNode(EntityID entity);
+    void Attach(EntityID entity);
+    void Detach(EntityID entity);
+    void RefreshChildren(EntityID parent);
+    void SetSearchName(Node& node, EntityID entity);
+    void ApplyFilter(bool fromPreviousMatches);
+    void FlattenRows();
+    void AppendRows(EntityID entity, uint32_t depth);
+    
+    std::unordered_map<EntityID, Node> m_nodes;
+    std::vector<EntityID> m_roots;
+    bool m_built = false;
+    uint64_t m_structureVersion = 0;    // entity manager version the model matches
+    std::vector<EntityID> m_structureChanges;
+    
+    std::unordered_set<EntityID> m_expanded;
+    
+    std::vector<SearchEntry> m_searchEntries;
+    std::string m_filter;               // lower-cased
+    std::vector<EntityID> m_matchList;  // candidates when the next query extends this one
+    std::unordered_set<EntityID> m_matches;
+    std::unordered_set<EntityID> m_shown;   // matches and their ancestors
+    bool m_filterDirty = false;
+    
+    std::vector<HierarchyRow> m_rows;
+    bool m_rowsDirty = true;
+};
+
+} // namespace BGE
@@ -18,6 +18,7 @@
 #include "../Panels/HierarchyPanel.h"
 #include "../Panels/MaterialPalettePanel.h"
 #include "../Panels/MaterialEditorPanel.h"
+#include "../Panels/ProfilerPanel.h"
 #include "../Panels/ConsolePanel.h"
 #include "../Docking/DockingSystem.h"
 #include "../Docking/DockNode.h"
@@ -90,6 +91,10 @@ void MaterialEditorUI::Initialize(MaterialTools* tools, SimulationWorld* world)
     consolePanel->Initialize();
     docking.AddPanel(consolePanel, "bottom");
     
+    auto profilerPanel = std::make_shared<ProfilerPanel>("Profiler");
+    profilerPanel->Initialize();
+    docking.AddPanel(profilerPanel, "bottom");
+    
     // Create Project Settings panel as standalone window (not docked)
     m_projectSettingsPanel = std::make_unique<ProjectSettingsPanel>("Project Settings");
     m_projectSettingsPanel->Initialize();
@@ -3,6 +3,8 @@
 #include "../../../Renderer/Renderer.h"
 #include "../../Events.h"
 #include "../../Services.h"
+#include "../../ConfigManager.h"
+#include "../../../Simulation/SimulationWorld.h"
 #include "ProjectSettingsPanel.h"
 #include <imgui.h>
 #include <imgui_internal.h>
@@ -11,6 +13,7 @@
 #include <fstream>
 #include <filesystem>
 #include <unordered_map>
+#include <unordered_set>
 #include <cctype>
 #include <ctime>
 
@@ -46,20 +49,22 @@ void AssetBrowserPanel::Initialize() {
     m_assetManager = ServiceLocator::Instance().GetService<AssetManager>().get();
     m_iconManager = &IconManager::Instance();
     
+    std::string cachePath = ConfigManager::Instance().GetString("assets.cache_path", "AssetCache/");
+    m_thumbnails.Initialize((fs::path(cachePath) / "Thumbnails").string(), m_assetManager);
+    
     RegisterEventListeners();
     RefreshCurrentDirectory();
 }
 
 void AssetBrowserPanel::RegisterEventListeners() {
     if (m_eventBus) {
-        m_eventBus->Subscribe<AssetReloadedEvent>([this](const AssetReloadedEvent& event) {
-            OnAssetReloaded(event);
-        });
+        m_eventSubscriptions.emplace_back(m_eventBus,
+            m_eventBus->Subscribe<AssetReloadedEvent, &AssetBrowserPanel::OnAssetReloaded>(this));
     }
 }
 
 void AssetBrowserPanel::UnregisterEventListeners() {
-    // Event bus handles cleanup automatically in destructor
+    m_eventSubscriptions.clear();
 }
 
 void AssetBrowserPanel::OnAssetReloaded(const AssetReloadedEvent& event) {
@@ -74,6 +79,7 @@ void AssetBrowserPanel::OnAssetReloaded(const AssetReloadedEvent& event) {
 
 void AssetBrowserPanel::OnRender() {
     CheckFileSystemChanges();
+    m_thumbnails.Update();
     
     // Handle keyboard shortcuts
     HandleKeyboardShortcuts();
@@ -268,7 +274,8 @@ void AssetBrowserPanel::RenderLeftPanel() {
 }
 
 void AssetBrowserPanel::RenderDirectoryTree(const std::string& path, int depth) {
-    if (!fs::exists(path) || !fs::is_directory(path)) {
+    std::vector<std::string> subdirectories;
+    if (!GetSubdirectories(path, subdirectories)) {
         return;
     }
     
@@ -283,18 +290,7 @@ void AssetBrowserPanel::RenderDirectoryTree(const std::string& path, int depth)
         flags |= ImGuiTreeNodeFlags_Selected;
     }
     
-    bool hasSubdirs = false;
-    try {
-        for (const auto& entry : fs::directory_iterator(path)) {
-            if (entry.is_directory()) {
-                hasSubdirs = true;
-                break;
-            }
-        }
-    } catch (...) {
-        // Ignore errors
-    }
-    
+    bool hasSubdirs = !subdirectories.empty();
     if (!hasSubdirs) {
         flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
     }
@@ -306,20 +302,45 @@ void AssetBrowserPanel::RenderDirectoryTree(const std::string& path, int depth)
     }
     
     if (nodeOpen && hasSubdirs) {
-        try {
-            for (const auto& entry : fs::directory_iterator(path)) {
-                if (entry.is_directory()) {
-                    RenderDirectoryTree(entry.path().string(), depth + 1);
-                }
-            }
-        } catch (...) {
-            // Ignore errors
+        for (const std::string& subdirectory : subdirectories) {
+            RenderDirectoryTree(subdirectory, depth + 1);
         }
         
-        if (hasSubdirs) {
-            ImGui::TreePop();
+        ImGui::TreePop();
+    }
+}
+
+bool AssetBrowserPanel::GetSubdirectories(const std::string& path, std::vector<std::string>& subdirectories) const {
+    subdirectories.clear();
+    
+    // The registry's index answers this without touching the disk, which matters when it runs every frame
+    if (m_assetManager) {
+        const AssetDatabase& database = m_assetManager->GetRegistry().GetDatabase();
+        std::string key = fs::path(path).make_preferred().string();
+        if (!database.Find(key)) {
+            return false;
+        }
+        for (const std::string& child : database.GetChildren(key)) {
+            const AssetRecord* record = database.Find(child);
+            if (record && record->isDirectory) {
+                subdirectories.push_back(child);
+            }
+        }
+    } else {
+        std::error_code ec;
+        if (!fs::is_directory(path, ec)) {
+            return false;
+        }
+        for (fs::directory_iterator it(path, ec), end; !ec && it != end; it.increment(ec)) {
+            std::error_code typeError;
+            if (it->is_directory(typeError)) {
+                subdirectories.push_back(it->path().string());
+            }
         }
     }
+    
+    std::sort(subdirectories.begin(), subdirectories.end());
+    return true;
 }
 
 void AssetBrowserPanel::RenderMainPanel() {
@@ -376,7 +397,7 @@ void AssetBrowserPanel::RenderAssetGrid() {
     
     // Use a table for better control over layout
     if (ImGui::BeginTable("AssetGrid", maxColumns, ImGuiTableFlags_NoHostExtendX)) {
-        
+    
         int currentColumn = 0;
         for (const auto& asset : m_currentAssets) {
             // Filter out .meta files unless explicitly shown
@@ -450,11 +471,16 @@ void AssetBrowserPanel::RenderAssetIcon(const AssetInfo& asset, const ImVec2& ic
                 projectSettings->RestoreThumbnailFromPath(asset.handle, asset.path);
             }
         }
-        
-        // If no individual thumbnail, check for type-based thumbnail
-        if (customThumbnailId == 0) {
-            customThumbnailId = projectSettings->GetAssetTypeThumbnailTexture(asset.type);
-        }
+    }
+    
+    // Generated preview, requested only once the icon scrolls into view; the type icon shows until it is ready
+    if (customThumbnailId == 0 && !asset.isDirectory && ImGui::IsRectVisible(iconSize)) {
+        customThumbnailId = m_thumbnails.GetThumbnail(asset.path, asset.type);
+    }
+    
+    // If no individual thumbnail or preview, check for type-based thumbnail
+    if (customThumbnailId == 0 && projectSettings) {
+        customThumbnailId = projectSettings->GetAssetTypeThumbnailTexture(asset.type);
     }
     
     if (customThumbnailId != 0) {
@@ -826,6 +852,14 @@ void AssetBrowserPanel::RenderAssetMenuContent() {
         DuplicateAsset(m_selectedAssetsForMenu[0]);
     }
     
+    // Scenes have no image of their own; their preview is a snapshot of the world
+    if (!isMultiSelection && GetAssetType(m_selectedAssetsForMenu[0]) == AssetType::Scene) {
+        auto world = Services::GetWorld();
+        if (ImGui::MenuItem("Capture Thumbnail From World", nullptr, false, world != nullptr)) {
+            m_thumbnails.CaptureSceneSnapshot(m_selectedAssetsForMenu[0], *world);
+        }
+    }
+    
     ImGui::Separator();
     
     // Delete
@@ -863,31 +897,34 @@ void AssetBrowserPanel::ScanDirectory(const std::string& path) {
         return;
     }
     
-    try {
-        for (const auto& entry : fs::directory_iterator(path)) {
-            AssetInfo assetInfo;
-            assetInfo.path = entry.path().string();
-            assetInfo.name = entry.path().filename().string();
-            assetInfo.isDirectory = entry.is_directory();
-            assetInfo.lastModified = entry.last_write_time();
-            
-            if (!assetInfo.isDirectory) {
-                assetInfo.extension = entry.path().extension().string();
-                assetInfo.type = GetAssetType(assetInfo.path);
-                assetInfo.fileSize = entry.file_size();
+    // The index leaves out .meta files, so showing them needs a real directory listing
+    if (!m_assetManager || m_showMetaFiles || !ListIndexedDirectory(path)) {
+        try {
+            for (const auto& entry : fs::directory_iterator(path)) {
+                AssetInfo assetInfo;
+                assetInfo.path = entry.path().string();
+                assetInfo.name = entry.path().filename().string();
+                assetInfo.isDirectory = entry.is_directory();
+                assetInfo.lastModified = entry.last_write_time();
                 
-                // Get asset handle from registry
-                if (m_assetManager) {
-                    assetInfo.handle = m_assetManager->GetRegistry().GetAssetHandle(assetInfo.path);
+                if (!assetInfo.isDirectory) {
+                    assetInfo.extension = entry.path().extension().string();
+                    assetInfo.type = GetAssetType(assetInfo.path);
+                    assetInfo.fileSize = entry.file_size();
+                    
+                    // Get asset handle from registry
+                    if (m_assetManager) {
+                        assetInfo.handle = m_assetManager->GetRegistry().GetAssetHandle(assetInfo.path);
+                    }
+                } else {
+                    assetInfo.type = AssetType::Folder;
                 }
-            } else {
-                assetInfo.type = AssetType::Folder;
+                
+                m_currentAssets.push_back(assetInfo);
             }
-            
-            m_currentAssets.push_back(assetInfo);
+        } catch (const std::exception& e) {
+            std::cerr << "Error scanning directory " << path << ": " << e.what() << std::endl;
         }
-    } catch (const std::exception& e) {
-        std::cerr << "Error scanning directory " << path << ": " << e.what() << std::endl;
     }
     
     // Sort assets (directories first)
@@ -900,6 +937,52 @@ void AssetBrowserPanel::ScanDirectory(const std::string& path) {
         });
 }
 
+bool AssetBrowserPanel::ListIndexedDirectory(const std::string& path) {
+    AssetRegistry& registry = m_assetManager->GetRegistry();
+    std::string key = fs::path(path).make_preferred().string();
+    
+    // A folder's timestamp changes whenever an entry is added, removed or renamed, so one stat
+    // tells whether the index is still accurate; if not, only this folder is rescanned
+    std::error_code ec;
+    int64_t modified = AssetDatabase::ToTicks(fs::last_write_time(key, ec));
+    if (ec) {
+        return false;
+    }
+    
+    const AssetRecord* folder = registry.GetDatabase().Find(key);
+    if (!folder || folder->modified != modified) {
+        registry.RefreshAsset(key);
+        if (!registry.GetDatabase().Find(key)) {
+            return false;   // outside the assets directory
+        }
+    }
+    
+    const AssetDatabase& database = registry.GetDatabase();
+    for (const std::string& child : database.GetChildren(key)) {
+        const AssetRecord* record = database.Find(child);
+        if (!record) {
+            continue;
+        }
+        
+        AssetInfo assetInfo;
+        assetInfo.path = child;
+        assetInfo.name = fs::path(child).filename().string();
+        assetInfo.isDirectory = record->isDirectory;
+        assetInfo.lastModified = AssetDatabase::FromTicks(record->modified);
+        assetInfo.fileSize = static_cast<size_t>(record->size);
+        if (!assetInfo.isDirectory) {
+            assetInfo.extension = fs::path(child).extension().string();
+            assetInfo.type = record->type;
+            assetInfo.handle = record->handle;
+        } else {
+            assetInfo.type = AssetType::Folder;
+        }
+        
+        m_currentAssets.push_back(assetInfo);
+    }
+    return true;
+}
+
 AssetType AssetBrowserPanel::GetAssetType(const std::string& path) const {
     if (m_assetManager) {
         return m_assetManager->GetRegistry().GetAssetType(
@@ -1160,6 +1243,8 @@ bool AssetBrowserPanel::RenameAsset(const std::string& oldPath, const std::strin
         fs::rename(oldPath, newPath);
         
         if (m_assetManager) {
+            // Drop the old path first, or it would keep the handle the .meta file carried over
+            m_assetManager->GetRegistry().RefreshAsset(oldPath);
             m_assetManager->GetRegistry().RefreshAsset(newPath);
             
             // Get new asset handle after renaming
@@ -1272,6 +1357,7 @@ bool AssetBrowserPanel::MoveAsset(const std::string& srcPath, const std::string&
         fs::rename(srcPath, newPath);
         
         if (m_assetManager) {
+            m_assetManager->GetRegistry().RefreshAsset(srcPath);
             m_assetManager->GetRegistry().RefreshAsset(newPath);
             
             // Get new asset handle after moving
@@ -1306,26 +1392,23 @@ std::string AssetBrowserPanel::GenerateUniqueAssetNameGlobally(const std::string
     std::string candidateName = baseName;
     int counter = 1;
     
-    // Check entire assets directory recursively
-    while (true) {
-        bool nameExists = false;
-        
+    // Every name in the project, from the registry's index when there is one
+    std::unordered_set<std::string> existingNames;
+    if (m_assetManager) {
+        for (const auto& [path, record] : m_assetManager->GetRegistry().GetDatabase().GetRecords()) {
+            existingNames.insert(fs::path(path).filename().string());
+        }
+    } else {
         try {
             for (const auto& entry : fs::recursive_directory_iterator(m_assetsDirectory)) {
-                if (entry.path().filename().string() == candidateName) {
-                    nameExists = true;
-                    break;
-                }
+                existingNames.insert(entry.path().filename().string());
             }
         } catch (const std::exception& e) {
             std::cerr << "Error checking for duplicate names: " << e.what() << std::endl;
-            break;
         }
-        
-        if (!nameExists) {
-            break;
-        }
-        
+    }
+    
+    while (existingNames.count(candidateName)) {
         // Generate next candidate name
         candidateName = stem + " " + std::to_string(counter) + extension;
         counter++;
@@ -1409,6 +1492,9 @@ void AssetBrowserPanel::NotifyAssetSystemOfChanges(const std::string& assetPath,
     if (m_assetManager) {
         m_assetManager->GetRegistry().RefreshAsset(assetPath);
     }
+    if (operation == "deleted") {
+        m_thumbnails.Invalidate(assetPath);
+    }
     
     // Broadcast event for UI updates
     if (m_eventBus) {
@@ -1477,7 +1563,7 @@ void AssetBrowserPanel::PasteAssets(const std::string& destinationDirectory) {
                 }
                 
                 NotifyAssetSystemOfChanges(destinationPath, "copied");
-                
+            
             } else if (m_clipboardOperation == ClipboardOperation::Cut) {
                 // Move operation
                 MoveAsset(assetPath, destinationDirectory);
@@ -6,6 +6,7 @@
 #include "../../../AssetPipeline/AssetHandle.h"
 #include "../../../AssetPipeline/AssetManager.h"
 #include "../IconManager.h"
+#include "../ThumbnailService.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -42,7 +43,7 @@ public:
     const std::string& GetCurrentDirectory() const { return m_currentDirectory; }
     void NavigateToDirectory(const std::string& path);
     void RefreshCurrentDirectory();
-    
+
 private:
     // Event handling
     void RegisterEventListeners();
@@ -58,6 +59,7 @@ private:
     
     // Directory tree
     void RenderDirectoryTree(const std::string& path, int depth = 0);
+    bool GetSubdirectories(const std::string& path, std::vector<std::string>& subdirectories) const;
     bool IsDirectoryExpanded(const std::string& path) const;
     void SetDirectoryExpanded(const std::string& path, bool expanded);
     
@@ -70,6 +72,7 @@ private:
     
     // File system operations
     void ScanDirectory(const std::string& path);
+    bool ListIndexedDirectory(const std::string& path);
     void RefreshAssets();
     bool CreateFolder(const std::string& name);
     bool CreateAsset(const std::string& name, AssetType type);
@@ -165,8 +168,12 @@ private:
     
     // Services
     EventBus* m_eventBus = nullptr;
+    std::vector<EventSubscription> m_eventSubscriptions;
     AssetManager* m_assetManager = nullptr;
     IconManager* m_iconManager = nullptr;
+    
+    // Texture and material previews, drawn in the background and cached next to the cooked assets
+    ThumbnailService m_thumbnails;
 };
 
 } // namespace BGE
\ No newline at end of file
@@ -21,15 +21,13 @@ void ECSInspectorPanel::Initialize() {
 }
 
 void ECSInspectorPanel::RegisterEventListeners() {
-    EventBus::Instance().Subscribe<EntitySelectionChangedEvent>(
-        [this](const EntitySelectionChangedEvent& event) {
-            OnEntitySelectionChanged(event);
-        });
+    EventBus& eventBus = EventBus::Instance();
+    m_selectionChangedSubscription = EventSubscription(&eventBus,
+        eventBus.Subscribe<EntitySelectionChangedEvent, &ECSInspectorPanel::OnEntitySelectionChanged>(this));
 }
 
 void ECSInspectorPanel::UnregisterEventListeners() {
-    // EventBus doesn't have unsubscribe in this implementation
-    // Would need to be added or use a different approach
+    m_selectionChangedSubscription.Reset();
 }
 
 void ECSInspectorPanel::OnEntitySelectionChanged(const EntitySelectionChangedEvent& event) {
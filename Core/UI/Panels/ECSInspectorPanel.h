@@ -101,7 +101,7 @@ private:
     char m_componentSearchBuffer[256] = {0};
     
     // Event listener handles
-    uint32_t m_selectionChangedHandle = 0;
+    EventSubscription m_selectionChangedSubscription;
 };
 
 } // namespace BGE
\ No newline at end of file
@@ -164,7 +164,6 @@ void GameViewportPanel::RenderGameContent() {
         renderer->BeginRenderToTexture();
         renderer->BeginFrame();
         renderer->RenderWorld(world.get());  // Convert shared_ptr to raw pointer
-        renderer->RenderParticles();
         renderer->EndFrame();
         renderer->EndRenderToTexture();
         
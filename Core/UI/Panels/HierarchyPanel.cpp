@@ -39,17 +39,23 @@ void HierarchyPanel::RegisterEventListeners() {
     
     if (m_eventBus) {
         // Listen for external selection changes
-        m_eventBus->Subscribe<EntitySelectionChangedEvent>([this](const EntitySelectionChangedEvent& event) {
-            OnEntitySelectionChanged(event);
-        });
+        m_eventSubscriptions.emplace_back(m_eventBus,
+            m_eventBus->Subscribe<EntitySelectionChangedEvent, &HierarchyPanel::OnEntitySelectionChanged>(this));
+        
+        // Keep the tree model in step with entities created or moved elsewhere in the editor
+        m_eventSubscriptions.emplace_back(m_eventBus,
+            m_eventBus->Subscribe<EntityHierarchyChangedEvent, &HierarchyPanel::OnEntityHierarchyChanged>(this));
     }
 }
 
 void HierarchyPanel::UnregisterEventListeners() {
-    // EventBus will handle cleanup when it's destroyed
+    m_eventSubscriptions.clear();
 }
 
 void HierarchyPanel::OnRender() {
+    // Patches in entities created or destroyed elsewhere since the last frame
+    m_treeModel.Sync();
+    
     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(2, 1));
     ImGui::PushStyleVar(ImGuiStyleVar_IndentSpacing, m_indentSize);
     
@@ -73,8 +79,7 @@ void HierarchyPanel::OnRender() {
         if (ImGui::Button("X", ImVec2(m_clearButtonWidth, 0))) {
             m_searchBuffer[0] = '\0';
             m_searchQuery.clear();
-            m_searchResults.clear();
-            m_showOnlySearchResults = false;
+            m_treeModel.SetFilter(m_searchQuery);
         }
     }
     
@@ -154,82 +159,90 @@ void HierarchyPanel::OnRender() {
 }
 
 void HierarchyPanel::RenderEntityHierarchy() {
-    auto& entityManager = EntityManager::Instance();
-    
-    // Check if hierarchy needs update
-    const auto allEntityIDs = entityManager.GetAllEntityIDs();
-    if (allEntityIDs.size() != m_lastEntityCount) {
-        m_hierarchyDirty = true;
-        m_lastEntityCount = static_cast<uint32_t>(allEntityIDs.size());
-    }
-    
-    // Update caches if needed
-    if (m_hierarchyDirty) {
-        UpdateCaches();
-    }
-    
     // Update stats
-    m_stats.totalEntities = allEntityIDs.size();
+    m_stats.totalEntities = m_treeModel.GetEntityCount();
     m_stats.selectedEntities = m_selectedEntities.size();
-    m_stats.visibleEntities = 0;
+    m_stats.visibleEntities = m_treeModel.GetRows().size();
     m_stats.lockedEntities = m_lockedEntities.size();
     
     // Early return if no entities
-    if (allEntityIDs.empty()) {
+    if (m_stats.totalEntities == 0) {
         ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "No entities in scene");
         return;
     }
     
-    // Render all root entities (entities without parents)
-    RenderRootEntities();
-}
-
-void HierarchyPanel::RenderRootEntities() {
-    std::vector<EntityID> rootEntities = GetRootEntities();
+    // Only the rows inside the scroll region are built; the rest are skipped as one block
+    float firstRowY = ImGui::GetCursorPosY();
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(m_stats.visibleEntities));
+    while (clipper.Step()) {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+            // Re-fetched per row: a row's actions can change the tree, which is flattened again on the next call
+            const auto& rows = m_treeModel.GetRows();
+            if (i >= static_cast<int>(rows.size())) {
+                break;
+            }
+            HierarchyRow row = rows[i];
+            
+            // Rows are flat, so nesting is drawn as indentation rather than pushed tree nodes
+            float indent = row.depth * m_indentSize;
+            if (indent > 0.0f) {
+                ImGui::Indent(indent);
+            }
+            RenderEntityRow(row);
+            if (indent > 0.0f) {
+                ImGui::Unindent(indent);
+            }
+        }
+    }
     
-    for (EntityID entityId : rootEntities) {
-        bool nodeOpen = false;
-        RenderEntityNode(entityId, nodeOpen);
+    // Keep the entity reached with the arrow keys in view
+    if (m_scrollToEntity != INVALID_ENTITY) {
+        size_t rowIndex = 0;
+        float rowHeight = clipper.ItemsHeight;
+        if (rowHeight > 0.0f && m_treeModel.FindRow(m_scrollToEntity, rowIndex)) {
+            float rowTop = firstRowY + rowIndex * rowHeight;
+            float viewHeight = ImGui::GetWindowHeight();
+            if (rowTop < ImGui::GetScrollY()) {
+                ImGui::SetScrollY(rowTop);
+            } else if (rowTop + rowHeight > ImGui::GetScrollY() + viewHeight) {
+                ImGui::SetScrollY(rowTop + rowHeight - viewHeight);
+            }
+        }
+        m_scrollToEntity = INVALID_ENTITY;
     }
 }
 
-void HierarchyPanel::RenderEntityNode(EntityID entityId, bool& nodeOpen) {
+void HierarchyPanel::RenderEntityRow(const HierarchyRow& row) {
     auto& entityManager = EntityManager::Instance();
+    EntityID entityId = row.entity;
     
     // Don't use GetEntity - it returns nullptr for new ECS entities
     if (!entityManager.IsEntityValid(entityId)) {
-        return; // Entity was destroyed
-    }
-    
-    // Check if entity should be visible based on search filter
-    if (!m_searchQuery.empty() && !IsVisible(entityId)) {
+        // Entity was destroyed this frame; still take up the row so the clipper's spacing holds
+        ImGui::Dummy(ImVec2(0.0f, ImGui::GetFrameHeight()));
         return;
     }
     
-    // Update visible entity count
-    m_stats.visibleEntities++;
-    
     std::string displayName = GetEntityDisplayName(entityId);
     const char* icon = GetEntityIcon(entityId);
-    bool hasChildren = HasChildren(entityId);
+    bool hasChildren = row.hasChildren;
     bool isSelected = IsEntitySelected(entityId);
-    bool isExpanded = m_expandedNodes.count(entityId) > 0;
+    bool isExpanded = m_treeModel.IsExpanded(entityId);
     bool isVisible = IsEntityVisible(entityId);
     bool isLocked = IsEntityLocked(entityId);
+    bool isSearchMatch = MatchesSearchFilter(entityId);
     
-    // Create the tree node
-    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_SpanAvailWidth;
+    // Create the tree node; the model owns the open state and the row's children follow it in the list
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_OpenOnDoubleClick | ImGuiTreeNodeFlags_SpanAvailWidth |
+                               ImGuiTreeNodeFlags_NoTreePushOnOpen;
     
     if (isSelected) {
         flags |= ImGuiTreeNodeFlags_Selected;
     }
     
     if (!hasChildren) {
-        flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
-    }
-    
-    if (isExpanded) {
-        flags |= ImGuiTreeNodeFlags_DefaultOpen;
+        flags |= ImGuiTreeNodeFlags_Leaf;
     }
     
     // Always push ID first for consistency
@@ -333,7 +346,7 @@ void HierarchyPanel::RenderEntityNode(EntityID entityId, bool& nodeOpen) {
     }
     
     // Highlight search results
-    if (!m_searchQuery.empty() && MatchesSearchFilter(entityId)) {
+    if (isSearchMatch) {
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.5f, 0.8f, 1.0f, 1.0f));
     }
     
@@ -354,7 +367,8 @@ void HierarchyPanel::RenderEntityNode(EntityID entityId, bool& nodeOpen) {
         ImGui::SameLine(0, 4); // Small spacing between icon and text
     }
     
-    nodeOpen = ImGui::TreeNodeEx("node", flags, "%s", nodeLabel.c_str());
+    ImGui::SetNextItemOpen(isExpanded, ImGuiCond_Always);
+    bool nodeOpen = ImGui::TreeNodeEx("node", flags, "%s", nodeLabel.c_str());
     ImGui::PopItemWidth();
     
     // Pop selection colors
@@ -366,7 +380,7 @@ void HierarchyPanel::RenderEntityNode(EntityID entityId, bool& nodeOpen) {
     bool treeNodeHovered = ImGui::IsItemHovered();
     
     // Pop text colors
-    if (!m_searchQuery.empty() && MatchesSearchFilter(entityId)) {
+    if (isSearchMatch) {
         ImGui::PopStyleColor();
     }
     if (isLocked) {
@@ -483,27 +497,9 @@ void HierarchyPanel::RenderEntityNode(EntityID entityId, bool& nodeOpen) {
         ImGui::EndDragDropTarget();
     }
     
-    // Update expansion state
-    if (hasChildren) {
-        if (nodeOpen && m_expandedNodes.count(entityId) == 0) {
-            m_expandedNodes.insert(entityId);
-        } else if (!nodeOpen && m_expandedNodes.count(entityId) > 0) {
-            m_expandedNodes.erase(entityId);
-        }
-    }
-    
-    // Render children if expanded
-    if (nodeOpen && hasChildren) {
-        std::vector<EntityID> children = GetChildEntities(entityId);
-        for (EntityID childId : children) {
-            bool childNodeOpen = false;
-            RenderEntityNode(childId, childNodeOpen);
-        }
-    }
-    
-    // Only pop if node was opened AND we actually pushed (i.e., has children)
-    if (nodeOpen && hasChildren) {
-        ImGui::TreePop();
+    // Update expansion state; the model lays the children out in the rows
+    if (hasChildren && nodeOpen != isExpanded) {
+        m_treeModel.SetExpanded(entityId, nodeOpen);
     }
     
     // Pop the ID we pushed at the beginning
@@ -511,10 +507,9 @@ void HierarchyPanel::RenderEntityNode(EntityID entityId, bool& nodeOpen) {
 }
 
 std::string HierarchyPanel::GetEntityDisplayName(EntityID entityId) const {
-    // Check cache first
-    auto it = m_cachedDisplayNames.find(entityId);
-    if (it != m_cachedDisplayNames.end()) {
-        return it->second;
+    // The tree model keeps every entity's name
+    if (const std::string* cachedName = m_treeModel.FindName(entityId)) {
+        return *cachedName;
     }
     
     auto& entityManager = EntityManager::Instance();
@@ -531,8 +526,6 @@ std::string HierarchyPanel::GetEntityDisplayName(EntityID entityId) const {
         displayName = "Entity " + std::to_string(entityId.id);
     }
     
-    // Cache the result
-    m_cachedDisplayNames[entityId] = displayName;
     return displayName;
 }
 
@@ -667,7 +660,7 @@ ImVec4 HierarchyPanel::GetEntityIconColor(EntityID entityId) const {
 }
 
 void HierarchyPanel::SelectEntity(EntityID entityId, bool ctrlHeld, bool shiftHeld) {
-    
+
     if (shiftHeld && m_lastClickedEntity != INVALID_ENTITY) {
         // Shift-click: range selection
         SelectRange(m_lastClickedEntity, entityId);
@@ -729,40 +722,26 @@ void HierarchyPanel::OnEntitySelectionChanged(const EntitySelectionChangedEvent&
     }
 }
 
-std::vector<EntityID> HierarchyPanel::GetRootEntities() const {
-    // Use cached root entities if available
-    if (!m_hierarchyDirty && !m_cachedRootEntities.empty()) {
-        return m_cachedRootEntities;
-    }
-    
-    // Otherwise fall back to recalculating
-    UpdateCaches();
-    return m_cachedRootEntities;
+void HierarchyPanel::OnEntityHierarchyChanged(const EntityHierarchyChangedEvent& event) {
+    m_treeModel.Apply(event);
 }
 
-std::vector<EntityID> HierarchyPanel::GetChildEntities(EntityID parentId) const {
-    // Check cache first
-    if (!m_childrenCacheDirty) {
-        auto it = m_childrenCache.find(parentId);
-        if (it != m_childrenCache.end()) {
-            return it->second;
-        }
-    }
-    
-    auto& entityManager = EntityManager::Instance();
-    
-    if (!entityManager.IsEntityValid(parentId)) {
-        return {};
-    }
-    
-    auto* transform = entityManager.GetComponent<TransformComponent>(parentId);
-    if (!transform) {
-        return {};
+void HierarchyPanel::NotifyHierarchyChanged(EntityHierarchyChangedEvent::Change change, EntityID entityId) {
+    EntityHierarchyChangedEvent event(change, entityId);
+    if (m_eventBus) {
+        // Reaches the model through OnEntityHierarchyChanged, along with any other view of the tree
+        m_eventBus->Publish(event);
+    } else {
+        m_treeModel.Apply(event);
     }
-    
-    // Cache the result
-    m_childrenCache[parentId] = transform->children;
-    return transform->children;
+}
+
+const std::vector<EntityID>& HierarchyPanel::GetRootEntities() const {
+    return m_treeModel.GetRoots();
+}
+
+const std::vector<EntityID>& HierarchyPanel::GetChildEntities(EntityID parentId) const {
+    return m_treeModel.GetChildren(parentId);
 }
 
 bool HierarchyPanel::HasChildren(EntityID entityId) const {
@@ -807,8 +786,7 @@ void HierarchyPanel::RenameEntity(EntityID entityId, const std::string& newName)
         nameComponent->name = newName;
     }
     
-    // Invalidate name cache
-    m_cachedDisplayNames.erase(entityId);
+    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Renamed, entityId);
     
     std::cout << "Renamed entity " << entityId << " to '" << newName << "'" << std::endl;
 }
@@ -830,14 +808,14 @@ void HierarchyPanel::DeleteSelectedEntities() {
     RecordOperation(op);
     
     for (EntityID entityId : m_selectedEntities) {
+        if (!entityManager.IsEntityValid(entityId)) {
+            continue;
+        }
         std::cout << "Deleting entity " << entityId << std::endl;
         entityManager.DestroyEntity(entityId);
+        NotifyHierarchyChanged(EntityHierarchyChangedEvent::Destroyed, entityId);
     }
     
-    // Invalidate caches
-    InvalidateHierarchy();
-    InvalidateChildrenCache();
-    
     ClearSelection();
 }
 
@@ -891,13 +869,11 @@ void HierarchyPanel::CreateChildEntity(EntityID parentId) {
             parentTransform->children.push_back(newEntityId);
             
             // Expand the parent node
-            m_expandedNodes.insert(parentId);
+            m_treeModel.SetExpanded(parentId, true);
         }
     }
     
-    // Invalidate caches
-    InvalidateHierarchy();
-    InvalidateChildrenCache();
+    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newEntityId);
     
     // Select the new entity
     SelectEntity(newEntityId, false, false);
@@ -944,8 +920,7 @@ void HierarchyPanel::CreateEmpty() {
         materialResult.GetValue()->materialID = 1; // Default material
     }
     
-    // Invalidate caches
-    InvalidateHierarchy();
+    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newEntityId);
     
     // Select the new entity
     SelectEntity(newEntityId, false, false);
@@ -989,6 +964,8 @@ void HierarchyPanel::CreateRigidbodyEntity() {
         rigidbodyResult.GetValue()->angularDrag = 0.05f;
     }
     
+    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newEntityId);
+    
     // Select the new entity
     SelectEntity(newEntityId, false, false);
     
@@ -1032,6 +1009,8 @@ void HierarchyPanel::CreatePointLightEntity() {
     lightComp.enabled = true;
     auto lightResult = entityManager.AddComponent<LightComponent>(newEntityId, std::move(lightComp));
     
+    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newEntityId);
+    
     // Select the new entity
     SelectEntity(newEntityId, false, false);
     
@@ -1081,7 +1060,7 @@ void HierarchyPanel::CreateDirectionalLightEntity() {
         materialResult.GetValue()->materialID = 3;
     }
     
-    InvalidateHierarchy();
+    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newEntityId);
     SelectEntity(newEntityId, false, false);
 }
 
@@ -1130,7 +1109,7 @@ void HierarchyPanel::CreateSpotLightEntity() {
         materialResult.GetValue()->materialID = 3;
     }
     
-    InvalidateHierarchy();
+    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newEntityId);
     SelectEntity(newEntityId, false, false);
 }
 
@@ -1178,7 +1157,7 @@ void HierarchyPanel::CreateAreaLightEntity() {
         materialResult.GetValue()->materialID = 3;
     }
     
-    InvalidateHierarchy();
+    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newEntityId);
     SelectEntity(newEntityId, false, false);
 }
 
@@ -1219,7 +1198,7 @@ void HierarchyPanel::CreateParticleSystemEntity() {
     
     // TODO: Add actual ParticleSystemComponent when available
     
-    InvalidateHierarchy();
+    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newEntityId);
     SelectEntity(newEntityId, false, false);
 }
 
@@ -1265,7 +1244,7 @@ void HierarchyPanel::CreateTrailRendererEntity() {
     
     // TODO: Add actual TrailRendererComponent when available
     
-    InvalidateHierarchy();
+    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newEntityId);
     SelectEntity(newEntityId, false, false);
 }
 
@@ -1308,7 +1287,7 @@ void HierarchyPanel::CreatePointLightChild(EntityID parentId) {
         if (parentTransform) {
             transform->parent = parentId;
             parentTransform->children.push_back(newEntityId);
-            m_expandedNodes.insert(parentId);
+            m_treeModel.SetExpanded(parentId, true);
         }
     }
     
@@ -1333,8 +1312,7 @@ void HierarchyPanel::CreatePointLightChild(EntityID parentId) {
         materialResult.GetValue()->materialID = 3;
     }
     
-    InvalidateHierarchy();
-    InvalidateChildrenCache();
+    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newEntityId);
     SelectEntity(newEntityId, false, false);
 }
 
@@ -1525,9 +1503,10 @@ void HierarchyPanel::HandleDragDropPayload(EntityID targetEntity, EntityID dragg
                 if (newParentTransform) {
                     newParentTransform->children.push_back(moveEntity);
                 }
+                NotifyHierarchyChanged(EntityHierarchyChangedEvent::Reparented, moveEntity);
                 
                 // Expand the parent to show the new child
-                m_expandedNodes.insert(targetEntity);
+                m_treeModel.SetExpanded(targetEntity, true);
             }
         }
         
@@ -1548,10 +1527,11 @@ void HierarchyPanel::HandleDragDropPayload(EntityID targetEntity, EntityID dragg
             siblingsList = &parentTransform->children;
         } else {
             // Handle root entity reordering
-            auto targetIt = std::find(m_rootEntityOrder.begin(), m_rootEntityOrder.end(), targetEntity);
-            if (targetIt == m_rootEntityOrder.end()) return;
+            std::vector<EntityID> rootOrder = GetRootEntities();
+            auto targetIt = std::find(rootOrder.begin(), rootOrder.end(), targetEntity);
+            if (targetIt == rootOrder.end()) return;
             
-            size_t targetIndex = std::distance(m_rootEntityOrder.begin(), targetIt);
+            size_t targetIndex = std::distance(rootOrder.begin(), targetIt);
             if (m_currentDropPosition == DropPosition::Below) {
                 targetIndex++;
             }
@@ -1569,26 +1549,28 @@ void HierarchyPanel::HandleDragDropPayload(EntityID targetEntity, EntityID dragg
                         oldChildren.erase(std::remove(oldChildren.begin(), oldChildren.end(), moveEntity), oldChildren.end());
                     }
                     moveTransform->parent = INVALID_ENTITY;
+                    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Reparented, moveEntity);
                 }
                 
                 // Remove from current position in root order
-                auto moveIt = std::find(m_rootEntityOrder.begin(), m_rootEntityOrder.end(), moveEntity);
-                if (moveIt != m_rootEntityOrder.end()) {
-                    size_t moveIndex = std::distance(m_rootEntityOrder.begin(), moveIt);
+                auto moveIt = std::find(rootOrder.begin(), rootOrder.end(), moveEntity);
+                if (moveIt != rootOrder.end()) {
+                    size_t moveIndex = std::distance(rootOrder.begin(), moveIt);
                     if (moveIndex < targetIndex) {
                         targetIndex--;
                     }
-                    m_rootEntityOrder.erase(moveIt);
+                    rootOrder.erase(moveIt);
                 }
                 
                 // Insert at target position
-                if (targetIndex <= m_rootEntityOrder.size()) {
-                    m_rootEntityOrder.insert(m_rootEntityOrder.begin() + targetIndex, moveEntity);
+                if (targetIndex <= rootOrder.size()) {
+                    rootOrder.insert(rootOrder.begin() + targetIndex, moveEntity);
                     targetIndex++;
                 } else {
-                    m_rootEntityOrder.push_back(moveEntity);
+                    rootOrder.push_back(moveEntity);
                 }
             }
+            m_treeModel.SetRootOrder(rootOrder);
             
             std::cout << "Reordered " << entitiesToMove.size() << " root entities" << std::endl;
             return;
@@ -1649,6 +1631,7 @@ void HierarchyPanel::HandleDragDropPayload(EntityID targetEntity, EntityID dragg
             } else {
                 siblingsList->push_back(moveEntity);
             }
+            NotifyHierarchyChanged(EntityHierarchyChangedEvent::Reparented, moveEntity);
         }
         
         std::cout << "Reordered " << entitiesToMove.size() << " entities" << std::endl;
@@ -1659,12 +1642,12 @@ void HierarchyPanel::HandleDragDropPayload(EntityID targetEntity, EntityID dragg
 }
 
 void HierarchyPanel::HandleDragAndDrop(EntityID entityId) {
-    // This function is deprecated - drag & drop is now handled inline in RenderEntityNode
+    // This function is deprecated - drag & drop is now handled inline in RenderEntityRow
     (void)entityId;
 }
 
 void HierarchyPanel::HandleMaterialDragAndDrop(EntityID entityId) {
-    // This function is deprecated - material drag & drop is now handled inline in RenderEntityNode
+    // This function is deprecated - material drag & drop is now handled inline in RenderEntityRow
     (void)entityId;
 }
 
@@ -1739,10 +1722,10 @@ void HierarchyPanel::SelectRange(EntityID fromEntity, EntityID toEntity) {
     BroadcastSelectionChanged();
 }
 
-std::vector<EntityID> HierarchyPanel::GetEntitiesBetween(EntityID start, EntityID end) const {
+std::vector<EntityID> HierarchyPanel::GetEntitiesBetween(EntityID start, EntityID end) {
     std::vector<EntityID> result;
     std::vector<EntityID> orderedEntities;
-    CollectVisibleEntitiesInOrder(const_cast<std::vector<EntityID>&>(orderedEntities));
+    CollectVisibleEntitiesInOrder(orderedEntities);
     
     auto startIt = std::find(orderedEntities.begin(), orderedEntities.end(), start);
     auto endIt = std::find(orderedEntities.begin(), orderedEntities.end(), end);
@@ -1762,25 +1745,12 @@ std::vector<EntityID> HierarchyPanel::GetEntitiesBetween(EntityID start, EntityI
     return result;
 }
 
-void HierarchyPanel::CollectVisibleEntitiesInOrder(std::vector<EntityID>& outEntities) const {
-    // Collect root entities first
-    std::vector<EntityID> rootEntities = GetRootEntities();
-    
-    for (EntityID root : rootEntities) {
-        CollectEntityAndChildrenInOrder(root, outEntities);
-    }
-}
-
-void HierarchyPanel::CollectEntityAndChildrenInOrder(EntityID entity, std::vector<EntityID>& outEntities) const {
-    // Add this entity
-    outEntities.push_back(entity);
-    
-    // If expanded, add children
-    if (m_expandedNodes.count(entity) > 0) {
-        std::vector<EntityID> children = GetChildEntities(entity);
-        for (EntityID child : children) {
-            CollectEntityAndChildrenInOrder(child, outEntities);
-        }
+void HierarchyPanel::CollectVisibleEntitiesInOrder(std::vector<EntityID>& outEntities) {
+    // The rows are the visible entities, already in tree order
+    const auto& rows = m_treeModel.GetRows();
+    outEntities.reserve(outEntities.size() + rows.size());
+    for (const HierarchyRow& row : rows) {
+        outEntities.push_back(row.entity);
     }
 }
 
@@ -1976,6 +1946,7 @@ void HierarchyPanel::PasteEntities() {
                     if (newParentTransform) {
                         newParentTransform->children.push_back(sourceEntity);
                     }
+                    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Reparented, sourceEntity);
                 }
             }
             pastedEntities.push_back(sourceEntity);
@@ -2030,6 +2001,7 @@ void HierarchyPanel::PasteEntities() {
                 entityManager.AddComponent(newEntity, RigidbodyComponent(*comp));
             }
             
+            NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newEntity);
             pastedEntities.push_back(newEntity);
         }
     }
@@ -2082,70 +2054,12 @@ bool HierarchyPanel::IsChildOf(EntityID potentialChild, EntityID potentialParent
 
 // Search and filtering implementation
 void HierarchyPanel::UpdateSearchResults() {
-    m_searchResults.clear();
-    
-    if (m_searchQuery.empty()) {
-        m_showOnlySearchResults = false;
-        return;
-    }
-    
-    m_showOnlySearchResults = true;
-    auto& entityManager = EntityManager::Instance();
-    auto allEntities = entityManager.GetAllEntityIDs();
-    
-    // Convert search query to lowercase for case-insensitive search
-    std::string queryLower = m_searchQuery;
-    std::transform(queryLower.begin(), queryLower.end(), queryLower.begin(), ::tolower);
-    
-    for (EntityID entity : allEntities) {
-        std::string name = GetEntityDisplayName(entity);
-        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-        
-        if (name.find(queryLower) != std::string::npos) {
-            m_searchResults.insert(entity);
-            
-            // Also add all parents to ensure the path is visible
-            auto* transform = entityManager.GetComponent<TransformComponent>(entity);
-            EntityID parent = transform ? transform->parent : INVALID_ENTITY;
-            while (parent != INVALID_ENTITY) {
-                m_searchResults.insert(parent);
-                auto* parentTransform = entityManager.GetComponent<TransformComponent>(parent);
-                parent = parentTransform ? parentTransform->parent : INVALID_ENTITY;
-            }
-        }
-    }
+    // Runs over the model's name index; typing on narrows the previous matches
+    m_treeModel.SetFilter(m_searchQuery);
 }
 
 bool HierarchyPanel::MatchesSearchFilter(EntityID entityId) const {
-    if (m_searchQuery.empty()) return false;
-    
-    std::string name = GetEntityDisplayName(entityId);
-    std::string queryLower = m_searchQuery;
-    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-    std::transform(queryLower.begin(), queryLower.end(), queryLower.begin(), ::tolower);
-    
-    return name.find(queryLower) != std::string::npos;
-}
-
-bool HierarchyPanel::IsVisible(EntityID entityId) const {
-    if (!m_showOnlySearchResults || m_searchQuery.empty()) {
-        return true;
-    }
-    
-    // Check if entity or any of its children match the search
-    if (m_searchResults.count(entityId) > 0) {
-        return true;
-    }
-    
-    // Check if any child matches
-    std::vector<EntityID> children = GetChildEntities(entityId);
-    for (EntityID child : children) {
-        if (IsVisible(child)) {
-            return true;
-        }
-    }
-    
-    return false;
+    return m_treeModel.HasFilter() && m_treeModel.IsMatch(entityId);
 }
 
 // Visibility and locking implementation
@@ -2246,27 +2160,30 @@ void HierarchyPanel::Undo() {
             // Undo create by deleting the entity
             if (entityManager.IsEntityValid(op.entityId)) {
                 entityManager.DestroyEntity(op.entityId);
+                NotifyHierarchyChanged(EntityHierarchyChangedEvent::Destroyed, op.entityId);
             }
             break;
-            
+        
         case EntityOperation::Delete:
             // Undo delete by recreating the entities
             // Note: This is simplified - in a real system we'd store component data
             for (EntityID deletedId : op.affectedEntities) {
                 EntityID newId = entityManager.CreateEntity(op.oldName);
                 // TODO: Restore component data from operation
+                NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newId);
             }
             break;
-            
+        
         case EntityOperation::Rename:
             if (entityManager.IsEntityValid(op.entityId)) {
                 auto* nameComp = entityManager.GetComponent<NameComponent>(op.entityId);
                 if (nameComp) {
                     nameComp->name = op.oldName;
+                    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Renamed, op.entityId);
                 }
             }
             break;
-            
+        
         case EntityOperation::Reparent:
             if (entityManager.IsEntityValid(op.entityId)) {
                 auto* transform = entityManager.GetComponent<TransformComponent>(op.entityId);
@@ -2288,10 +2205,11 @@ void HierarchyPanel::Undo() {
                             oldParent->children.push_back(op.entityId);
                         }
                     }
+                    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Reparented, op.entityId);
                 }
             }
             break;
-            
+        
         default:
             break;
     }
@@ -2314,27 +2232,30 @@ void HierarchyPanel::Redo() {
             {
                 EntityID newId = entityManager.CreateEntity(op.newName);
                 // TODO: Restore component data from operation
+                NotifyHierarchyChanged(EntityHierarchyChangedEvent::Created, newId);
             }
             break;
-            
+        
         case EntityOperation::Delete:
             // Redo delete by deleting the entities again
             for (EntityID entityId : op.affectedEntities) {
                 if (entityManager.IsEntityValid(entityId)) {
                     entityManager.DestroyEntity(entityId);
+                    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Destroyed, entityId);
                 }
             }
             break;
-            
+        
         case EntityOperation::Rename:
             if (entityManager.IsEntityValid(op.entityId)) {
                 auto* nameComp = entityManager.GetComponent<NameComponent>(op.entityId);
                 if (nameComp) {
                     nameComp->name = op.newName;
+                    NotifyHierarchyChanged(EntityHierarchyChangedEvent::Renamed, op.entityId);
                 }
             }
             break;
-            
+        
         case EntityOperation::Reparent:
             // Redo reparent - this logic is complex because we need to find the new parent
             // In a real implementation, we'd store both old and new parent IDs
@@ -2343,7 +2264,7 @@ void HierarchyPanel::Redo() {
                 std::cout << "Redo reparent not fully implemented" << std::endl;
             }
             break;
-            
+        
         default:
             break;
     }
@@ -2455,6 +2376,7 @@ void HierarchyPanel::NavigateUp() {
     EntityID prev = GetNextVisibleEntity(m_primarySelection, false);
     if (prev != INVALID_ENTITY) {
         SelectEntity(prev, false, false);
+        m_scrollToEntity = prev;
     }
 }
 
@@ -2464,36 +2386,26 @@ void HierarchyPanel::NavigateDown() {
     EntityID next = GetNextVisibleEntity(m_primarySelection, true);
     if (next != INVALID_ENTITY) {
         SelectEntity(next, false, false);
+        m_scrollToEntity = next;
     }
 }
 
 void HierarchyPanel::ExpandCollapseSelected(bool expand) {
     if (m_primarySelection == INVALID_ENTITY) return;
     
-    if (expand) {
-        m_expandedNodes.insert(m_primarySelection);
-    } else {
-        m_expandedNodes.erase(m_primarySelection);
-    }
+    m_treeModel.SetExpanded(m_primarySelection, expand);
 }
 
-EntityID HierarchyPanel::GetNextVisibleEntity(EntityID current, bool forward) const {
-    // TODO: Implement proper tree traversal for navigation
-    // This is a simplified version
-    auto& entityManager = EntityManager::Instance();
-    auto allEntities = entityManager.GetAllEntityIDs();
-    
-    auto it = std::find(allEntities.begin(), allEntities.end(), current);
-    if (it == allEntities.end()) return INVALID_ENTITY;
+EntityID HierarchyPanel::GetNextVisibleEntity(EntityID current, bool forward) {
+    // Walk the rows as shown: expanded children, filtered by the search
+    size_t rowIndex = 0;
+    if (!m_treeModel.FindRow(current, rowIndex)) return INVALID_ENTITY;
     
+    const auto& rows = m_treeModel.GetRows();
     if (forward) {
-        ++it;
-        if (it != allEntities.end()) return *it;
+        if (rowIndex + 1 < rows.size()) return rows[rowIndex + 1].entity;
     } else {
-        if (it != allEntities.begin()) {
-            --it;
-            return *it;
-        }
+        if (rowIndex > 0) return rows[rowIndex - 1].entity;
     }
     
     return INVALID_ENTITY;
@@ -2523,43 +2435,4 @@ void HierarchyPanel::FocusCameraOnEntity(EntityID entityId) {
               << transform->position.z << ")" << std::endl;
 }
 
-void HierarchyPanel::UpdateCaches() const {
-    // Clear all caches
-    m_childrenCache.clear();
-    m_cachedDisplayNames.clear();
-    m_cachedIcons.clear();
-    m_cachedRootEntities.clear();
-    
-    auto& entityManager = EntityManager::Instance();
-    auto allEntities = entityManager.GetAllEntityIDs();
-    
-    // Pre-cache root entities
-    for (EntityID entityId : allEntities) {
-        if (!entityManager.IsEntityValid(entityId)) {
-            continue;
-        }
-        
-        auto* transform = entityManager.GetComponent<TransformComponent>(entityId);
-        if (!transform || transform->parent == INVALID_ENTITY) {
-            m_cachedRootEntities.push_back(entityId);
-        }
-    }
-    
-    // Sort root entities by their order
-    std::sort(m_cachedRootEntities.begin(), m_cachedRootEntities.end(),
-        [this](EntityID a, EntityID b) {
-            auto itA = std::find(m_rootEntityOrder.begin(), m_rootEntityOrder.end(), a);
-            auto itB = std::find(m_rootEntityOrder.begin(), m_rootEntityOrder.end(), b);
-            
-            if (itA != m_rootEntityOrder.end() && itB != m_rootEntityOrder.end()) {
-                return std::distance(m_rootEntityOrder.begin(), itA) < 
-                       std::distance(m_rootEntityOrder.begin(), itB);
-            }
-            return a < b;
-        });
-    
-    m_childrenCacheDirty = false;
-    m_hierarchyDirty = false;
-}
-
 } // namespace BGE
\ No newline at end of file
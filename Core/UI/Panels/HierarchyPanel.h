@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Framework/Panel.h"
+#include "../HierarchyTreeModel.h"
 #include "../../../Simulation/SimulationWorld.h"
 #include "../../Entity.h"
 #include "../../Events.h"
@@ -25,12 +26,11 @@ public:
     
     void Initialize() override;
     void OnRender() override;
-    
+
 private:
     // Core rendering
     void RenderEntityHierarchy();
-    void RenderEntityNode(EntityID entityId, bool& nodeOpen);
-    void RenderRootEntities();
+    void RenderEntityRow(const HierarchyRow& row);
     
     // Selection management
     void SelectEntity(EntityID entityId, bool ctrlHeld, bool shiftHeld);
@@ -38,6 +38,8 @@ private:
     bool IsEntitySelected(EntityID entityId) const;
     void BroadcastSelectionChanged();
     void OnEntitySelectionChanged(const EntitySelectionChangedEvent& event);
+    void OnEntityHierarchyChanged(const EntityHierarchyChangedEvent& event);
+    void NotifyHierarchyChanged(EntityHierarchyChangedEvent::Change change, EntityID entityId);
     
     // Entity operations
     void RenameEntity(EntityID entityId, const std::string& newName);
@@ -68,14 +70,14 @@ private:
     void FocusCameraOnEntity(EntityID entityId);
     
     // Entity hierarchy queries
-    std::vector<EntityID> GetRootEntities() const;
-    std::vector<EntityID> GetChildEntities(EntityID parentId) const;
+    const std::vector<EntityID>& GetRootEntities() const;
+    const std::vector<EntityID>& GetChildEntities(EntityID parentId) const;
     bool HasChildren(EntityID entityId) const;
     
     // Multi-selection helpers
     void SelectRange(EntityID fromEntity, EntityID toEntity);
     void SelectChildren(EntityID parentEntity);
-    std::vector<EntityID> GetEntitiesBetween(EntityID start, EntityID end) const;
+    std::vector<EntityID> GetEntitiesBetween(EntityID start, EntityID end);
     
     // Event handling
     void RegisterEventListeners();
@@ -92,13 +94,11 @@ private:
     
     // Helper functions
     bool IsChildOf(EntityID potentialChild, EntityID potentialParent) const;
-    void CollectVisibleEntitiesInOrder(std::vector<EntityID>& outEntities) const;
-    void CollectEntityAndChildrenInOrder(EntityID entity, std::vector<EntityID>& outEntities) const;
+    void CollectVisibleEntitiesInOrder(std::vector<EntityID>& outEntities);
     
     // Search and filtering
     void UpdateSearchResults();
     bool MatchesSearchFilter(EntityID entityId) const;
-    bool IsVisible(EntityID entityId) const;
     
     // Visibility and locking
     void ToggleVisibility(EntityID entityId);
@@ -132,7 +132,7 @@ private:
     void NavigateUp();
     void NavigateDown();
     void ExpandCollapseSelected(bool expand);
-    EntityID GetNextVisibleEntity(EntityID current, bool forward) const;
+    EntityID GetNextVisibleEntity(EntityID current, bool forward);
     
     SimulationWorld* m_world;
     
@@ -153,9 +153,11 @@ private:
     
     // Event bus for selection synchronization
     EventBus* m_eventBus = nullptr;
+    std::vector<EventSubscription> m_eventSubscriptions;
     
-    // Node expansion state
-    std::unordered_set<EntityID> m_expandedNodes;
+    // Entity tree, expansion and filter state, flattened into the rows drawn each frame
+    HierarchyTreeModel m_treeModel;
+    EntityID m_scrollToEntity = INVALID_ENTITY;
     
     // Clipboard state
     struct EntityClipboardData {
@@ -167,8 +169,6 @@ private:
     // Search/filter state
     char m_searchBuffer[256] = {0};
     std::string m_searchQuery;
-    std::unordered_set<EntityID> m_searchResults;
-    bool m_showOnlySearchResults = false;
     
     // Visibility and lock state
     std::unordered_set<EntityID> m_hiddenEntities;
@@ -206,22 +206,6 @@ private:
     float m_dropZoneThreshold = 0.3f;
     Vector3 m_defaultEntityPosition = Vector3(1024.0f, 1024.0f, 0.0f);
     Vector2 m_defaultSpriteSize = Vector2(32.0f, 32.0f);
-    
-    // Performance optimization
-    mutable std::unordered_map<EntityID, std::vector<EntityID>> m_childrenCache;
-    mutable bool m_childrenCacheDirty = true;
-    mutable bool m_hierarchyDirty = true;
-    mutable uint32_t m_lastEntityCount = 0;
-    mutable std::vector<EntityID> m_cachedRootEntities;
-    mutable std::unordered_map<EntityID, std::string> m_cachedDisplayNames;
-    mutable std::unordered_map<EntityID, const char*> m_cachedIcons;
-    
-    void InvalidateChildrenCache() const { m_childrenCacheDirty = true; }
-    void InvalidateHierarchy() const { m_hierarchyDirty = true; }
-    void UpdateCaches() const;
-    
-    // Root entity ordering
-    std::vector<EntityID> m_rootEntityOrder;
 };
 
 } // namespace BGE
\ No newline at end of file
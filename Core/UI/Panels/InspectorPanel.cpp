@@ -53,22 +53,19 @@ void InspectorPanel::RegisterEventListeners() {
     m_eventBus = eventBusPtr.get();
     
     if (m_eventBus) {
-        m_eventBus->Subscribe<EntitySelectionChangedEvent>([this](const EntitySelectionChangedEvent& event) {
-            OnEntitySelectionChanged(event);
-        });
+        m_eventSubscriptions.emplace_back(m_eventBus,
+            m_eventBus->Subscribe<EntitySelectionChangedEvent, &InspectorPanel::OnEntitySelectionChanged>(this));
         
-        m_eventBus->Subscribe<AssetSelectionChangedEvent>([this](const AssetSelectionChangedEvent& event) {
-            OnAssetSelectionChanged(event);
-        });
+        m_eventSubscriptions.emplace_back(m_eventBus,
+            m_eventBus->Subscribe<AssetSelectionChangedEvent, &InspectorPanel::OnAssetSelectionChanged>(this));
         
-        m_eventBus->Subscribe<MaterialHoverEvent>([this](const MaterialHoverEvent& event) {
-            OnMaterialHover(event);
-        });
+        m_eventSubscriptions.emplace_back(m_eventBus,
+            m_eventBus->Subscribe<MaterialHoverEvent, &InspectorPanel::OnMaterialHover>(this));
     }
 }
 
 void InspectorPanel::UnregisterEventListeners() {
-    // EventBus will handle cleanup when it's destroyed
+    m_eventSubscriptions.clear();
 }
 
 void InspectorPanel::OnEntitySelectionChanged(const EntitySelectionChangedEvent& event) {
@@ -129,6 +126,13 @@ void InspectorPanel::OnMaterialHover(const MaterialHoverEvent& event) {
     }
 }
 
+void InspectorPanel::NotifyRenamed(EntityID entityId) {
+    if (m_eventBus) {
+        EntityHierarchyChangedEvent event(EntityHierarchyChangedEvent::Renamed, entityId);
+        m_eventBus->Publish(event);
+    }
+}
+
 void InspectorPanel::OnRender() {
     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(4, 4));
     ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(4, 3));
@@ -552,6 +556,9 @@ void InspectorPanel::RenderNameComponent(EntityID entityId, NameComponent* compo
     }
     
     bool changed = InputText("Name", &component->name);
+    if (changed) {
+        NotifyRenamed(entityId);
+    }
     
     // Apply changes to all selected entities if this is multi-selection
     if (changed && m_selectedEntities.size() > 1) {
@@ -562,6 +569,7 @@ void InspectorPanel::RenderNameComponent(EntityID entityId, NameComponent* compo
             auto* selectedName = entityManager.GetComponent<NameComponent>(selectedId);
             if (selectedName) {
                 selectedName->name = component->name;
+                NotifyRenamed(selectedId);
             }
         }
     }
@@ -874,6 +882,7 @@ void InspectorPanel::AddComponentToEntity(EntityID entityId, const std::string&
             NameComponent nameComp;
             nameComp.name = "New Entity";
             entityManager.AddComponent<NameComponent>(entityId, std::move(nameComp));
+            NotifyRenamed(entityId);
         }
     } else if (componentType == "SpriteComponent") {
         if (!entityManager.HasComponent<SpriteComponent>(entityId)) {
@@ -917,6 +926,7 @@ void InspectorPanel::RemoveComponentFromEntity(EntityID entityId, const std::str
     
     if (componentType == "NameComponent") {
         entityManager.RemoveComponent<NameComponent>(entityId);
+        NotifyRenamed(entityId);
     } else if (componentType == "SpriteComponent") {
         entityManager.RemoveComponent<SpriteComponent>(entityId);
     } else if (componentType == "VelocityComponent") {
@@ -1393,6 +1403,7 @@ void InspectorPanel::PasteComponent(EntityID entityId, const std::string& compon
         auto* comp = entityManager.GetComponent<NameComponent>(entityId);
         if (comp && !s_componentClipboard.componentData.empty()) {
             comp->name = std::string(reinterpret_cast<const char*>(s_componentClipboard.componentData.data()));
+            NotifyRenamed(entityId);
         }
     } else if (componentType == "Sprite") {
         auto* comp = entityManager.GetComponent<SpriteComponent>(entityId);
@@ -31,6 +31,8 @@ private:
     void OnEntitySelectionChanged(const EntitySelectionChangedEvent& event);
     void OnAssetSelectionChanged(const AssetSelectionChangedEvent& event);
     void OnMaterialHover(const MaterialHoverEvent& event);
+    // Lets the hierarchy refresh the entity's cached display name
+    void NotifyRenamed(EntityID entityId);
     
     // Component rendering
     void RenderEntityInspector();
@@ -100,6 +102,7 @@ private:
     
     // Event bus for selection synchronization
     EventBus* m_eventBus = nullptr;
+    std::vector<EventSubscription> m_eventSubscriptions;
     
     // Available component types for Add Component menu
     std::vector<std::string> m_availableComponents;
@@ -0,0 +1,392 @@
+#include "ProfilerPanel.h"
+#include "../../ServiceLocator.h"
+#include "../../../AssetPipeline/AssetManager.h"
+#include <imgui.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+namespace BGE {
+
+namespace {
+
+// Stable colour per zone name
+ImU32 ZoneColor(const char* name) {
+    // FNV-1a over the name, so identical names from different call sites match
+    uint32_t hash = 2166136261u;
+    for (const char* c = name; c && *c; ++c) {
+        hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+    }
+    float hue = static_cast<float>(hash % 360) / 360.0f;
+    return ImColor::HSV(hue, 0.45f, 0.8f);
+}
+
+double ToMs(uint64_t nanoseconds) {
+    return static_cast<double>(nanoseconds) / 1.0e6;
+}
+
+double ToMB(size_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+const char* AssetTypeName(AssetType type) {
+    switch (type) {
+        case AssetType::Texture: return "Textures";
+        case AssetType::Material: return "Materials";
+        case AssetType::Scene: return "Scenes";
+        case AssetType::Prefab: return "Prefabs";
+        case AssetType::Audio: return "Audio";
+        case AssetType::Model: return "Models";
+        default: return "Other";
+    }
+}
+
+} // anonymous namespace
+
+ProfilerPanel::ProfilerPanel(const std::string& name)
+    : Panel(name) {
+}
+
+void ProfilerPanel::Initialize() {
+    SetMinSize(400, 250);
+}
+
+void ProfilerPanel::OnRender() {
+    RenderToolbar();
+    RenderFrameGraph();
+    
+    const ProfileFrame* frame = GetSelectedFrame();
+    if (!frame) {
+        ImGui::TextUnformatted("No frames recorded yet");
+        return;
+    }
+    
+    ImGui::Text("Frame %llu: %.2f ms, %zu zones", static_cast<unsigned long long>(frame->frameIndex),
+                frame->GetDurationMs(), frame->zones.size());
+    ImGui::Separator();
+    
+    if (ImGui::BeginTabBar("ProfilerViews")) {
+        if (ImGui::BeginTabItem("Flame Chart")) {
+            RenderFlameChart(*frame);
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Top Zones")) {
+            RenderTopZones(*frame);
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Asset Memory")) {
+            RenderAssetMemory();
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Frame Memory")) {
+            RenderFrameMemory(*frame);
+            ImGui::EndTabItem();
+        }
+        ImGui::EndTabBar();
+    }
+}
+
+void ProfilerPanel::RenderToolbar() {
+    Profiler& profiler = Profiler::Instance();
+    
+    bool enabled = Profiler::IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled)) {
+        profiler.SetEnabled(enabled);
+    }
+    
+    ImGui::SameLine();
+    if (ImGui::Button(m_paused ? "Resume" : "Pause")) {
+        if (m_paused) {
+            m_paused = false;
+        } else {
+            SelectFrame(0);
+        }
+    }
+    
+    ImGui::SameLine();
+    if (profiler.IsCapturing()) {
+        if (ImGui::Button("Stop Capture")) {
+            profiler.EndCapture();
+        }
+        ImGui::SameLine();
+        ImGui::Text("%zu frames", profiler.GetCapturedFrameCount());
+    } else if (ImGui::Button("Capture")) {
+        profiler.BeginCapture();
+    }
+    
+    ImGui::SameLine();
+    if (ImGui::Button("Export Trace")) {
+        m_status = profiler.ExportChromeTrace(m_exportPath) ? "Wrote " + m_exportPath : "Export failed";
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Chrome trace_event JSON (open in chrome://tracing or Perfetto)");
+    }
+    
+    if (!m_status.empty()) {
+        ImGui::SameLine();
+        ImGui::TextUnformatted(m_status.c_str());
+    }
+}
+
+void ProfilerPanel::RenderFrameGraph() {
+    Profiler& profiler = Profiler::Instance();
+    size_t count = profiler.GetFrameCount();
+    
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::SliderFloat("Graph scale (ms)", &m_graphScaleMs, 5.0f, 100.0f, "%.0f");
+    
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    float width = std::max(ImGui::GetContentRegionAvail().x, 50.0f);
+    ImGui::InvisibleButton("FrameGraph", ImVec2(width, GRAPH_HEIGHT));
+    bool hovered = ImGui::IsItemHovered();
+    bool clicked = ImGui::IsItemClicked();
+    
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + GRAPH_HEIGHT), IM_COL32(30, 30, 30, 255));
+    
+    // 60 and 30 FPS budgets
+    for (float budget : {16.6f, 33.3f}) {
+        if (budget > m_graphScaleMs) continue;
+        float y = origin.y + GRAPH_HEIGHT * (1.0f - budget / m_graphScaleMs);
+        drawList->AddLine(ImVec2(origin.x, y), ImVec2(origin.x + width, y), IM_COL32(200, 200, 80, 120));
+    }
+    
+    if (count == 0) return;
+    
+    // Newest frame on the right
+    float barWidth = width / static_cast<float>(Profiler::DEFAULT_HISTORY_FRAMES);
+    for (size_t ago = 0; ago < count; ++ago) {
+        const ProfileFrame* frame = profiler.GetFrame(ago);
+        float ms = static_cast<float>(frame->GetDurationMs());
+        float height = std::min(ms / m_graphScaleMs, 1.0f) * GRAPH_HEIGHT;
+        float x1 = origin.x + width - static_cast<float>(ago) * barWidth;
+        float x0 = x1 - barWidth;
+        if (x1 < origin.x) break;
+        
+        bool selected = m_paused && frame->frameIndex == m_frozenFrame.frameIndex;
+        ImU32 color = selected ? IM_COL32(255, 255, 255, 255)
+                    : ms > 33.3f ? IM_COL32(220, 80, 60, 255)
+                    : ms > 16.6f ? IM_COL32(220, 170, 60, 255)
+                    : IM_COL32(90, 180, 90, 255);
+        drawList->AddRectFilled(ImVec2(x0, origin.y + GRAPH_HEIGHT - height), ImVec2(std::max(x1 - 1.0f, x0 + 1.0f), origin.y + GRAPH_HEIGHT), color);
+    }
+    
+    if (hovered) {
+        float mouseX = ImGui::GetIO().MousePos.x;
+        size_t ago = static_cast<size_t>(std::max(0.0f, (origin.x + width - mouseX) / barWidth));
+        if (const ProfileFrame* frame = profiler.GetFrame(ago)) {
+            ImGui::SetTooltip("Frame %llu: %.2f ms\nClick to inspect", static_cast<unsigned long long>(frame->frameIndex),
+                              frame->GetDurationMs());
+            if (clicked) {
+                SelectFrame(ago);
+            }
+        }
+    }
+}
+
+void ProfilerPanel::RenderFlameChart(const ProfileFrame& frame) {
+    ImGui::SetNextItemWidth(150.0f);
+    ImGui::SliderFloat("Zoom", &m_zoom, 1.0f, 64.0f, "%.1fx", ImGuiSliderFlags_Logarithmic);
+    
+    ImGui::BeginChild("FlameChart", ImVec2(0, 0), true, ImGuiWindowFlags_HorizontalScrollbar);
+    
+    Profiler& profiler = Profiler::Instance();
+    const float labelWidth = 90.0f;
+    const float chartWidth = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 100.0f) * m_zoom;
+    const uint64_t frameStart = frame.start;
+    const double frameLength = static_cast<double>(std::max<uint64_t>(frame.end - frame.start, 1));
+    
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 mouse = ImGui::GetIO().MousePos;
+    const ProfileZone* hoveredZone = nullptr;
+    
+    // Zones are grouped by thread; draw one lane per thread, one row per depth
+    size_t begin = 0;
+    while (begin < frame.zones.size()) {
+        uint32_t thread = frame.zones[begin].threadIndex;
+        size_t end = begin;
+        uint32_t maxDepth = 0;
+        while (end < frame.zones.size() && frame.zones[end].threadIndex == thread) {
+            maxDepth = std::max(maxDepth, frame.zones[end].depth);
+            ++end;
+        }
+        
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        float laneHeight = (maxDepth + 1) * ROW_HEIGHT;
+        ImGui::TextUnformatted(profiler.GetThreadName(thread).c_str());
+        ImGui::SetCursorScreenPos(origin);
+        ImGui::Dummy(ImVec2(labelWidth + chartWidth, laneHeight + 4.0f));
+        
+        float chartX = origin.x + labelWidth;
+        for (size_t i = begin; i < end; ++i) {
+            const ProfileZone& zone = frame.zones[i];
+            // Zones that straddle the frame boundary are clipped to it
+            double startT = (static_cast<double>(zone.start) - static_cast<double>(frameStart)) / frameLength;
+            double endT = (static_cast<double>(zone.end) - static_cast<double>(frameStart)) / frameLength;
+            float x0 = chartX + static_cast<float>(std::clamp(startT, 0.0, 1.0)) * chartWidth;
+            float x1 = chartX + static_cast<float>(std::clamp(endT, 0.0, 1.0)) * chartWidth;
+            if (x1 - x0 < 1.0f) x1 = x0 + 1.0f;
+            float y0 = origin.y + zone.depth * ROW_HEIGHT;
+            float y1 = y0 + ROW_HEIGHT - 1.0f;
+            
+            drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ZoneColor(zone.name));
+            if (x1 - x0 > 30.0f) {
+                drawList->PushClipRect(ImVec2(x0, y0), ImVec2(x1, y1), true);
+                drawList->AddText(ImVec2(x0 + 3.0f, y0 + 2.0f), IM_COL32(20, 20, 20, 255), zone.name);
+                drawList->PopClipRect();
+            }
+            
+            if (mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1 && ImGui::IsWindowHovered()) {
+                hoveredZone = &zone;
+            }
+        }
+        
+        begin = end;
+    }
+    
+    if (hoveredZone) {
+        ImGui::SetTooltip("%s\n%.3f ms (depth %u)", hoveredZone->name, ToMs(hoveredZone->end - hoveredZone->start),
+                          hoveredZone->depth);
+    }
+    
+    ImGui::EndChild();
+}
+
+void ProfilerPanel::RenderTopZones(const ProfileFrame& frame) {
+    // Inclusive time per zone name
+    m_totals.clear();
+    for (const ProfileZone& zone : frame.zones) {
+        auto it = std::find_if(m_totals.begin(), m_totals.end(), [&zone](const ZoneTotal& total) {
+            return total.name == zone.name;
+        });
+        if (it == m_totals.end()) {
+            m_totals.push_back(ZoneTotal{zone.name, zone.end - zone.start, 1});
+        } else {
+            it->total += zone.end - zone.start;
+            it->calls++;
+        }
+    }
+    std::sort(m_totals.begin(), m_totals.end(), [](const ZoneTotal& a, const ZoneTotal& b) {
+        return a.total > b.total;
+    });
+    
+    if (ImGui::BeginTable("TopZones", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+        ImGui::TableSetupColumn("Zone");
+        ImGui::TableSetupColumn("Total (ms)");
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableHeadersRow();
+        
+        size_t shown = std::min(m_totals.size(), TOP_ZONE_COUNT);
+        for (size_t i = 0; i < shown; ++i) {
+            const ZoneTotal& total = m_totals[i];
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(total.name);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%.3f", ToMs(total.total));
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%u", total.calls);
+        }
+        ImGui::EndTable();
+    }
+}
+
+void ProfilerPanel::RenderAssetMemory() {
+    auto assets = ServiceLocator::Instance().GetService<AssetManager>();
+    if (!assets) {
+        ImGui::TextUnformatted("No asset manager");
+        return;
+    }
+    
+    if (ImGui::BeginTable("AssetMemory", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+        ImGui::TableSetupColumn("Type");
+        ImGui::TableSetupColumn("Resident");
+        ImGui::TableSetupColumn("CPU (MB)");
+        ImGui::TableSetupColumn("GPU (MB)");
+        ImGui::TableSetupColumn("Budget");
+        ImGui::TableSetupColumn("Evicted");
+        ImGui::TableHeadersRow();
+        
+        for (const auto& [type, usage] : assets->GetMemoryUsage()) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(AssetTypeName(type));
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%zu", usage.residentCount);
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.2f", ToMB(usage.cpuBytes));
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text("%.2f", ToMB(usage.gpuBytes));
+            ImGui::TableSetColumnIndex(4);
+            if (usage.budgetBytes == 0) {
+                ImGui::TextUnformatted("-");
+            } else {
+                float fraction = static_cast<float>(usage.GetTotalBytes()) / static_cast<float>(usage.budgetBytes);
+                char label[32];
+                snprintf(label, sizeof(label), "%.0f MB", ToMB(usage.budgetBytes));
+                ImGui::ProgressBar(std::min(fraction, 1.0f), ImVec2(-1.0f, 0.0f), label);
+            }
+            ImGui::TableSetColumnIndex(5);
+            ImGui::Text("%zu", usage.evictions);
+        }
+        ImGui::EndTable();
+    }
+    
+    ImGui::Text("Waiting for release: %zu", assets->GetRetiredAssetCount());
+}
+
+void ProfilerPanel::RenderFrameMemory(const ProfileFrame& frame) {
+    // Totals the frame arenas reported at the end of the selected frame
+    for (const ProfileCounter& counter : frame.counters) {
+        ImGui::Text("%s: %.1f", counter.name, counter.value);
+    }
+    if (frame.counters.empty()) {
+        ImGui::TextUnformatted("No counters recorded for this frame");
+    }
+    ImGui::Separator();
+    
+    FrameArena::GetStats(m_arenaStats);
+    if (ImGui::BeginTable("FrameArenas", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+        ImGui::TableSetupColumn("Arena");
+        ImGui::TableSetupColumn("Capacity (MB)");
+        ImGui::TableSetupColumn("Peak (KB)");
+        ImGui::TableSetupColumn("Allocations");
+        ImGui::TableSetupColumn("Live");
+        ImGui::TableSetupColumn("Heap blocks");
+        ImGui::TableHeadersRow();
+        
+        for (const FrameArenaStats& stats : m_arenaStats) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            if (stats.mainThread) {
+                ImGui::Text("%u (main)", stats.arenaIndex);
+            } else {
+                ImGui::Text("%u", stats.arenaIndex);
+            }
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%.2f", ToMB(stats.capacity));
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.1f", static_cast<double>(stats.peakBytes) / 1024.0);
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text("%zu", stats.allocations);
+            ImGui::TableSetColumnIndex(4);
+            ImGui::Text("%zu", stats.liveAllocations);
+            ImGui::TableSetColumnIndex(5);
+            ImGui::Text("%zu", stats.heapBlocks);
+        }
+        ImGui::EndTable();
+    }
+}
+
+const ProfileFrame* ProfilerPanel::GetSelectedFrame() const {
+    return m_paused ? &m_frozenFrame : Profiler::Instance().GetFrame(0);
+}
+
+void ProfilerPanel::SelectFrame(size_t framesAgo) {
+    if (const ProfileFrame* frame = Profiler::Instance().GetFrame(framesAgo)) {
+        m_frozenFrame = *frame;
+        m_paused = true;
+    }
+}
+
+} // namespace BGE
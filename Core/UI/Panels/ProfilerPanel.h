@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../Framework/Panel.h"
+#include "../../Profiling/Profiler.h"
+#include "../../Memory/FrameArena.h"
+#include <string>
+#include <vector>
+
+namespace BGE {
+
+// Frame time history and a per-thread flame chart of the profiler's zones
+class ProfilerPanel : public Panel {
+public:
+    ProfilerPanel(const std::string& name);
+    
+    void Initialize() override;
+    void OnRender() override;
+
+private:
+    void RenderToolbar();
+    void RenderFrameGraph();
+    void RenderFlameChart(const ProfileFrame& frame);
+    void RenderTopZones(const ProfileFrame& frame);
+    void RenderAssetMemory();
+    void RenderFrameMemory(const ProfileFrame& frame);
+    
+    // Frame being inspected: the latest one, or a frozen copy while paused
+    const ProfileFrame* GetSelectedFrame() const;
+    void SelectFrame(size_t framesAgo);
+    
+    struct ZoneTotal {
+        const char* name;
+        uint64_t total;
+        uint32_t calls;
+    };
+    
+    bool m_paused = false;
+    ProfileFrame m_frozenFrame;
+    float m_zoom = 1.0f;
+    float m_graphScaleMs = 33.3f;
+    std::string m_exportPath = "profile_trace.json";
+    std::string m_status;
+    std::vector<ZoneTotal> m_totals;
+    std::vector<FrameArenaStats> m_arenaStats;
+    
+    static constexpr float ROW_HEIGHT = 18.0f;
+    static constexpr float GRAPH_HEIGHT = 60.0f;
+    static constexpr size_t TOP_ZONE_COUNT = 20;
+};
+
+} // namespace BGE
@@ -16,6 +16,7 @@
 #include <cmath>
 #include <cfloat>
 #include <unordered_map>
+#include <unordered_set>
 #include <GLFW/glfw3.h>
 
 namespace BGE {
@@ -74,14 +75,13 @@ void SceneViewPanel::RegisterEventListeners() {
     auto eventBusPtr = ServiceLocator::Instance().GetService<EventBus>();
     m_eventBus = eventBusPtr.get();
     if (m_eventBus) {
-        m_eventBus->Subscribe<EntitySelectionChangedEvent>([this](const EntitySelectionChangedEvent& event) {
-            OnEntitySelectionChanged(event);
-        });
+        m_eventSubscriptions.emplace_back(m_eventBus,
+            m_eventBus->Subscribe<EntitySelectionChangedEvent, &SceneViewPanel::OnEntitySelectionChanged>(this));
     }
 }
 
 void SceneViewPanel::UnregisterEventListeners() {
-    // EventBus will handle cleanup when it's destroyed
+    m_eventSubscriptions.clear();
 }
 
 void SceneViewPanel::OnEntitySelectionChanged(const EntitySelectionChangedEvent& event) {
@@ -223,8 +223,17 @@ void SceneViewPanel::RenderSceneContent() {
         }
         
         // Draw entities
+        m_pickIndex.Refresh();
+        CacheVisibleEntities();
         RenderEntitiesOverlay(drawList);
         
+        // Highlight what a click would select
+        m_hoveredEntity = INVALID_ENTITY;
+        if (isViewportHovered && !m_panning && !m_boxSelecting) {
+            m_hoveredEntity = GetEntityAtPosition(ScreenToWorld(ImGui::GetMousePos()));
+        }
+        RenderHoverOutline(drawList);
+        
         // Draw gizmos
         if (m_showGizmos) {
             RenderGizmos();
@@ -272,6 +281,9 @@ void SceneViewPanel::RenderSceneContent() {
                 }
             }
         }
+        
+        // Runs while not hovered too, so releasing outside the viewport still ends the box
+        UpdateBoxSelection();
     }
 }
 
@@ -367,13 +379,49 @@ void SceneViewPanel::HandleEntitySelection(ImVec2 mousePos) {
         if (entityId != INVALID_ENTITY) {
             bool ctrlHeld = ImGui::GetIO().KeyCtrl;
             SelectEntity(entityId, ctrlHeld);
-        } else if (!ImGui::GetIO().KeyCtrl) {
-            // Clear selection if clicking empty space without Ctrl
+        } else {
+            // Empty space: dragging selects a box, releasing in place clears the selection
+            m_boxSelecting = true;
+            m_mousePressPos = Vector2(mousePos.x, mousePos.y);
+        }
+    }
+}
+
+void SceneViewPanel::UpdateBoxSelection() {
+    if (!m_boxSelecting) return;
+    
+    ImVec2 mousePos = ImGui::GetMousePos();
+    ImVec2 rectMin(std::min(m_mousePressPos.x, mousePos.x), std::min(m_mousePressPos.y, mousePos.y));
+    ImVec2 rectMax(std::max(m_mousePressPos.x, mousePos.x), std::max(m_mousePressPos.y, mousePos.y));
+    
+    if (ImGui::IsMouseDown(ImGuiMouseButton_Left)) {
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        drawList->PushClipRect(m_viewportScreenPos, 
+                               ImVec2(m_viewportScreenPos.x + m_viewportWidth, m_viewportScreenPos.y + m_viewportHeight), true);
+        drawList->AddRectFilled(rectMin, rectMax, IM_COL32(100, 150, 255, 40));
+        drawList->AddRect(rectMin, rectMax, IM_COL32(100, 150, 255, 200));
+        drawList->PopClipRect();
+        return;
+    }
+    
+    m_boxSelecting = false;
+    bool ctrlHeld = ImGui::GetIO().KeyCtrl;
+    float threshold = ImGui::GetIO().MouseDragThreshold;
+    
+    if (rectMax.x - rectMin.x < threshold && rectMax.y - rectMin.y < threshold) {
+        // Clear selection if clicking empty space without Ctrl
+        if (!ctrlHeld) {
             m_selectedEntities.clear();
             m_primarySelection = INVALID_ENTITY;
             BroadcastSelectionChanged();
         }
+        return;
     }
+    
+    // Screen and world y both grow downwards, so the corners map straight across
+    SpatialBounds worldBounds(ScreenToWorld(rectMin), ScreenToWorld(rectMax));
+    m_pickIndex.QueryBounds(worldBounds, m_queryResults);
+    SelectEntities(m_queryResults, ctrlHeld);
 }
 
 void SceneViewPanel::RenderGrid() {
@@ -584,29 +632,48 @@ void SceneViewPanel::RenderGridOverlay(ImDrawList* drawList) {
     drawList->AddLine(yStart, yEnd, IM_COL32(100, 255, 100, 200), 3.0f);
 }
 
+void SceneViewPanel::CacheVisibleEntities() {
+    m_visibleEntities.clear();
+    
+    // The viewport plus a 50 pixel margin, so shapes at the edge are still drawn
+    const float margin = 50.0f;
+    Vector2 worldMin = ScreenToWorld(ImVec2(m_viewportScreenPos.x - margin, m_viewportScreenPos.y - margin));
+    Vector2 worldMax = ScreenToWorld(ImVec2(m_viewportScreenPos.x + m_viewportWidth + margin, 
+                                            m_viewportScreenPos.y + m_viewportHeight + margin));
+    m_pickIndex.QueryBounds(SpatialBounds(worldMin, worldMax), m_queryResults);
+    
+    m_visibleEntities.reserve(m_queryResults.size());
+    SpatialBounds bounds;
+    for (EntityID entityId : m_queryResults) {
+        if (!m_pickIndex.TryGetBounds(entityId, bounds)) continue;
+        
+        VisibleEntity visible;
+        visible.entity = entityId;
+        visible.screenPos = WorldToScreen((bounds.min + bounds.max) * 0.5f);
+        visible.screenMin = WorldToScreen(bounds.min);
+        visible.screenMax = WorldToScreen(bounds.max);
+        m_visibleEntities.push_back(visible);
+    }
+}
+
 void SceneViewPanel::RenderEntitiesOverlay(ImDrawList* drawList) {
     auto& entityManager = EntityManager::Instance();
     
-    auto allEntities = entityManager.GetAllEntityIDs();
+    std::unordered_set<EntityID> selected(m_selectedEntities.begin(), m_selectedEntities.end());
     
-    for (EntityID entityId : allEntities) {
+    for (const VisibleEntity& visible : m_visibleEntities) {
+        EntityID entityId = visible.entity;
         auto* transform = entityManager.GetComponent<TransformComponent>(entityId);
         if (!transform) continue;
         
-        ImVec2 screenPos = WorldToScreen(Vector2(transform->position.x, transform->position.y));
-        
-        // Skip if outside viewport
-        if (screenPos.x < m_viewportScreenPos.x - 50 || screenPos.x > m_viewportScreenPos.x + m_viewportWidth + 50 ||
-            screenPos.y < m_viewportScreenPos.y - 50 || screenPos.y > m_viewportScreenPos.y + m_viewportHeight + 50) {
-            continue;
-        }
+        ImVec2 screenPos = visible.screenPos;
         
         // Determine entity appearance based on components
         auto* sprite = entityManager.GetComponent<SpriteComponent>(entityId);
         auto* material = entityManager.GetComponent<MaterialComponent>(entityId);
         auto* light = entityManager.GetComponent<LightComponent>(entityId);
         
-        bool isSelected = std::find(m_selectedEntities.begin(), m_selectedEntities.end(), entityId) != m_selectedEntities.end();
+        bool isSelected = selected.count(entityId) > 0;
         
         if (material) {
             // Material entity - square
@@ -710,6 +777,19 @@ void SceneViewPanel::RenderEntitiesOverlay(ImDrawList* drawList) {
     }
 }
 
+void SceneViewPanel::RenderHoverOutline(ImDrawList* drawList) {
+    if (m_hoveredEntity == INVALID_ENTITY) return;
+    
+    for (const VisibleEntity& visible : m_visibleEntities) {
+        if (visible.entity != m_hoveredEntity) continue;
+        
+        drawList->AddRect(ImVec2(visible.screenMin.x - 3, visible.screenMin.y - 3),
+                         ImVec2(visible.screenMax.x + 3, visible.screenMax.y + 3),
+                         IM_COL32(255, 255, 255, 120), 0.0f, 0, 1.0f);
+        return;
+    }
+}
+
 void SceneViewPanel::RenderEditorOverlays() {
     if (m_showSelectionOutline) {
         RenderSelectionOutlines();
@@ -775,11 +855,9 @@ void SceneViewPanel::RenderEntityIcons() {
     auto& entityManager = EntityManager::Instance();
     ImDrawList* drawList = ImGui::GetWindowDrawList();
     
-    for (EntityID entityId : entityManager.GetAllEntityIDs()) {
-        auto* transform = entityManager.GetComponent<TransformComponent>(entityId);
-        if (!transform) continue;
-        
-        ImVec2 screenPos = WorldToScreen(Vector2(transform->position.x, transform->position.y));
+    for (const VisibleEntity& visible : m_visibleEntities) {
+        EntityID entityId = visible.entity;
+        ImVec2 screenPos = visible.screenPos;
         
         // Determine icon text based on components and name
         const char* icon = "[?]"; // Default unknown
@@ -864,76 +942,8 @@ void SceneViewPanel::ResetCamera() {
 }
 
 EntityID SceneViewPanel::GetEntityAtPosition(Vector2 worldPos) {
-    auto& entityManager = EntityManager::Instance();
-    
-    // Check entities in reverse order (top to bottom) for proper layering
-    EntityID selectedEntity = INVALID_ENTITY;
-    float minDistance = FLT_MAX;
-    
-    for (EntityID entityId : entityManager.GetAllEntityIDs()) {
-        auto* transform = entityManager.GetComponent<TransformComponent>(entityId);
-        if (!transform) continue;
-        
-        Vector2 entityPos(transform->position.x, transform->position.y);
-        
-        // Check based on entity type for more accurate selection
-        bool isHit = false;
-        float hitDistance = FLT_MAX;
-        
-        auto* sprite = entityManager.GetComponent<SpriteComponent>(entityId);
-        auto* material = entityManager.GetComponent<MaterialComponent>(entityId);
-        auto* light = entityManager.GetComponent<LightComponent>(entityId);
-        
-        if (material) {
-            // Material entities - check square bounds
-            float size = 16.0f * transform->scale.x;
-            float halfSize = size / 2.0f;
-            
-            if (worldPos.x >= entityPos.x - halfSize && worldPos.x <= entityPos.x + halfSize &&
-                worldPos.y >= entityPos.y - halfSize && worldPos.y <= entityPos.y + halfSize) {
-                isHit = true;
-                hitDistance = 0.0f; // Inside bounds
-            }
-        }
-        else if (sprite && sprite->visible) {
-            // Sprite entities - check rectangle bounds
-            float halfWidth = (sprite->size.x * transform->scale.x) / 2.0f;
-            float halfHeight = (sprite->size.y * transform->scale.y) / 2.0f;
-            
-            if (worldPos.x >= entityPos.x - halfWidth && worldPos.x <= entityPos.x + halfWidth &&
-                worldPos.y >= entityPos.y - halfHeight && worldPos.y <= entityPos.y + halfHeight) {
-                isHit = true;
-                hitDistance = 0.0f; // Inside bounds
-            }
-        }
-        else if (light) {
-            // Light entities - check circle bounds
-            float radius = (light->type == LightComponent::Point) ? 10.0f : 20.0f;
-            float distance = sqrtf((worldPos.x - entityPos.x) * (worldPos.x - entityPos.x) + 
-                                  (worldPos.y - entityPos.y) * (worldPos.y - entityPos.y));
-            if (distance <= radius) {
-                isHit = true;
-                hitDistance = distance;
-            }
-        }
-        else {
-            // Default entities - check distance to center
-            float distance = sqrtf((worldPos.x - entityPos.x) * (worldPos.x - entityPos.x) + 
-                                  (worldPos.y - entityPos.y) * (worldPos.y - entityPos.y));
-            if (distance <= 15.0f) { // 15 pixel radius for default entities
-                isHit = true;
-                hitDistance = distance;
-            }
-        }
-        
-        // Update selection if this entity is closer
-        if (isHit && hitDistance < minDistance) {
-            minDistance = hitDistance;
-            selectedEntity = entityId;
-        }
-    }
-    
-    return selectedEntity;
+    // Only the shapes in the grid cells under the point are tested
+    return m_pickIndex.Pick(worldPos);
 }
 
 void SceneViewPanel::SelectEntity(EntityID entityId, bool addToSelection) {
@@ -954,6 +964,25 @@ void SceneViewPanel::SelectEntity(EntityID entityId, bool addToSelection) {
     BroadcastSelectionChanged();
 }
 
+void SceneViewPanel::SelectEntities(const std::vector<EntityID>& entities, bool addToSelection) {
+    if (!addToSelection) {
+        m_selectedEntities.clear();
+    }
+    
+    std::unordered_set<EntityID> selected(m_selectedEntities.begin(), m_selectedEntities.end());
+    for (EntityID entityId : entities) {
+        if (selected.insert(entityId).second) {
+            m_selectedEntities.push_back(entityId);
+        }
+    }
+    
+    if (!addToSelection || m_primarySelection == INVALID_ENTITY) {
+        m_primarySelection = m_selectedEntities.empty() ? INVALID_ENTITY : m_selectedEntities.front();
+    }
+    
+    BroadcastSelectionChanged();
+}
+
 void SceneViewPanel::BroadcastSelectionChanged() {
     if (!m_eventBus) return;
     
@@ -11,6 +11,7 @@
 #include "../../Math/Ray.h"
 #include "../Gizmos/TransformGizmo.h"
 #include "../Gizmos/Gizmo2D.h"
+#include "../ScenePickIndex.h"
 #include <vector>
 #include <unordered_set>
 #include <memory>
@@ -39,7 +40,7 @@ public:
     // Editor camera access
     Vector2 GetEditorCameraPosition() const { return m_editorCameraPos; }
     float GetEditorCameraZoom() const { return m_editorCameraZoom; }
-    
+
 private:
     // Event handling
     void RegisterEventListeners();
@@ -58,10 +59,13 @@ private:
     void RenderWorldPixels(ImDrawList* drawList, SimulationWorld* world);
     void RenderGridOverlay(ImDrawList* drawList);
     void RenderEntitiesOverlay(ImDrawList* drawList);
+    void RenderHoverOutline(ImDrawList* drawList);
+    void CacheVisibleEntities();
     
     // Editor camera controls
     void HandleEditorCameraInput();
     void HandleEntitySelection(ImVec2 mousePos);
+    void UpdateBoxSelection();
     
     // Camera state
     void UpdateEditorCamera();
@@ -72,6 +76,7 @@ private:
     // Selection helpers
     EntityID GetEntityAtPosition(Vector2 worldPos);
     void SelectEntity(EntityID entityId, bool addToSelection = false);
+    void SelectEntities(const std::vector<EntityID>& entities, bool addToSelection);
     void BroadcastSelectionChanged();
     
     // Coordinate conversion
@@ -104,6 +109,22 @@ private:
     std::vector<EntityID> m_selectedEntities;
     EntityID m_primarySelection = INVALID_ENTITY;
     
+    EntityID m_hoveredEntity = INVALID_ENTITY;
+    
+    // Entity bounds for picking, refreshed once per frame before anything is drawn
+    ScenePickIndex m_pickIndex;
+    
+    // Entities inside the viewport this frame with their screen position and
+    // rectangle, shared by the overlays and the hover outline
+    struct VisibleEntity {
+        EntityID entity;
+        ImVec2 screenPos;
+        ImVec2 screenMin;
+        ImVec2 screenMax;
+    };
+    std::vector<VisibleEntity> m_visibleEntities;
+    std::vector<EntityID> m_queryResults;
+    
     // Display options
     bool m_showGrid = true;
     bool m_showEntityIcons = true;
@@ -115,8 +136,12 @@ private:
     bool m_mousePressed = false;
     Vector2 m_mousePressPos{0.0f, 0.0f};
     
+    // Rubber-band selection, started by pressing on empty space
+    bool m_boxSelecting = false;
+    
     // Event bus for selection synchronization
     EventBus* m_eventBus = nullptr;
+    std::vector<EventSubscription> m_eventSubscriptions;
     
     // Transform gizmo
     std::unique_ptr<TransformGizmo> m_transformGizmo;
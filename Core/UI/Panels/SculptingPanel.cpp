@@ -151,7 +151,6 @@ void SculptingPanel::RenderSculptingContent() {
         renderer->BeginRenderToTexture();
         renderer->BeginFrame();
         renderer->RenderWorld(world.get());
-        renderer->RenderParticles();
         renderer->EndFrame();
         renderer->EndRenderToTexture();
         
@@ -0,0 +1,155 @@
+#include "ScenePickIndex.h"
+#include "../Components.h"
+#include "../Entity.h"
+#include "../ECS/EntityManager.h"
+#include "../ECS/CachedEntityQuery.h"
+#include "../Profiling/Profiler.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace BGE {
+
+ScenePickIndex::ScenePickIndex() = default;
+ScenePickIndex::~ScenePickIndex() = default;
+
+void ScenePickIndex::Refresh() {
+    BGE_PROFILE_SCOPE("ScenePickIndex::Refresh");
+    auto& entityManager = EntityManager::Instance();
+    if (!m_query) {
+        CachedQueryBuilder builder(&entityManager);
+        m_query = builder.With<TransformComponent>().Build();
+    }
+    
+    ++m_pass;
+    m_walked.clear();
+    m_walked.reserve(m_tracked.size());
+    auto& archetypeManager = entityManager.GetArchetypeManager();
+    QueryResult result = m_query->Execute();
+    
+    // Component columns are read per archetype, so the walk costs no per-entity lookups
+    for (uint32_t archetypeIdx : result.GetArchetypeIndices()) {
+        Archetype* archetype = archetypeManager.GetArchetype(archetypeIdx);
+        if (!archetype || archetype->GetEntityCount() == 0) continue;
+        
+        auto* transforms = archetype->GetComponentStorage<TransformComponent>();
+        if (!transforms) continue;
+        auto* materials = archetype->GetComponentStorage<MaterialComponent>();
+        auto* sprites = archetype->GetComponentStorage<SpriteComponent>();
+        auto* lights = archetype->GetComponentStorage<LightComponent>();
+        
+        const auto& entities = archetype->GetEntities();
+        size_t count = std::min(entities.size(), transforms->Size());
+        for (size_t row = 0; row < count; ++row) {
+            EntityID entity = entities[row];
+            const TransformComponent& transform = transforms->Get(row);
+            
+            // Same precedence as the overlay: material, visible sprite, light, marker
+            Vector2 halfExtents;
+            bool circle = false;
+            if (materials && row < materials->Size()) {
+                float half = MATERIAL_SIZE * std::abs(transform.scale.x) * 0.5f;
+                halfExtents = Vector2(half, half);
+            } else if (sprites && row < sprites->Size() && sprites->Get(row).visible) {
+                const SpriteComponent& sprite = sprites->Get(row);
+                halfExtents = Vector2(std::abs(sprite.size.x * transform.scale.x) * 0.5f,
+                                      std::abs(sprite.size.y * transform.scale.y) * 0.5f);
+            } else {
+                float radius = MARKER_RADIUS;
+                if (lights && row < lights->Size()) {
+                    radius = lights->Get(row).type == LightComponent::Point ? POINT_LIGHT_RADIUS
+                                                                              : DIRECTIONAL_LIGHT_RADIUS;
+                }
+                halfExtents = Vector2(radius, radius);
+                circle = true;
+            }
+            Vector2 center(transform.position.x, transform.position.y);
+            
+            uint32_t index = entity.GetIndex();
+            if (index >= m_shapes.size()) {
+                m_shapes.resize(index + 1);
+            }
+            PickShape& shape = m_shapes[index];
+            if (shape.entity != entity) {
+                // New entity, or a new generation in a destroyed entity's slot
+                m_index.Insert(entity, center, halfExtents);
+            } else if (shape.center.x != center.x || shape.center.y != center.y ||
+                       shape.halfExtents.x != halfExtents.x || shape.halfExtents.y != halfExtents.y) {
+                m_index.Update(entity, center, halfExtents);
+            }
+            
+            shape.entity = entity;
+            shape.center = center;
+            shape.halfExtents = halfExtents;
+            shape.circle = circle;
+            shape.order = static_cast<uint32_t>(m_walked.size());
+            shape.pass = m_pass;
+            m_walked.push_back(entity);
+        }
+    }
+    
+    // Whatever the walk did not reach was destroyed or lost its transform
+    for (EntityID entity : m_tracked) {
+        PickShape& shape = m_shapes[entity.GetIndex()];
+        if (shape.entity == entity && shape.pass != m_pass) {
+            m_index.Remove(entity);
+            shape = PickShape();
+        }
+    }
+    m_tracked.swap(m_walked);
+}
+
+void ScenePickIndex::Clear() {
+    m_index.Clear();
+    m_shapes.clear();
+    m_tracked.clear();
+    m_walked.clear();
+}
+
+EntityID ScenePickIndex::Pick(const Vector2& worldPos) const {
+    m_candidates.clear();
+    m_index.QueryAABB(SpatialBounds(worldPos, worldPos), m_candidates);
+    
+    EntityID picked = INVALID_ENTITY;
+    float minDistance = FLT_MAX;
+    uint32_t pickedOrder = 0;
+    for (EntityID entity : m_candidates) {
+        const PickShape& shape = m_shapes[entity.GetIndex()];
+        float distance = 0.0f;
+        if (!HitTest(shape, worldPos, distance)) continue;
+        
+        if (distance < minDistance || (distance == minDistance && shape.order > pickedOrder)) {
+            minDistance = distance;
+            pickedOrder = shape.order;
+            picked = entity;
+        }
+    }
+    return picked;
+}
+
+void ScenePickIndex::QueryBounds(const SpatialBounds& bounds, std::vector<EntityID>& results) const {
+    results.clear();
+    m_index.QueryAABB(bounds, results);
+    std::sort(results.begin(), results.end(), [this](EntityID a, EntityID b) {
+        return m_shapes[a.GetIndex()].order < m_shapes[b.GetIndex()].order;
+    });
+}
+
+bool ScenePickIndex::TryGetBounds(EntityID entity, SpatialBounds& bounds) const {
+    return m_index.TryGetBounds(entity, bounds);
+}
+
+bool ScenePickIndex::HitTest(const PickShape& shape, const Vector2& point, float& distance) const {
+    float dx = point.x - shape.center.x;
+    float dy = point.y - shape.center.y;
+    if (!shape.circle) {
+        // Anywhere inside a square or rectangle counts as a direct hit
+        distance = 0.0f;
+        return std::abs(dx) <= shape.halfExtents.x && std::abs(dy) <= shape.halfExtents.y;
+    }
+    
+    distance = std::sqrt(dx * dx + dy * dy);
+    return distance <= shape.halfExtents.x;
+}
+
+} // namespace BGE
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../ECS/EntityID.h"
+#include "../ECS/SpatialIndex.h"
+#include "../Math/Vector2.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace BGE {
+
+class CachedEntityQuery;
+
+// What the scene view can click on, hover or box-select.
+//
+// Refresh() walks the transform archetypes once per frame and keeps each
+// entity's pick shape in a SpatialIndex: the square of a material, the
+// rectangle of a visible sprite, the circle of a light or of the marker
+// drawn for anything else. The index is only touched for shapes that moved
+// or changed, and for entities that appeared or went away. Pick() and
+// QueryBounds() then look at the grid cells under the point or rectangle
+// and run the exact test on those candidates only, so a click costs the
+// entities near the cursor rather than the size of the scene.
+class ScenePickIndex {
+public:
+    ScenePickIndex();
+    ~ScenePickIndex();
+    
+    ScenePickIndex(const ScenePickIndex&) = delete;
+    ScenePickIndex& operator=(const ScenePickIndex&) = delete;
+    
+    void Refresh();
+    void Clear();
+    
+    // Entity under the point: the closest center among the shapes containing it,
+    // and on a tie the one drawn last (on top)
+    EntityID Pick(const Vector2& worldPos) const;
+    // Entities whose shape overlaps the rectangle, in draw order
+    void QueryBounds(const SpatialBounds& bounds, std::vector<EntityID>& results) const;
+    bool TryGetBounds(EntityID entity, SpatialBounds& bounds) const;
+    
+    size_t GetEntityCount() const { return m_tracked.size(); }
+    
+    // Pick radii in world units, matching the icons the scene view draws
+    static constexpr float POINT_LIGHT_RADIUS = 10.0f;
+    static constexpr float DIRECTIONAL_LIGHT_RADIUS = 20.0f;
+    static constexpr float MARKER_RADIUS = 15.0f;
+    static constexpr float MATERIAL_SIZE = 16.0f;
+
+private:
+    struct PickShape {
+        EntityID entity = INVALID_ENTITY;
+        Vector2 center;
+        Vector2 halfExtents;    // radius in both for circles
+        bool circle = false;
+        uint32_t order = 0;     // position in the last walk, which is the draw order
+        uint64_t pass = 0;      // last Refresh() that saw the entity
+    };
+    
+    bool HitTest(const PickShape& shape, const Vector2& point, float& distance) const;
+    
+    std::unique_ptr<CachedEntityQuery> m_query;
+    SpatialIndex m_index;
+    std::vector<PickShape> m_shapes;    // indexed by EntityID::GetIndex()
+    std::vector<EntityID> m_tracked;    // entities in the index, in draw order
+    std::vector<EntityID> m_walked;     // scratch for the next m_tracked
+    mutable std::vector<EntityID> m_candidates;
+    uint64_t m_pass = 0;
+};
+
+} // namespace BGE
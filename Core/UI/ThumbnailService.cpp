@@ -0,0 +1,471 @@
+#include "ThumbnailService.h"
+#include "../ServiceLocator.h"
+#include "../Profiling/Profiler.h"
+#include "../Threading/ThreadPool.h"
+#include "../../Renderer/Renderer.h"
+#include "../../Simulation/SimulationWorld.h"
+#include "../../Simulation/Materials/MaterialDatabase.h"
+#include "../../AssetPipeline/AssetManager.h"
+#include "../../AssetPipeline/IAssetLoader.h"
+#include "../../ThirdParty/json/json.hpp"
+#include "../../ThirdParty/stb/stb_image.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+using json = nlohmann::json;
+
+namespace BGE {
+
+namespace {
+
+constexpr uint32_t THUMBNAIL_MAGIC = 0x54454742;    // "BGET"
+constexpr uint32_t THUMBNAIL_VERSION = 1;           // bump when previews are drawn differently
+
+constexpr size_t MAX_SWATCHES = 8;                  // bands in a preview of a material list
+constexpr int SWATCH_CELL_PIXELS = 2;               // one world cell, as drawn in a swatch
+
+struct ThumbnailHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+};
+
+uint64_t MakeKey(uint64_t contentHash, AssetType type) {
+    uint64_t values[3] = {contentHash, static_cast<uint64_t>(type),
+                          (static_cast<uint64_t>(THUMBNAIL_VERSION) << 32) | ThumbnailService::THUMBNAIL_SIZE};
+    uint64_t key = AssetCache::HashBytes(values, sizeof(values));
+    return key != 0 ? key : 1;  // 0 means "not known yet"
+}
+
+// Box-filters RGBA pixels down to fit in THUMBNAIL_SIZE, keeping the aspect ratio
+void Downscale(const unsigned char* pixels, int width, int height, int& outWidth, int& outHeight,
+               std::vector<unsigned char>& out) {
+    const int size = ThumbnailService::THUMBNAIL_SIZE;
+    float scale = std::min(1.0f, static_cast<float>(size) / static_cast<float>(std::max(width, height)));
+    outWidth = std::max(1, static_cast<int>(width * scale + 0.5f));
+    outHeight = std::max(1, static_cast<int>(height * scale + 0.5f));
+    out.resize(static_cast<size_t>(outWidth) * outHeight * 4);
+    
+    for (int y = 0; y < outHeight; ++y) {
+        int y0 = static_cast<int>(static_cast<int64_t>(y) * height / outHeight);
+        int y1 = std::max(y0 + 1, static_cast<int>(static_cast<int64_t>(y + 1) * height / outHeight));
+        for (int x = 0; x < outWidth; ++x) {
+            int x0 = static_cast<int>(static_cast<int64_t>(x) * width / outWidth);
+            int x1 = std::max(x0 + 1, static_cast<int>(static_cast<int64_t>(x + 1) * width / outWidth));
+            
+            uint32_t sum[4] = {0, 0, 0, 0};
+            for (int sy = y0; sy < y1; ++sy) {
+                const unsigned char* row = pixels + (static_cast<size_t>(sy) * width + x0) * 4;
+                for (int sx = x0; sx < x1; ++sx, row += 4) {
+                    sum[0] += row[0];
+                    sum[1] += row[1];
+                    sum[2] += row[2];
+                    sum[3] += row[3];
+                }
+            }
+            uint32_t count = static_cast<uint32_t>((y1 - y0) * (x1 - x0));
+            unsigned char* pixel = &out[(static_cast<size_t>(y) * outWidth + x) * 4];
+            for (int c = 0; c < 4; ++c) {
+                pixel[c] = static_cast<unsigned char>(sum[c] / count);
+            }
+        }
+    }
+}
+
+// "color" is [0-1] floats in material assets and [0-255] in materials.json
+uint32_t ReadColor(const json& color) {
+    if (!color.is_array() || color.size() < 3) {
+        return 0xFF808080;
+    }
+    float channels[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+    bool bytes = false;
+    for (size_t i = 0; i < std::min<size_t>(color.size(), 4); ++i) {
+        channels[i] = color[i].is_number() ? color[i].get<float>() : 0.0f;
+        bytes = bytes || channels[i] > 1.0f;
+    }
+    if (color.size() < 4 && bytes) {
+        channels[3] = 255.0f;
+    }
+    
+    uint32_t packed = 0;
+    for (int i = 0; i < 4; ++i) {
+        float value = bytes ? channels[i] : channels[i] * 255.0f;
+        packed |= static_cast<uint32_t>(std::clamp(value, 0.0f, 255.0f)) << (i * 8);
+    }
+    return packed;
+}
+
+VisualProperties ReadVisualProperties(const json& material) {
+    // Drawn the way the world draws it: only the pattern is read from the file
+    VisualProperties properties;
+    auto visual = material.find("visualPattern");
+    if (visual != material.end() && visual->is_object()) {
+        auto pattern = visual->find("pattern");
+        if (pattern != visual->end() && pattern->is_string()) {
+            properties.pattern = MaterialDatabase::ParseVisualPattern(pattern->get<std::string>());
+        }
+    }
+    return properties;
+}
+
+bool RenderTexture(const std::vector<char>& source, int& width, int& height, std::vector<unsigned char>& pixels) {
+    int sourceWidth = 0;
+    int sourceHeight = 0;
+    int channels = 0;
+    unsigned char* decoded = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(source.data()),
+                                                   static_cast<int>(source.size()), &sourceWidth, &sourceHeight,
+                                                   &channels, 4);
+    if (!decoded) {
+        return false;
+    }
+    Downscale(decoded, sourceWidth, sourceHeight, width, height, pixels);
+    stbi_image_free(decoded);
+    return true;
+}
+
+// A material asset is one swatch; a material list such as materials.json is a band per material
+bool RenderMaterialSwatch(const std::vector<char>& source, int& width, int& height, std::vector<unsigned char>& pixels) {
+    json document = json::parse(source.begin(), source.end(), nullptr, false);
+    if (document.is_discarded() || !document.is_object()) {
+        return false;
+    }
+    
+    std::vector<std::pair<uint32_t, VisualProperties>> swatches;
+    auto materials = document.find("materials");
+    if (materials != document.end() && materials->is_array()) {
+        for (const json& material : *materials) {
+            if (swatches.size() == MAX_SWATCHES) {
+                break;
+            }
+            if (material.is_object()) {
+                swatches.emplace_back(ReadColor(material.value("color", json())), ReadVisualProperties(material));
+            }
+        }
+    } else if (document.contains("color")) {
+        swatches.emplace_back(ReadColor(document["color"]), ReadVisualProperties(document));
+    }
+    if (swatches.empty()) {
+        return false;
+    }
+    
+    const int size = ThumbnailService::THUMBNAIL_SIZE;
+    width = size;
+    height = size;
+    pixels.resize(static_cast<size_t>(size) * size * 4);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            const auto& [color, properties] = swatches[static_cast<size_t>(x) * swatches.size() / size];
+            uint32_t value = SimulationWorld::ApplyVisualPattern(color, properties, x / SWATCH_CELL_PIXELS,
+                                                                 y / SWATCH_CELL_PIXELS);
+            unsigned char* pixel = &pixels[(static_cast<size_t>(y) * size + x) * 4];
+            for (int c = 0; c < 4; ++c) {
+                pixel[c] = static_cast<unsigned char>(value >> (c * 8));
+            }
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+ThumbnailService::~ThumbnailService() {
+    Shutdown();
+}
+
+bool ThumbnailService::Initialize(const std::string& cacheDirectory, AssetManager* assetManager) {
+    Shutdown();
+    m_cacheDirectory = cacheDirectory;
+    m_assetManager = assetManager;
+    
+    std::error_code ec;
+    std::filesystem::create_directories(m_cacheDirectory, ec);
+    if (ec) {
+        std::cerr << "Thumbnails will not be cached: cannot create " << m_cacheDirectory << std::endl;
+    }
+    
+    m_workers = std::make_unique<ThreadPool>(WORKER_THREADS);
+    return true;
+}
+
+void ThumbnailService::Shutdown() {
+    // Queued previews are dropped; the one being drawn finishes
+    m_workers.reset();
+    
+    auto renderer = ServiceLocator::Instance().GetService<Renderer>();
+    for (auto& [path, thumbnail] : m_thumbnails) {
+        if (thumbnail.textureId != 0 && renderer) {
+            renderer->DeleteTexture(thumbnail.textureId);
+        }
+    }
+    m_thumbnails.clear();
+    m_results.clear();
+    m_inFlight = 0;
+}
+
+bool ThumbnailService::HasPreview(AssetType type) {
+    return type == AssetType::Texture || type == AssetType::Material || type == AssetType::Scene;
+}
+
+uint32_t ThumbnailService::GetThumbnail(const std::string& assetPath, AssetType type) {
+    if (!m_workers || !HasPreview(type)) {
+        return 0;
+    }
+    
+    Thumbnail& thumbnail = m_thumbnails[assetPath];
+    thumbnail.lastUsedFrame = m_frame;
+    
+    // The key only has to be looked up again when the index changed
+    uint64_t revision = m_assetManager ? m_assetManager->GetRegistry().GetDatabase().GetRevision() : 0;
+    if (!thumbnail.requested || thumbnail.revision != revision) {
+        thumbnail.revision = revision;
+        uint64_t key = GetKey(assetPath, type);
+        if (!thumbnail.requested || (key != 0 && key != thumbnail.key)) {
+            // An edited asset keeps showing its old preview until the new one is ready
+            thumbnail.key = key;
+            Request(assetPath, type, thumbnail);
+        }
+    }
+    return thumbnail.textureId;
+}
+
+void ThumbnailService::Update() {
+    ++m_frame;
+    if (m_inFlight > 0) {
+        BGE_PROFILE_SCOPE("ThumbnailService::Update");
+        auto start = std::chrono::steady_clock::now();
+        auto budget = std::chrono::duration<float, std::milli>(UPLOAD_BUDGET_MS);
+        
+        while (true) {
+            Result result;
+            {
+                std::lock_guard<std::mutex> lock(m_resultMutex);
+                if (m_results.empty()) {
+                    break;
+                }
+                result = std::move(m_results.front());
+                m_results.pop_front();
+            }
+            --m_inFlight;
+            
+            // Superseded by a newer request, or invalidated while it was drawn
+            auto it = m_thumbnails.find(result.path);
+            if (it != m_thumbnails.end() && it->second.key == result.key) {
+                Upload(it->second, result);
+            }
+            
+            if (std::chrono::steady_clock::now() - start >= budget) {
+                break;
+            }
+        }
+    }
+    
+    if (m_thumbnails.size() > MAX_RESIDENT_THUMBNAILS) {
+        EvictUnused();
+    }
+}
+
+void ThumbnailService::Invalidate(const std::string& assetPath) {
+    auto it = m_thumbnails.find(assetPath);
+    if (it == m_thumbnails.end()) {
+        return;
+    }
+    if (it->second.textureId != 0) {
+        if (auto renderer = ServiceLocator::Instance().GetService<Renderer>()) {
+            renderer->DeleteTexture(it->second.textureId);
+        }
+    }
+    m_thumbnails.erase(it);
+}
+
+bool ThumbnailService::CaptureSceneSnapshot(const std::string& scenePath, const SimulationWorld& world) {
+    BGE_PROFILE_SCOPE("ThumbnailService::CaptureSceneSnapshot");
+    const unsigned char* pixels = world.GetPixelData();
+    if (!pixels || world.GetWidth() == 0 || world.GetHeight() == 0) {
+        return false;
+    }
+    
+    uint64_t key = GetKey(scenePath, AssetType::Scene);
+    if (key == 0) {
+        std::vector<char> source;
+        if (!IAssetLoader::ReadFile(scenePath, source)) {
+            return false;
+        }
+        key = MakeKey(AssetCache::HashBytes(source.data(), source.size()), AssetType::Scene);
+    }
+    
+    Result result;
+    result.path = scenePath;
+    result.key = key;
+    Downscale(pixels, static_cast<int>(world.GetWidth()), static_cast<int>(world.GetHeight()),
+              result.width, result.height, result.pixels);
+    StoreCached(key, result);
+    
+    // Replaces whatever preview was showing or on its way
+    Thumbnail& thumbnail = m_thumbnails[scenePath];
+    thumbnail.key = key;
+    thumbnail.revision = m_assetManager ? m_assetManager->GetRegistry().GetDatabase().GetRevision() : 0;
+    thumbnail.requested = true;
+    thumbnail.lastUsedFrame = m_frame;
+    Upload(thumbnail, result);
+    return true;
+}
+
+uint64_t ThumbnailService::GetKey(const std::string& assetPath, AssetType type) const {
+    if (!m_assetManager) {
+        return 0;
+    }
+    const AssetRecord* record = m_assetManager->GetRegistry().GetDatabase().Find(
+        std::filesystem::absolute(assetPath).string());
+    return record && record->contentHash != 0 ? MakeKey(record->contentHash, type) : 0;
+}
+
+void ThumbnailService::Request(const std::string& assetPath, AssetType type, Thumbnail& thumbnail) {
+    thumbnail.requested = true;
+    ++m_inFlight;
+    
+    uint64_t key = thumbnail.key;
+    m_workers->Submit([this, assetPath, type, key]() {
+        Result result;
+        result.path = assetPath;
+        result.key = key;
+        Generate(result, type);
+        
+        std::lock_guard<std::mutex> lock(m_resultMutex);
+        m_results.push_back(std::move(result));
+    });
+}
+
+void ThumbnailService::Generate(Result& result, AssetType type) const {
+    BGE_PROFILE_SCOPE("ThumbnailService::Generate");
+    
+    // Without an index entry the source has to be read to know its key
+    std::vector<char> source;
+    uint64_t cacheKey = result.key;
+    if (cacheKey == 0) {
+        if (!IAssetLoader::ReadFile(result.path, source)) {
+            return;
+        }
+        cacheKey = MakeKey(AssetCache::HashBytes(source.data(), source.size()), type);
+    }
+    
+    if (LoadCached(cacheKey, result) || type == AssetType::Scene) {
+        return;     // scene previews only come from CaptureSceneSnapshot()
+    }
+    
+    if (source.empty() && !IAssetLoader::ReadFile(result.path, source)) {
+        return;
+    }
+    bool drawn = type == AssetType::Texture
+        ? RenderTexture(source, result.width, result.height, result.pixels)
+        : RenderMaterialSwatch(source, result.width, result.height, result.pixels);
+    if (drawn) {
+        StoreCached(cacheKey, result);
+    } else {
+        result.pixels.clear();
+    }
+}
+
+std::string ThumbnailService::GetCachePath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.thumb", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(m_cacheDirectory) / name).string();
+}
+
+bool ThumbnailService::LoadCached(uint64_t key, Result& result) const {
+    std::ifstream file(GetCachePath(key), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    ThumbnailHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != THUMBNAIL_MAGIC ||
+        header.version != THUMBNAIL_VERSION || header.width == 0 || header.height == 0 ||
+        header.width > THUMBNAIL_SIZE || header.height > THUMBNAIL_SIZE) {
+        return false;
+    }
+    
+    result.width = static_cast<int>(header.width);
+    result.height = static_cast<int>(header.height);
+    result.pixels.resize(static_cast<size_t>(header.width) * header.height * 4);
+    if (!file.read(reinterpret_cast<char*>(result.pixels.data()), static_cast<std::streamsize>(result.pixels.size()))) {
+        result.pixels.clear();
+        return false;
+    }
+    return true;
+}
+
+void ThumbnailService::StoreCached(uint64_t key, const Result& result) const {
+    if (m_cacheDirectory.empty() || result.pixels.empty()) {
+        return;
+    }
+    
+    // Two copies of one file can be drawn at once; each writes its own temporary
+    std::string path = GetCachePath(key);
+    std::string tempPath = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return;
+        }
+        ThumbnailHeader header = {THUMBNAIL_MAGIC, THUMBNAIL_VERSION, static_cast<uint32_t>(result.width),
+                                  static_cast<uint32_t>(result.height)};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(result.pixels.data()), static_cast<std::streamsize>(result.pixels.size()));
+        if (!file) {
+            file.close();
+            std::remove(tempPath.c_str());
+            return;
+        }
+    }
+    
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+    }
+}
+
+void ThumbnailService::Upload(Thumbnail& thumbnail, const Result& result) {
+    auto renderer = ServiceLocator::Instance().GetService<Renderer>();
+    if (!renderer) {
+        return;
+    }
+    if (thumbnail.textureId != 0) {
+        renderer->DeleteTexture(thumbnail.textureId);
+        thumbnail.textureId = 0;
+    }
+    if (!result.pixels.empty()) {
+        thumbnail.textureId = renderer->CreateTexture(result.width, result.height, 4, result.pixels.data());
+    }
+}
+
+void ThumbnailService::EvictUnused() {
+    // Previews not drawn last frame go, longest unseen first
+    std::vector<std::unordered_map<std::string, Thumbnail>::iterator> unused;
+    for (auto it = m_thumbnails.begin(); it != m_thumbnails.end(); ++it) {
+        if (it->second.lastUsedFrame + 1 < m_frame) {
+            unused.push_back(it);
+        }
+    }
+    std::sort(unused.begin(), unused.end(), [](const auto& a, const auto& b) {
+        return a->second.lastUsedFrame < b->second.lastUsedFrame;
+    });
+    
+    auto renderer = ServiceLocator::Instance().GetService<Renderer>();
+    size_t excess = m_thumbnails.size() - MAX_RESIDENT_THUMBNAILS;
+    for (size_t i = 0; i < unused.size() && i < excess; ++i) {
+        if (unused[i]->second.textureId != 0 && renderer) {
+            renderer->DeleteTexture(unused[i]->second.textureId);
+        }
+        m_thumbnails.erase(unused[i]);
+    }
+}
+
+} // namespace BGE
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../AssetTypes.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BGE {
+
+class AssetManager;
+class SimulationWorld;
+class ThreadPool;
+
+// Downscaled previews for the asset browser.
+//
+// Textures are decoded and shrunk, and materials are drawn as swatches of
+// their visual pattern, on worker threads; finished previews are uploaded a
+// few per frame by Update(). Every preview is also written to the cache
+// directory, keyed by the source's content hash from the asset index, so a
+// folder that was browsed before shows its previews without reading a
+// single source file. Scenes have no image of their own: their preview is
+// a snapshot of the world, taken with CaptureSceneSnapshot().
+class ThumbnailService {
+public:
+    ThumbnailService() = default;
+    ~ThumbnailService();
+    
+    ThumbnailService(const ThumbnailService&) = delete;
+    ThumbnailService& operator=(const ThumbnailService&) = delete;
+    
+    // assetManager may be null; previews are then keyed by hashing the source on the worker
+    bool Initialize(const std::string& cacheDirectory, AssetManager* assetManager);
+    void Shutdown();
+    
+    // Texture for the asset's preview, or 0 while it is generated (or if the type has none).
+    // Only call it for assets on screen: the first call queues the work.
+    uint32_t GetThumbnail(const std::string& assetPath, AssetType type);
+    // Uploads finished previews within the upload budget and frees ones long off screen
+    void Update();
+    // Forgets the asset's preview so the next GetThumbnail() makes a new one
+    void Invalidate(const std::string& assetPath);
+    
+    bool CaptureSceneSnapshot(const std::string& scenePath, const SimulationWorld& world);
+    
+    size_t GetPendingCount() const { return m_inFlight; }
+    static bool HasPreview(AssetType type);
+    
+    static constexpr int THUMBNAIL_SIZE = 128;
+
+private:
+    struct Thumbnail {
+        uint64_t key = 0;               // 0 until known when there is no asset index
+        uint64_t revision = 0;          // asset index revision the key was computed at
+        uint32_t textureId = 0;
+        uint64_t lastUsedFrame = 0;
+        bool requested = false;
+    };
+    
+    // A finished preview on its way from a worker to Update(); no pixels when there is none
+    struct Result {
+        std::string path;
+        uint64_t key = 0;
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> pixels;
+    };
+    
+    uint64_t GetKey(const std::string& assetPath, AssetType type) const;
+    void Request(const std::string& assetPath, AssetType type, Thumbnail& thumbnail);
+    void Generate(Result& result, AssetType type) const;
+    std::string GetCachePath(uint64_t key) const;
+    bool LoadCached(uint64_t key, Result& result) const;
+    void StoreCached(uint64_t key, const Result& result) const;
+    void Upload(Thumbnail& thumbnail, const Result& result);
+    void EvictUnused();
+    
+    std::string m_cacheDirectory;
+    AssetManager* m_assetManager = nullptr;
+    
+    std::unordered_map<std::string, Thumbnail> m_thumbnails;
+    uint64_t m_frame = 0;
+    size_t m_inFlight = 0;
+    
+    std::mutex m_resultMutex;
+    std::deque<Result> m_results;
+    
+    // Declared last so the workers are joined before the state they touch goes
+    std::unique_ptr<ThreadPool> m_workers;
+    
+    static constexpr size_t WORKER_THREADS = 2;
+    static constexpr float UPLOAD_BUDGET_MS = 1.0f;
+    static constexpr size_t MAX_RESIDENT_THUMBNAILS = 512;  // 32 MB of 128x128 RGBA
+};
+
+} // namespace BGE
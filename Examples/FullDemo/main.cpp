@@ -118,8 +118,7 @@ public:
     void Render() override {
         // Rendering is handled by the engine's render pipeline
         // This includes:
-        // - World rendering via Renderer::RenderWorld()
-        // - Particle rendering via Renderer::RenderParticles()
+        // - World and particle rendering via Renderer::RenderWorld()
         // - Asset-loaded sprites (when implemented)
     }
 
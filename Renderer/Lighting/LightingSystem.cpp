@@ -0,0 +1,641 @@
+#include "LightingSystem.h"
+#include "../../Simulation/SimulationWorld.h"
+#include "../../Simulation/Materials/MaterialSystem.h"
+#include "../../Core/Threading/ThreadPool.h"
+#include "../../Core/Logger.h"
+#include "../../Core/Profiling/Profiler.h"
+#include "../../Core/Memory/FrameArena.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace BGE {
+
+namespace {
+
+constexpr int QUALITY_TEXEL_SIZES[] = {8, 4, 2, 1};
+
+// Light a material passes on when the optical properties were left at their
+// defaults (most materials only set a colour): gases and liquids let light through
+constexpr float GAS_MIN_TRANSMITTANCE = 0.9f;
+constexpr float LIQUID_MIN_TRANSMITTANCE = 0.6f;
+
+inline float MaxChannel(const float* rgb) {
+    return std::max(rgb[0], std::max(rgb[1], rgb[2]));
+}
+
+// Light map texels [x0, x1) x [y0, y1) to re-solve
+struct SolveRegion {
+    int x0, y0, x1, y1;
+};
+
+} // anonymous namespace
+
+LightingSystem::LightingSystem() = default;
+
+LightingSystem::~LightingSystem() = default;
+
+LightHandle LightingSystem::AddLight(const Light& light) {
+    LightHandle handle = m_nextHandle++;
+    m_lights.push_back(LightEntry{handle, light});
+    return handle;
+}
+
+void LightingSystem::RemoveLight(LightHandle handle) {
+    m_lights.erase(std::remove_if(m_lights.begin(), m_lights.end(),
+                                  [handle](const LightEntry& entry) { return entry.handle == handle; }),
+                   m_lights.end());
+}
+
+void LightingSystem::ClearLights() {
+    m_lights.clear();
+}
+
+Light* LightingSystem::GetLight(LightHandle handle) {
+    for (LightEntry& entry : m_lights) {
+        if (entry.handle == handle) return &entry.light;
+    }
+    return nullptr;
+}
+
+void LightingSystem::SetLightPosition(LightHandle handle, const Vector2& position) {
+    if (Light* light = GetLight(handle)) light->position = position;
+}
+
+void LightingSystem::SetLightIntensity(LightHandle handle, float intensity) {
+    if (Light* light = GetLight(handle)) light->intensity = intensity;
+}
+
+void LightingSystem::SetLightColor(LightHandle handle, const Vector3& color) {
+    if (Light* light = GetLight(handle)) light->color = color;
+}
+
+void LightingSystem::EnableGlobalIllumination(bool enable) {
+    if (m_emissiveEnabled != enable) {
+        m_emissiveEnabled = enable;
+        m_layoutValid = false;
+    }
+}
+
+void LightingSystem::SetQualityLevel(int level) {
+    level = std::clamp(level, 0, 3);
+    if (level != m_qualityLevel) {
+        m_qualityLevel = level;
+        m_layoutValid = false;
+    }
+}
+
+void LightingSystem::SetFalloffDistance(float cells) {
+    cells = std::max(cells, 1.0f);
+    if (cells != m_falloffDistance) {
+        m_falloffDistance = cells;
+        m_layoutValid = false;
+    }
+}
+
+const float* LightingSystem::GetLightMap() const {
+    return m_lights.empty() ? m_emitted.data() : m_lit.data();
+}
+
+void LightingSystem::ForEachRow(int rows, const std::function<void(int, int)>& func) {
+    int bands = (rows + ROWS_PER_BAND - 1) / ROWS_PER_BAND;
+    if (m_threadPool && bands > 1) {
+        m_threadPool->ParallelFor(0, static_cast<size_t>(bands), [&func, rows](size_t band) {
+            int begin = static_cast<int>(band) * ROWS_PER_BAND;
+            func(begin, std::min(begin + ROWS_PER_BAND, rows));
+        });
+    } else if (rows > 0) {
+        func(0, rows);
+    }
+}
+
+void LightingSystem::PrepareLayout(SimulationWorld* world) {
+    int width = static_cast<int>(world->GetWidth());
+    int height = static_cast<int>(world->GetHeight());
+    int texelSize = QUALITY_TEXEL_SIZES[m_qualityLevel];
+    if (m_layoutValid && width == m_worldWidth && height == m_worldHeight && texelSize == m_texelSize) {
+        return;
+    }
+    
+    m_worldWidth = width;
+    m_worldHeight = height;
+    m_texelSize = texelSize;
+    m_mapWidth = (width + texelSize - 1) / texelSize;
+    m_mapHeight = (height + texelSize - 1) / texelSize;
+    m_chunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunksY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    
+    size_t texels = static_cast<size_t>(m_mapWidth) * m_mapHeight;
+    m_emission.assign(texels * 3, 0.0f);
+    m_transmittance.assign(texels, 1.0f);
+    m_emitted.assign(texels * 3, 0.0f);
+    m_lit.clear();
+    
+    // Version 0 is never current, so every tile is scanned on the next update
+    size_t tiles = static_cast<size_t>(m_chunksX) * m_chunksY;
+    m_tileVersions.assign(tiles, 0);
+    m_tileChanged.assign(tiles, 1);
+    m_tileThermal.assign(tiles, 0);
+    m_tileEmitters.assign(tiles, 0);
+    m_tilePeak.assign(tiles, 0.0f);
+    m_solvedPeak = 0.0f;
+    m_materialsBuiltFor = 0;
+    m_tapX0.clear();
+    
+    m_stats.mapWidth = static_cast<uint32_t>(m_mapWidth);
+    m_stats.mapHeight = static_cast<uint32_t>(m_mapHeight);
+    m_layoutValid = true;
+    
+    BGE_LOG_INFO("LightingSystem", "Light map " + std::to_string(m_mapWidth) + "x" + std::to_string(m_mapHeight) +
+                 " (" + std::to_string(texelSize) + " cells per texel)");
+}
+
+void LightingSystem::RefreshMaterials(SimulationWorld* world) {
+    MaterialSystem* materialSystem = world->GetMaterialSystem();
+    if (!materialSystem) return;
+    
+    const auto& materials = materialSystem->GetAllMaterials();
+    if (m_materialsBuiltFor == materials.size()) return;
+    
+    m_materials.clear();
+    for (const auto& material : materials) {
+        if (material->GetID() >= m_materials.size()) {
+            m_materials.resize(material->GetID() + 1);
+        }
+        
+        const OpticalProperties& optical = material->GetOpticalProps();
+        MaterialLight& entry = m_materials[material->GetID()];
+        
+        // Emitted light takes the material's own colour, tinted by its emission colour
+        uint32_t color = material->GetColor();
+        float r = static_cast<float>(color & 0xFF) / 255.0f;
+        float g = static_cast<float>((color >> 8) & 0xFF) / 255.0f;
+        float b = static_cast<float>((color >> 16) & 0xFF) / 255.0f;
+        float emission = m_emissiveEnabled ? optical.emission : 0.0f;
+        entry.emission[0] = emission * optical.emissionR * r;
+        entry.emission[1] = emission * optical.emissionG * g;
+        entry.emission[2] = emission * optical.emissionB * b;
+        entry.thermalFactor = m_emissiveEnabled ? optical.thermalEmissionFactor : 0.0f;
+        entry.thermalThreshold = optical.thermalEmissionThreshold;
+        
+        float transmittance = optical.castsShadows ? std::clamp(optical.transmission, 0.0f, 1.0f) : 1.0f;
+        if (material->GetState() == MaterialState::Gas) {
+            transmittance = std::max(transmittance, GAS_MIN_TRANSMITTANCE);
+        } else if (material->GetState() == MaterialState::Liquid) {
+            transmittance = std::max(transmittance, LIQUID_MIN_TRANSMITTANCE);
+        }
+        entry.transmittance = transmittance;
+    }
+    if (m_materials.size() <= MATERIAL_EMPTY) {
+        m_materials.resize(MATERIAL_EMPTY + 1);
+    }
+    m_materials[MATERIAL_EMPTY] = MaterialLight();
+    m_materialsBuiltFor = materials.size();
+    
+    // Every tile has to pick up the new inputs
+    std::fill(m_tileVersions.begin(), m_tileVersions.end(), 0);
+}
+
+bool LightingSystem::RebuildTile(SimulationWorld* world, int chunkX, int chunkY) {
+    const int texelSize = m_texelSize;
+    const int tileTexels = CHUNK_SIZE / texelSize;
+    const int texelX0 = chunkX * tileTexels;
+    const int texelY0 = chunkY * tileTexels;
+    const int texelX1 = std::min(texelX0 + tileTexels, m_mapWidth);
+    const int texelY1 = std::min(texelY0 + tileTexels, m_mapHeight);
+    const MaterialLight* materials = m_materials.data();
+    const size_t materialCount = m_materials.size();
+    
+    bool changed = false;
+    bool thermal = false;
+    uint32_t emitters = 0;
+    float peak = 0.0f;
+    
+    for (int ty = texelY0; ty < texelY1; ++ty) {
+        int cellY0 = ty * texelSize;
+        int cellY1 = std::min(cellY0 + texelSize, m_worldHeight);
+        
+        for (int tx = texelX0; tx < texelX1; ++tx) {
+            int cellX0 = tx * texelSize;
+            int span = std::min(texelSize, m_worldWidth - cellX0);
+            
+            // Average the cells under this texel
+            float emission[3] = {0.0f, 0.0f, 0.0f};
+            float transmittance = 0.0f;
+            for (int cy = cellY0; cy < cellY1; ++cy) {
+                const Cell* row = &world->GetCell(cellX0, cy);
+                for (int i = 0; i < span; ++i) {
+                    const Cell& cell = row[i];
+                    if (cell.material == MATERIAL_EMPTY || cell.material >= materialCount) {
+                        transmittance += 1.0f;
+                        continue;
+                    }
+                    
+                    const MaterialLight& material = materials[cell.material];
+                    emission[0] += material.emission[0];
+                    emission[1] += material.emission[1];
+                    emission[2] += material.emission[2];
+                    transmittance += material.transmittance;
+                    
+                    // Hot cells glow orange-white
+                    thermal |= material.thermalFactor > 0.0f;
+                    if (material.thermalFactor > 0.0f && cell.temperature > material.thermalThreshold) {
+                        float glow = (cell.temperature - material.thermalThreshold) * material.thermalFactor * THERMAL_SCALE;
+                        emission[0] += glow;
+                        emission[1] += glow * 0.5f;
+                        emission[2] += glow * 0.15f;
+                    }
+                }
+            }
+            
+            float inverseCount = 1.0f / static_cast<float>(span * (cellY1 - cellY0));
+            emission[0] *= inverseCount;
+            emission[1] *= inverseCount;
+            emission[2] *= inverseCount;
+            transmittance *= inverseCount;
+            
+            float brightest = MaxChannel(emission);
+            if (brightest > MIN_LIGHT) {
+                emitters++;
+                peak = std::max(peak, brightest);
+            }
+            
+            size_t texel = static_cast<size_t>(ty) * m_mapWidth + tx;
+            float* stored = &m_emission[texel * 3];
+            if (stored[0] != emission[0] || stored[1] != emission[1] || stored[2] != emission[2] ||
+                m_transmittance[texel] != transmittance) {
+                stored[0] = emission[0];
+                stored[1] = emission[1];
+                stored[2] = emission[2];
+                m_transmittance[texel] = transmittance;
+                changed = true;
+            }
+        }
+    }
+    
+    size_t tile = static_cast<size_t>(chunkY) * m_chunksX + chunkX;
+    m_tileEmitters[tile] = emitters;
+    m_tilePeak[tile] = peak;
+    m_tileThermal[tile] = thermal ? 1 : 0;
+    return changed;
+}
+
+void LightingSystem::Update(SimulationWorld* world) {
+    if (!world || !m_enabled) return;
+    BGE_PROFILE_SCOPE("LightingSystem::Update");
+    
+    PrepareLayout(world);
+    RefreshMaterials(world);
+    
+    m_stats.tilesRebuilt = 0;
+    m_stats.tilesChanged = 0;
+    m_stats.texelsPropagated = 0;
+    
+    // Rescan tiles whose chunk changed since they were built, and those holding
+    // materials that glow with heat (temperature changes don't bump the chunk
+    // version); only tiles whose averaged emission or transmittance moved need
+    // the light re-solved around them
+    const size_t tileCount = m_tileVersions.size();
+    std::atomic<uint32_t> tilesRebuilt{0};
+    auto rebuild = [this, world, &tilesRebuilt](size_t tile) {
+        int chunkX = static_cast<int>(tile % m_chunksX);
+        int chunkY = static_cast<int>(tile / m_chunksX);
+        uint64_t version = world->GetChunkVersion(chunkX, chunkY);
+        if (m_tileVersions[tile] == version && !m_tileThermal[tile]) return;
+        m_tileVersions[tile] = version;
+        tilesRebuilt.fetch_add(1, std::memory_order_relaxed);
+        if (RebuildTile(world, chunkX, chunkY)) {
+            m_tileChanged[tile] = 1;
+        }
+    };
+    if (m_threadPool && tileCount > 1) {
+        m_threadPool->ParallelFor(0, tileCount, rebuild);
+    } else {
+        for (size_t tile = 0; tile < tileCount; ++tile) {
+            rebuild(tile);
+        }
+    }
+    m_stats.tilesRebuilt = tilesRebuilt.load(std::memory_order_relaxed);
+    
+    uint32_t emitterTexels = 0;
+    float peak = 0.0f;
+    for (size_t tile = 0; tile < tileCount; ++tile) {
+        emitterTexels += m_tileEmitters[tile];
+        peak = std::max(peak, m_tilePeak[tile]);
+    }
+    m_stats.emitterTexels = emitterTexels;
+    
+    // Light from inside a changed tile reaches no further than where the
+    // brightest emitter decays below one step of 8-bit colour; emitters that
+    // were just removed count too, their light has to be cleared
+    float reachPeak = std::max(peak, m_solvedPeak);
+    int range = 0;
+    if (reachPeak > MIN_LIGHT) {
+        float reach = m_falloffDistance * std::log(reachPeak / MIN_LIGHT);
+        range = std::min(static_cast<int>(std::ceil(reach)), MAX_LIGHT_RANGE);
+    }
+    int rangeTexels = (range + m_texelSize - 1) / m_texelSize;
+    int tileTexels = CHUNK_SIZE / m_texelSize;
+    
+    // Each changed tile needs the light re-solved within its reach. Regions that
+    // overlap are merged, so scattered changes re-solve separate patches of the
+    // map rather than the box around all of them.
+    FrameVector<SolveRegion> regions(FrameArena::Resource());
+    for (size_t tile = 0; tile < tileCount; ++tile) {
+        if (!m_tileChanged[tile]) continue;
+        m_tileChanged[tile] = 0;
+        m_stats.tilesChanged++;
+        
+        int chunkX = static_cast<int>(tile % m_chunksX);
+        int chunkY = static_cast<int>(tile / m_chunksX);
+        SolveRegion region{std::max(0, chunkX * tileTexels - rangeTexels),
+                           std::max(0, chunkY * tileTexels - rangeTexels),
+                           std::min(m_mapWidth, (chunkX + 1) * tileTexels + rangeTexels),
+                           std::min(m_mapHeight, (chunkY + 1) * tileTexels + rangeTexels)};
+        
+        // Growing a region can make it overlap ones it was clear of, so keep
+        // absorbing until it overlaps none
+        for (size_t i = 0; i < regions.size();) {
+            const SolveRegion& other = regions[i];
+            if (other.x0 < region.x1 && region.x0 < other.x1 && other.y0 < region.y1 && region.y0 < other.y1) {
+                region.x0 = std::min(region.x0, other.x0);
+                region.y0 = std::min(region.y0, other.y0);
+                region.x1 = std::max(region.x1, other.x1);
+                region.y1 = std::max(region.y1, other.y1);
+                regions[i] = regions.back();
+                regions.pop_back();
+                i = 0;
+            } else {
+                ++i;
+            }
+        }
+        regions.push_back(region);
+    }
+    
+    if (!regions.empty()) {
+        m_solvedPeak = peak;
+        for (const SolveRegion& region : regions) {
+            SolveEmitted(region.x0, region.y0, region.x1, region.y1);
+        }
+    }
+    
+    // Explicit lights move freely, so they are added on top every update
+    if (!m_lights.empty()) {
+        m_lit = m_emitted;
+        for (const LightEntry& entry : m_lights) {
+            if (entry.light.intensity <= 0.0f) continue;
+            if (entry.light.type == LightType::Directional) {
+                AddDirectionalLight(entry.light);
+            } else {
+                AddPointLight(entry.light);
+            }
+        }
+    }
+}
+
+void LightingSystem::SolveEmitted(int x0, int y0, int x1, int y1) {
+    const int mapWidth = m_mapWidth;
+    float* light = m_emitted.data();
+    const float* emission = m_emission.data();
+    const float* transmittance = m_transmittance.data();
+    
+    // Start from the emitters themselves
+    for (int y = y0; y < y1; ++y) {
+        size_t offset = (static_cast<size_t>(y) * mapWidth + x0) * 3;
+        std::copy(emission + offset, emission + offset + static_cast<size_t>(x1 - x0) * 3, light + offset);
+    }
+    m_stats.texelsPropagated += static_cast<uint32_t>((x1 - x0) * (y1 - y0));
+    if (m_stats.emitterTexels == 0) return;
+    
+    const float straightDecay = std::exp(-static_cast<float>(m_texelSize) / m_falloffDistance);
+    const float diagonalDecay = std::exp(-static_cast<float>(m_texelSize) * 1.41421356f / m_falloffDistance);
+    
+    // What a neighbour passes on: its own emission, or the light it received
+    // attenuated by what it lets through. Opaque texels are lit but cast shadows.
+    auto gather = [&](float* target, int nx, int ny, float decay) {
+        if (nx < 0 || ny < 0 || nx >= mapWidth || ny >= m_mapHeight) return;
+        size_t neighbour = static_cast<size_t>(ny) * mapWidth + nx;
+        const float* source = light + neighbour * 3;
+        const float* emitted = emission + neighbour * 3;
+        float pass = transmittance[neighbour];
+        for (int c = 0; c < 3; ++c) {
+            float outgoing = std::max(emitted[c], source[c] * pass) * decay;
+            target[c] = std::max(target[c], outgoing);
+        }
+    };
+    
+    // Forward then backward passes over the 8-neighbourhood, as in a chamfer
+    // distance transform; repeating the pair lets light bend around occluders
+    for (int sweep = 0; sweep < PROPAGATION_SWEEPS; ++sweep) {
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                float* target = light + (static_cast<size_t>(y) * mapWidth + x) * 3;
+                gather(target, x - 1, y, straightDecay);
+                gather(target, x - 1, y - 1, diagonalDecay);
+                gather(target, x, y - 1, straightDecay);
+                gather(target, x + 1, y - 1, diagonalDecay);
+            }
+        }
+        for (int y = y1 - 1; y >= y0; --y) {
+            for (int x = x1 - 1; x >= x0; --x) {
+                float* target = light + (static_cast<size_t>(y) * mapWidth + x) * 3;
+                gather(target, x + 1, y, straightDecay);
+                gather(target, x + 1, y + 1, diagonalDecay);
+                gather(target, x, y + 1, straightDecay);
+                gather(target, x - 1, y + 1, diagonalDecay);
+            }
+        }
+    }
+}
+
+float LightingSystem::Transmittance(int fromX, int fromY, int toX, int toY) const {
+    // Walk the texels strictly between the two ends
+    int dx = toX - fromX;
+    int dy = toY - fromY;
+    int steps = std::max(std::abs(dx), std::abs(dy));
+    float stepX = steps > 0 ? static_cast<float>(dx) / steps : 0.0f;
+    float stepY = steps > 0 ? static_cast<float>(dy) / steps : 0.0f;
+    
+    float result = 1.0f;
+    for (int i = 1; i < steps; ++i) {
+        int x = fromX + static_cast<int>(std::lround(stepX * i));
+        int y = fromY + static_cast<int>(std::lround(stepY * i));
+        result *= m_transmittance[static_cast<size_t>(y) * m_mapWidth + x];
+        if (result < MIN_LIGHT) return 0.0f;
+    }
+    return result;
+}
+
+void LightingSystem::AddPointLight(const Light& light) {
+    if (light.radius <= 0.0f) return;
+    
+    const float texelSize = static_cast<float>(m_texelSize);
+    const float inverseRadius = 1.0f / light.radius;
+    const bool shadows = m_shadowsEnabled && light.castsShadows;
+    int lightX = std::clamp(static_cast<int>(light.position.x / texelSize), 0, m_mapWidth - 1);
+    int lightY = std::clamp(static_cast<int>(light.position.y / texelSize), 0, m_mapHeight - 1);
+    
+    int x0 = std::max(0, static_cast<int>((light.position.x - light.radius) / texelSize));
+    int x1 = std::min(m_mapWidth, static_cast<int>((light.position.x + light.radius) / texelSize) + 1);
+    int y0 = std::max(0, static_cast<int>((light.position.y - light.radius) / texelSize));
+    int y1 = std::min(m_mapHeight, static_cast<int>((light.position.y + light.radius) / texelSize) + 1);
+    if (x0 >= x1 || y0 >= y1) return;
+    
+    // Rows are independent, so large lights spread across the workers
+    ForEachRow(y1 - y0, [&](int rowBegin, int rowEnd) {
+        for (int y = y0 + rowBegin; y < y0 + rowEnd; ++y) {
+            float dy = (y + 0.5f) * texelSize - light.position.y;
+            float* row = m_lit.data() + static_cast<size_t>(y) * m_mapWidth * 3;
+            
+            for (int x = x0; x < x1; ++x) {
+                float dx = (x + 0.5f) * texelSize - light.position.x;
+                float distance = std::sqrt(dx * dx + dy * dy);
+                if (distance >= light.radius) continue;
+                
+                float falloff = 1.0f - distance * inverseRadius;
+                float amount = falloff * falloff * light.intensity;
+                if (shadows) {
+                    amount *= Transmittance(lightX, lightY, x, y);
+                }
+                if (amount <= 0.0f) continue;
+                
+                row[x * 3 + 0] += light.color.x * amount;
+                row[x * 3 + 1] += light.color.y * amount;
+                row[x * 3 + 2] += light.color.z * amount;
+            }
+        }
+    });
+}
+
+void LightingSystem::AddDirectionalLight(const Light& light) {
+    float length = std::sqrt(light.direction.x * light.direction.x + light.direction.y * light.direction.y);
+    float directionX = length > 0.0f ? light.direction.x / length : 0.0f;
+    float directionY = length > 0.0f ? light.direction.y / length : 1.0f;
+    
+    const float red = light.color.x * light.intensity;
+    const float green = light.color.y * light.intensity;
+    const float blue = light.color.z * light.intensity;
+    const int mapWidth = m_mapWidth;
+    
+    // Nearly horizontal light would need an unbounded shift per row; treat it as unshadowed
+    if (!m_shadowsEnabled || !light.castsShadows || std::abs(directionY) < 0.05f) {
+        for (size_t texel = 0; texel < m_lit.size(); texel += 3) {
+            m_lit[texel + 0] += red;
+            m_lit[texel + 1] += green;
+            m_lit[texel + 2] += blue;
+        }
+        return;
+    }
+    
+    // Sweep rows in the direction of travel; each texel's transmittance comes
+    // from the row before, shifted along the light direction
+    const int rowStep = directionY > 0.0f ? 1 : -1;
+    const float shift = directionX / std::abs(directionY);
+    FrameVector<float> incoming(mapWidth, 1.0f, FrameArena::Resource());
+    FrameVector<float> outgoing(mapWidth, FrameArena::Resource());
+    
+    int y = rowStep > 0 ? 0 : m_mapHeight - 1;
+    for (int row = 0; row < m_mapHeight; ++row, y += rowStep) {
+        const float* pass = m_transmittance.data() + static_cast<size_t>(y) * mapWidth;
+        float* lit = m_lit.data() + static_cast<size_t>(y) * mapWidth * 3;
+        
+        for (int x = 0; x < mapWidth; ++x) {
+            float amount = incoming[x];
+            lit[x * 3 + 0] += red * amount;
+            lit[x * 3 + 1] += green * amount;
+            lit[x * 3 + 2] += blue * amount;
+            outgoing[x] = amount * pass[x];
+        }
+        
+        // Light entering from outside the map is unobstructed
+        for (int x = 0; x < mapWidth; ++x) {
+            float source = x - shift;
+            int left = static_cast<int>(std::floor(source));
+            float t = source - left;
+            float a = (left >= 0 && left < mapWidth) ? outgoing[left] : 1.0f;
+            float b = (left + 1 >= 0 && left + 1 < mapWidth) ? outgoing[left + 1] : 1.0f;
+            incoming[x] = a + (b - a) * t;
+        }
+    }
+}
+
+void LightingSystem::Apply(uint8_t* pixelData, int width, int height) {
+    if (!m_enabled || !pixelData || width != m_worldWidth || height != m_worldHeight || m_mapWidth == 0) return;
+    BGE_PROFILE_SCOPE("LightingSystem::Apply");
+    
+    const float* lightMap = GetLightMap();
+    const int texelSize = m_texelSize;
+    const int mapWidth = m_mapWidth;
+    const int mapHeight = m_mapHeight;
+    
+    // Bilinear taps between texel centres, shared by every row
+    if (static_cast<int>(m_tapX0.size()) != width) {
+        m_tapX0.resize(width);
+        m_tapX1.resize(width);
+        m_tapWeight.resize(width);
+        for (int x = 0; x < width; ++x) {
+            float u = std::clamp((x + 0.5f) / texelSize - 0.5f, 0.0f, static_cast<float>(mapWidth - 1));
+            int left = static_cast<int>(u);
+            m_tapX0[x] = left;
+            m_tapX1[x] = std::min(left + 1, mapWidth - 1);
+            m_tapWeight[x] = u - left;
+        }
+    }
+    
+    const float ambientR = m_ambient.x;
+    const float ambientG = m_ambient.y;
+    const float ambientB = m_ambient.z;
+    const float exposure = m_exposure;
+    const float glow = m_exposure * m_airGlow;
+    const int* tapX0 = m_tapX0.data();
+    const int* tapX1 = m_tapX1.data();
+    const float* tapWeight = m_tapWeight.data();
+    
+    ForEachRow(height, [&](int rowBegin, int rowEnd) {
+        thread_local std::vector<float> scratch;
+        scratch.resize(static_cast<size_t>(mapWidth) * 3);
+        float* blended = scratch.data();
+        
+        for (int py = rowBegin; py < rowEnd; ++py) {
+            // Pixel rows are stored bottom-up
+            int worldY = height - 1 - py;
+            float v = std::clamp((worldY + 0.5f) / texelSize - 0.5f, 0.0f, static_cast<float>(mapHeight - 1));
+            int top = static_cast<int>(v);
+            int bottom = std::min(top + 1, mapHeight - 1);
+            float t = v - top;
+            const float* rowA = lightMap + static_cast<size_t>(top) * mapWidth * 3;
+            const float* rowB = lightMap + static_cast<size_t>(bottom) * mapWidth * 3;
+            for (int i = 0; i < mapWidth * 3; ++i) {
+                blended[i] = rowA[i] + (rowB[i] - rowA[i]) * t;
+            }
+            
+            uint8_t* pixel = pixelData + static_cast<size_t>(py) * width * 4;
+            for (int x = 0; x < width; ++x, pixel += 4) {
+                const float* a = blended + tapX0[x] * 3;
+                const float* b = blended + tapX1[x] * 3;
+                float w = tapWeight[x];
+                float lightR = a[0] + (b[0] - a[0]) * w;
+                float lightG = a[1] + (b[1] - a[1]) * w;
+                float lightB = a[2] + (b[2] - a[2]) * w;
+                
+                if (pixel[3] > 0) {
+                    pixel[0] = static_cast<uint8_t>(std::min(255.0f, pixel[0] * (ambientR + lightR * exposure)));
+                    pixel[1] = static_cast<uint8_t>(std::min(255.0f, pixel[1] * (ambientG + lightG * exposure)));
+                    pixel[2] = static_cast<uint8_t>(std::min(255.0f, pixel[2] * (ambientB + lightB * exposure)));
+                    continue;
+                }
+                
+                // Empty space: a translucent haze in the light's hue
+                float peak = std::max(lightR, std::max(lightG, lightB)) * glow;
+                if (peak <= MIN_LIGHT) continue;
+                float scale = 255.0f * glow / peak;
+                pixel[0] = static_cast<uint8_t>(std::min(255.0f, lightR * scale));
+                pixel[1] = static_cast<uint8_t>(std::min(255.0f, lightG * scale));
+                pixel[2] = static_cast<uint8_t>(std::min(255.0f, lightB * scale));
+                pixel[3] = static_cast<uint8_t>(std::min(255.0f, peak * 255.0f));
+            }
+        }
+    });
+}
+
+} // namespace BGE
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "../../Core/Math/Vector2.h"
+#include "../../Core/Math/Vector3.h"
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace BGE {
+
+class SimulationWorld;
+class ThreadPool;
+
+enum class LightType {
+    Point,
+    Directional
+};
+
+// Positions and radii are in world cells (y down, like the simulation grid)
+struct Light {
+    LightType type = LightType::Point;
+    Vector2 position = {0.0f, 0.0f};
+    Vector2 direction = {0.0f, 1.0f};   // Directional: the way the light travels
+    Vector3 color = {1.0f, 1.0f, 1.0f};
+    float intensity = 1.0f;
+    float radius = 100.0f;              // Point: reach in cells
+    bool castsShadows = true;
+};
+
+using LightHandle = uint32_t;
+constexpr LightHandle INVALID_LIGHT_HANDLE = 0;
+
+struct LightingStats {
+    uint32_t mapWidth = 0;
+    uint32_t mapHeight = 0;
+    uint32_t tilesRebuilt = 0;      // chunk tiles rescanned this update
+    uint32_t tilesChanged = 0;      // tiles whose emission/occlusion actually changed
+    uint32_t texelsPropagated = 0;  // light map texels re-solved this update
+    uint32_t emitterTexels = 0;
+};
+
+// CPU 2D lighting on a reduced-resolution light map.
+//
+// Each chunk contributes a tile of emission (from OpticalProperties emission
+// and thermal glow) and transmittance (from castsShadows / transmission).
+// Tiles are rebuilt when their chunk changes, and only tiles whose contents
+// differ re-solve the emitted light, within the reach of the brightest
+// emitter. Light spreads by forward/backward sweeps in the
+// manner of a chamfer distance transform: each texel keeps the brightest of
+// its own emission and what its neighbours pass on, attenuated by distance
+// and by the transmittance of the texel it leaves. Explicit lights are added
+// on top every update.
+class LightingSystem {
+public:
+    LightingSystem();
+    ~LightingSystem();
+    
+    // Refreshes the light map from the world; cheap when nothing changed
+    void Update(SimulationWorld* world);
+    // Lights a world pixel buffer (RGBA rows, bottom row first as produced by
+    // SimulationWorld). Empty pixels pick up a faint glow from nearby light.
+    void Apply(uint8_t* pixelData, int width, int height);
+    
+    void SetEnabled(bool enabled) { m_enabled = enabled; }
+    bool IsEnabled() const { return m_enabled; }
+    
+    // Lights
+    LightHandle AddLight(const Light& light);
+    void RemoveLight(LightHandle handle);
+    void ClearLights();
+    Light* GetLight(LightHandle handle);
+    void SetLightPosition(LightHandle handle, const Vector2& position);
+    void SetLightIntensity(LightHandle handle, float intensity);
+    void SetLightColor(LightHandle handle, const Vector3& color);
+    size_t GetLightCount() const { return m_lights.size(); }
+    
+    // Occlusion of explicit lights by cells
+    void EnableRaytracing(bool enable) { m_shadowsEnabled = enable; }
+    bool IsRaytracingEnabled() const { return m_shadowsEnabled; }
+    // Light emitted by cells (lava, fire, hot materials)
+    void EnableGlobalIllumination(bool enable);
+    bool IsGlobalIlluminationEnabled() const { return m_emissiveEnabled; }
+    // 0..3, picks 8, 4, 2 or 1 cells per light map texel
+    void SetQualityLevel(int level);
+    int GetQualityLevel() const { return m_qualityLevel; }
+    
+    // Pixel = pixel * (ambient + exposure * light)
+    void SetAmbient(const Vector3& ambient) { m_ambient = ambient; }
+    const Vector3& GetAmbient() const { return m_ambient; }
+    void SetExposure(float exposure) { m_exposure = exposure; }
+    void SetAirGlow(float glow) { m_airGlow = glow; }
+    // Distance (cells) over which emitted light falls to 1/e
+    void SetFalloffDistance(float cells);
+    
+    // Forces every tile to be rebuilt on the next update
+    void Invalidate() { m_layoutValid = false; }
+    
+    void SetThreadPool(ThreadPool* threadPool) { m_threadPool = threadPool; }
+    
+    // Final light map, 3 floats (RGB) per texel
+    int GetLightMapWidth() const { return m_mapWidth; }
+    int GetLightMapHeight() const { return m_mapHeight; }
+    int GetTexelSize() const { return m_texelSize; }
+    const float* GetLightMap() const;
+    const LightingStats& GetStats() const { return m_stats; }
+
+private:
+    struct MaterialLight {
+        float emission[3] = {0.0f, 0.0f, 0.0f};
+        float transmittance = 1.0f;
+        float thermalFactor = 0.0f;
+        float thermalThreshold = 0.0f;
+    };
+    
+    struct LightEntry {
+        LightHandle handle;
+        Light light;
+    };
+    
+    void PrepareLayout(SimulationWorld* world);
+    void RefreshMaterials(SimulationWorld* world);
+    bool RebuildTile(SimulationWorld* world, int chunkX, int chunkY);
+    void SolveEmitted(int x0, int y0, int x1, int y1);
+    void AddPointLight(const Light& light);
+    void AddDirectionalLight(const Light& light);
+    float Transmittance(int fromX, int fromY, int toX, int toY) const;
+    
+    void ForEachRow(int rows, const std::function<void(int, int)>& func);
+    
+    bool m_enabled = true;
+    bool m_shadowsEnabled = true;
+    bool m_emissiveEnabled = true;
+    int m_qualityLevel = 1;
+    Vector3 m_ambient = {1.0f, 1.0f, 1.0f};
+    float m_exposure = 0.5f;
+    float m_airGlow = 0.35f;
+    float m_falloffDistance = 24.0f;
+    
+    std::vector<LightEntry> m_lights;
+    LightHandle m_nextHandle = 1;
+    
+    // Layout (rebuilt when the world size or quality changes)
+    bool m_layoutValid = false;
+    int m_worldWidth = 0;
+    int m_worldHeight = 0;
+    int m_texelSize = 4;
+    int m_mapWidth = 0;
+    int m_mapHeight = 0;
+    int m_chunksX = 0;
+    int m_chunksY = 0;
+    
+    // Scene: emission (RGB) and transmittance per texel
+    std::vector<float> m_emission;
+    std::vector<float> m_transmittance;
+    // Light emitted by cells, solved incrementally
+    std::vector<float> m_emitted;
+    // m_emitted plus explicit lights (only used when there are lights)
+    std::vector<float> m_lit;
+    
+    // Per chunk tile
+    std::vector<uint64_t> m_tileVersions;   // chunk version each tile was built at
+    std::vector<uint8_t> m_tileChanged;
+    std::vector<uint8_t> m_tileThermal;     // holds heat-glowing materials, rebuilt every update
+    std::vector<uint32_t> m_tileEmitters;
+    std::vector<float> m_tilePeak;          // brightest emission channel in the tile
+    float m_solvedPeak = 0.0f;              // brightest emitter when m_emitted was last solved
+    
+    // Per-material lighting inputs, indexed by MaterialID
+    std::vector<MaterialLight> m_materials;
+    size_t m_materialsBuiltFor = 0;
+    
+    // Bilinear upsample taps per pixel column
+    std::vector<int> m_tapX0;
+    std::vector<int> m_tapX1;
+    std::vector<float> m_tapWeight;
+    
+    ThreadPool* m_threadPool = nullptr;
+    LightingStats m_stats;
+    
+    static constexpr float MIN_LIGHT = 1.0f / 255.0f;
+    static constexpr float THERMAL_SCALE = 0.002f;   // Light per degree above the threshold
+    static constexpr int MAX_LIGHT_RANGE = 256;      // Cells
+    static constexpr int PROPAGATION_SWEEPS = 2;     // Forward + backward pairs
+    static constexpr int ROWS_PER_BAND = 32;
+};
+
+} // namespace BGE
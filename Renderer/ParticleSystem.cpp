@@ -1,13 +1,39 @@
 #include "ParticleSystem.h"
 #include "../Core/Logger.h"
-#include <cstdlib> // For rand() if needed for CreateSparks later, or use C++ random
+#include "../Core/Threading/ThreadPool.h"
 #include <algorithm> // For std::min/max if needed
-#include <random>    // For std::mt19937 and distributions
+#include <cmath>
 #include "../Renderer/Renderer.h" // Include Renderer.h for Renderer class definition
 
 namespace BGE {
 
-ParticleSystem::ParticleSystem() : m_poolSize(0) {
+void ParticleData::Resize(size_t capacity) {
+    positionX.resize(capacity);
+    positionY.resize(capacity);
+    velocityX.resize(capacity);
+    velocityY.resize(capacity);
+    colorR.resize(capacity);
+    colorG.resize(capacity);
+    colorB.resize(capacity);
+    lifetime.resize(capacity);
+}
+
+void ParticleData::Clear() {
+    Resize(0);
+}
+
+void ParticleData::Move(size_t from, size_t to) {
+    positionX[to] = positionX[from];
+    positionY[to] = positionY[from];
+    velocityX[to] = velocityX[from];
+    velocityY[to] = velocityY[from];
+    colorR[to] = colorR[from];
+    colorG[to] = colorG[from];
+    colorB[to] = colorB[from];
+    lifetime[to] = lifetime[from];
+}
+
+ParticleSystem::ParticleSystem() : m_poolSize(0), m_random(std::random_device{}()) {
     // Constructor
 }
 
@@ -17,191 +43,208 @@ ParticleSystem::~ParticleSystem() {
 
 bool ParticleSystem::Initialize(size_t poolSize) {
     m_poolSize = poolSize;
-    m_particlePool.resize(m_poolSize);
-    for (size_t i = 0; i < m_poolSize; ++i) {
-        m_particlePool[i].isActive = false;
-    }
-    m_currentIndex = 0;
+    m_data.Resize(m_poolSize);
+    m_count = 0;
+    m_overwriteCursor = 0;
     BGE_LOG_INFO("ParticleSystem", "Initialized with pool size: " + std::to_string(m_poolSize));
     return true;
 }
 
 void ParticleSystem::Shutdown() {
-    m_particlePool.clear();
+    m_data.Clear();
+    m_count = 0;
+    m_poolSize = 0;
     BGE_LOG_INFO("ParticleSystem", "Shutdown complete.");
 }
 
-Particle* ParticleSystem::FindInactiveParticle() {
-    // Round-robin search for an inactive particle
-    for (size_t i = 0; i < m_poolSize; ++i) {
-        size_t index = (m_currentIndex + i) % m_poolSize;
-        if (!m_particlePool[index].isActive) {
-            m_currentIndex = (index + 1) % m_poolSize;
-            return &m_particlePool[index];
-        }
+size_t ParticleSystem::Allocate(size_t count, size_t& allocated) {
+    if (m_count < m_poolSize) {
+        size_t first = m_count;
+        allocated = std::min(count, m_poolSize - m_count);
+        m_count += allocated;
+        return first;
+    }
+    
+    // Pool is full: overwrite live particles round-robin
+    if (m_overwriteCursor >= m_poolSize) {
+        m_overwriteCursor = 0;
     }
-    // If no inactive particle is found (pool is full), overwrite the current one (oldest)
-    // This is a common strategy, alternatively, emission could fail.
-    Particle* p = &m_particlePool[m_currentIndex];
-    m_currentIndex = (m_currentIndex + 1) % m_poolSize;
-    // BGE_LOG_WARN("ParticleSystem", "Particle pool full. Overwriting oldest particle.");
-    return p;
+    size_t first = m_overwriteCursor;
+    allocated = std::min(count, m_poolSize - first);
+    m_overwriteCursor = first + allocated;
+    return first;
 }
 
 void ParticleSystem::Emit(const ParticleProperties& properties) {
-    Particle* particle = FindInactiveParticle();
-    if (!particle) {
-        // Should not happen if FindInactiveParticle always returns one (even if overwriting)
-        // BGE_LOG_WARN("ParticleSystem", "Could not find inactive particle to emit.");
-        return;
-    }
-
-    particle->position = properties.position;
-    particle->velocity = properties.velocity;
-    particle->color = properties.color;
-    particle->lifetime = properties.lifetime;
-    particle->isActive = true;
-    // particle->size = properties.size; // Future
-    // particle->rotation = properties.rotation; // Future
+    if (m_poolSize == 0) return;
+    
+    size_t allocated;
+    size_t i = Allocate(1, allocated);
+    m_data.positionX[i] = properties.position.x;
+    m_data.positionY[i] = properties.position.y;
+    m_data.velocityX[i] = properties.velocity.x;
+    m_data.velocityY[i] = properties.velocity.y;
+    m_data.colorR[i] = properties.color.x;
+    m_data.colorG[i] = properties.color.y;
+    m_data.colorB[i] = properties.color.z;
+    m_data.lifetime[i] = properties.lifetime;
 }
 
 void ParticleSystem::Update(float deltaTime) {
-    for (size_t i = 0; i < m_poolSize; ++i) {
-        if (m_particlePool[i].isActive) {
-            UpdatePhysics(m_particlePool[i], deltaTime);
-        }
+    if (m_count == 0) return;
+    
+    if (m_threadPool && m_count >= m_parallelThreshold) {
+        size_t chunkCount = (m_count + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+        m_threadPool->ParallelFor(0, chunkCount, [this, deltaTime](size_t chunk) {
+            size_t begin = chunk * PARALLEL_GRAIN;
+            Integrate(begin, std::min(begin + PARALLEL_GRAIN, m_count), deltaTime);
+        });
+    } else {
+        Integrate(0, m_count, deltaTime);
     }
+    
+    RemoveDead();
 }
 
-void ParticleSystem::UpdatePhysics(Particle& particle, float deltaTime) {
-    // Apply gravity
-    particle.velocity.y += m_gravity * deltaTime;
-
-    // Apply air resistance
-    particle.velocity.x *= AIR_RESISTANCE;
-    particle.velocity.y *= AIR_RESISTANCE;
-
-    // Update position
-    particle.position += particle.velocity * deltaTime;
-
-    // Decrease lifetime
-    particle.lifetime -= deltaTime;
-
-    // Fade color based on lifetime (visual enhancement)
-    if (particle.lifetime < 0.3f) {
-        float fadeAlpha = particle.lifetime / 0.3f;
-        particle.color = particle.color * fadeAlpha;
+void ParticleSystem::Integrate(size_t begin, size_t end, float deltaTime) {
+    // Straight-line loops over separate arrays so the compiler can vectorise them
+    float* positionX = m_data.positionX.data();
+    float* positionY = m_data.positionY.data();
+    float* velocityX = m_data.velocityX.data();
+    float* velocityY = m_data.velocityY.data();
+    float* lifetime = m_data.lifetime.data();
+    const float gravityStep = m_gravity * deltaTime;
+    
+    for (size_t i = begin; i < end; ++i) {
+        // Gravity, then air resistance
+        velocityX[i] *= AIR_RESISTANCE;
+        velocityY[i] = (velocityY[i] + gravityStep) * AIR_RESISTANCE;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        positionX[i] += velocityX[i] * deltaTime;
+        positionY[i] += velocityY[i] * deltaTime;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        lifetime[i] -= deltaTime;
     }
+}
 
-    // Deactivate if lifetime is over
-    if (particle.lifetime <= 0.0f) {
-        particle.isActive = false;
+void ParticleSystem::RemoveDead() {
+    // Swap-remove keeps the live range dense; order is not preserved
+    size_t i = 0;
+    while (i < m_count) {
+        if (m_data.lifetime[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        --m_count;
+        if (i != m_count) {
+            m_data.Move(m_count, i);
+        }
     }
 }
 
 void ParticleSystem::CreateSparks(Vector2 position, int count) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> vel_dist(-50.0f, 50.0f); // Velocity range for x
-    std::uniform_real_distribution<> vel_y_dist(-100.0f, -20.0f); // Velocity range for y (upwards)
-    std::uniform_real_distribution<> life_dist(0.5f, 1.5f);    // Lifetime range
+    std::uniform_real_distribution<float> vel_dist(-50.0f, 50.0f); // Velocity range for x
+    std::uniform_real_distribution<float> vel_y_dist(-100.0f, -20.0f); // Velocity range for y (upwards)
+    std::uniform_real_distribution<float> life_dist(0.5f, 1.5f);    // Lifetime range
     std::uniform_int_distribution<> color_choice(0, 1);         // For choosing between two colors
-
-    for (int i = 0; i < count; ++i) {
-        ParticleProperties props;
-        props.position = position;
-        props.velocity = Vector2(static_cast<float>(vel_dist(gen)), static_cast<float>(vel_y_dist(gen)));
-        props.lifetime = static_cast<float>(life_dist(gen));
-
-        if (color_choice(gen) == 0) {
-            props.color = Vector3(1.0f, 0.5f, 0.0f); // Orange
-        } else {
-            props.color = Vector3(1.0f, 1.0f, 0.0f); // Yellow
+    
+    size_t remaining = m_poolSize > 0 ? static_cast<size_t>(std::max(count, 0)) : 0;
+    while (remaining > 0) {
+        size_t allocated;
+        size_t first = Allocate(remaining, allocated);
+        for (size_t i = first; i < first + allocated; ++i) {
+            m_data.positionX[i] = position.x;
+            m_data.positionY[i] = position.y;
+            m_data.velocityX[i] = vel_dist(m_random);
+            m_data.velocityY[i] = vel_y_dist(m_random);
+            m_data.lifetime[i] = life_dist(m_random);
+            
+            // Orange or yellow
+            m_data.colorR[i] = 1.0f;
+            m_data.colorG[i] = color_choice(m_random) == 0 ? 0.5f : 1.0f;
+            m_data.colorB[i] = 0.0f;
         }
-
-        Emit(props);
+        remaining -= allocated;
     }
 }
 
-void ParticleSystem::Render(Renderer& renderer) {
-    // Batch render all active particles for better performance
-    size_t activeCount = 0;
-    for (size_t i = 0; i < m_poolSize; ++i) {
-        if (m_particlePool[i].isActive) {
-            const Particle& p = m_particlePool[i];
-            renderer.DrawPrimitivePixel(static_cast<int>(p.position.x),
-                                        static_cast<int>(p.position.y),
-                                        p.color);
-            activeCount++;
-        }
-    }
+void ParticleSystem::Render(Renderer& renderer, uint32_t worldHeight) {
+    // All live particles go out in a single batched draw
+    renderer.DrawParticles(m_data, m_count, worldHeight);
     
     // Log performance metrics periodically
     static int frameCounter = 0;
     if (++frameCounter % 300 == 0) { // Every 5 seconds at 60 FPS
-        BGE_LOG_DEBUG("ParticleSystem", "Rendered " + std::to_string(activeCount) + 
+        BGE_LOG_DEBUG("ParticleSystem", "Rendered " + std::to_string(m_count) +
                       "/" + std::to_string(m_poolSize) + " particles");
     }
 }
 
 void ParticleSystem::CreateExplosion(Vector2 position, float intensity, int particleCount) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> angle_dist(0.0f, 2.0f * 3.14159f); // Full circle
-    std::uniform_real_distribution<> speed_dist(intensity * 0.5f, intensity * 1.5f);
-    std::uniform_real_distribution<> life_dist(0.8f, 2.0f);
+    std::uniform_real_distribution<float> angle_dist(0.0f, 2.0f * 3.14159f); // Full circle
+    std::uniform_real_distribution<float> speed_dist(intensity * 0.5f, intensity * 1.5f);
+    std::uniform_real_distribution<float> life_dist(0.8f, 2.0f);
+    std::uniform_real_distribution<float> color_dist(0.0f, 1.0f);
     
-    for (int i = 0; i < particleCount; ++i) {
-        float angle = static_cast<float>(angle_dist(gen));
-        float speed = static_cast<float>(speed_dist(gen));
-        
-        ParticleProperties props;
-        props.position = position;
-        props.velocity = Vector2(std::cos(angle) * speed, std::sin(angle) * speed);
-        props.lifetime = static_cast<float>(life_dist(gen));
-        
-        // Hot explosion colors (red/orange/yellow)
-        float colorChoice = static_cast<float>(std::uniform_real_distribution<>(0.0, 1.0)(gen));
-        if (colorChoice < 0.33f) {
-            props.color = Vector3(1.0f, 0.2f, 0.0f); // Red
-        } else if (colorChoice < 0.66f) {
-            props.color = Vector3(1.0f, 0.6f, 0.0f); // Orange
-        } else {
-            props.color = Vector3(1.0f, 1.0f, 0.2f); // Yellow
+    size_t remaining = m_poolSize > 0 ? static_cast<size_t>(std::max(particleCount, 0)) : 0;
+    while (remaining > 0) {
+        size_t allocated;
+        size_t first = Allocate(remaining, allocated);
+        for (size_t i = first; i < first + allocated; ++i) {
+            float angle = angle_dist(m_random);
+            float speed = speed_dist(m_random);
+            
+            m_data.positionX[i] = position.x;
+            m_data.positionY[i] = position.y;
+            m_data.velocityX[i] = std::cos(angle) * speed;
+            m_data.velocityY[i] = std::sin(angle) * speed;
+            m_data.lifetime[i] = life_dist(m_random);
+            
+            // Hot explosion colors (red/orange/yellow)
+            float colorChoice = color_dist(m_random);
+            m_data.colorR[i] = 1.0f;
+            if (colorChoice < 0.33f) {
+                m_data.colorG[i] = 0.2f; // Red
+                m_data.colorB[i] = 0.0f;
+            } else if (colorChoice < 0.66f) {
+                m_data.colorG[i] = 0.6f; // Orange
+                m_data.colorB[i] = 0.0f;
+            } else {
+                m_data.colorG[i] = 1.0f; // Yellow
+                m_data.colorB[i] = 0.2f;
+            }
         }
-        
-        Emit(props);
+        remaining -= allocated;
     }
 }
 
 void ParticleSystem::CreateTrail(Vector2 start, Vector2 end, const Vector3& color, int segments) {
-    if (segments <= 0) return;
+    if (segments <= 0 || m_poolSize == 0) return;
     
     Vector2 direction = end - start;
     float segmentLength = 1.0f / static_cast<float>(segments);
     
-    for (int i = 0; i < segments; ++i) {
-        float t = static_cast<float>(i) * segmentLength;
-        Vector2 position = start + direction * t;
-        
-        ParticleProperties props;
-        props.position = position;
-        props.velocity = Vector2(0.0f, 0.0f); // Stationary trail particles
-        props.color = color;
-        props.lifetime = 0.5f + (1.0f - t) * 0.5f; // Longer lifetime at start
-        
-        Emit(props);
-    }
-}
-
-size_t ParticleSystem::GetActiveParticleCount() const {
-    size_t count = 0;
-    for (const auto& particle : m_particlePool) {
-        if (particle.isActive) {
-            count++;
+    size_t remaining = static_cast<size_t>(segments);
+    size_t segment = 0;
+    while (remaining > 0) {
+        size_t allocated;
+        size_t first = Allocate(remaining, allocated);
+        for (size_t i = first; i < first + allocated; ++i, ++segment) {
+            float t = static_cast<float>(segment) * segmentLength;
+            
+            m_data.positionX[i] = start.x + direction.x * t;
+            m_data.positionY[i] = start.y + direction.y * t;
+            m_data.velocityX[i] = 0.0f; // Stationary trail particles
+            m_data.velocityY[i] = 0.0f;
+            m_data.colorR[i] = color.x;
+            m_data.colorG[i] = color.y;
+            m_data.colorB[i] = color.z;
+            m_data.lifetime[i] = 0.5f + (1.0f - t) * 0.5f; // Longer lifetime at start
         }
+        remaining -= allocated;
     }
-    return count;
 }
 
 } // namespace BGE
@@ -1,76 +1,101 @@
 #pragma once
 
 #include <vector>
-#include <memory> // For std::unique_ptr if ParticleSystem holds complex objects later
+#include <random>
+#include <cstdint>
 #include "../Core/Math/Vector2.h"
 #include "../Core/Math/Vector3.h" // For color
 
-// Forward declare Renderer if needed for drawing, or pass drawing context
-// class Renderer;
-
 namespace BGE {
 
+class ThreadPool;
+
 // Structure to define properties for emitting a new particle
 struct ParticleProperties {
     Vector2 position = {0.0f, 0.0f};
     Vector2 velocity = {0.0f, 0.0f};
     Vector3 color = {1.0f, 1.0f, 1.0f}; // Default to white
     float lifetime = 1.0f;             // Default to 1 second
-    // Future: float size = 1.0f;
-    // Future: float rotation = 0.0f;
-    // Future: TextureID texture = 0;
 };
 
-// Represents a single particle in the system
-struct Particle {
-    Vector2 position;
-    Vector2 velocity;
-    Vector3 color;
-    float lifetime;
-    // float size;       // Future extension
-    // float rotation;   // Future extension
-    // TextureID texture; // Future extension
-    bool isActive = false;
+// Live particles stored as parallel arrays (structure of arrays). Only the
+// first GetActiveParticleCount() entries are alive; dead particles are
+// swap-removed so every pass touches live data only, and emission appends
+// at the end of the live range.
+struct ParticleData {
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> colorR;
+    std::vector<float> colorG;
+    std::vector<float> colorB;
+    std::vector<float> lifetime;
+    
+    void Resize(size_t capacity);
+    void Clear();
+    void Move(size_t from, size_t to);
 };
 
 class ParticleSystem {
 public:
     ParticleSystem();
     ~ParticleSystem();
-
+    
     bool Initialize(size_t poolSize = 1000); // Default pool size
     void Shutdown();
-
+    
     void Emit(const ParticleProperties& properties);
     void Update(float deltaTime);
-
+    
     // Enhanced rendering with batching for better performance
-    void Render(class Renderer& renderer);
-
+    void Render(class Renderer& renderer, uint32_t worldHeight);
+    
     // Spark effects for material interactions
     void CreateSparks(Vector2 position, int count);
     void CreateExplosion(Vector2 position, float intensity, int particleCount);
     void CreateTrail(Vector2 start, Vector2 end, const Vector3& color, int segments);
-
+    
     // Physics effects
     void SetGravity(float gravity) { m_gravity = gravity; }
     float GetGravity() const { return m_gravity; }
     
+    // Optional parallel update for large particle counts
+    void SetThreadPool(ThreadPool* threadPool) { m_threadPool = threadPool; }
+    void SetParallelThreshold(size_t threshold) { m_parallelThreshold = threshold; }
+    
+    // Raw access to the live range for batched rendering
+    const ParticleData& GetData() const { return m_data; }
+    // Color fades out over the last FADE_TIME seconds of a particle's life
+    static float GetFade(float lifetime) { return lifetime < FADE_TIME ? lifetime / FADE_TIME : 1.0f; }
+    
     // Performance monitoring
-    size_t GetActiveParticleCount() const;
+    size_t GetActiveParticleCount() const { return m_count; }
     size_t GetMaxParticles() const { return m_poolSize; }
 
 private:
-    Particle* FindInactiveParticle();
-    void UpdatePhysics(Particle& particle, float deltaTime);
-
-    std::vector<Particle> m_particlePool;
+    // Reserves up to 'count' contiguous slots and returns the first; 'allocated'
+    // receives how many. Appends to the live range, or reuses live slots
+    // round-robin once the pool is full.
+    size_t Allocate(size_t count, size_t& allocated);
+    void Integrate(size_t begin, size_t end, float deltaTime);
+    void RemoveDead();
+    
+    ParticleData m_data;
     size_t m_poolSize;
-    size_t m_currentIndex = 0; // For round-robin inactive particle search
-
+    size_t m_count = 0;
+    size_t m_overwriteCursor = 0; // Next slot to reuse when the pool is full
+    
+    std::mt19937 m_random;
+    
+    ThreadPool* m_threadPool = nullptr;
+    size_t m_parallelThreshold = 8192;
+    
     // Physics properties
     float m_gravity = 98.0f; // Pixels/second^2
     static constexpr float AIR_RESISTANCE = 0.99f; // Velocity damping factor
+    static constexpr float FADE_TIME = 0.3f;
+    static constexpr size_t PARALLEL_GRAIN = 4096;
 };
 
 } // namespace BGE
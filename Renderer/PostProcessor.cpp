@@ -1,11 +1,44 @@
 #include "PostProcessor.h"
 #include "../Core/Logger.h"
+#include "../Core/Math/SIMD.h"
+#include "../Core/Threading/ThreadPool.h"
 #include <cmath>
 #include <algorithm>
+#include <array>
 #include <random>
 
 namespace BGE {
 
+namespace {
+    // out[i] = scale * sum of sources[s][i]. Both blur passes reduce to this:
+    // horizontally the sources are the same row shifted by -r..r, vertically
+    // they are the neighbouring rows.
+    void SumScaled(const float* const* sources, int sourceCount, float scale, float* out, int count) {
+        int i = 0;
+#if defined(BGE_SIMD_SSE)
+        const __m128 scale4 = _mm_set1_ps(scale);
+        for (; i + 4 <= count; i += 4) {
+            __m128 sum = _mm_loadu_ps(sources[0] + i);
+            for (int s = 1; s < sourceCount; ++s) {
+                sum = _mm_add_ps(sum, _mm_loadu_ps(sources[s] + i));
+            }
+            _mm_storeu_ps(out + i, _mm_mul_ps(sum, scale4));
+        }
+#endif
+        for (; i < count; ++i) {
+            float sum = sources[0][i];
+            for (int s = 1; s < sourceCount; ++s) {
+                sum += sources[s][i];
+            }
+            out[i] = sum * scale;
+        }
+    }
+    
+    inline uint8_t ToByte(float value) {
+        return static_cast<uint8_t>(std::clamp(value, 0.0f, 255.0f));
+    }
+}
+
 PostProcessor::PostProcessor() {
     // Constructor
 }
@@ -19,9 +52,7 @@ bool PostProcessor::Initialize(int screenWidth, int screenHeight) {
     m_screenHeight = screenHeight;
 
     // Initialize working buffers
-    size_t bufferSize = screenWidth * screenHeight * 4; // RGBA
-    m_bloomBuffer.resize(bufferSize);
-    m_tempBuffer.resize(bufferSize);
+    PrepareBloomBuffers(screenWidth, screenHeight);
 
     BGE_LOG_INFO("PostProcessor", "Initialized for " + std::to_string(screenWidth) + 
                  "x" + std::to_string(screenHeight) + " resolution");
@@ -29,8 +60,10 @@ bool PostProcessor::Initialize(int screenWidth, int screenHeight) {
 }
 
 void PostProcessor::Shutdown() {
-    m_bloomBuffer.clear();
-    m_tempBuffer.clear();
+    m_bloomPlanes.clear();
+    m_blurTemp.clear();
+    m_bloomWidth = m_bloomHeight = 0;
+    m_bloomDownsample = 0;
     BGE_LOG_INFO("PostProcessor", "Post-processor shutdown complete");
 }
 
@@ -47,50 +80,21 @@ void PostProcessor::ProcessFrame(uint8_t* pixelData, int width, int height) {
         return;
     }
 
-    static int frameCounter = 0;
-    bool hasEffects = m_enabledEffects != 0;
-    
-    // Apply effects in order
-    if (IsEffectEnabled(PostProcessEffect::Bloom)) {
-        ApplyBloom(pixelData, width, height);
-        if (frameCounter % 60 == 0) {
-            BGE_LOG_DEBUG("PostProcessor", "Applying Bloom effect");
-        }
+    const bool bloom = IsEffectEnabled(PostProcessEffect::Bloom);
+    if (bloom) {
+        ExtractBloom(pixelData, width, height);
+        BlurBloom();
+        ResolveBloom();
     }
-
-    if (IsEffectEnabled(PostProcessEffect::ColorGrading)) {
-        ApplyColorGrading(pixelData, width, height);
-        if (frameCounter % 60 == 0) {
-            BGE_LOG_DEBUG("PostProcessor", "Applying Color Grading effect");
-        }
-    }
-
-    if (IsEffectEnabled(PostProcessEffect::Scanlines)) {
-        ApplyScanlines(pixelData, width, height);
-        if (frameCounter % 60 == 0) {
-            BGE_LOG_DEBUG("PostProcessor", "Applying Scanlines effect");
-        }
+    
+    // Composite, grading and scanlines touch each pixel once
+    if (bloom || IsEffectEnabled(PostProcessEffect::ColorGrading) || IsEffectEnabled(PostProcessEffect::Scanlines)) {
+        ApplyFinalPass(pixelData, width, height);
     }
-
+    
     if (IsEffectEnabled(PostProcessEffect::Pixelation)) {
         ApplyPixelation(pixelData, width, height);
-        if (frameCounter % 60 == 0) {
-            BGE_LOG_DEBUG("PostProcessor", "Applying Pixelation effect");
-        }
-    }
-    
-    if (hasEffects && frameCounter % 60 == 0) {
-        // Count active effects manually (cross-platform way)
-        int activeCount = 0;
-        uint32_t temp = m_enabledEffects;
-        while (temp) {
-            activeCount += temp & 1;
-            temp >>= 1;
-        }
-        BGE_LOG_DEBUG("PostProcessor", "ProcessFrame completed with " + std::to_string(activeCount) + " active effects");
     }
-    
-    frameCounter++;
 }
 
 void PostProcessor::EnableEffect(PostProcessEffect effect) {
@@ -130,116 +134,356 @@ void PostProcessor::Update(float deltaTime) {
     }
 }
 
-void PostProcessor::ApplyBloom(uint8_t* pixelData, int width, int height) {
-    // Extract bright pixels for bloom
-    for (int i = 0; i < width * height * 4; i += 4) {
-        float brightness = GetPixelBrightness(pixelData[i], pixelData[i + 1], pixelData[i + 2]);
-        
-        if (brightness > m_bloomConfig.threshold) {
-            // Scale brightness for bloom
-            float bloomFactor = (brightness - m_bloomConfig.threshold) * m_bloomConfig.intensity;
-            m_bloomBuffer[i] = static_cast<uint8_t>(std::min(255.0f, pixelData[i] * bloomFactor));
-            m_bloomBuffer[i + 1] = static_cast<uint8_t>(std::min(255.0f, pixelData[i + 1] * bloomFactor));
-            m_bloomBuffer[i + 2] = static_cast<uint8_t>(std::min(255.0f, pixelData[i + 2] * bloomFactor));
-            m_bloomBuffer[i + 3] = pixelData[i + 3]; // Keep alpha
-        } else {
-            // Clear non-bright pixels
-            m_bloomBuffer[i] = 0;
-            m_bloomBuffer[i + 1] = 0;
-            m_bloomBuffer[i + 2] = 0;
-            m_bloomBuffer[i + 3] = 0;
-        }
+void PostProcessor::ForEachRowBand(int rows, const std::function<void(int, int)>& func) {
+    int bands = (rows + ROWS_PER_BAND - 1) / ROWS_PER_BAND;
+    if (m_threadPool && bands > 1) {
+        m_threadPool->ParallelFor(0, static_cast<size_t>(bands), [&func, rows](size_t band) {
+            int begin = static_cast<int>(band) * ROWS_PER_BAND;
+            func(begin, std::min(begin + ROWS_PER_BAND, rows));
+        });
+    } else if (rows > 0) {
+        func(0, rows);
     }
+}
 
-    // Apply blur to bloom buffer
-    for (int pass = 0; pass < m_bloomConfig.blurPasses; ++pass) {
-        GaussianBlur(m_bloomBuffer.data(), width, height, m_bloomConfig.blurRadius);
+void PostProcessor::PrepareBloomBuffers(int width, int height) {
+    int factor = std::clamp(m_bloomConfig.downsample, 1, 8);
+    if (factor == m_bloomDownsample && width == m_bloomSourceWidth && height == m_bloomSourceHeight) {
+        return;
     }
-
-    // Combine bloom with original
-    for (int i = 0; i < width * height * 4; i += 4) {
-        if (pixelData[i + 3] > 0) { // Only process non-transparent pixels
-            pixelData[i] = static_cast<uint8_t>(std::min(255.0f, pixelData[i] + m_bloomBuffer[i] * 0.3f));
-            pixelData[i + 1] = static_cast<uint8_t>(std::min(255.0f, pixelData[i + 1] + m_bloomBuffer[i + 1] * 0.3f));
-            pixelData[i + 2] = static_cast<uint8_t>(std::min(255.0f, pixelData[i + 2] + m_bloomBuffer[i + 2] * 0.3f));
-        }
+    
+    m_bloomDownsample = factor;
+    m_bloomSourceWidth = width;
+    m_bloomSourceHeight = height;
+    m_bloomWidth = (width + factor - 1) / factor;
+    m_bloomHeight = (height + factor - 1) / factor;
+    size_t planeSize = static_cast<size_t>(m_bloomWidth) * m_bloomHeight;
+    m_bloomPlanes.assign(planeSize * BLOOM_PLANES, 0.0f);
+    m_blurTemp.assign(planeSize * BLOOM_PLANES, 0.0f);
+    
+    // Sample the bloom buffer at each full-resolution pixel center
+    m_upsampleX0.resize(width);
+    m_upsampleX1.resize(width);
+    m_upsampleWeightX.resize(width);
+    for (int x = 0; x < width; ++x) {
+        float u = std::clamp((x + 0.5f) / factor - 0.5f, 0.0f, static_cast<float>(m_bloomWidth - 1));
+        int x0 = static_cast<int>(u);
+        m_upsampleX0[x] = x0;
+        m_upsampleX1[x] = std::min(x0 + 1, m_bloomWidth - 1);
+        m_upsampleWeightX[x] = u - x0;
     }
 }
 
-void PostProcessor::ApplyColorGrading(uint8_t* pixelData, int width, int height) {
-    for (int i = 0; i < width * height * 4; i += 4) {
-        if (pixelData[i + 3] > 0) { // Only process non-transparent pixels
-            Vector3 color = {
-                pixelData[i] / 255.0f,
-                pixelData[i + 1] / 255.0f,
-                pixelData[i + 2] / 255.0f
-            };
-
-            Vector3 gradedColor = ApplyColorGradeToPixel(color);
-
-            pixelData[i] = static_cast<uint8_t>(std::clamp(gradedColor.x * 255.0f, 0.0f, 255.0f));
-            pixelData[i + 1] = static_cast<uint8_t>(std::clamp(gradedColor.y * 255.0f, 0.0f, 255.0f));
-            pixelData[i + 2] = static_cast<uint8_t>(std::clamp(gradedColor.z * 255.0f, 0.0f, 255.0f));
+void PostProcessor::ExtractBloom(const uint8_t* pixelData, int width, int height) {
+    PrepareBloomBuffers(width, height);
+    
+    const int factor = m_bloomDownsample;
+    const int bloomWidth = m_bloomWidth;
+    const size_t planeSize = static_cast<size_t>(m_bloomWidth) * m_bloomHeight;
+    const float threshold = m_bloomConfig.threshold;
+    const float intensity = m_bloomConfig.intensity;
+    float* planeR = m_bloomPlanes.data();
+    float* planeG = planeR + planeSize;
+    float* planeB = planeG + planeSize;
+    float* planeCoverage = planeB + planeSize;
+    
+    // Bright pass and box downsample in one read of the frame
+    ForEachRowBand(m_bloomHeight, [&](int rowBegin, int rowEnd) {
+        // Per-pixel contributions of one source row (R, G, B, bright flag)
+        thread_local std::vector<float> scratch;
+        scratch.resize(static_cast<size_t>(width) * 4);
+        float* contribR = scratch.data();
+        float* contribG = contribR + width;
+        float* contribB = contribG + width;
+        float* contribW = contribB + width;
+        
+        for (int by = rowBegin; by < rowEnd; ++by) {
+            size_t rowOffset = static_cast<size_t>(by) * bloomWidth;
+            std::fill(planeR + rowOffset, planeR + rowOffset + bloomWidth, 0.0f);
+            std::fill(planeG + rowOffset, planeG + rowOffset + bloomWidth, 0.0f);
+            std::fill(planeB + rowOffset, planeB + rowOffset + bloomWidth, 0.0f);
+            std::fill(planeCoverage + rowOffset, planeCoverage + rowOffset + bloomWidth, 0.0f);
+            
+            int y0 = by * factor;
+            int y1 = std::min(y0 + factor, height);
+            for (int y = y0; y < y1; ++y) {
+                // Branch-free: pixels under the threshold contribute zero
+                const uint8_t* row = pixelData + static_cast<size_t>(y) * width * 4;
+                for (int x = 0; x < width; ++x) {
+                    float r = row[x * 4];
+                    float g = row[x * 4 + 1];
+                    float b = row[x * 4 + 2];
+                    float brightness = (0.299f * r + 0.587f * g + 0.114f * b) * (1.0f / 255.0f);
+                    float isBright = brightness > threshold ? 1.0f : 0.0f;
+                    float bloomFactor = (brightness - threshold) * intensity * isBright;
+                    contribR[x] = std::min(255.0f, r * bloomFactor);
+                    contribG[x] = std::min(255.0f, g * bloomFactor);
+                    contribB[x] = std::min(255.0f, b * bloomFactor);
+                    contribW[x] = isBright;
+                }
+                for (int bx = 0; bx < bloomWidth; ++bx) {
+                    int x0 = bx * factor;
+                    int x1 = std::min(x0 + factor, width);
+                    float sumR = 0.0f, sumG = 0.0f, sumB = 0.0f, sumW = 0.0f;
+                    for (int x = x0; x < x1; ++x) {
+                        sumR += contribR[x];
+                        sumG += contribG[x];
+                        sumB += contribB[x];
+                        sumW += contribW[x];
+                    }
+                    size_t index = rowOffset + bx;
+                    planeR[index] += sumR;
+                    planeG[index] += sumG;
+                    planeB[index] += sumB;
+                    planeCoverage[index] += sumW;
+                }
+            }
+            
+            // Average over the block (edge blocks may be partial)
+            for (int bx = 0; bx < bloomWidth; ++bx) {
+                int x0 = bx * factor;
+                float scale = 1.0f / ((y1 - y0) * (std::min(x0 + factor, width) - x0));
+                size_t index = rowOffset + bx;
+                planeR[index] *= scale;
+                planeG[index] *= scale;
+                planeB[index] *= scale;
+                planeCoverage[index] *= scale;
+            }
         }
+    });
+}
+
+void PostProcessor::ResolveBloom() {
+    // Colour / coverage = average over the bright samples, pre-scaled by the
+    // composite strength, so the full-resolution pass only upsamples and adds
+    const size_t planeSize = static_cast<size_t>(m_bloomWidth) * m_bloomHeight;
+    float* planeR = m_bloomPlanes.data();
+    float* planeG = planeR + planeSize;
+    float* planeB = planeG + planeSize;
+    const float* planeCoverage = planeB + planeSize;
+    for (size_t i = 0; i < planeSize; ++i) {
+        float coverage = planeCoverage[i];
+        float scale = coverage > MIN_BLOOM_COVERAGE ? BLOOM_STRENGTH / coverage : 0.0f;
+        planeR[i] *= scale;
+        planeG[i] *= scale;
+        planeB[i] *= scale;
     }
 }
 
-void PostProcessor::ApplyScanlines(uint8_t* pixelData, int width, int height) {
-    // Apply horizontal scanlines every 2 pixels for retro effect (much more obvious)
-    for (int y = 0; y < height; y += 2) {
-        for (int x = 0; x < width; ++x) {
-            int index = (y * width + x) * 4;
-            if (index + 3 < width * height * 4 && pixelData[index + 3] > 0) {
-                // Make scanlines much more noticeable
-                pixelData[index] = static_cast<uint8_t>(pixelData[index] * 0.3f);
-                pixelData[index + 1] = static_cast<uint8_t>(pixelData[index + 1] * 0.3f);
-                pixelData[index + 2] = static_cast<uint8_t>(pixelData[index + 2] * 0.3f);
+void PostProcessor::BlurBloom() {
+    // Radius is given in full-resolution pixels
+    int radius = static_cast<int>(std::lround(m_bloomConfig.blurRadius / m_bloomDownsample));
+    radius = std::min(std::max(radius, m_bloomConfig.blurRadius > 0.0f ? 1 : 0), MAX_BLUR_RADIUS);
+    if (radius <= 0) return;
+    
+    const int width = m_bloomWidth;
+    const int height = m_bloomHeight;
+    const float interiorScale = 1.0f / (2 * radius + 1);
+    
+    // All planes are blurred as one image of BLOOM_PLANES * height rows; the
+    // vertical pass never mixes rows from different planes. Blurring the
+    // coverage alongside the colour lets the composite average over bright
+    // samples only, so glow keeps its strength away from the source.
+    for (int pass = 0; pass < m_bloomConfig.blurPasses; ++pass) {
+        // Horizontal: planes -> temp
+        ForEachRowBand(height * BLOOM_PLANES, [&](int rowBegin, int rowEnd) {
+            std::array<const float*, 2 * MAX_BLUR_RADIUS + 1> sources;
+            for (int row = rowBegin; row < rowEnd; ++row) {
+                const float* in = m_bloomPlanes.data() + static_cast<size_t>(row) * width;
+                float* out = m_blurTemp.data() + static_cast<size_t>(row) * width;
+                
+                // Edges average only the samples inside the row
+                for (int x = 0; x < width; ++x) {
+                    if (x == radius && width > 2 * radius) {
+                        x = width - radius;
+                    }
+                    int x0 = std::max(0, x - radius);
+                    int x1 = std::min(width - 1, x + radius);
+                    float sum = 0.0f;
+                    for (int k = x0; k <= x1; ++k) {
+                        sum += in[k];
+                    }
+                    out[x] = sum / (x1 - x0 + 1);
+                }
+                if (width > 2 * radius) {
+                    for (int k = 0; k <= 2 * radius; ++k) {
+                        sources[k] = in + k;
+                    }
+                    SumScaled(sources.data(), 2 * radius + 1, interiorScale, out + radius, width - 2 * radius);
+                }
             }
-        }
+        });
+        
+        // Vertical: temp -> planes
+        ForEachRowBand(height * BLOOM_PLANES, [&](int rowBegin, int rowEnd) {
+            std::array<const float*, 2 * MAX_BLUR_RADIUS + 1> sources;
+            for (int row = rowBegin; row < rowEnd; ++row) {
+                int plane = row / height;
+                int y = row - plane * height;
+                int y0 = std::max(0, y - radius);
+                int y1 = std::min(height - 1, y + radius);
+                const float* planeBase = m_blurTemp.data() + static_cast<size_t>(plane) * height * width;
+                
+                int count = 0;
+                for (int k = y0; k <= y1; ++k) {
+                    sources[count++] = planeBase + static_cast<size_t>(k) * width;
+                }
+                SumScaled(sources.data(), count, 1.0f / count, m_bloomPlanes.data() + static_cast<size_t>(row) * width, width);
+            }
+        });
     }
 }
 
-void PostProcessor::ApplyPixelation(uint8_t* pixelData, int width, int height) {
-    // Simple pixelation by averaging 2x2 blocks
-    const int blockSize = 2;
+void PostProcessor::ApplyFinalPass(uint8_t* pixelData, int width, int height) {
+    const bool bloom = IsEffectEnabled(PostProcessEffect::Bloom);
+    const bool grading = IsEffectEnabled(PostProcessEffect::ColorGrading);
+    const bool scanlines = IsEffectEnabled(PostProcessEffect::Scanlines);
     
-    for (int y = 0; y < height; y += blockSize) {
-        for (int x = 0; x < width; x += blockSize) {
-            int r = 0, g = 0, b = 0, a = 0, count = 0;
+    // Everything the inner loop reads is copied to locals: byte stores may
+    // alias any member, which would otherwise force reloads per pixel
+    const size_t planeSize = static_cast<size_t>(m_bloomWidth) * m_bloomHeight;
+    const float* planeR = m_bloomPlanes.data();
+    const float* planeG = planeR + planeSize;
+    const float* planeB = planeG + planeSize;
+    const int* upsampleX0 = m_upsampleX0.data();
+    const int* upsampleX1 = m_upsampleX1.data();
+    const float* upsampleWeightX = m_upsampleWeightX.data();
+    const int bloomWidth = m_bloomWidth;
+    const int bloomHeight = m_bloomHeight;
+    const float bloomScale = 1.0f / std::max(m_bloomDownsample, 1);
+    
+    // Grading constants; the tone band is picked by luminance
+    const ColorGradingConfig grade = m_colorGradingConfig;
+    const float contrastOffset = (0.5f - 0.5f * grade.contrast) * 255.0f;
+    
+    ForEachRowBand(height, [&](int rowBegin, int rowEnd) {
+        // One row at a time as separate float channels, so each stage is a
+        // straight loop the compiler can vectorise
+        thread_local std::vector<float> scratch;
+        scratch.resize(static_cast<size_t>(width) * 3 + bloomWidth);
+        float* red = scratch.data();
+        float* green = red + width;
+        float* blue = green + width;
+        float* bloomRow = blue + width;
+        
+        for (int y = rowBegin; y < rowEnd; ++y) {
+            uint8_t* row = pixelData + static_cast<size_t>(y) * width * 4;
             
-            // Average the block
-            for (int by = 0; by < blockSize && y + by < height; ++by) {
-                for (int bx = 0; bx < blockSize && x + bx < width; ++bx) {
-                    int index = ((y + by) * width + (x + bx)) * 4;
-                    if (pixelData[index + 3] > 0) {
-                        r += pixelData[index];
-                        g += pixelData[index + 1];
-                        b += pixelData[index + 2];
-                        a += pixelData[index + 3];
-                        count++;
+            // Horizontal scanlines every 2 pixels for the retro look
+            const float rowScale = (scanlines && (y % 2) == 0) ? SCANLINE_DIM : 1.0f;
+            if (!bloom && !grading && rowScale == 1.0f) {
+                continue;
+            }
+            
+            for (int x = 0; x < width; ++x) {
+                red[x] = row[x * 4];
+                green[x] = row[x * 4 + 1];
+                blue[x] = row[x * 4 + 2];
+            }
+            
+            if (bloom) {
+                // Bilinear upsample: blend the two bracketing bloom rows, then
+                // sample that row at each pixel's horizontal taps
+                float v = std::clamp((y + 0.5f) * bloomScale - 0.5f, 0.0f, static_cast<float>(bloomHeight - 1));
+                int by = static_cast<int>(v);
+                size_t offset0 = static_cast<size_t>(by) * bloomWidth;
+                size_t offset1 = static_cast<size_t>(std::min(by + 1, bloomHeight - 1)) * bloomWidth;
+                float weightY = v - by;
+                
+                const float* planes[3] = {planeR, planeG, planeB};
+                float* channels[3] = {red, green, blue};
+                for (int c = 0; c < 3; ++c) {
+                    const float* top = planes[c] + offset0;
+                    const float* bottom = planes[c] + offset1;
+                    for (int bx = 0; bx < bloomWidth; ++bx) {
+                        bloomRow[bx] = top[bx] + (bottom[bx] - top[bx]) * weightY;
                     }
+                    
+                    float* channel = channels[c];
+                    for (int x = 0; x < width; ++x) {
+                        float left = bloomRow[upsampleX0[x]];
+                        float right = bloomRow[upsampleX1[x]];
+                        channel[x] = std::min(255.0f, channel[x] + left + (right - left) * upsampleWeightX[x]);
+                    }
+                }
+            }
+            
+            if (grading) {
+                // Contrast, saturation, then a shadow/midtone/highlight tint
+                // picked by luminance (arithmetically, not by branching)
+                for (int x = 0; x < width; ++x) {
+                    float r = red[x] * grade.contrast + contrastOffset;
+                    float g = green[x] * grade.contrast + contrastOffset;
+                    float b = blue[x] * grade.contrast + contrastOffset;
+                    float gray = r * 0.299f + g * 0.587f + b * 0.114f;
+                    r = gray + (r - gray) * grade.saturation;
+                    g = gray + (g - gray) * grade.saturation;
+                    b = gray + (b - gray) * grade.saturation;
+                    
+                    float shadow = gray < SHADOW_LIMIT ? 1.0f : 0.0f;
+                    float highlight = gray >= HIGHLIGHT_LIMIT ? 1.0f : 0.0f;
+                    float midtone = 1.0f - shadow - highlight;
+                    red[x] = r * (shadow * grade.shadows.x + midtone * grade.midtones.x + highlight * grade.highlights.x);
+                    green[x] = g * (shadow * grade.shadows.y + midtone * grade.midtones.y + highlight * grade.highlights.y);
+                    blue[x] = b * (shadow * grade.shadows.z + midtone * grade.midtones.z + highlight * grade.highlights.z);
                 }
             }
             
-            if (count > 0) {
-                uint8_t avgR = static_cast<uint8_t>(r / count);
-                uint8_t avgG = static_cast<uint8_t>(g / count);
-                uint8_t avgB = static_cast<uint8_t>(b / count);
-                uint8_t avgA = static_cast<uint8_t>(a / count);
+            // Only non-transparent pixels are written back
+            for (int x = 0; x < width; ++x) {
+                uint8_t* pixel = row + x * 4;
+                bool opaque = pixel[3] != 0;
+                pixel[0] = opaque ? ToByte(red[x] * rowScale) : pixel[0];
+                pixel[1] = opaque ? ToByte(green[x] * rowScale) : pixel[1];
+                pixel[2] = opaque ? ToByte(blue[x] * rowScale) : pixel[2];
+            }
+        }
+    });
+}
+
+void PostProcessor::ApplyPixelation(uint8_t* pixelData, int width, int height) {
+    // Simple pixelation by averaging 2x2 blocks
+    const int blockSize = 2;
+    
+    ForEachRowBand((height + blockSize - 1) / blockSize, [&](int blockRowBegin, int blockRowEnd) {
+        for (int y = blockRowBegin * blockSize; y < blockRowEnd * blockSize; y += blockSize) {
+            for (int x = 0; x < width; x += blockSize) {
+                int r = 0, g = 0, b = 0, a = 0, count = 0;
                 
-                // Apply average to all pixels in block
+                // Average the block
                 for (int by = 0; by < blockSize && y + by < height; ++by) {
                     for (int bx = 0; bx < blockSize && x + bx < width; ++bx) {
                         int index = ((y + by) * width + (x + bx)) * 4;
-                        pixelData[index] = avgR;
-                        pixelData[index + 1] = avgG;
-                        pixelData[index + 2] = avgB;
-                        pixelData[index + 3] = avgA;
+                        if (pixelData[index + 3] > 0) {
+                            r += pixelData[index];
+                            g += pixelData[index + 1];
+                            b += pixelData[index + 2];
+                            a += pixelData[index + 3];
+                            count++;
+                        }
+                    }
+                }
+                
+                if (count > 0) {
+                    uint8_t avgR = static_cast<uint8_t>(r / count);
+                    uint8_t avgG = static_cast<uint8_t>(g / count);
+                    uint8_t avgB = static_cast<uint8_t>(b / count);
+                    uint8_t avgA = static_cast<uint8_t>(a / count);
+                    
+                    // Apply average to all pixels in block
+                    for (int by = 0; by < blockSize && y + by < height; ++by) {
+                        for (int bx = 0; bx < blockSize && x + bx < width; ++bx) {
+                            int index = ((y + by) * width + (x + bx)) * 4;
+                            pixelData[index] = avgR;
+                            pixelData[index + 1] = avgG;
+                            pixelData[index + 2] = avgB;
+                            pixelData[index + 3] = avgA;
+                        }
                     }
                 }
             }
         }
-    }
+    });
 }
 
 void PostProcessor::UpdateScreenShake(float deltaTime) {
@@ -272,117 +516,4 @@ Vector2 PostProcessor::CalculateShakeOffset() {
     return {shakeX, shakeY};
 }
 
-float PostProcessor::GetPixelBrightness(uint8_t r, uint8_t g, uint8_t b) {
-    // Luminance calculation
-    return (0.299f * r + 0.587f * g + 0.114f * b) / 255.0f;
-}
-
-Vector3 PostProcessor::ApplyColorGradeToPixel(const Vector3& color) {
-    // Simple color grading implementation
-    Vector3 result = color;
-
-    // Apply contrast
-    result.x = (result.x - 0.5f) * m_colorGradingConfig.contrast + 0.5f;
-    result.y = (result.y - 0.5f) * m_colorGradingConfig.contrast + 0.5f;
-    result.z = (result.z - 0.5f) * m_colorGradingConfig.contrast + 0.5f;
-
-    // Apply saturation
-    float gray = result.x * 0.299f + result.y * 0.587f + result.z * 0.114f;
-    result.x = gray + (result.x - gray) * m_colorGradingConfig.saturation;
-    result.y = gray + (result.y - gray) * m_colorGradingConfig.saturation;
-    result.z = gray + (result.z - gray) * m_colorGradingConfig.saturation;
-
-    // Apply tone mapping (simplified)
-    float brightness = GetPixelBrightness(
-        static_cast<uint8_t>(result.x * 255),
-        static_cast<uint8_t>(result.y * 255),
-        static_cast<uint8_t>(result.z * 255)
-    );
-
-    if (brightness < 0.33f) {
-        // Shadows
-        result.x *= m_colorGradingConfig.shadows.x;
-        result.y *= m_colorGradingConfig.shadows.y;
-        result.z *= m_colorGradingConfig.shadows.z;
-    } else if (brightness < 0.66f) {
-        // Midtones
-        result.x *= m_colorGradingConfig.midtones.x;
-        result.y *= m_colorGradingConfig.midtones.y;
-        result.z *= m_colorGradingConfig.midtones.z;
-    } else {
-        // Highlights
-        result.x *= m_colorGradingConfig.highlights.x;
-        result.y *= m_colorGradingConfig.highlights.y;
-        result.z *= m_colorGradingConfig.highlights.z;
-    }
-
-    return result;
-}
-
-void PostProcessor::GaussianBlur(uint8_t* buffer, int width, int height, float radius) {
-    // Simple box blur approximation for performance
-    int r = static_cast<int>(radius);
-    if (r <= 0) return;
-
-    // Copy to temp buffer
-    std::copy(buffer, buffer + width * height * 4, m_tempBuffer.begin());
-
-    // Horizontal pass
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int rSum = 0, gSum = 0, bSum = 0, count = 0;
-            
-            for (int dx = -r; dx <= r; ++dx) {
-                int nx = x + dx;
-                if (nx >= 0 && nx < width) {
-                    int index = (y * width + nx) * 4;
-                    if (m_tempBuffer[index + 3] > 0) {
-                        rSum += m_tempBuffer[index];
-                        gSum += m_tempBuffer[index + 1];
-                        bSum += m_tempBuffer[index + 2];
-                        count++;
-                    }
-                }
-            }
-            
-            if (count > 0) {
-                int index = (y * width + x) * 4;
-                buffer[index] = static_cast<uint8_t>(rSum / count);
-                buffer[index + 1] = static_cast<uint8_t>(gSum / count);
-                buffer[index + 2] = static_cast<uint8_t>(bSum / count);
-            }
-        }
-    }
-
-    // Copy back to temp
-    std::copy(buffer, buffer + width * height * 4, m_tempBuffer.begin());
-
-    // Vertical pass
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int rSum = 0, gSum = 0, bSum = 0, count = 0;
-            
-            for (int dy = -r; dy <= r; ++dy) {
-                int ny = y + dy;
-                if (ny >= 0 && ny < height) {
-                    int index = (ny * width + x) * 4;
-                    if (m_tempBuffer[index + 3] > 0) {
-                        rSum += m_tempBuffer[index];
-                        gSum += m_tempBuffer[index + 1];
-                        bSum += m_tempBuffer[index + 2];
-                        count++;
-                    }
-                }
-            }
-            
-            if (count > 0) {
-                int index = (y * width + x) * 4;
-                buffer[index] = static_cast<uint8_t>(rSum / count);
-                buffer[index + 1] = static_cast<uint8_t>(gSum / count);
-                buffer[index + 2] = static_cast<uint8_t>(bSum / count);
-            }
-        }
-    }
-}
-
 } // namespace BGE
\ No newline at end of file
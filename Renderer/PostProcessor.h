@@ -4,11 +4,14 @@
 #include "../Core/Math/Vector3.h"
 #include <vector>
 #include <memory>
+#include <functional>
+#include <cstdint>
 
 namespace BGE {
 
 // Forward declarations
 class PixelCamera;
+class ThreadPool;
 
 // Post-processing effect types
 enum class PostProcessEffect {
@@ -33,7 +36,8 @@ struct BloomConfig {
     float threshold = 0.8f;     // Brightness threshold for bloom
     float intensity = 1.5f;     // Bloom effect intensity
     int blurPasses = 3;         // Number of blur iterations
-    float blurRadius = 2.0f;    // Blur kernel radius
+    float blurRadius = 2.0f;    // Blur kernel radius (full-resolution pixels)
+    int downsample = 2;         // Bloom buffer resolution divisor (1 = full, 2 = half, 4 = quarter)
 };
 
 // Color grading configuration
@@ -75,22 +79,26 @@ public:
     // Update for time-based effects
     void Update(float deltaTime);
 
+    // Optional worker pool; row bands of each pass are spread across it
+    void SetThreadPool(ThreadPool* threadPool) { m_threadPool = threadPool; }
+
 private:
     // Effect implementations
-    void ApplyBloom(uint8_t* pixelData, int width, int height);
-    void ApplyColorGrading(uint8_t* pixelData, int width, int height);
-    void ApplyScanlines(uint8_t* pixelData, int width, int height);
+    void ExtractBloom(const uint8_t* pixelData, int width, int height);
+    void BlurBloom();
+    void ResolveBloom();
+    // Bloom composite, colour grading and scanlines in a single pass over the frame
+    void ApplyFinalPass(uint8_t* pixelData, int width, int height);
     void ApplyPixelation(uint8_t* pixelData, int width, int height);
 
+    // Runs func(rowBegin, rowEnd) over [0, rows), in parallel when a pool is set
+    void ForEachRowBand(int rows, const std::function<void(int, int)>& func);
+    void PrepareBloomBuffers(int width, int height);
+
     // Screen shake implementation
     void UpdateScreenShake(float deltaTime);
     Vector2 CalculateShakeOffset();
 
-    // Utility functions
-    float GetPixelBrightness(uint8_t r, uint8_t g, uint8_t b);
-    Vector3 ApplyColorGradeToPixel(const Vector3& color);
-    void GaussianBlur(uint8_t* buffer, int width, int height, float radius);
-
     // State
     uint32_t m_enabledEffects = 0;  // Bitmask of enabled effects
     int m_screenWidth = 0;
@@ -106,9 +114,31 @@ private:
     BloomConfig m_bloomConfig;
     ColorGradingConfig m_colorGradingConfig;
 
-    // Working buffers for effects
-    std::vector<uint8_t> m_bloomBuffer;
-    std::vector<uint8_t> m_tempBuffer;
+    // Bloom works on planar float channels (R, G, B and bright coverage,
+    // stacked) at 1/downsample resolution
+    std::vector<float> m_bloomPlanes;
+    std::vector<float> m_blurTemp;
+    int m_bloomWidth = 0;
+    int m_bloomHeight = 0;
+    int m_bloomDownsample = 0;
+    int m_bloomSourceWidth = 0;
+    int m_bloomSourceHeight = 0;
+
+    // Bilinear upsample taps per full-resolution column
+    std::vector<int> m_upsampleX0;
+    std::vector<int> m_upsampleX1;
+    std::vector<float> m_upsampleWeightX;
+
+    ThreadPool* m_threadPool = nullptr;
+
+    static constexpr int BLOOM_PLANES = 4;
+    static constexpr int ROWS_PER_BAND = 32;
+    static constexpr int MAX_BLUR_RADIUS = 16;
+    static constexpr float BLOOM_STRENGTH = 0.3f;   // Bloom added on top of the frame
+    static constexpr float MIN_BLOOM_COVERAGE = 1e-4f;
+    static constexpr float SCANLINE_DIM = 0.3f;
+    static constexpr float SHADOW_LIMIT = 0.33f * 255.0f;    // Tone bands by luminance
+    static constexpr float HIGHLIGHT_LIMIT = 0.66f * 255.0f;
 };
 
 // Inline helper for effect flags
@@ -4,9 +4,13 @@
 #include "PostProcessor.h"
 #include "../Core/Logger.h"
 #include "../Core/ServiceLocator.h" // For ServiceLocator
+#include "../Core/Profiling/Profiler.h"
 #include "../Core/Math/Vector2.h"
 #include "../Simulation/SimulationWorld.h"
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 
 // Define OpenGL extension function pointer types
 typedef void (APIENTRY *PFNGLGENFRAMEBUFFERSPROC) (GLsizei n, GLuint *framebuffers);
@@ -19,6 +23,11 @@ typedef void (APIENTRY *PFNGLFRAMEBUFFERRENDERBUFFERPROC) (GLenum target, GLenum
 typedef GLenum (APIENTRY *PFNGLCHECKFRAMEBUFFERSTATUSPROC) (GLenum target);
 typedef void (APIENTRY *PFNGLDELETEFRAMEBUFFERSPROC) (GLsizei n, const GLuint *framebuffers);
 typedef void (APIENTRY *PFNGLDELETERENDERBUFFERSPROC) (GLsizei n, const GLuint *renderbuffers);
+typedef void (APIENTRY *PFNGLGENBUFFERSPROC) (GLsizei n, GLuint *buffers);
+typedef void (APIENTRY *PFNGLBINDBUFFERPROC) (GLenum target, GLuint buffer);
+typedef void (APIENTRY *PFNGLBUFFERDATAPROC) (GLenum target, ptrdiff_t size, const void *data, GLenum usage);
+typedef void (APIENTRY *PFNGLBUFFERSUBDATAPROC) (GLenum target, ptrdiff_t offset, ptrdiff_t size, const void *data);
+typedef void (APIENTRY *PFNGLDELETEBUFFERSPROC) (GLsizei n, const GLuint *buffers);
 
 // OpenGL extension function pointers (will be loaded at runtime)
 PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers = nullptr;
@@ -31,6 +40,11 @@ PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer = nullptr;
 PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus = nullptr;
 PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers = nullptr;
 PFNGLDELETERENDERBUFFERSPROC glDeleteRenderbuffers = nullptr;
+PFNGLGENBUFFERSPROC glGenBuffers = nullptr;
+PFNGLBINDBUFFERPROC glBindBuffer = nullptr;
+PFNGLBUFFERDATAPROC glBufferData = nullptr;
+PFNGLBUFFERSUBDATAPROC glBufferSubData = nullptr;
+PFNGLDELETEBUFFERSPROC glDeleteBuffers = nullptr;
 
 // OpenGL constants for framebuffer operations
 #ifndef GL_FRAMEBUFFER
@@ -55,6 +69,14 @@ PFNGLDELETERENDERBUFFERSPROC glDeleteRenderbuffers = nullptr;
 #define GL_CLAMP_TO_EDGE 0x812F
 #endif
 
+// OpenGL constants for vertex buffer objects
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+
 // Function to load OpenGL extensions
 bool LoadFramebufferExtensions() {
     glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)glfwGetProcAddress("glGenFramebuffers");
@@ -74,6 +96,17 @@ bool LoadFramebufferExtensions() {
             glDeleteFramebuffers && glDeleteRenderbuffers);
 }
 
+// Vertex buffer objects (core since OpenGL 1.5) for streamed geometry
+bool LoadBufferExtensions() {
+    glGenBuffers = (PFNGLGENBUFFERSPROC)glfwGetProcAddress("glGenBuffers");
+    glBindBuffer = (PFNGLBINDBUFFERPROC)glfwGetProcAddress("glBindBuffer");
+    glBufferData = (PFNGLBUFFERDATAPROC)glfwGetProcAddress("glBufferData");
+    glBufferSubData = (PFNGLBUFFERSUBDATAPROC)glfwGetProcAddress("glBufferSubData");
+    glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)glfwGetProcAddress("glDeleteBuffers");
+    
+    return (glGenBuffers && glBindBuffer && glBufferData && glBufferSubData && glDeleteBuffers);
+}
+
 namespace BGE {
 
 Renderer::Renderer() {
@@ -97,6 +130,11 @@ bool Renderer::Initialize(Window* window) {
     } else {
         BGE_LOG_INFO("Renderer", "OpenGL framebuffer extensions loaded successfully.");
     }
+    
+    // Particles are streamed through a vertex buffer when available, client-side arrays otherwise
+    if (!LoadBufferExtensions()) {
+        BGE_LOG_WARNING("Renderer", "Failed to load OpenGL buffer object functions. Particles will use client-side vertex arrays.");
+    }
 
     m_pixelCamera = std::make_unique<PixelCamera>();
     if (m_pixelCamera) {
@@ -116,6 +154,7 @@ bool Renderer::Initialize(Window* window) {
     // Initialize PostProcessor with simulation world dimensions
     // The PostProcessor works on the simulation pixel data, not the window size
     m_postProcessor = std::make_unique<PostProcessor>();
+    m_lightingSystem = std::make_unique<LightingSystem>();
     // Note: PostProcessor will be re-initialized when we know the actual world size
 
     BGE_LOG_INFO("Renderer", "Renderer initialized successfully.");
@@ -128,13 +167,27 @@ void Renderer::Shutdown() {
     // Cleanup framebuffer
     DestroyGameFramebuffer();
     
+    if (m_particleBuffer != 0 && glDeleteBuffers) {
+        glDeleteBuffers(1, &m_particleBuffer);
+        m_particleBuffer = 0;
+    }
+    m_particleBufferCapacity = 0;
+    m_particleVertices.clear();
+    m_particleVertices.shrink_to_fit();
+    
     if (m_postProcessor) {
         m_postProcessor->Shutdown();
         m_postProcessor.reset();
     }
+    m_lightingSystem.reset();
     m_pixelCamera.reset();
 }
 
+void Renderer::NewFrame() {
+    m_particleDrawCalls = 0;
+    m_particlesUploaded = false;
+}
+
 void Renderer::BeginFrame() {
     BGE_LOG_TRACE("Renderer", "BeginFrame() - Setting up OpenGL state");
     
@@ -153,15 +206,12 @@ void Renderer::BeginFrame() {
             // Convert from top-left origin to bottom-left origin for OpenGL
             int openglY = windowHeight - m_simViewportY - m_simViewportHeight;
             glViewport(m_simViewportX, openglY, m_simViewportWidth, m_simViewportHeight);
-            BGE_LOG_TRACE("Renderer", "OpenGL viewport set to (" + std::to_string(m_simViewportX) + "," + 
-                          std::to_string(openglY) + ") size " + std::to_string(m_simViewportWidth) + 
-                          "x" + std::to_string(m_simViewportHeight) + " (converted from window coords (" +
-                          std::to_string(m_simViewportX) + "," + std::to_string(m_simViewportY) + "))");
+            BGE_LOG_TRACE_FMT("Renderer", "OpenGL viewport set to ({},{}) size {}x{} (converted from window coords ({},{}))",
+                              m_simViewportX, openglY, m_simViewportWidth, m_simViewportHeight, m_simViewportX, m_simViewportY);
         } else {
             glViewport(m_simViewportX, m_simViewportY, m_simViewportWidth, m_simViewportHeight);
-            BGE_LOG_TRACE("Renderer", "OpenGL viewport set to (" + std::to_string(m_simViewportX) + "," + 
-                          std::to_string(m_simViewportY) + ") size " + std::to_string(m_simViewportWidth) + 
-                          "x" + std::to_string(m_simViewportHeight) + " (no window available for Y conversion)");
+            BGE_LOG_TRACE_FMT("Renderer", "OpenGL viewport set to ({},{}) size {}x{} (no window available for Y conversion)",
+                              m_simViewportX, m_simViewportY, m_simViewportWidth, m_simViewportHeight);
         }
     } else {
         BGE_LOG_TRACE("Renderer", "Rendering to texture - viewport already set by BeginRenderToTexture()");
@@ -188,10 +238,8 @@ void Renderer::BeginFrame() {
         viewMatrix.ToFloatArray(matrix);
         glMultMatrixf(matrix);
         
-        BGE_LOG_TRACE("Renderer", "Applied camera view matrix with position (" + 
-                      std::to_string(m_pixelCamera->GetPosition().x) + "," + 
-                      std::to_string(m_pixelCamera->GetPosition().y) + ") zoom " + 
-                      std::to_string(m_pixelCamera->GetZoom()));
+        BGE_LOG_TRACE_FMT("Renderer", "Applied camera view matrix with position ({},{}) zoom {}",
+                          m_pixelCamera->GetPosition().x, m_pixelCamera->GetPosition().y, m_pixelCamera->GetZoom());
     } else {
         // Default projection for direct rendering (no camera)
         // Apply screen shake offset if available
@@ -208,8 +256,8 @@ void Renderer::BeginFrame() {
         float top = 512.0f + shakeOffset.y;
         
         glOrtho(left, right, bottom, top, -1, 1);
-        BGE_LOG_TRACE("Renderer", "Projection matrix set to default orthographic with shake offset (" + 
-                      std::to_string(shakeOffset.x) + "," + std::to_string(shakeOffset.y) + ")");
+        BGE_LOG_TRACE_FMT("Renderer", "Projection matrix set to default orthographic with shake offset ({},{})",
+                          shakeOffset.x, shakeOffset.y);
     }
     
     glMatrixMode(GL_MODELVIEW);
@@ -262,6 +310,7 @@ void Renderer::SetSimulationViewport(int x, int y, int width, int height) {
 }
 
 void Renderer::RenderWorld(class SimulationWorld* world) {
+    BGE_PROFILE_SCOPE("Renderer::RenderWorld");
     if (!world) return;
     
     // Get the pre-rendered pixel data from the simulation world
@@ -292,12 +341,28 @@ void Renderer::RenderWorld(class SimulationWorld* world) {
         }
     }
     
-    // Create a working copy for post-processing
-    std::vector<uint8_t> workingPixelData(originalPixelData, originalPixelData + (width * height * 4));
-    uint8_t* pixelData = workingPixelData.data();
+    // CPU lighting, post-processing and particle updates borrow the simulation's workers,
+    // which are idle once the world has updated, rather than oversubscribing with a pool of our own
+    ThreadPool* threadPool = world->GetThreadPool();
+    if (m_postProcessor) m_postProcessor->SetThreadPool(threadPool);
+    if (m_lightingSystem) m_lightingSystem->SetThreadPool(threadPool);
+    if (auto particleSystem = ServiceLocator::Instance().GetService<ParticleSystem>()) {
+        particleSystem->SetThreadPool(threadPool);
+    }
+    
+    // Working copy for post-processing, reused across frames
+    m_workingPixels.assign(originalPixelData, originalPixelData + (width * height * 4));
+    uint8_t* pixelData = m_workingPixels.data();
+    
+    // Light the frame before post-processing so bloom picks up lit surfaces
+    if (m_lightingSystem && m_lightingSystem->IsEnabled()) {
+        m_lightingSystem->Update(world);
+        m_lightingSystem->Apply(pixelData, static_cast<int>(width), static_cast<int>(height));
+    }
     
     // Apply post-processing effects
     if (m_postProcessor) {
+        BGE_PROFILE_SCOPE("PostProcessor::ProcessFrame");
         m_postProcessor->ProcessFrame(pixelData, width, height);
     }
     
@@ -317,6 +382,7 @@ void Renderer::RenderWorld(class SimulationWorld* world) {
     BGE_LOG_TRACE("Renderer", "Starting OpenGL quad rendering for tight pixels");
     
     // Use GL_QUADS to ensure tight pixel coverage without gaps
+    BGE_PROFILE_SCOPE("Renderer::DrawWorldQuads");
     glBegin(GL_QUADS);
     
     int pixelsDrawn = 0;
@@ -360,6 +426,9 @@ void Renderer::RenderWorld(class SimulationWorld* world) {
     
     BGE_LOG_TRACE("Renderer", "OpenGL rendering completed - drew " + std::to_string(pixelsDrawn) + " pixels");
     
+    // Particles go on top of the cells, in the same world-space projection
+    RenderParticles(height);
+    
     // Check for OpenGL errors after rendering
     GLenum error = glGetError();
     if (error != GL_NO_ERROR) {
@@ -379,10 +448,84 @@ void Renderer::DrawPrimitivePixel(int x, int y, const Vector3& color) {
     // BGE_LOG_VERY_VERBOSE("Renderer", "DrawPrimitivePixel at (" + std::to_string(x) + "," + std::to_string(y) + ") with color (" + std::to_string(color.x) + ", " + std::to_string(color.y) + ", " + std::to_string(color.z) + ")");
 }
 
-void Renderer::RenderParticles() {
+void Renderer::RenderParticles(uint32_t worldHeight) {
+    BGE_PROFILE_SCOPE("Renderer::RenderParticles");
     auto particleSystem = ServiceLocator::Instance().GetService<ParticleSystem>();
     if (particleSystem) {
-        particleSystem->Render(*this); // Pass *this (the Renderer instance)
+        particleSystem->Render(*this, worldHeight);
+    }
+}
+
+void Renderer::DrawParticles(const ParticleData& particles, size_t count, uint32_t worldHeight) {
+    if (count == 0) return;
+    
+    // The world may be drawn into several targets per frame; only the first draw
+    // builds and streams the batch, the rest redraw it from the same buffer
+    const bool upload = !m_particlesUploaded || count != m_particleUploadCount ||
+                        worldHeight != m_particleUploadHeight;
+    ParticleVertex* vertices = nullptr;
+    if (upload) {
+        // Build the whole batch on the CPU; the staging array only ever grows
+        if (m_particleVertices.size() < count) {
+            m_particleVertices.resize(count);
+        }
+        vertices = m_particleVertices.data();
+        const float* positionX = particles.positionX.data();
+        const float* positionY = particles.positionY.data();
+        const float* colorR = particles.colorR.data();
+        const float* colorG = particles.colorG.data();
+        const float* colorB = particles.colorB.data();
+        const float* lifetime = particles.lifetime.data();
+        const float flipY = static_cast<float>(worldHeight) - 0.5f;
+        for (size_t i = 0; i < count; ++i) {
+            float scale = ParticleSystem::GetFade(lifetime[i]) * 255.0f;
+            ParticleVertex& vertex = vertices[i];
+            // Pixel center; rows are flipped like the pixel buffer (grid y down, GL y up)
+            vertex.x = std::floor(positionX[i]) + 0.5f;
+            vertex.y = flipY - std::floor(positionY[i]);
+            vertex.r = static_cast<uint8_t>(std::clamp(colorR[i] * scale, 0.0f, 255.0f));
+            vertex.g = static_cast<uint8_t>(std::clamp(colorG[i] * scale, 0.0f, 255.0f));
+            vertex.b = static_cast<uint8_t>(std::clamp(colorB[i] * scale, 0.0f, 255.0f));
+            vertex.a = 255;
+        }
+        m_particlesUploaded = true;
+        m_particleUploadCount = count;
+        m_particleUploadHeight = worldHeight;
+    }
+    vertices = m_particleVertices.data();
+    
+    const size_t byteCount = count * sizeof(ParticleVertex);
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(vertices);
+    if (glGenBuffers) {
+        if (m_particleBuffer == 0) {
+            glGenBuffers(1, &m_particleBuffer);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, m_particleBuffer);
+        if (upload) {
+            if (byteCount > m_particleBufferCapacity) {
+                // Grow geometrically so steady emission doesn't reallocate every frame
+                m_particleBufferCapacity = std::max(byteCount, m_particleBufferCapacity * 2);
+            }
+            // Orphan the previous frame's storage so the upload never waits on the GPU
+            glBufferData(GL_ARRAY_BUFFER, static_cast<ptrdiff_t>(m_particleBufferCapacity), nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<ptrdiff_t>(byteCount), vertices);
+        }
+        base = nullptr; // Attribute pointers become offsets into the bound buffer
+    }
+    
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(ParticleVertex), base + offsetof(ParticleVertex, x));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(ParticleVertex), base + offsetof(ParticleVertex, r));
+    glPointSize(1.0f);
+    
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(count));
+    ++m_particleDrawCalls;
+    
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    if (glBindBuffer) {
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 }
 
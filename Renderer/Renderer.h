@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include <cstdint>
 #include "../Core/Math/Matrix4.h" // For BGE::Matrix4
 #include "../Core/Platform/Window.h" // For BGE::Window
@@ -8,6 +9,7 @@
 #include "PixelCamera.h" // Added include for PixelCamera
 #include "ParticleSystem.h" // Added include for ParticleSystem
 #include "PostProcessor.h" // Added include for PostProcessor
+#include "Lighting/LightingSystem.h"
 
 // Forward declarations
 namespace BGE {
@@ -24,19 +26,28 @@ public:
     bool Initialize(Window* window);
     void Shutdown();
 
+    // Marks the start of an engine frame. BeginFrame/EndFrame run once per render
+    // target (window, game and sculpting panels), so per-frame stats and uploads
+    // are keyed to this instead.
+    void NewFrame();
     void BeginFrame();
     void EndFrame();
     
     // Viewport management
     void SetSimulationViewport(int x, int y, int width, int height);
 
-    // World rendering
+    // World rendering, including the live particles on top of the cells
     void RenderWorld(class SimulationWorld* world);
 
-    // Particle system methods
-    void RenderParticles();
+    // Draws the first 'count' particles (grid coordinates, y down, in a world
+    // 'worldHeight' cells tall) as one batch. The batch is built and streamed into a
+    // persistent vertex buffer on the first draw of a frame; later draws in the same
+    // frame reuse it.
+    void DrawParticles(const ParticleData& particles, size_t count, uint32_t worldHeight);
+    // Particle draw calls issued since NewFrame()
+    uint32_t GetParticleDrawCalls() const { return m_particleDrawCalls; }
 
-    // Primitive drawing methods (used by ParticleSystem for now)
+    // Primitive drawing methods
     void DrawPrimitivePixel(int x, int y, const Vector3& color);
 
     // Texture management for asset pipeline
@@ -62,12 +73,15 @@ public:
 
     PixelCamera* GetPixelCamera() const { return m_pixelCamera.get(); }
     PostProcessor* GetPostProcessor() const { return m_postProcessor.get(); }
+    LightingSystem* GetLightingSystem() const { return m_lightingSystem.get(); }
     Window* GetWindow() const { return m_window; }
 
 private:
     Window* m_window = nullptr;
     std::unique_ptr<PixelCamera> m_pixelCamera;
     std::unique_ptr<PostProcessor> m_postProcessor;
+    std::unique_ptr<LightingSystem> m_lightingSystem;
+    std::vector<uint8_t> m_workingPixels;     // Post-processed copy of the world pixels
     uint32_t m_nextTextureId = 1; // Simple way to generate unique IDs for placeholder
 
     // Simulation viewport settings
@@ -92,6 +106,21 @@ private:
     int m_sceneTextureHeight = 512;
     bool m_renderingToSceneTexture = false;
 
+    // Batched particle rendering
+    struct ParticleVertex {
+        float x, y;
+        uint8_t r, g, b, a;
+    };
+    std::vector<ParticleVertex> m_particleVertices; // CPU staging, reused every frame
+    uint32_t m_particleBuffer = 0;
+    size_t m_particleBufferCapacity = 0;          // Bytes allocated for m_particleBuffer
+    uint32_t m_particleDrawCalls = 0;
+    bool m_particlesUploaded = false;             // Batch for this frame is in m_particleBuffer
+    size_t m_particleUploadCount = 0;
+    uint32_t m_particleUploadHeight = 0;
+
+    void RenderParticles(uint32_t worldHeight);
+
     // Placeholder for actual rendering context or device
     void* m_renderContext = nullptr;
 };
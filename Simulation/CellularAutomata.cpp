@@ -1,6 +1,7 @@
 #include "CellularAutomata.h"
 #include "SimulationWorld.h"
 #include "Materials/MaterialSystem.h"
+#include "Physics/DebrisSystem.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
@@ -221,7 +222,7 @@ void CellularAutomata::Update(float deltaTime) {
 void CellularAutomata::ProcessCell(int x, int y, float deltaTime) {
     (void)deltaTime;
     const Cell& cell = m_world->GetCell(x, y);
-    if (cell.material == MATERIAL_EMPTY) {
+    if (cell.material == MATERIAL_EMPTY || (cell.flags & CELL_FLAG_RIGID_BODY)) {
         return;
     }
     
@@ -1349,6 +1350,11 @@ bool CellularAutomata::TryMove(int fromX, int fromY, int toX, int toY) {
     const Cell& fromCell = m_world->GetCell(fromX, fromY);
     const Cell& toCell = m_world->GetCell(toX, toY);
     
+    // Pixel body cells are moved by the rigid body solver, never by the CA
+    if ((fromCell.flags | toCell.flags) & CELL_FLAG_RIGID_BODY) {
+        return false;
+    }
+    
     // CRITICAL: Also check what's already in the destination in the NEXT grid
     // This prevents multiple materials from moving to the same spot
     const Cell& nextToCell = m_world->GetNextCell(toX, toY);
@@ -1540,6 +1546,9 @@ void CellularAutomata::SwapCells(int x1, int y1, int x2, int y2) {
     // Get current cell data
     const Cell& cell1 = m_world->GetCell(x1, y1);
     const Cell& cell2 = m_world->GetCell(x2, y2);
+    if ((cell1.flags | cell2.flags) & CELL_FLAG_RIGID_BODY) {
+        return;
+    }
     
     // Verify that neither cell has been modified by another process
     const Cell& nextCell1 = m_world->GetNextCell(x1, y1);
@@ -2695,6 +2704,51 @@ float CellularAutomata::GetPowderCohesion(const std::string& materialName) {
 void CellularAutomata::CreateExplosion(int centerX, int centerY, float power, float radius) {
     if (!m_world) return;
     
+    MaterialSystem* materialSystem = m_world->GetMaterialSystem();
+    if (!materialSystem) return;
+    
+    // Name lookups once per explosion rather than once per cell
+    const MaterialID fireID = materialSystem->GetMaterialID("Fire");
+    const MaterialID smokeID = materialSystem->GetMaterialID("Smoke");
+    const MaterialID ashID = materialSystem->GetMaterialID("Ash");
+    
+    // Cells knocked loose become ballistic debris, handed over in one batch
+    DebrisSystem* debrisSystem = m_world->GetDebrisSystem();
+    size_t debrisBudget = debrisSystem ? debrisSystem->GetFreeCapacity() : 0;
+    std::vector<DebrisSpawn> debris;
+    
+    auto tryFling = [&](int x, int y, int dx, int dy, float distance, float force, const Material* mat) {
+        MaterialBehavior behavior = mat->GetBehavior();
+        if (debris.size() >= debrisBudget || m_world->IsRigidBodyCell(x, y) ||
+            (behavior != MaterialBehavior::Static && behavior != MaterialBehavior::Powder &&
+             behavior != MaterialBehavior::Liquid)) {
+            return false;
+        }
+        
+        // Outward from the center with an upward kick
+        float dirX, dirY;
+        if (distance > 0.5f) {
+            dirX = dx / distance;
+            dirY = dy / distance;
+        } else {
+            float angle = Random01() * 6.2831853f;
+            dirX = std::cos(angle);
+            dirY = std::sin(angle);
+        }
+        float speed = DEBRIS_SPEED * force * (0.5f + Random01());
+        
+        DebrisSpawn spawn;
+        spawn.x = x + 0.5f;
+        spawn.y = y + 0.5f;
+        spawn.velocityX = dirX * speed;
+        spawn.velocityY = dirY * speed - DEBRIS_LIFT * force;
+        spawn.material = mat->GetID();
+        debris.push_back(spawn);
+        
+        m_world->SetNextMaterial(x, y, MATERIAL_EMPTY);
+        return true;
+    };
+    
     // Create explosion pattern in a circle around the center
     int radiusInt = static_cast<int>(radius + 0.5f);
     
@@ -2718,83 +2772,77 @@ void CellularAutomata::CreateExplosion(int centerX, int centerY, float power, fl
             // Check if material can be destroyed by this explosion
             if (CanDestroyMaterial(currentMaterial, force)) {
                 // Destroy material - replace with appropriate debris or empty space
-                MaterialSystem* materialSystem = m_world->GetMaterialSystem();
-                if (materialSystem) {
-                    const Material* mat = materialSystem->GetMaterialPtr(currentMaterial);
-                    if (mat && mat->GetPhysicalProps().hardness < force) {
-                        // Spectacular explosion effects - more fire, burning layers, blackening
-                        if (force > 3.0f) {
-                            // Intense explosions: Create fire and add burning effects to surrounding area
-                            m_world->SetNextMaterial(x, y, materialSystem->GetMaterialID("Fire"));
-                            
-                            // Add burning effect to nearby materials
-                            for (int bdy = -2; bdy <= 2; ++bdy) {
-                                for (int bdx = -2; bdx <= 2; ++bdx) {
-                                    int fx = x + bdx;
-                                    int fy = y + bdy;
-                                    if (m_world->IsValidPosition(fx, fy)) {
-                                        MaterialID nearMaterial = m_world->GetMaterial(fx, fy);
-                                        if (nearMaterial != MATERIAL_EMPTY && nearMaterial != materialSystem->GetMaterialID("Fire")) {
-                                            // Add burning effect layer
-                                            uint8_t burnIntensity = static_cast<uint8_t>(200 - (bdx*bdx + bdy*bdy) * 20);
-                                            if (burnIntensity > 50) {
-                                                m_world->SetEffect(fx, fy, EffectLayer::Burning, burnIntensity, 180);
-                                            }
+                const Material* mat = materialSystem->GetMaterialPtr(currentMaterial);
+                if (mat && mat->GetPhysicalProps().hardness < force) {
+                    // Spectacular explosion effects - more fire, burning layers, blackening
+                    if (force > 3.0f) {
+                        // Intense explosions: Create fire and add burning effects to surrounding area
+                        m_world->SetNextMaterial(x, y, fireID);
+                        
+                        // Add burning effect to nearby materials
+                        for (int bdy = -2; bdy <= 2; ++bdy) {
+                            for (int bdx = -2; bdx <= 2; ++bdx) {
+                                int fx = x + bdx;
+                                int fy = y + bdy;
+                                if (m_world->IsValidPosition(fx, fy)) {
+                                    MaterialID nearMaterial = m_world->GetMaterial(fx, fy);
+                                    if (nearMaterial != MATERIAL_EMPTY && nearMaterial != fireID) {
+                                        // Add burning effect layer
+                                        uint8_t burnIntensity = static_cast<uint8_t>(200 - (bdx*bdx + bdy*bdy) * 20);
+                                        if (burnIntensity > 50) {
+                                            m_world->SetEffect(fx, fy, EffectLayer::Burning, burnIntensity, 180);
                                         }
                                     }
                                 }
                             }
-                        } else if (force > 1.5f) {
-                            // Medium explosions: Fire + blackening effects
+                        }
+                    } else if (force > 1.5f) {
+                        // Medium explosions: flung debris, otherwise fire or smoke
+                        if (!(RandomChance(DEBRIS_MEDIUM_CHANCE) && tryFling(x, y, dx, dy, distance, force, mat))) {
                             if (RandomChance(0.7f)) {
-                                m_world->SetNextMaterial(x, y, materialSystem->GetMaterialID("Fire"));
+                                m_world->SetNextMaterial(x, y, fireID);
                             } else {
-                                m_world->SetNextMaterial(x, y, materialSystem->GetMaterialID("Smoke"));
+                                m_world->SetNextMaterial(x, y, smokeID);
                             }
-                            
-                            // Add blackening effect to show blast damage
-                            m_world->SetEffect(x, y, EffectLayer::Blackened, 150, 240);
-                        } else {
-                            // Weak explosions: Debris + blackening
-                            if (mat->GetBehavior() == MaterialBehavior::Static) {
-                                MaterialID ashID = materialSystem->GetMaterialID("Ash");
-                                if (ashID != MATERIAL_EMPTY) {
-                                    m_world->SetNextMaterial(x, y, ashID);
-                                } else {
-                                    m_world->SetNextMaterial(x, y, MATERIAL_EMPTY);
-                                }
+                        }
+                        
+                        // Add blackening effect to show blast damage
+                        m_world->SetEffect(x, y, EffectLayer::Blackened, 150, 240);
+                    } else {
+                        // Weak explosions: the cell is flung out as debris
+                        if (!tryFling(x, y, dx, dy, distance, force, mat)) {
+                            if (mat->GetBehavior() == MaterialBehavior::Static && ashID != MATERIAL_EMPTY) {
+                                m_world->SetNextMaterial(x, y, ashID);
                             } else {
                                 m_world->SetNextMaterial(x, y, MATERIAL_EMPTY);
                             }
-                            
-                            // Light blackening effect
-                            m_world->SetEffect(x, y, EffectLayer::Blackened, 80, 120);
                         }
+                        
+                        // Light blackening effect
+                        m_world->SetEffect(x, y, EffectLayer::Blackened, 80, 120);
                     }
                 }
             } else {
                 // Material survived explosion - might create fire nearby if it's flammable
-                if (force > 2.0f && RandomChance(0.3f)) {
-                    MaterialSystem* materialSystem = m_world->GetMaterialSystem();
-                    if (materialSystem) {
-                        MaterialID fireID = materialSystem->GetMaterialID("Fire");
-                        if (fireID != MATERIAL_EMPTY) {
-                            // Try to place fire in adjacent empty spaces
-                            for (const auto& offset : NEIGHBOR_OFFSETS) {
-                                int fx = x + offset.first;
-                                int fy = y + offset.second;
-                                if (m_world->IsValidPosition(fx, fy) && 
-                                    m_world->GetMaterial(fx, fy) == MATERIAL_EMPTY) {
-                                    m_world->SetNextMaterial(fx, fy, fireID);
-                                    break;
-                                }
-                            }
+                if (force > 2.0f && RandomChance(0.3f) && fireID != MATERIAL_EMPTY) {
+                    // Try to place fire in adjacent empty spaces
+                    for (const auto& offset : NEIGHBOR_OFFSETS) {
+                        int fx = x + offset.first;
+                        int fy = y + offset.second;
+                        if (m_world->IsValidPosition(fx, fy) && 
+                            m_world->GetMaterial(fx, fy) == MATERIAL_EMPTY) {
+                            m_world->SetNextMaterial(fx, fy, fireID);
+                            break;
                         }
                     }
                 }
             }
         }
     }
+    
+    if (!debris.empty()) {
+        debrisSystem->Spawn(debris);
+    }
 }
 
 bool CellularAutomata::CanDestroyMaterial(MaterialID material, float explosivePower) const {
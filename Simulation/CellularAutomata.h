@@ -168,6 +168,11 @@ private:
     static constexpr int MAX_FALL_VELOCITY = 5;
     static constexpr int MAX_FLOW_VELOCITY = 3;
     
+    // Explosion debris (cells/s per unit of explosion force)
+    static constexpr float DEBRIS_SPEED = 30.0f;
+    static constexpr float DEBRIS_LIFT = 10.0f;
+    static constexpr float DEBRIS_MEDIUM_CHANCE = 0.4f; // Share of medium-force cells flung rather than burned
+    
     // Neighbor offsets (8-directional)
     static constexpr std::array<std::pair<int, int>, 8> NEIGHBOR_OFFSETS = {{
         {-1, -1}, {0, -1}, {1, -1},  // Top row
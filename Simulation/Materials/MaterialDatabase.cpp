@@ -2,6 +2,7 @@
 #include "MaterialSystem.h"
 #include "../../ThirdParty/json/json.hpp" // Changed: Added json.hpp include
 #include <fstream>
+#include <unordered_map>
 #include <iostream> // Changed: Kept iostream for error reporting
 #include "../../Core/Logger.h" // Add BGE logging
 #ifdef _WIN32
@@ -16,6 +17,52 @@ namespace BGE {
 MaterialDatabase::MaterialDatabase() = default;
 MaterialDatabase::~MaterialDatabase() = default;
 
+VisualPattern MaterialDatabase::ParseVisualPattern(const std::string& name) {
+    static const std::unordered_map<std::string, VisualPattern> patterns = {
+        {"Speck", VisualPattern::Speck},
+        {"Wavy", VisualPattern::Wavy},
+        {"Line", VisualPattern::Line},
+        {"Border", VisualPattern::Border},
+        {"Gradient", VisualPattern::Gradient},
+        {"Checkerboard", VisualPattern::Checkerboard},
+        {"Dots", VisualPattern::Dots},
+        {"Stripes", VisualPattern::Stripes},
+        {"Noise", VisualPattern::Noise},
+        {"Marble", VisualPattern::Marble},
+        {"Crystal", VisualPattern::Crystal},
+        {"Honeycomb", VisualPattern::Honeycomb},
+        {"Spiral", VisualPattern::Spiral},
+        {"Ripple", VisualPattern::Ripple},
+        {"Flame", VisualPattern::Flame},
+        {"Wood", VisualPattern::Wood},
+        {"Metal", VisualPattern::Metal},
+        {"Fabric", VisualPattern::Fabric},
+        {"Scale", VisualPattern::Scale},
+        {"Bubble", VisualPattern::Bubble},
+        {"Crack", VisualPattern::Crack},
+        {"Flow", VisualPattern::Flow},
+        {"Spark", VisualPattern::Spark},
+        {"Glow", VisualPattern::Glow},
+        {"Frost", VisualPattern::Frost},
+        {"Sand", VisualPattern::Sand},
+        {"Rock", VisualPattern::Rock},
+        {"Plasma", VisualPattern::Plasma},
+        {"Lightning", VisualPattern::Lightning},
+        {"Smoke", VisualPattern::Smoke},
+        {"Steam", VisualPattern::Steam},
+        {"Oil", VisualPattern::Oil},
+        {"Blood", VisualPattern::Blood},
+        {"Acid", VisualPattern::Acid},
+        {"Ice", VisualPattern::Ice},
+        {"Lava", VisualPattern::Lava},
+        {"Gas", VisualPattern::Gas},
+        {"Liquid", VisualPattern::Liquid},
+        {"Powder", VisualPattern::Powder},
+    };
+    auto it = patterns.find(name);
+    return it != patterns.end() ? it->second : VisualPattern::Solid;
+}
+
 bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem& materialSystem) {
     // Debug: Log current working directory and file path
     char* cwd = getcwd(nullptr, 0);
@@ -28,7 +75,7 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
         BGE_LOG_ERROR("MaterialDatabase", "Failed to open material database file: " + filepath);
         return false;
     }
-
+    
     nlohmann::json jsonData;
     try {
         BGE_LOG_INFO("MaterialDatabase", "File opened successfully, attempting JSON parse...");
@@ -40,17 +87,17 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
                   << "Details: " << e.what() << std::endl;
         return false;
     }
-
+    
     if (!jsonData.contains("materials") || !jsonData["materials"].is_array()) {
         std::cerr << "Error: JSON file does not contain a 'materials' array: " << filepath << std::endl;
         return false;
     }
-
+    
     BGE_LOG_INFO("MaterialDatabase", "Found materials array with " + std::to_string(jsonData["materials"].size()) + " entries");
-
+    
     // Store reaction data for later processing after all materials are loaded
     std::vector<std::pair<std::string, nlohmann::json>> pendingReactions;
-
+    
     // First pass: Create all materials without reactions
     for (const auto& materialEntry : jsonData["materials"]) {
         try {
@@ -61,12 +108,12 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
             float density = materialEntry.at("density").get<float>();
             auto colorArray = materialEntry.at("color").get<std::vector<uint8_t>>();
             int hotkey = materialEntry.value("hotkey", 0); // Default to 0 if not present
-
+            
             if (colorArray.size() != 4) {
                 std::cerr << "Error: Color array for material '" << name << "' must have 4 components (RGBA)." << std::endl;
                 continue;
             }
-
+            
             MaterialBehavior behavior;
             if (behaviorStr == "Powder") {
                 behavior = MaterialBehavior::Powder;
@@ -82,16 +129,16 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
                 std::cerr << "Warning: Unknown material behavior '" << behaviorStr << "' for material '" << name << "'. Defaulting to Static." << std::endl;
                 behavior = MaterialBehavior::Static;
             }
-
+            
             auto builder = materialSystem.CreateMaterialBuilder(name)
                 .SetBehavior(behavior)
                 .SetDensity(density)
                 .SetColor(colorArray[0], colorArray[1], colorArray[2], colorArray[3]); // Corrected SetColor call
-
+            
             if (hotkey != 0) {
                 builder.SetHotKey(hotkey); // Use the new SetHotKey method
             }
-
+            
             // Parse physical properties if present
             if (materialEntry.contains("physicalProperties") && materialEntry["physicalProperties"].is_object()) {
                 auto physicalProps = materialEntry["physicalProperties"];
@@ -107,7 +154,7 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
                     }
                 }
             }
-
+            
             // Parse reactive properties if present
             if (materialEntry.contains("reactiveProperties") && materialEntry["reactiveProperties"].is_object()) {
                 auto reactiveProps = materialEntry["reactiveProperties"];
@@ -126,7 +173,7 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
                     }
                 }
             }
-
+            
             // Parse visual pattern if present
             if (materialEntry.contains("visualPattern") && materialEntry["visualPattern"].is_object()) {
                 auto visualPattern = materialEntry["visualPattern"];
@@ -134,47 +181,7 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
                 // Parse pattern type
                 if (visualPattern.contains("pattern")) {
                     std::string patternStr = visualPattern["pattern"].get<std::string>();
-                    VisualPattern pattern = VisualPattern::Solid;
-                    
-                    if (patternStr == "Speck") pattern = VisualPattern::Speck;
-                    else if (patternStr == "Wavy") pattern = VisualPattern::Wavy;
-                    else if (patternStr == "Line") pattern = VisualPattern::Line;
-                    else if (patternStr == "Border") pattern = VisualPattern::Border;
-                    else if (patternStr == "Gradient") pattern = VisualPattern::Gradient;
-                    else if (patternStr == "Checkerboard") pattern = VisualPattern::Checkerboard;
-                    else if (patternStr == "Dots") pattern = VisualPattern::Dots;
-                    else if (patternStr == "Stripes") pattern = VisualPattern::Stripes;
-                    else if (patternStr == "Noise") pattern = VisualPattern::Noise;
-                    else if (patternStr == "Marble") pattern = VisualPattern::Marble;
-                    else if (patternStr == "Crystal") pattern = VisualPattern::Crystal;
-                    else if (patternStr == "Honeycomb") pattern = VisualPattern::Honeycomb;
-                    else if (patternStr == "Spiral") pattern = VisualPattern::Spiral;
-                    else if (patternStr == "Ripple") pattern = VisualPattern::Ripple;
-                    else if (patternStr == "Flame") pattern = VisualPattern::Flame;
-                    else if (patternStr == "Wood") pattern = VisualPattern::Wood;
-                    else if (patternStr == "Metal") pattern = VisualPattern::Metal;
-                    else if (patternStr == "Fabric") pattern = VisualPattern::Fabric;
-                    else if (patternStr == "Scale") pattern = VisualPattern::Scale;
-                    else if (patternStr == "Bubble") pattern = VisualPattern::Bubble;
-                    else if (patternStr == "Crack") pattern = VisualPattern::Crack;
-                    else if (patternStr == "Flow") pattern = VisualPattern::Flow;
-                    else if (patternStr == "Spark") pattern = VisualPattern::Spark;
-                    else if (patternStr == "Glow") pattern = VisualPattern::Glow;
-                    else if (patternStr == "Frost") pattern = VisualPattern::Frost;
-                    else if (patternStr == "Sand") pattern = VisualPattern::Sand;
-                    else if (patternStr == "Rock") pattern = VisualPattern::Rock;
-                    else if (patternStr == "Plasma") pattern = VisualPattern::Plasma;
-                    else if (patternStr == "Lightning") pattern = VisualPattern::Lightning;
-                    else if (patternStr == "Smoke") pattern = VisualPattern::Smoke;
-                    else if (patternStr == "Steam") pattern = VisualPattern::Steam;
-                    else if (patternStr == "Oil") pattern = VisualPattern::Oil;
-                    else if (patternStr == "Blood") pattern = VisualPattern::Blood;
-                    else if (patternStr == "Acid") pattern = VisualPattern::Acid;
-                    else if (patternStr == "Ice") pattern = VisualPattern::Ice;
-                    else if (patternStr == "Lava") pattern = VisualPattern::Lava;
-                    else if (patternStr == "Gas") pattern = VisualPattern::Gas;
-                    else if (patternStr == "Liquid") pattern = VisualPattern::Liquid;
-                    else if (patternStr == "Powder") pattern = VisualPattern::Powder;
+                    VisualPattern pattern = ParseVisualPattern(patternStr);
                     
                     // Get the material to apply visual pattern
                     MaterialID currentMaterialID = materialSystem.GetMaterialID(name);
@@ -203,7 +210,7 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
                     }
                 }
             }
-
+            
             // Get the material to add reactions
             MaterialID currentMaterialID = materialSystem.GetMaterialID(name);
             if (!materialSystem.HasMaterial(currentMaterialID)) {
@@ -214,7 +221,7 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
             if (materialEntry.contains("reactions") && materialEntry["reactions"].is_array()) {
                 pendingReactions.emplace_back(name, materialEntry["reactions"]);
             }
-
+        
         } catch (const nlohmann::json::exception& e) {
             std::string materialNameHint = "unknown (error before reading name)";
             if (materialEntry.contains("name") && materialEntry["name"].is_string()) {
@@ -246,7 +253,7 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
                 std::string reactantName = reactionEntry.at("reactant").get<std::string>();
                 std::string product1Name = reactionEntry.at("product1").get<std::string>();
                 std::string product2Name = reactionEntry.value("product2", "");
-
+                
                 double probability = reactionEntry.at("probability").get<double>();
                 
                 // Parse new reaction properties
@@ -255,15 +262,15 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
                 int range = reactionEntry.value("range", 1);
                 bool consumeReactant = reactionEntry.value("consumeReactant", true);
                 bool particleEffect = reactionEntry.value("particleEffect", false);
-
+                
                 MaterialID reactantID = materialSystem.GetMaterialID(reactantName);
                 MaterialID product1ID = materialSystem.GetMaterialID(product1Name);
                 MaterialID product2ID = BGE::MATERIAL_EMPTY;
-
+                
                 // Debug material ID lookup
                 std::cout << "DEBUG: Loading reaction for " << materialName << " - reactant '" << reactantName 
                          << "' -> ID " << reactantID << ", product1 '" << product1Name << "' -> ID " << product1ID << std::endl;
-
+                
                 if (reactantID == BGE::MATERIAL_EMPTY && reactantName != "Empty") {
                     std::cerr << "Error: Unknown reactant material '" << reactantName << "' (ID: " << reactantID << ") in reaction for '" << materialName << "'." << std::endl;
                     continue;
@@ -272,14 +279,14 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
                     std::cerr << "Error: Unknown product1 material '" << product1Name << "' (ID: " << product1ID << ") in reaction for '" << materialName << "'." << std::endl;
                     continue;
                 }
-
+                
                 if (!product2Name.empty()) {
                     product2ID = materialSystem.GetMaterialID(product2Name);
                     if (product2ID == BGE::MATERIAL_EMPTY && product2Name != "Empty") {
                         std::cerr << "Warning: Unknown product2 material '" << product2Name << "' (ID: " << product2ID << ") in reaction for '" << materialName << "'. Setting to MATERIAL_EMPTY." << std::endl;
                     }
                 }
-
+                
                 // Parse reaction type
                 ReactionType reactionType = ReactionType::Contact;
                 if (typeStr == "Catalyst") reactionType = ReactionType::Catalyst;
@@ -290,7 +297,7 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
                 else if (typeStr == "Growth") reactionType = ReactionType::Growth;
                 else if (typeStr == "Crystallize") reactionType = ReactionType::Crystallize;
                 else if (typeStr == "Electrify") reactionType = ReactionType::Electrify;
-
+                
                 BGE::MaterialReaction reaction;
                 reaction.reactant = reactantID;
                 reaction.product1 = product1ID;
@@ -301,12 +308,12 @@ bool MaterialDatabase::LoadFromFile(const std::string& filepath, MaterialSystem&
                 reaction.range = range;
                 reaction.consumeReactant = consumeReactant;
                 reaction.particleEffect = particleEffect;
-
+                
                 currentMaterial.AddReaction(reaction);
                 std::cout << "Successfully added reaction: " << materialName << " + " << reactantName << " -> " << product1Name;
                 if (!product2Name.empty()) std::cout << " + " << product2Name;
                 std::cout << std::endl;
-
+            
             } catch (const nlohmann::json::exception& re) {
                 std::cerr << "Error parsing reaction for material '" << materialName << "': " << re.what() << std::endl;
             }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -7,6 +8,7 @@
 namespace BGE {
 
 class MaterialSystem;
+enum class VisualPattern : uint8_t;
 
 class MaterialDatabase {
 public:
@@ -25,6 +27,9 @@ public:
     // Validation
     bool ValidateDatabase(const MaterialSystem& materialSystem) const;
     
+    // "Sand", "Liquid", ... as written in materials.json; Solid when unknown
+    static VisualPattern ParseVisualPattern(const std::string& name);
+
 private:
     struct MaterialData {
         std::string name;
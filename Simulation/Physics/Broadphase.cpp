@@ -0,0 +1,99 @@
+#include "Broadphase.h"
+#include <algorithm>
+
+namespace BGE {
+
+void Broadphase::RebuildProxies(size_t bodyCount) {
+    m_proxies.resize(bodyCount);
+    for (size_t i = 0; i < bodyCount; ++i) {
+        m_proxies[i].body = static_cast<uint32_t>(i);
+    }
+}
+
+int Broadphase::ChooseAxis(const std::vector<std::unique_ptr<RigidBody>>& bodies) const {
+    // Sweep along the axis with the larger variance of body centers
+    double sum[2] = {0.0, 0.0};
+    double sumSq[2] = {0.0, 0.0};
+    for (const auto& body : bodies) {
+        Vector2 p = body->GetPosition();
+        sum[0] += p.x; sumSq[0] += double(p.x) * p.x;
+        sum[1] += p.y; sumSq[1] += double(p.y) * p.y;
+    }
+    
+    double n = static_cast<double>(bodies.size());
+    double varianceX = sumSq[0] - sum[0] * sum[0] / n;
+    double varianceY = sumSq[1] - sum[1] * sum[1] / n;
+    
+    // Hysteresis so the axis doesn't flip (and force a full sort) every step
+    if (m_axis == 0) return varianceY > varianceX * 1.5 ? 1 : 0;
+    return varianceX > varianceY * 1.5 ? 0 : 1;
+}
+
+void Broadphase::FindPairs(const std::vector<std::unique_ptr<RigidBody>>& bodies, std::vector<BroadphasePair>& pairs) {
+    pairs.clear();
+    if (bodies.size() < 2) {
+        m_proxies.clear();
+        m_dirty = true;
+        return;
+    }
+    
+    bool fullSort = false;
+    if (m_dirty || m_proxies.size() != bodies.size()) {
+        RebuildProxies(bodies.size());
+        m_dirty = false;
+        fullSort = true;
+    }
+    
+    int axis = ChooseAxis(bodies);
+    if (axis != m_axis) {
+        m_axis = axis;
+        fullSort = true;
+    }
+    
+    // Refresh bounds
+    for (Proxy& proxy : m_proxies) {
+        const RigidBody& body = *bodies[proxy.body];
+        Vector2 min, max;
+        body.GetBounds(min, max);
+        if (m_axis == 0) {
+            proxy.lo = min.x; proxy.hi = max.x;
+            proxy.crossLo = min.y; proxy.crossHi = max.y;
+        } else {
+            proxy.lo = min.y; proxy.hi = max.y;
+            proxy.crossLo = min.x; proxy.crossHi = max.x;
+        }
+        proxy.active = !body.IsStatic() && !body.IsSleeping();
+    }
+    
+    if (fullSort) {
+        std::sort(m_proxies.begin(), m_proxies.end(),
+                  [](const Proxy& a, const Proxy& b) { return a.lo < b.lo; });
+    } else {
+        // Bodies move little between steps: insertion sort is close to linear
+        for (size_t i = 1; i < m_proxies.size(); ++i) {
+            Proxy proxy = m_proxies[i];
+            size_t j = i;
+            while (j > 0 && m_proxies[j - 1].lo > proxy.lo) {
+                m_proxies[j] = m_proxies[j - 1];
+                --j;
+            }
+            m_proxies[j] = proxy;
+        }
+    }
+    
+    // Sweep
+    const size_t count = m_proxies.size();
+    for (size_t i = 0; i < count; ++i) {
+        const Proxy& a = m_proxies[i];
+        for (size_t j = i + 1; j < count; ++j) {
+            const Proxy& b = m_proxies[j];
+            if (b.lo > a.hi) break;
+            if (!a.active && !b.active) continue;
+            if (a.crossHi < b.crossLo || b.crossHi < a.crossLo) continue;
+            
+            pairs.push_back(BroadphasePair{std::min(a.body, b.body), std::max(a.body, b.body)});
+        }
+    }
+}
+
+} // namespace BGE
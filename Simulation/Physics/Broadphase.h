@@ -0,0 +1,44 @@
+#pragma once
+
+#include "RigidBody.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+namespace BGE {
+
+struct BroadphasePair {
+    uint32_t indexA; // body indices into the owning PhysicsWorld
+    uint32_t indexB;
+};
+
+// Sweep-and-prune over body bounds. The proxy list is kept sorted between
+// steps, so re-sorting is an insertion sort over nearly ordered data; the sweep
+// axis follows whichever axis the bodies are spread along the most.
+class Broadphase {
+public:
+    // Rebuild proxies after bodies were added or removed
+    void MarkDirty() { m_dirty = true; }
+    
+    // Reports overlapping pairs where at least one body is awake and dynamic
+    void FindPairs(const std::vector<std::unique_ptr<RigidBody>>& bodies, std::vector<BroadphasePair>& pairs);
+    
+    int GetSweepAxis() const { return m_axis; }
+
+private:
+    struct Proxy {
+        float lo, hi;           // extent on the sweep axis
+        float crossLo, crossHi; // extent on the other axis
+        uint32_t body;
+        bool active;
+    };
+    
+    void RebuildProxies(size_t bodyCount);
+    int ChooseAxis(const std::vector<std::unique_ptr<RigidBody>>& bodies) const;
+    
+    std::vector<Proxy> m_proxies;
+    int m_axis = 0;
+    bool m_dirty = true;
+};
+
+} // namespace BGE
@@ -1,16 +1,44 @@
 #include "Collision.h"
 #include "RigidBody.h"
 #include "../../Core/Math/Math.h"
+#include <algorithm>
+#include <cmath>
 
 namespace BGE {
 
 bool CollisionDetector::CheckCollision(RigidBody* bodyA, RigidBody* bodyB, CollisionInfo& info) {
-    // Simplified collision detection - treat all bodies as circles for now
-    float radiusA = 1.0f; // TODO: Get actual radius from shape
-    float radiusB = 1.0f;
+    info.bodyA = bodyA;
+    info.bodyB = bodyB;
     
-    return CircleVsCircle(bodyA->GetPosition(), radiusA,
-                         bodyB->GetPosition(), radiusB, info);
+    ShapeType shapeA = bodyA->GetShapeType();
+    ShapeType shapeB = bodyB->GetShapeType();
+    
+    if (shapeA == ShapeType::Circle && shapeB == ShapeType::Circle) {
+        return CircleVsCircle(bodyA->GetPosition(), bodyA->GetRadius(),
+                             bodyB->GetPosition(), bodyB->GetRadius(), info);
+    }
+    
+    if (shapeA == ShapeType::Box && shapeB == ShapeType::Box) {
+        Vector2 minA, maxA, minB, maxB;
+        bodyA->GetBounds(minA, maxA);
+        bodyB->GetBounds(minB, maxB);
+        return AABBvsAABB(minA, maxA, minB, maxB, info);
+    }
+    
+    if (shapeA == ShapeType::Circle) {
+        Vector2 minB, maxB;
+        bodyB->GetBounds(minB, maxB);
+        return CircleVsAABB(bodyA->GetPosition(), bodyA->GetRadius(), minB, maxB, info);
+    }
+    
+    // Box vs circle: test from the circle's side and flip the normal back
+    Vector2 minA, maxA;
+    bodyA->GetBounds(minA, maxA);
+    if (!CircleVsAABB(bodyB->GetPosition(), bodyB->GetRadius(), minA, maxA, info)) {
+        return false;
+    }
+    info.normal = -info.normal;
+    return true;
 }
 
 bool CollisionDetector::CircleVsCircle(const Vector2& centerA, float radiusA,
@@ -56,12 +84,64 @@ bool CollisionDetector::AABBvsAABB(const Vector2& minA, const Vector2& maxA,
     // Choose the axis with minimum overlap as separation axis
     if (overlapX < overlapY) {
         info.penetration = overlapX;
-        info.normal = Vector2((maxA.x + minA.x) < (maxB.x + minB.x) ? -1.0f : 1.0f, 0.0f);
+        info.normal = Vector2((maxA.x + minA.x) < (maxB.x + minB.x) ? 1.0f : -1.0f, 0.0f);
     } else {
         info.penetration = overlapY;
-        info.normal = Vector2(0.0f, (maxA.y + minA.y) < (maxB.y + minB.y) ? -1.0f : 1.0f);
+        info.normal = Vector2(0.0f, (maxA.y + minA.y) < (maxB.y + minB.y) ? 1.0f : -1.0f);
     }
     
+    // Contact at the center of the overlap region
+    info.contactPoint = Vector2(
+        (std::max(minA.x, minB.x) + std::min(maxA.x, maxB.x)) * 0.5f,
+        (std::max(minA.y, minB.y) + std::min(maxA.y, maxB.y)) * 0.5f
+    );
+    
+    return true;
+}
+
+bool CollisionDetector::CircleVsAABB(const Vector2& center, float radius,
+                                    const Vector2& min, const Vector2& max,
+                                    CollisionInfo& info) {
+    Vector2 closest(std::clamp(center.x, min.x, max.x), std::clamp(center.y, min.y, max.y));
+    Vector2 delta = closest - center;
+    float distanceSq = delta.LengthSquared();
+    
+    if (distanceSq >= radius * radius) {
+        info.isColliding = false;
+        return false;
+    }
+    
+    info.isColliding = true;
+    
+    if (distanceSq > 0.0f) {
+        float distance = std::sqrt(distanceSq);
+        info.normal = delta / distance;
+        info.penetration = radius - distance;
+        info.contactPoint = closest;
+        return true;
+    }
+    
+    // Center inside the box: push out through the nearest face
+    float left = center.x - min.x;
+    float right = max.x - center.x;
+    float top = center.y - min.y;
+    float bottom = max.y - center.y;
+    float nearest = std::min(std::min(left, right), std::min(top, bottom));
+    
+    if (nearest == left) {
+        info.normal = Vector2(1.0f, 0.0f);
+        info.contactPoint = Vector2(min.x, center.y);
+    } else if (nearest == right) {
+        info.normal = Vector2(-1.0f, 0.0f);
+        info.contactPoint = Vector2(max.x, center.y);
+    } else if (nearest == top) {
+        info.normal = Vector2(0.0f, 1.0f);
+        info.contactPoint = Vector2(center.x, min.y);
+    } else {
+        info.normal = Vector2(0.0f, -1.0f);
+        info.contactPoint = Vector2(center.x, max.y);
+    }
+    info.penetration = radius + nearest;
     return true;
 }
 
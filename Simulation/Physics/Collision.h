@@ -6,6 +6,7 @@ namespace BGE {
 
 class RigidBody;
 
+// Contact normal always points from bodyA towards bodyB
 struct CollisionInfo {
     RigidBody* bodyA;
     RigidBody* bodyB;
@@ -17,6 +18,7 @@ struct CollisionInfo {
 
 class CollisionDetector {
 public:
+    // Dispatches on the shapes of both bodies and fills info.bodyA/bodyB
     static bool CheckCollision(RigidBody* bodyA, RigidBody* bodyB, CollisionInfo& info);
     
     // Primitive collision tests
@@ -27,13 +29,17 @@ public:
     static bool AABBvsAABB(const Vector2& minA, const Vector2& maxA,
                           const Vector2& minB, const Vector2& maxB,
                           CollisionInfo& info);
+    
+    static bool CircleVsAABB(const Vector2& center, float radius,
+                            const Vector2& min, const Vector2& max,
+                            CollisionInfo& info);
 };
 
 class CollisionResolver {
 public:
     static void ResolveCollision(const CollisionInfo& info);
     static void ResolveCollisionWithFriction(const CollisionInfo& info);
-    
+
 private:
     static void ApplyImpulse(RigidBody* bodyA, RigidBody* bodyB,
                            const Vector2& normal, float impulse);
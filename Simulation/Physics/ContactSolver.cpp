@@ -0,0 +1,131 @@
+#include "ContactSolver.h"
+#include <algorithm>
+#include <cmath>
+
+namespace BGE {
+
+namespace {
+    inline float Cross(const Vector2& a, const Vector2& b) {
+        return a.x * b.y - a.y * b.x;
+    }
+    
+    // w x r for a scalar angular velocity
+    inline Vector2 Cross(float w, const Vector2& r) {
+        return Vector2(-w * r.y, w * r.x);
+    }
+    
+    inline Vector2 Tangent(const Vector2& normal) {
+        return Vector2(-normal.y, normal.x);
+    }
+    
+    inline Vector2 RelativeVelocity(const SolverBody& a, const SolverBody& b, const Contact& c) {
+        return b.velocity + Cross(b.angularVelocity, c.rB) - a.velocity - Cross(a.angularVelocity, c.rA);
+    }
+    
+    inline void ApplyImpulse(SolverBody& a, SolverBody& b, const Contact& c, const Vector2& impulse) {
+        a.velocity -= impulse * a.invMass;
+        a.angularVelocity -= a.invInertia * Cross(c.rA, impulse);
+        b.velocity += impulse * b.invMass;
+        b.angularVelocity += b.invInertia * Cross(c.rB, impulse);
+    }
+}
+
+void ContactSolver::Prepare(std::vector<Contact>& contacts, const std::vector<uint32_t>& active,
+                            const std::vector<SolverBody>& bodies, const ContactSolverSettings& settings) {
+    for (uint32_t index : active) {
+        Contact& c = contacts[index];
+        const SolverBody& a = bodies[c.indexA];
+        const SolverBody& b = bodies[c.indexB];
+        
+        c.rA = c.point - a.position;
+        c.rB = c.point - b.position;
+        
+        float rnA = Cross(c.rA, c.normal);
+        float rnB = Cross(c.rB, c.normal);
+        float kNormal = a.invMass + b.invMass + a.invInertia * rnA * rnA + b.invInertia * rnB * rnB;
+        c.normalMass = kNormal > 0.0f ? 1.0f / kNormal : 0.0f;
+        
+        Vector2 tangent = Tangent(c.normal);
+        float rtA = Cross(c.rA, tangent);
+        float rtB = Cross(c.rB, tangent);
+        float kTangent = a.invMass + b.invMass + a.invInertia * rtA * rtA + b.invInertia * rtB * rtB;
+        c.tangentMass = kTangent > 0.0f ? 1.0f / kTangent : 0.0f;
+        
+        // Restitution only applies to fast impacts so resting contacts stay quiet
+        float closingSpeed = RelativeVelocity(a, b, c).Dot(c.normal);
+        c.velocityBias = closingSpeed < -settings.restitutionThreshold ? -c.restitution * closingSpeed : 0.0f;
+        
+        if (!settings.warmStarting) {
+            c.normalImpulse = 0.0f;
+            c.tangentImpulse = 0.0f;
+        }
+    }
+}
+
+void ContactSolver::WarmStart(const std::vector<Contact>& contacts, const std::vector<uint32_t>& active,
+                              std::vector<SolverBody>& bodies) {
+    for (uint32_t index : active) {
+        const Contact& c = contacts[index];
+        Vector2 impulse = c.normal * c.normalImpulse + Tangent(c.normal) * c.tangentImpulse;
+        ApplyImpulse(bodies[c.indexA], bodies[c.indexB], c, impulse);
+    }
+}
+
+void ContactSolver::SolveVelocities(std::vector<Contact>& contacts, const std::vector<uint32_t>& active,
+                                    std::vector<SolverBody>& bodies) {
+    for (uint32_t index : active) {
+        Contact& c = contacts[index];
+        SolverBody& a = bodies[c.indexA];
+        SolverBody& b = bodies[c.indexB];
+        Vector2 tangent = Tangent(c.normal);
+        
+        // Friction first so the normal constraint has the final say on penetration
+        {
+            float vt = RelativeVelocity(a, b, c).Dot(tangent);
+            float lambda = -vt * c.tangentMass;
+            float maxFriction = c.friction * c.normalImpulse;
+            float newImpulse = std::clamp(c.tangentImpulse + lambda, -maxFriction, maxFriction);
+            lambda = newImpulse - c.tangentImpulse;
+            c.tangentImpulse = newImpulse;
+            ApplyImpulse(a, b, c, tangent * lambda);
+        }
+        
+        {
+            float vn = RelativeVelocity(a, b, c).Dot(c.normal);
+            float lambda = c.normalMass * (c.velocityBias - vn);
+            float newImpulse = std::max(c.normalImpulse + lambda, 0.0f);
+            lambda = newImpulse - c.normalImpulse;
+            c.normalImpulse = newImpulse;
+            ApplyImpulse(a, b, c, c.normal * lambda);
+        }
+    }
+}
+
+bool ContactSolver::SolvePositions(const std::vector<Contact>& contacts, const std::vector<uint32_t>& active,
+                                   std::vector<SolverBody>& bodies, const ContactSolverSettings& settings) {
+    float largestPenetration = 0.0f;
+    
+    for (uint32_t index : active) {
+        const Contact& c = contacts[index];
+        SolverBody& a = bodies[c.indexA];
+        SolverBody& b = bodies[c.indexB];
+        
+        float invMassSum = a.invMass + b.invMass;
+        if (invMassSum <= 0.0f) continue;
+        
+        // Current overlap, approximated from the linear motion since the contact was found
+        float penetration = c.penetration - (b.displacement - a.displacement).Dot(c.normal);
+        largestPenetration = std::max(largestPenetration, penetration);
+        
+        float correction = std::min(settings.positionCorrection * (penetration - settings.penetrationSlop), settings.maxCorrection);
+        if (correction <= 0.0f) continue;
+        
+        Vector2 push = c.normal * (correction / invMassSum);
+        a.displacement -= push * a.invMass;
+        b.displacement += push * b.invMass;
+    }
+    
+    return largestPenetration <= settings.penetrationSlop * 3.0f;
+}
+
+} // namespace BGE
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../../Core/Math/Vector2.h"
+#include <vector>
+#include <cstdint>
+
+namespace BGE {
+
+// Persistent contact between two bodies. Keyed by the body IDs so impulses
+// accumulated in one step can warm start the solver in the next.
+struct Contact {
+    uint64_t key = 0;
+    uint32_t indexA = 0; // body indices, bodyA has the lower ID
+    uint32_t indexB = 0;
+    bool terrain = false; // B is static world geometry
+    
+    Vector2 normal;      // from A towards B
+    Vector2 point;
+    float penetration = 0.0f;
+    float friction = 0.0f;
+    float restitution = 0.0f;
+    
+    // Accumulated impulses (carried across steps)
+    float normalImpulse = 0.0f;
+    float tangentImpulse = 0.0f;
+    
+    // Solver scratch
+    Vector2 rA, rB;
+    float normalMass = 0.0f;
+    float tangentMass = 0.0f;
+    float velocityBias = 0.0f;
+    
+    static uint64_t MakeKey(uint32_t idA, uint32_t idB) {
+        return (static_cast<uint64_t>(idA) << 32) | idB;
+    }
+    
+    // Terrain features live in the upper half of the B range so they never collide with body IDs
+    static uint64_t MakeTerrainKey(uint32_t bodyID, uint32_t feature) {
+        return MakeKey(bodyID, 0x80000000u | (feature & 0x7FFFFFFFu));
+    }
+};
+
+// Velocity state of a body as seen by the solver
+struct SolverBody {
+    Vector2 position;     // at the start of the step
+    Vector2 displacement; // integrated motion plus position corrections this step
+    Vector2 velocity;
+    float angularVelocity = 0.0f;
+    float invMass = 0.0f;
+    float invInertia = 0.0f;
+};
+
+struct ContactSolverSettings {
+    int velocityIterations = 8;
+    int positionIterations = 3;
+    float positionCorrection = 0.2f;  // fraction of penetration removed per position iteration
+    float penetrationSlop = 0.01f;    // allowed overlap before correction kicks in
+    float maxCorrection = 0.2f;       // largest positional push per iteration
+    float restitutionThreshold = 1.0f; // closing speed below which contacts don't bounce
+    bool warmStarting = true;
+};
+
+// Sequential impulse solver (normal + Coulomb friction) over a set of contacts.
+// Penetration is resolved by a separate position pass rather than a velocity
+// bias, so resting stacks don't gain energy and can fall asleep.
+class ContactSolver {
+public:
+    static void Prepare(std::vector<Contact>& contacts, const std::vector<uint32_t>& active,
+                        const std::vector<SolverBody>& bodies, const ContactSolverSettings& settings);
+    static void WarmStart(const std::vector<Contact>& contacts, const std::vector<uint32_t>& active,
+                          std::vector<SolverBody>& bodies);
+    static void SolveVelocities(std::vector<Contact>& contacts, const std::vector<uint32_t>& active,
+                                std::vector<SolverBody>& bodies);
+    // Pushes bodies apart along contact normals; returns true when all
+    // contacts are within the slop
+    static bool SolvePositions(const std::vector<Contact>& contacts, const std::vector<uint32_t>& active,
+                               std::vector<SolverBody>& bodies, const ContactSolverSettings& settings);
+};
+
+} // namespace BGE
@@ -0,0 +1,302 @@
+#include "DebrisSystem.h"
+#include "../SimulationWorld.h"
+#include "../World/ChunkManager.h"
+#include "../../Core/Threading/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace BGE {
+
+DebrisSystem::DebrisSystem(SimulationWorld* world, size_t capacity)
+    : m_world(world), m_capacity(capacity) {
+    m_positionX.resize(capacity);
+    m_positionY.resize(capacity);
+    m_velocityX.resize(capacity);
+    m_velocityY.resize(capacity);
+    m_age.resize(capacity);
+    m_materials.resize(capacity);
+    m_states.resize(capacity);
+    m_chunksX = (world->GetWidth() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+}
+
+size_t DebrisSystem::Spawn(const std::vector<DebrisSpawn>& debris) {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    size_t used = m_count + m_pending.size();
+    size_t accepted = std::min(debris.size(), used < m_capacity ? m_capacity - used : 0);
+    m_pending.insert(m_pending.end(), debris.begin(), debris.begin() + accepted);
+    return accepted;
+}
+
+size_t DebrisSystem::GetFreeCapacity() const {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    size_t used = m_count + m_pending.size();
+    return used < m_capacity ? m_capacity - used : 0;
+}
+
+void DebrisSystem::Clear() {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_pending.clear();
+    m_deposits.clear();
+    m_depositRanges.clear();
+    m_count = 0;
+    m_stats = DebrisStats();
+}
+
+void DebrisSystem::Update(float deltaTime, ThreadPool* threadPool) {
+    m_stats = DebrisStats();
+    AcceptPending();
+    
+    if (m_count > 0 && deltaTime > 0.0f) {
+        if (threadPool && m_count >= PARALLEL_THRESHOLD) {
+            size_t chunkCount = (m_count + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+            threadPool->ParallelFor(0, chunkCount, [this, deltaTime](size_t chunk) {
+                size_t begin = chunk * PARALLEL_GRAIN;
+                Integrate(begin, std::min(begin + PARALLEL_GRAIN, m_count), deltaTime);
+            });
+        } else {
+            Integrate(0, m_count, deltaTime);
+        }
+        
+        CollectDeposits();
+        ApplyDeposits(threadPool);
+        RemoveFinished();
+    }
+    
+    m_stats.activeCount = static_cast<uint32_t>(m_count);
+}
+
+void DebrisSystem::AcceptPending() {
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    for (const DebrisSpawn& spawn : m_pending) {
+        if (m_count >= m_capacity) break;
+        size_t i = m_count++;
+        m_positionX[i] = spawn.x;
+        m_positionY[i] = spawn.y;
+        m_velocityX[i] = spawn.velocityX;
+        m_velocityY[i] = spawn.velocityY;
+        m_age[i] = 0.0f;
+        m_materials[i] = spawn.material;
+        m_states[i] = Flying;
+    }
+    m_stats.spawned = static_cast<uint32_t>(m_pending.size());
+    m_pending.clear();
+}
+
+bool DebrisSystem::IsBlocked(int x, int y) const {
+    // Open sky above the world; the other edges are handled by the caller
+    if (y < 0) return false;
+    const Cell& cell = m_world->m_currentGrid[CoordToIndex(x, y, m_world->GetWidth())];
+    return cell.material != MATERIAL_EMPTY || (cell.flags & CELL_FLAG_RIGID_BODY);
+}
+
+void DebrisSystem::Integrate(size_t begin, size_t end, float deltaTime) {
+    const int width = static_cast<int>(m_world->GetWidth());
+    const int height = static_cast<int>(m_world->GetHeight());
+    const float gravityStep = m_gravity * deltaTime;
+    const float damping = std::max(0.0f, 1.0f - AIR_DAMPING * deltaTime);
+    const float settleSpeedSq = m_settleSpeed * m_settleSpeed;
+    
+    for (size_t i = begin; i < end; ++i) {
+        float x = m_positionX[i];
+        float y = m_positionY[i];
+        float vx = m_velocityX[i] * damping;
+        float vy = (m_velocityY[i] + gravityStep) * damping;
+        
+        // Sub-step so no step crosses more than one cell
+        float travel = std::max(std::abs(vx), std::abs(vy)) * deltaTime;
+        int steps = std::clamp(static_cast<int>(std::ceil(travel)), 1, MAX_SUBSTEPS);
+        float stepX = vx * deltaTime / steps;
+        float stepY = vy * deltaTime / steps;
+        
+        uint8_t state = Flying;
+        bool impact = false;
+        for (int s = 0; s < steps; ++s) {
+            float nx = x + stepX;
+            float ny = y + stepY;
+            int cellX = static_cast<int>(std::floor(x));
+            int cellY = static_cast<int>(std::floor(y));
+            int nextX = static_cast<int>(std::floor(nx));
+            int nextY = static_cast<int>(std::floor(ny));
+            
+            if (nextX < 0 || nextX >= width || nextY >= height) {
+                state = Lost;
+                break;
+            }
+            if ((nextX == cellX && nextY == cellY) || !IsBlocked(nextX, nextY)) {
+                x = nx;
+                y = ny;
+                continue;
+            }
+            
+            // Hit an occupied cell: bounce off the blocking axis, slide along the free one
+            impact = true;
+            bool xFree = nextX == cellX || !IsBlocked(nextX, cellY);
+            bool yFree = nextY == cellY || !IsBlocked(cellX, nextY);
+            if (xFree && !yFree) {
+                x = nx;
+                vy = -vy * m_restitution;
+                vx *= m_friction;
+            } else if (yFree && !xFree) {
+                y = ny;
+                vx = -vx * m_restitution;
+                vy *= m_friction;
+            } else {
+                vx = -vx * m_restitution;
+                vy = -vy * m_restitution;
+            }
+            break;
+        }
+        
+        float age = m_age[i] + deltaTime;
+        if (state == Flying && y >= 0.0f) {
+            if ((impact && vx * vx + vy * vy < settleSpeedSq) || age > MAX_AGE) {
+                state = Settling;
+            }
+        }
+        
+        m_positionX[i] = x;
+        m_positionY[i] = y;
+        m_velocityX[i] = vx;
+        m_velocityY[i] = vy;
+        m_age[i] = age;
+        m_states[i] = state;
+    }
+}
+
+void DebrisSystem::CollectDeposits() {
+    const int width = static_cast<int>(m_world->GetWidth());
+    
+    m_deposits.clear();
+    for (size_t i = 0; i < m_count; ++i) {
+        if (m_states[i] != Settling) continue;
+        
+        int x = static_cast<int>(m_positionX[i]);
+        int y = static_cast<int>(m_positionY[i]);
+        uint32_t chunk = static_cast<uint32_t>((y / CHUNK_SIZE) * m_chunksX + x / CHUNK_SIZE);
+        m_deposits.push_back(Deposit{chunk, static_cast<uint32_t>(CoordToIndex(x, y, width)),
+                                     static_cast<uint32_t>(i), 0, false});
+    }
+    
+    // Bucket by chunk; within a chunk, fill from the bottom up so piles stack
+    std::sort(m_deposits.begin(), m_deposits.end(), [](const Deposit& a, const Deposit& b) {
+        return a.chunk != b.chunk ? a.chunk < b.chunk : a.cell > b.cell;
+    });
+    
+    m_depositRanges.clear();
+    for (size_t begin = 0; begin < m_deposits.size();) {
+        size_t end = begin + 1;
+        while (end < m_deposits.size() && m_deposits[end].chunk == m_deposits[begin].chunk) {
+            ++end;
+        }
+        m_depositRanges.emplace_back(begin, end);
+        begin = end;
+    }
+}
+
+void DebrisSystem::ApplyDeposits(ThreadPool* threadPool) {
+    if (m_deposits.empty()) return;
+    
+    // Each chunk only writes its own cells, so chunks can be filled concurrently
+    if (threadPool && m_depositRanges.size() > 1 && m_deposits.size() >= PARALLEL_GRAIN / 4) {
+        threadPool->ParallelFor(0, m_depositRanges.size(), [this](size_t range) {
+            ApplyChunkDeposits(m_depositRanges[range].first, m_depositRanges[range].second);
+        });
+    } else {
+        for (const auto& range : m_depositRanges) {
+            ApplyChunkDeposits(range.first, range.second);
+        }
+    }
+    
+    ChunkManager* chunkManager = m_world->GetChunkManager();
+    for (const auto& range : m_depositRanges) {
+        bool chunkWritten = false;
+        for (size_t k = range.first; k < range.second; ++k) {
+            const Deposit& deposit = m_deposits[k];
+            if (deposit.placed) {
+                m_states[deposit.particle] = Settled;
+                chunkWritten = true;
+                m_stats.deposited++;
+            } else if (m_age[deposit.particle] > MAX_AGE * 2.0f) {
+                m_states[deposit.particle] = Lost;
+            } else {
+                // Retry from above the searched column next frame
+                m_positionY[deposit.particle] = deposit.retryY + 0.5f;
+                m_velocityX[deposit.particle] = 0.0f;
+                m_velocityY[deposit.particle] = 0.0f;
+                m_states[deposit.particle] = Flying;
+                m_stats.deferred++;
+            }
+        }
+        
+        if (chunkWritten) {
+            m_stats.depositChunks++;
+            uint32_t chunk = m_deposits[range.first].chunk;
+            int chunkX = static_cast<int>(chunk % m_chunksX);
+            int chunkY = static_cast<int>(chunk / m_chunksX);
+            m_world->MarkChunkChanged(chunkX, chunkY);
+            if (chunkManager) {
+                chunkManager->MarkChunkDirty(chunkX, chunkY);
+            }
+        }
+    }
+}
+
+void DebrisSystem::ApplyChunkDeposits(size_t begin, size_t end) {
+    auto& grid = m_world->m_currentGrid;
+    const int width = static_cast<int>(m_world->GetWidth());
+    
+    for (size_t k = begin; k < end; ++k) {
+        Deposit& deposit = m_deposits[k];
+        int x = static_cast<int>(deposit.cell) % width;
+        int y = static_cast<int>(deposit.cell) / width;
+        
+        // Look for room upwards, without leaving this chunk
+        int chunkTop = (y / CHUNK_SIZE) * CHUNK_SIZE;
+        int lowest = std::max(chunkTop, y - DEPOSIT_SEARCH);
+        int target = y;
+        while (target >= lowest && IsBlocked(x, target)) {
+            --target;
+        }
+        
+        if (target < lowest) {
+            deposit.retryY = target;
+            deposit.placed = false;
+            continue;
+        }
+        
+        // Start from a default cell so the target's old temperature, flags and effects don't carry over
+        Cell& cell = grid[CoordToIndex(x, target, width)];
+        cell = Cell{};
+        cell.material = m_materials[deposit.particle];
+        deposit.placed = true;
+    }
+}
+
+void DebrisSystem::RemoveFinished() {
+    // Swap-remove settled and lost particles to keep the live range dense
+    size_t i = 0;
+    while (i < m_count) {
+        uint8_t state = m_states[i];
+        if (state == Flying) {
+            ++i;
+            continue;
+        }
+        
+        if (state == Lost) {
+            m_stats.lost++;
+        }
+        
+        size_t last = --m_count;
+        if (i != last) {
+            m_positionX[i] = m_positionX[last];
+            m_positionY[i] = m_positionY[last];
+            m_velocityX[i] = m_velocityX[last];
+            m_velocityY[i] = m_velocityY[last];
+            m_age[i] = m_age[last];
+            m_materials[i] = m_materials[last];
+            m_states[i] = m_states[last];
+        }
+    }
+}
+
+} // namespace BGE
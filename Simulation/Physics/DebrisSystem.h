@@ -0,0 +1,119 @@
+#pragma once
+
+#include "../Materials/Material.h"
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+namespace BGE {
+
+class SimulationWorld;
+class ThreadPool;
+
+// A cell torn out of the grid (positions and velocities in cells, cells/s)
+struct DebrisSpawn {
+    float x = 0.0f;
+    float y = 0.0f;
+    float velocityX = 0.0f;
+    float velocityY = 0.0f;
+    MaterialID material = MATERIAL_EMPTY;
+};
+
+struct DebrisStats {
+    uint32_t activeCount = 0;
+    uint32_t spawned = 0;       // this frame
+    uint32_t deposited = 0;     // settled back into cells this frame
+    uint32_t deferred = 0;      // no free cell near the landing spot; retried next frame
+    uint32_t lost = 0;          // left the world or expired without room
+    uint32_t depositChunks = 0; // chunks written by this frame's deposits
+};
+
+// Ballistic cell debris. Particles carry their MaterialID, fly under gravity,
+// bounce off occupied cells and settle back into the grid when they come to
+// rest. Movement only reads the grid, so it can run across worker threads;
+// settling particles are bucketed by chunk and each chunk's deposits are
+// written in one pass, independently of the other chunks.
+class DebrisSystem {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 16384;
+    
+    DebrisSystem(SimulationWorld* world, size_t capacity = DEFAULT_CAPACITY);
+    
+    // Queues debris for the next update. Safe to call from any thread; returns
+    // how many were accepted (the rest are dropped when capacity is reached).
+    size_t Spawn(const std::vector<DebrisSpawn>& debris);
+    size_t GetFreeCapacity() const;
+    
+    void Update(float deltaTime, ThreadPool* threadPool = nullptr);
+    void Clear();
+    
+    // Live particles (structure of arrays, first GetCount() entries)
+    size_t GetCount() const { return m_count; }
+    const float* GetPositionsX() const { return m_positionX.data(); }
+    const float* GetPositionsY() const { return m_positionY.data(); }
+    const MaterialID* GetMaterials() const { return m_materials.data(); }
+    
+    const DebrisStats& GetStats() const { return m_stats; }
+    
+    void SetGravity(float gravity) { m_gravity = gravity; }
+    void SetRestitution(float restitution) { m_restitution = restitution; }
+    void SetSettleSpeed(float speed) { m_settleSpeed = speed; }
+
+private:
+    enum State : uint8_t { Flying = 0, Settling = 1, Settled = 2, Lost = 3 };
+    
+    struct Deposit {
+        uint32_t chunk;
+        uint32_t cell;
+        uint32_t particle;
+        int retryY;         // where to try again when the chunk had no room
+        bool placed;
+    };
+    
+    void AcceptPending();
+    void Integrate(size_t begin, size_t end, float deltaTime);
+    void CollectDeposits();
+    void ApplyDeposits(ThreadPool* threadPool);
+    void ApplyChunkDeposits(size_t begin, size_t end);
+    void RemoveFinished();
+    
+    bool IsBlocked(int x, int y) const;
+    
+    SimulationWorld* m_world;
+    size_t m_capacity;
+    
+    // Structure of arrays, first m_count entries are live
+    std::vector<float> m_positionX;
+    std::vector<float> m_positionY;
+    std::vector<float> m_velocityX;
+    std::vector<float> m_velocityY;
+    std::vector<float> m_age;
+    std::vector<MaterialID> m_materials;
+    std::vector<uint8_t> m_states;
+    size_t m_count = 0;
+    
+    // Spawns queued since the last update
+    std::vector<DebrisSpawn> m_pending;
+    mutable std::mutex m_pendingMutex;
+    
+    // Deposits grouped by chunk; m_depositRanges holds [begin, end) per chunk
+    std::vector<Deposit> m_deposits;
+    std::vector<std::pair<size_t, size_t>> m_depositRanges;
+    size_t m_chunksX = 0;
+    
+    DebrisStats m_stats;
+    
+    float m_gravity = 98.1f;      // cells/s^2
+    float m_restitution = 0.3f;
+    float m_friction = 0.6f;      // tangential velocity kept on impact
+    float m_settleSpeed = 6.0f;   // cells/s; slower than this after an impact = at rest
+    
+    static constexpr float AIR_DAMPING = 0.2f;    // fraction of velocity lost per second
+    static constexpr float MAX_AGE = 8.0f;        // seconds before forcing a deposit
+    static constexpr int MAX_SUBSTEPS = 16;
+    static constexpr int DEPOSIT_SEARCH = 8;      // cells searched upward for room
+    static constexpr size_t PARALLEL_THRESHOLD = 4096;
+    static constexpr size_t PARALLEL_GRAIN = 2048;
+};
+
+} // namespace BGE
@@ -1,66 +1,378 @@
 #include "PhysicsWorld.h"
+#include "Collision.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 
 namespace BGE {
 
+namespace {
+    using Clock = std::chrono::high_resolution_clock;
+    
+    inline float ElapsedMs(Clock::time_point start) {
+        return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
+}
+
 PhysicsWorld::PhysicsWorld() : m_gravity(0.0f, 9.81f) {
 }
 
 PhysicsWorld::~PhysicsWorld() = default;
 
 void PhysicsWorld::Update(float deltaTime) {
+    if (deltaTime <= 0.0f) return;
+    
+    auto stepStart = Clock::now();
+    
+    auto start = Clock::now();
     ApplyGravity(deltaTime);
     IntegrateForces(deltaTime);
+    m_stats.integrateTime = ElapsedMs(start);
+    
     CheckCollisions();
+    
+    start = Clock::now();
+    BuildIslands();
+    float islandTime = ElapsedMs(start);
+    
+    start = Clock::now();
     SolveConstraints();
     IntegrateVelocities(deltaTime);
+    m_stats.solverTime = ElapsedMs(start);
+    
+    start = Clock::now();
+    UpdateSleep(deltaTime);
+    m_stats.islandTime = islandTime + ElapsedMs(start);
+    
+    m_stats.bodyCount = static_cast<uint32_t>(m_bodies.size());
+    m_stats.awakeBodyCount = 0;
+    for (uint32_t i = 0; i < m_bodies.size(); ++i) {
+        m_stats.awakeBodyCount += IsAwakeDynamic(i) ? 1 : 0;
+    }
+    m_stats.totalTime = ElapsedMs(stepStart);
 }
 
 RigidBody* PhysicsWorld::CreateRigidBody() {
     auto body = std::make_unique<RigidBody>();
+    body->m_id = m_nextBodyID++;
     RigidBody* bodyPtr = body.get();
     m_bodies.push_back(std::move(body));
+    m_broadphase.MarkDirty();
+    RemapTerrainContacts();
     return bodyPtr;
 }
 
+void PhysicsWorld::RemapTerrainContacts() {
+    const uint32_t terrainIndex = static_cast<uint32_t>(m_bodies.size());
+    for (Contact& contact : m_contacts) {
+        if (contact.terrain) {
+            contact.indexB = terrainIndex;
+        }
+    }
+}
+
 void PhysicsWorld::DestroyRigidBody(RigidBody* body) {
     auto it = std::find_if(m_bodies.begin(), m_bodies.end(),
         [body](const std::unique_ptr<RigidBody>& ptr) {
             return ptr.get() == body;
         });
     
-    if (it != m_bodies.end()) {
-        m_bodies.erase(it);
+    if (it == m_bodies.end()) return;
+    
+    uint32_t removed = static_cast<uint32_t>(it - m_bodies.begin());
+    uint32_t last = static_cast<uint32_t>(m_bodies.size() - 1);
+    
+    auto touchesRemoved = [removed](const Contact& c) {
+        return c.indexA == removed || (!c.terrain && c.indexB == removed);
+    };
+    
+    // Wake whatever rested on it, drop its contacts, then follow the swap-remove
+    for (const Contact& c : m_contacts) {
+        if (touchesRemoved(c)) {
+            uint32_t other = c.indexA == removed ? c.indexB : c.indexA;
+            if (other < m_bodies.size()) {
+                m_bodies[other]->WakeUp();
+            }
+        }
+    }
+    auto contactEnd = std::remove_if(m_contacts.begin(), m_contacts.end(), touchesRemoved);
+    m_contacts.erase(contactEnd, m_contacts.end());
+    for (Contact& c : m_contacts) {
+        if (c.indexA == last) c.indexA = removed;
+        if (!c.terrain && c.indexB == last) c.indexB = removed;
+    }
+    m_lastContacts.clear();
+    
+    if (removed != last) {
+        m_bodies[removed] = std::move(m_bodies[last]);
+    }
+    m_bodies.pop_back();
+    m_broadphase.MarkDirty();
+    RemapTerrainContacts();
+}
+
+void PhysicsWorld::SetSleepingEnabled(bool enabled) {
+    m_sleepingEnabled = enabled;
+    if (!enabled) {
+        for (auto& body : m_bodies) {
+            body->WakeUp();
+        }
     }
 }
 
 void PhysicsWorld::CheckCollisions() {
-    // TODO: Implement collision detection
+    auto start = Clock::now();
+    m_broadphase.FindPairs(m_bodies, m_pairs);
+    m_stats.broadphaseTime = ElapsedMs(start);
+    
+    start = Clock::now();
+    m_lastContacts.swap(m_contacts);
+    m_contacts.clear();
+    
+    for (const BroadphasePair& pair : m_pairs) {
+        uint32_t indexA = pair.indexA;
+        uint32_t indexB = pair.indexB;
+        if (m_bodies[indexA]->GetID() > m_bodies[indexB]->GetID()) {
+            std::swap(indexA, indexB);
+        }
+        
+        RigidBody* bodyA = m_bodies[indexA].get();
+        RigidBody* bodyB = m_bodies[indexB].get();
+        if (bodyA->IsStatic() && bodyB->IsStatic()) continue;
+        
+        CollisionInfo info;
+        if (!CollisionDetector::CheckCollision(bodyA, bodyB, info)) continue;
+        
+        Contact contact;
+        contact.key = Contact::MakeKey(bodyA->GetID(), bodyB->GetID());
+        contact.indexA = indexA;
+        contact.indexB = indexB;
+        contact.normal = info.normal;
+        contact.point = info.contactPoint;
+        contact.penetration = info.penetration;
+        contact.friction = std::sqrt(bodyA->GetFriction() * bodyB->GetFriction());
+        contact.restitution = std::min(bodyA->GetRestitution(), bodyB->GetRestitution());
+        m_contacts.push_back(contact);
+    }
+    
+    if (m_terrainCollider) {
+        const uint32_t terrainIndex = static_cast<uint32_t>(m_bodies.size());
+        for (uint32_t i = 0; i < m_bodies.size(); ++i) {
+            if (!IsAwakeDynamic(i)) continue;
+            
+            RigidBody* body = m_bodies[i].get();
+            m_terrainContacts.clear();
+            m_terrainCollider->Collide(*body, m_terrainContacts);
+            
+            for (const TerrainContact& terrainContact : m_terrainContacts) {
+                Contact contact;
+                contact.key = Contact::MakeTerrainKey(body->GetID(), terrainContact.feature);
+                contact.indexA = i;
+                contact.indexB = terrainIndex;
+                contact.terrain = true;
+                contact.normal = terrainContact.normal;
+                contact.point = terrainContact.point;
+                contact.penetration = terrainContact.penetration;
+                contact.friction = body->GetFriction();
+                contact.restitution = body->GetRestitution();
+                m_contacts.push_back(contact);
+            }
+        }
+    }
+    
+    // Sleeping bodies don't move, so their contacts from the last step are
+    // still valid; keeping them preserves island connectivity for waking
+    for (const Contact& contact : m_lastContacts) {
+        if (!IsAwakeDynamic(contact.indexA) && !IsAwakeDynamic(contact.indexB)) {
+            m_contacts.push_back(contact);
+        }
+    }
+    
+    std::sort(m_contacts.begin(), m_contacts.end(),
+              [](const Contact& a, const Contact& b) { return a.key < b.key; });
+    
+    // Warm start: carry accumulated impulses over by merging on the key
+    size_t last = 0;
+    for (Contact& contact : m_contacts) {
+        while (last < m_lastContacts.size() && m_lastContacts[last].key < contact.key) {
+            ++last;
+        }
+        if (last < m_lastContacts.size() && m_lastContacts[last].key == contact.key) {
+            contact.normalImpulse = m_lastContacts[last].normalImpulse;
+            contact.tangentImpulse = m_lastContacts[last].tangentImpulse;
+        }
+    }
+    
+    m_stats.narrowphaseTime = ElapsedMs(start);
+    m_stats.pairCount = static_cast<uint32_t>(m_pairs.size());
+    m_stats.contactCount = static_cast<uint32_t>(m_contacts.size());
 }
 
 void PhysicsWorld::ApplyGravity(float deltaTime) {
-    (void)deltaTime;
     for (auto& body : m_bodies) {
-        if (!body->IsStatic()) {
-            Vector2 gravityForce = m_gravity * body->GetMass();
-            body->ApplyForce(gravityForce);
+        if (!body->IsStatic() && !body->IsSleeping()) {
+            body->m_velocity += m_gravity * deltaTime;
         }
     }
 }
 
 void PhysicsWorld::IntegrateForces(float deltaTime) {
-    (void)deltaTime;
     for (auto& body : m_bodies) {
-        body->Update(deltaTime);
+        if (!body->IsStatic() && !body->IsSleeping()) {
+            body->m_velocity += body->m_force * (body->m_invMass * deltaTime);
+            body->m_angularVelocity += body->m_torque * (body->GetInverseInertia() * deltaTime);
+        }
+        body->ClearForces();
     }
 }
 
+uint32_t PhysicsWorld::FindIslandRoot(uint32_t index) {
+    while (m_islandParent[index] != index) {
+        m_islandParent[index] = m_islandParent[m_islandParent[index]];
+        index = m_islandParent[index];
+    }
+    return index;
+}
+
+void PhysicsWorld::BuildIslands() {
+    const uint32_t bodyCount = static_cast<uint32_t>(m_bodies.size());
+    m_islandParent.resize(bodyCount);
+    for (uint32_t i = 0; i < bodyCount; ++i) {
+        m_islandParent[i] = i;
+    }
+    
+    // Static bodies don't propagate islands (a shared floor doesn't link everything)
+    for (const Contact& contact : m_contacts) {
+        if (IsStaticIndex(contact.indexA) || IsStaticIndex(contact.indexB)) continue;
+        
+        uint32_t rootA = FindIslandRoot(contact.indexA);
+        uint32_t rootB = FindIslandRoot(contact.indexB);
+        if (rootA != rootB) {
+            m_islandParent[rootA] = rootB;
+        }
+    }
+    
+    // An island is awake if any member is; wake the rest with it
+    m_islandAwake.assign(bodyCount, 0);
+    for (uint32_t i = 0; i < bodyCount; ++i) {
+        if (IsAwakeDynamic(i)) {
+            m_islandAwake[FindIslandRoot(i)] = 1;
+        }
+    }
+    for (uint32_t i = 0; i < bodyCount; ++i) {
+        RigidBody& body = *m_bodies[i];
+        if (!body.IsStatic() && body.IsSleeping() && m_islandAwake[FindIslandRoot(i)]) {
+            body.WakeUp();
+        }
+    }
+    
+    m_activeContacts.clear();
+    for (uint32_t i = 0; i < m_contacts.size(); ++i) {
+        if (IsAwakeDynamic(m_contacts[i].indexA) || IsAwakeDynamic(m_contacts[i].indexB)) {
+            m_activeContacts.push_back(i);
+        }
+    }
+    m_stats.activeContactCount = static_cast<uint32_t>(m_activeContacts.size());
+}
+
 void PhysicsWorld::SolveConstraints() {
-    // TODO: Implement constraint solving
+    // One extra static body stands in for terrain contacts
+    m_solverBodies.resize(m_bodies.size() + 1);
+    m_solverBodies.back() = SolverBody();
+    for (size_t i = 0; i < m_bodies.size(); ++i) {
+        const RigidBody& body = *m_bodies[i];
+        SolverBody& solverBody = m_solverBodies[i];
+        bool dynamic = !body.IsStatic() && !body.IsSleeping();
+        solverBody.position = body.m_position;
+        solverBody.displacement = Vector2(0.0f, 0.0f);
+        solverBody.velocity = body.m_velocity;
+        solverBody.angularVelocity = body.m_angularVelocity;
+        solverBody.invMass = dynamic ? body.m_invMass : 0.0f;
+        solverBody.invInertia = dynamic ? body.GetInverseInertia() : 0.0f;
+    }
+    
+    ContactSolver::Prepare(m_contacts, m_activeContacts, m_solverBodies, m_solverSettings);
+    if (m_solverSettings.warmStarting) {
+        ContactSolver::WarmStart(m_contacts, m_activeContacts, m_solverBodies);
+    }
+    for (int i = 0; i < m_solverSettings.velocityIterations; ++i) {
+        ContactSolver::SolveVelocities(m_contacts, m_activeContacts, m_solverBodies);
+    }
 }
 
 void PhysicsWorld::IntegrateVelocities(float deltaTime) {
-    (void)deltaTime;
-    // Already handled in RigidBody::Update
+    for (size_t i = 0; i < m_bodies.size(); ++i) {
+        RigidBody& body = *m_bodies[i];
+        if (body.IsStatic() || body.IsSleeping()) continue;
+        
+        SolverBody& solverBody = m_solverBodies[i];
+        body.m_velocity = solverBody.velocity;
+        body.m_angularVelocity = solverBody.angularVelocity;
+        body.m_rotation += body.m_angularVelocity * deltaTime;
+        solverBody.displacement = body.m_velocity * deltaTime;
+    }
+    
+    for (int i = 0; i < m_solverSettings.positionIterations; ++i) {
+        if (ContactSolver::SolvePositions(m_contacts, m_activeContacts, m_solverBodies, m_solverSettings)) {
+            break;
+        }
+    }
+    
+    for (size_t i = 0; i < m_bodies.size(); ++i) {
+        RigidBody& body = *m_bodies[i];
+        if (!body.IsStatic() && !body.IsSleeping()) {
+            body.m_position += m_solverBodies[i].displacement;
+        }
+    }
+}
+
+void PhysicsWorld::UpdateSleep(float deltaTime) {
+    const uint32_t bodyCount = static_cast<uint32_t>(m_bodies.size());
+    
+    for (auto& body : m_bodies) {
+        if (body->IsStatic() || body->IsSleeping()) continue;
+        
+        if (body->m_velocity.LengthSquared() < RigidBody::SLEEP_VELOCITY_THRESHOLD * RigidBody::SLEEP_VELOCITY_THRESHOLD &&
+            std::abs(body->m_angularVelocity) < RigidBody::SLEEP_ANGULAR_VELOCITY_THRESHOLD) {
+            body->m_sleepTimer += deltaTime;
+        } else {
+            body->m_sleepTimer = 0.0f;
+        }
+    }
+    
+    // Islands sleep as a unit once every member has been still long enough
+    m_islandSleepTime.assign(bodyCount, RigidBody::SLEEP_TIME_THRESHOLD);
+    m_stats.islandCount = 0;
+    m_stats.sleepingIslandCount = 0;
+    
+    for (uint32_t i = 0; i < bodyCount; ++i) {
+        const RigidBody& body = *m_bodies[i];
+        if (body.IsStatic()) continue;
+        
+        uint32_t root = FindIslandRoot(i);
+        if (root == i) {
+            m_stats.islandCount++;
+        }
+        if (!body.IsSleeping()) {
+            m_islandSleepTime[root] = std::min(m_islandSleepTime[root], body.m_sleepTimer);
+        }
+    }
+    
+    for (uint32_t i = 0; i < bodyCount; ++i) {
+        RigidBody& body = *m_bodies[i];
+        if (body.IsStatic()) continue;
+        
+        uint32_t root = FindIslandRoot(i);
+        bool islandStill = m_islandSleepTime[root] >= RigidBody::SLEEP_TIME_THRESHOLD;
+        if (m_sleepingEnabled && islandStill && !body.IsSleeping()) {
+            body.m_isSleeping = true;
+            body.m_velocity = Vector2(0.0f, 0.0f);
+            body.m_angularVelocity = 0.0f;
+        }
+        if (root == i && body.IsSleeping()) {
+            m_stats.sleepingIslandCount++;
+        }
+    }
 }
 
-} // namespace BGE
\ No newline at end of file
+} // namespace BGE
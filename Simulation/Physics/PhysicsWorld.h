@@ -1,11 +1,46 @@
 #pragma once
 
 #include "RigidBody.h"
+#include "Broadphase.h"
+#include "ContactSolver.h"
 #include <vector>
 #include <memory>
 
 namespace BGE {
 
+// Per-step timings (milliseconds) and counters
+struct PhysicsStats {
+    float integrateTime = 0.0f;
+    float broadphaseTime = 0.0f;
+    float narrowphaseTime = 0.0f;
+    float islandTime = 0.0f;
+    float solverTime = 0.0f;
+    float totalTime = 0.0f;
+    
+    uint32_t bodyCount = 0;
+    uint32_t awakeBodyCount = 0;
+    uint32_t pairCount = 0;
+    uint32_t contactCount = 0;
+    uint32_t activeContactCount = 0;
+    uint32_t islandCount = 0;
+    uint32_t sleepingIslandCount = 0;
+};
+
+// Contact against non-body geometry; normal points from the body into the terrain
+struct TerrainContact {
+    Vector2 point;
+    Vector2 normal;
+    float penetration = 0.0f;
+    uint32_t feature = 0; // stable per terrain feature (e.g. cell index) for warm starting
+};
+
+// Supplies contacts between bodies and static world geometry
+class TerrainCollider {
+public:
+    virtual ~TerrainCollider() = default;
+    virtual void Collide(const RigidBody& body, std::vector<TerrainContact>& contacts) = 0;
+};
+
 class PhysicsWorld {
 public:
     PhysicsWorld();
@@ -16,22 +51,67 @@ public:
     // RigidBody management
     RigidBody* CreateRigidBody();
     void DestroyRigidBody(RigidBody* body);
+    const std::vector<std::unique_ptr<RigidBody>>& GetBodies() const { return m_bodies; }
     
     // World properties
     Vector2 GetGravity() const { return m_gravity; }
     void SetGravity(const Vector2& gravity) { m_gravity = gravity; }
     
-    // Collision detection (simplified)
+    ContactSolverSettings& GetSolverSettings() { return m_solverSettings; }
+    
+    bool IsSleepingEnabled() const { return m_sleepingEnabled; }
+    void SetSleepingEnabled(bool enabled);
+    
+    // Optional static geometry queried for every awake body (not owned)
+    void SetTerrainCollider(TerrainCollider* collider) { m_terrainCollider = collider; }
+    
+    // Broadphase + narrowphase; fills the contact list used by the solver
     void CheckCollisions();
+    
+    const std::vector<Contact>& GetContacts() const { return m_contacts; }
+    const PhysicsStats& GetStats() const { return m_stats; }
 
 private:
     std::vector<std::unique_ptr<RigidBody>> m_bodies;
     Vector2 m_gravity;
     
+    Broadphase m_broadphase;
+    TerrainCollider* m_terrainCollider = nullptr;
+    std::vector<TerrainContact> m_terrainContacts;
+    ContactSolverSettings m_solverSettings;
+    bool m_sleepingEnabled = true;
+    uint32_t m_nextBodyID = 1;
+    
+    std::vector<BroadphasePair> m_pairs;
+    std::vector<Contact> m_contacts;      // sorted by key
+    std::vector<Contact> m_lastContacts;  // previous step, for warm starting
+    std::vector<uint32_t> m_activeContacts;
+    std::vector<SolverBody> m_solverBodies;
+    
+    // Islands (union-find over bodies touching through contacts)
+    std::vector<uint32_t> m_islandParent;
+    std::vector<uint8_t> m_islandAwake;     // per root
+    std::vector<float> m_islandSleepTime;   // per root, smallest member sleep time
+    
+    PhysicsStats m_stats;
+    
     void ApplyGravity(float deltaTime);
     void IntegrateForces(float deltaTime);
+    void BuildIslands();
     void SolveConstraints();
     void IntegrateVelocities(float deltaTime);
+    void UpdateSleep(float deltaTime);
+    
+    uint32_t FindIslandRoot(uint32_t index);
+    void RemapTerrainContacts();
+    
+    // Terrain contacts use index m_bodies.size(), a static solver body
+    bool IsAwakeDynamic(uint32_t index) const {
+        return index < m_bodies.size() && !m_bodies[index]->IsStatic() && !m_bodies[index]->IsSleeping();
+    }
+    bool IsStaticIndex(uint32_t index) const {
+        return index >= m_bodies.size() || m_bodies[index]->IsStatic();
+    }
 };
 
-} // namespace BGE
\ No newline at end of file
+} // namespace BGE
@@ -0,0 +1,697 @@
+#include "PixelBodySystem.h"
+#include "../SimulationWorld.h"
+#include "../Materials/MaterialSystem.h"
+#include "../World/ChunkManager.h"
+#include "../../Core/Memory/FrameArena.h"
+#include <algorithm>
+#include <cmath>
+
+namespace BGE {
+
+namespace {
+    inline uint64_t PackChunkKey(int chunkX, int chunkY) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+    }
+    
+    inline Vector2 Rotate(const Vector2& v, float c, float s) {
+        return Vector2(c * v.x - s * v.y, s * v.x + c * v.y);
+    }
+}
+
+PixelBodySystem::PixelBodySystem(SimulationWorld* world, PhysicsWorld* physicsWorld)
+    : m_world(world), m_physicsWorld(physicsWorld) {
+    m_physicsWorld->SetTerrainCollider(this);
+}
+
+PixelBodySystem::~PixelBodySystem() {
+    if (m_physicsWorld) {
+        m_physicsWorld->SetTerrainCollider(nullptr);
+    }
+}
+
+RigidBody* PixelBodySystem::CreateBody(const std::vector<MaterialID>& pixels, int width, int height, const Vector2& position) {
+    if (width <= 0 || height <= 0 || pixels.size() != static_cast<size_t>(width) * height) {
+        return nullptr;
+    }
+    
+    UpdateMaterialTables();
+    
+    auto body = std::make_unique<PixelBody>();
+    body->width = width;
+    body->height = height;
+    body->pixels = pixels;
+    body->rigidBody = m_physicsWorld->CreateRigidBody();
+    
+    if (!RebuildShape(*body)) {
+        m_physicsWorld->DestroyRigidBody(body->rigidBody);
+        return nullptr;
+    }
+    
+    // Average friction of the body's materials
+    float friction = 0.0f;
+    MaterialSystem* materials = m_world->GetMaterialSystem();
+    for (MaterialID material : body->pixels) {
+        if (material == MATERIAL_EMPTY) continue;
+        const Material* mat = materials ? materials->GetMaterialPtr(material) : nullptr;
+        friction += mat ? mat->GetPhysicalProps().friction : 0.5f;
+    }
+    
+    RigidBody* rigidBody = body->rigidBody;
+    rigidBody->SetPosition(position + body->centerOfMass);
+    rigidBody->SetFriction(friction / body->pixelCount);
+    rigidBody->SetRestitution(0.1f);
+    
+    m_bodyByID[rigidBody->GetID()] = body.get();
+    m_bodies.push_back(std::move(body));
+    return rigidBody;
+}
+
+RigidBody* PixelBodySystem::CreateBox(MaterialID material, int width, int height, const Vector2& position) {
+    if (width <= 0 || height <= 0) return nullptr;
+    return CreateBody(std::vector<MaterialID>(static_cast<size_t>(width) * height, material), width, height, position);
+}
+
+void PixelBodySystem::DestroyBody(RigidBody* rigidBody) {
+    auto it = std::find_if(m_bodies.begin(), m_bodies.end(),
+        [rigidBody](const std::unique_ptr<PixelBody>& body) { return body->rigidBody == rigidBody; });
+    if (it == m_bodies.end()) return;
+    
+    PixelBody& body = **it;
+    for (const auto& entry : body.footprint) {
+        LiftCell(body, entry.first, entry.second);
+    }
+    
+    m_bodyByID.erase(rigidBody->GetID());
+    m_physicsWorld->DestroyRigidBody(rigidBody);
+    m_bodies.erase(it);
+}
+
+void PixelBodySystem::Clear() {
+    while (!m_bodies.empty()) {
+        DestroyBody(m_bodies.back()->rigidBody);
+    }
+    m_solidChunks.clear();
+    m_seenRevisions.clear();
+}
+
+const PixelBody* PixelBodySystem::GetBody(const RigidBody* rigidBody) const {
+    if (!rigidBody) return nullptr;
+    auto it = m_bodyByID.find(rigidBody->GetID());
+    return it != m_bodyByID.end() ? it->second : nullptr;
+}
+
+void PixelBodySystem::Update(float deltaTime) {
+    m_stats = PixelBodyStats();
+    if (deltaTime <= 0.0f) return;
+    
+    UpdateMaterialTables();
+    
+    // Bodies that lost pixels since the last frame get new mass properties
+    for (size_t i = 0; i < m_bodies.size();) {
+        PixelBody& body = *m_bodies[i];
+        if (body.shapeDirty && !RebuildShape(body)) {
+            DestroyBody(body.rigidBody);
+            continue;
+        }
+        ++i;
+    }
+    
+    RefreshTerrain(deltaTime);
+    
+    for (auto& body : m_bodies) {
+        if (!body->rigidBody->IsSleeping() && !body->rigidBody->IsStatic()) {
+            ApplyBuoyancy(*body);
+        }
+    }
+    
+    m_physicsWorld->Update(deltaTime);
+    
+    Restamp();
+    
+    m_stats.bodyCount = static_cast<uint32_t>(m_bodies.size());
+}
+
+void PixelBodySystem::UpdateMaterialTables() {
+    MaterialSystem* materials = m_world->GetMaterialSystem();
+    if (!materials || materials->GetMaterialCount() == m_materialTablesBuiltFor) return;
+    
+    m_densities.clear();
+    m_fluids.clear();
+    for (const auto& mat : materials->GetAllMaterials()) {
+        MaterialID id = mat->GetID();
+        if (id >= m_densities.size()) {
+            m_densities.resize(id + 1, 1.0f);
+            m_fluids.resize(id + 1, 0);
+        }
+        m_densities[id] = mat->GetPhysicalProps().density;
+        MaterialBehavior behavior = mat->GetBehavior();
+        m_fluids[id] = (behavior == MaterialBehavior::Liquid || behavior == MaterialBehavior::Powder) ? 1 : 0;
+    }
+    m_materialTablesBuiltFor = materials->GetMaterialCount();
+}
+
+float PixelBodySystem::GetDensity(MaterialID material) const {
+    float density = material < m_densities.size() ? m_densities[material] : 1.0f;
+    return density > 0.0f ? density : 1.0f;
+}
+
+bool PixelBodySystem::IsFluid(MaterialID material) const {
+    return material < m_fluids.size() && m_fluids[material] != 0;
+}
+
+bool PixelBodySystem::RebuildShape(PixelBody& body) {
+    const int width = body.width;
+    const int height = body.height;
+    
+    float mass = 0.0f;
+    Vector2 weighted(0.0f, 0.0f);
+    body.pixelCount = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            MaterialID material = body.pixels[y * width + x];
+            if (material == MATERIAL_EMPTY) continue;
+            float density = GetDensity(material);
+            mass += density;
+            weighted += Vector2(x + 0.5f, y + 0.5f) * density;
+            ++body.pixelCount;
+        }
+    }
+    
+    if (body.pixelCount == 0) return false;
+    
+    Vector2 oldCenter = body.centerOfMass;
+    body.centerOfMass = weighted / mass;
+    
+    // Inertia about the center of mass (each pixel is a unit square)
+    float inertia = 0.0f;
+    float radiusSq = 0.0f;
+    body.outline.clear();
+    auto filled = [&body](int x, int y) {
+        return x >= 0 && y >= 0 && x < body.width && y < body.height &&
+               body.pixels[y * body.width + x] != MATERIAL_EMPTY;
+    };
+    
+    static const int sideOffsets[4][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            MaterialID material = body.pixels[y * width + x];
+            if (material == MATERIAL_EMPTY) continue;
+            
+            Vector2 r = Vector2(x + 0.5f, y + 0.5f) - body.centerOfMass;
+            inertia += GetDensity(material) * (r.LengthSquared() + 1.0f / 6.0f);
+            radiusSq = std::max(radiusSq, (std::abs(r.x) + 0.5f) * (std::abs(r.x) + 0.5f) +
+                                          (std::abs(r.y) + 0.5f) * (std::abs(r.y) + 0.5f));
+            
+            for (const auto& side : sideOffsets) {
+                if (filled(x + side[0], y + side[1])) continue;
+                Vector2 normal(static_cast<float>(side[0]), static_cast<float>(side[1]));
+                body.outline.push_back(PixelOutlineSample{r + normal * 0.5f, normal});
+            }
+        }
+    }
+    body.boundingRadius = std::sqrt(radiusSq);
+    
+    RigidBody* rigidBody = body.rigidBody;
+    if (body.shapeDirty) {
+        // Keep the remaining pixels where they are in the world
+        float c = std::cos(rigidBody->GetRotation());
+        float s = std::sin(rigidBody->GetRotation());
+        rigidBody->SetPosition(rigidBody->GetPosition() + Rotate(body.centerOfMass - oldCenter, c, s));
+        body.shapeDirty = false;
+    }
+    
+    // Body-vs-body contacts use an equal-area circle; terrain contacts use the exact mask
+    rigidBody->SetCircle(std::sqrt(body.pixelCount / 3.14159265f));
+    rigidBody->SetMass(mass);
+    rigidBody->SetInertia(inertia);
+    return true;
+}
+
+void PixelBodySystem::RefreshTerrain(float deltaTime) {
+    m_solidChunks.clear();
+    ChunkManager* chunkManager = m_world->GetChunkManager();
+    if (!chunkManager) return;
+    
+    const int maxChunkX = (static_cast<int>(m_world->GetWidth()) - 1) / CHUNK_SIZE;
+    const int maxChunkY = (static_cast<int>(m_world->GetHeight()) - 1) / CHUNK_SIZE;
+    FrameVector<uint64_t> changedChunks(FrameArena::Resource());
+    
+    for (const auto& body : m_bodies) {
+        const RigidBody* rigidBody = body->rigidBody;
+        const bool sleeping = rigidBody->IsSleeping();
+        float reach = body->boundingRadius + 2.0f;
+        if (!sleeping) {
+            reach += rigidBody->GetVelocity().Length() * deltaTime * 2.0f;
+        }
+        
+        Vector2 position = rigidBody->GetPosition();
+        int minX = std::max(0, static_cast<int>(std::floor(position.x - reach)) / CHUNK_SIZE);
+        int minY = std::max(0, static_cast<int>(std::floor(position.y - reach)) / CHUNK_SIZE);
+        int maxX = std::min(maxChunkX, static_cast<int>(std::floor(position.x + reach)) / CHUNK_SIZE);
+        int maxY = std::min(maxChunkY, static_cast<int>(std::floor(position.y + reach)) / CHUNK_SIZE);
+        
+        for (int cy = minY; cy <= maxY; ++cy) {
+            for (int cx = minX; cx <= maxX; ++cx) {
+                uint64_t key = PackChunkKey(cx, cy);
+                if (m_solidChunks.count(key)) continue;
+                
+                // Only rescans chunks whose cells changed since the last refresh
+                m_world->RefreshSolidMask(cx, cy);
+                const Chunk* chunk = chunkManager->GetChunk(cx, cy);
+                if (!sleeping) {
+                    // A sleeping body doesn't collide; IsSolid reads the grid if it wakes mid-step
+                    m_solidChunks.emplace(key, chunk);
+                    m_stats.refreshedChunks++;
+                }
+                if (!chunk) continue;
+                
+                // Compare against the revision we last saw, since other terrain
+                // queries may have refreshed the bitmap in between. The first
+                // sighting isn't a change anyone was resting on.
+                uint32_t& seen = m_seenRevisions[key];
+                if (seen != 0 && seen != chunk->GetSolidRevision()) {
+                    changedChunks.push_back(key);
+                }
+                seen = chunk->GetSolidRevision();
+            }
+        }
+    }
+    
+    m_stats.changedChunks = static_cast<uint32_t>(changedChunks.size());
+    if (changedChunks.empty()) return;
+    
+    // Terrain changed under sleeping bodies: wake them so they can fall
+    for (const auto& body : m_bodies) {
+        RigidBody* rigidBody = body->rigidBody;
+        if (!rigidBody->IsSleeping()) continue;
+        
+        Vector2 position = rigidBody->GetPosition();
+        float reach = body->boundingRadius + 2.0f;
+        int minX = static_cast<int>(std::floor(position.x - reach)) / CHUNK_SIZE;
+        int minY = static_cast<int>(std::floor(position.y - reach)) / CHUNK_SIZE;
+        int maxX = static_cast<int>(std::floor(position.x + reach)) / CHUNK_SIZE;
+        int maxY = static_cast<int>(std::floor(position.y + reach)) / CHUNK_SIZE;
+        
+        for (uint64_t key : changedChunks) {
+            int cx = static_cast<int>(key >> 32);
+            int cy = static_cast<int>(key & 0xFFFFFFFFu);
+            if (cx >= minX && cx <= maxX && cy >= minY && cy <= maxY) {
+                rigidBody->WakeUp();
+                break;
+            }
+        }
+    }
+}
+
+bool PixelBodySystem::IsSolid(int x, int y) const {
+    // The world border acts as a wall
+    if (!m_world->IsValidPosition(x, y)) return true;
+    
+    auto it = m_solidChunks.find(PackChunkKey(x / CHUNK_SIZE, y / CHUNK_SIZE));
+    if (it != m_solidChunks.end() && it->second) {
+        return it->second->IsSolid(x % CHUNK_SIZE, y % CHUNK_SIZE);
+    }
+    
+    // Outside the refreshed area (fast body): read the grid directly
+    const Cell& cell = m_world->GetCell(x, y);
+    return !(cell.flags & CELL_FLAG_RIGID_BODY) && m_world->IsStaticMaterial(cell.material);
+}
+
+float PixelBodySystem::EstimatePenetration(const Vector2& point, const Vector2& normal) const {
+    // Walk cells along the dominant axis of the terrain normal until leaving the solid
+    int cx = static_cast<int>(std::floor(point.x));
+    int cy = static_cast<int>(std::floor(point.y));
+    constexpr int MAX_STEPS = 4;
+    
+    if (std::abs(normal.x) > std::abs(normal.y)) {
+        int step = normal.x > 0.0f ? 1 : -1;
+        for (int k = 1; k <= MAX_STEPS; ++k) {
+            if (!IsSolid(cx + step * k, cy)) {
+                float boundary = step > 0 ? static_cast<float>(cx + k) : static_cast<float>(cx - k + 1);
+                return std::abs(boundary - point.x);
+            }
+        }
+    } else {
+        int step = normal.y > 0.0f ? 1 : -1;
+        for (int k = 1; k <= MAX_STEPS; ++k) {
+            if (!IsSolid(cx, cy + step * k)) {
+                float boundary = step > 0 ? static_cast<float>(cy + k) : static_cast<float>(cy - k + 1);
+                return std::abs(boundary - point.y);
+            }
+        }
+    }
+    return static_cast<float>(MAX_STEPS);
+}
+
+void PixelBodySystem::Collide(const RigidBody& rigidBody, std::vector<TerrainContact>& contacts) {
+    const PixelBody* body = GetBody(&rigidBody);
+    if (!body) return;
+    
+    const Vector2 position = rigidBody.GetPosition();
+    const float c = std::cos(rigidBody.GetRotation());
+    const float s = std::sin(rigidBody.GetRotation());
+    const int worldWidth = static_cast<int>(m_world->GetWidth());
+    
+    m_contactScratch.clear();
+    for (const PixelOutlineSample& sample : body->outline) {
+        Vector2 point = position + Rotate(sample.point, c, s);
+        int cx = static_cast<int>(std::floor(point.x));
+        int cy = static_cast<int>(std::floor(point.y));
+        if (!IsSolid(cx, cy)) continue;
+        
+        Vector2 sideNormal = Rotate(sample.normal, c, s);
+        
+        // Terrain surface normal from the open cells around the hit cell
+        Vector2 terrainNormal(0.0f, 0.0f);
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if ((dx || dy) && !IsSolid(cx + dx, cy + dy)) {
+                    terrainNormal += Vector2(static_cast<float>(dx), static_cast<float>(dy));
+                }
+            }
+        }
+        
+        float penetration;
+        if (terrainNormal.LengthSquared() > 0.0f) {
+            terrainNormal.Normalize();
+            // Sides facing away from the surface are the far side of a thin feature
+            if (sideNormal.Dot(terrainNormal) > 0.3f) continue;
+            penetration = EstimatePenetration(point, terrainNormal);
+        } else {
+            // Buried: push straight back out through the side
+            terrainNormal = -sideNormal;
+            penetration = 1.0f;
+        }
+        
+        TerrainContact contact;
+        contact.point = point;
+        contact.normal = -terrainNormal;
+        contact.penetration = penetration;
+        contact.feature = static_cast<uint32_t>(cy * worldWidth + cx) * 4u +
+                          static_cast<uint32_t>(&sample - body->outline.data()) % 4u;
+        m_contactScratch.push_back(contact);
+    }
+    
+    // Keep the deepest contacts, spread out so resting bodies get a stable base
+    if (m_contactScratch.size() > m_maxContactsPerBody) {
+        std::sort(m_contactScratch.begin(), m_contactScratch.end(),
+                  [](const TerrainContact& a, const TerrainContact& b) { return a.penetration > b.penetration; });
+        
+        size_t kept = 0;
+        for (size_t i = 0; i < m_contactScratch.size() && kept < m_maxContactsPerBody; ++i) {
+            bool spread = true;
+            for (size_t j = 0; j < kept; ++j) {
+                if ((m_contactScratch[j].point - m_contactScratch[i].point).LengthSquared() < 2.25f) {
+                    spread = false;
+                    break;
+                }
+            }
+            if (spread) {
+                m_contactScratch[kept++] = m_contactScratch[i];
+            }
+        }
+        m_contactScratch.resize(kept);
+    }
+    
+    contacts.insert(contacts.end(), m_contactScratch.begin(), m_contactScratch.end());
+    m_stats.terrainContacts += static_cast<uint32_t>(m_contactScratch.size());
+}
+
+void PixelBodySystem::ApplyBuoyancy(PixelBody& body) {
+    if (body.footprint.empty()) return;
+    
+    const auto& grid = m_world->m_currentGrid;
+    const int width = static_cast<int>(m_world->GetWidth());
+    
+    // Footprint is sorted by grid index, so each row is a contiguous run. A row
+    // counts as submerged when the fluid reaches it on either side of the body.
+    float buoyancy = 0.0f;
+    Vector2 moment(0.0f, 0.0f);
+    uint32_t submergedCells = 0;
+    
+    size_t i = 0;
+    while (i < body.footprint.size()) {
+        int y = static_cast<int>(body.footprint[i].first) / width;
+        int minX = static_cast<int>(body.footprint[i].first) % width;
+        int maxX = minX;
+        float sumX = 0.0f;
+        uint32_t count = 0;
+        
+        for (; i < body.footprint.size() && static_cast<int>(body.footprint[i].first) / width == y; ++i) {
+            int x = static_cast<int>(body.footprint[i].first) % width;
+            maxX = x;
+            sumX += x + 0.5f;
+            ++count;
+        }
+        
+        float fluidDensity = 0.0f;
+        for (int side : {minX - 1, maxX + 1}) {
+            if (!m_world->IsValidPosition(side, y)) continue;
+            const Cell& cell = grid[CoordToIndex(side, y, width)];
+            if (!(cell.flags & CELL_FLAG_RIGID_BODY) && IsFluid(cell.material)) {
+                fluidDensity = std::max(fluidDensity, GetDensity(cell.material));
+            }
+        }
+        if (fluidDensity <= 0.0f) continue;
+        
+        float rowForce = fluidDensity * count;
+        buoyancy += rowForce;
+        moment += Vector2(sumX / count, y + 0.5f) * rowForce;
+        submergedCells += count;
+    }
+    
+    if (submergedCells == 0) return;
+    
+    RigidBody* rigidBody = body.rigidBody;
+    Vector2 gravity = m_physicsWorld->GetGravity();
+    Vector2 center = moment / buoyancy;
+    rigidBody->ApplyForceAtPoint(-gravity * buoyancy, center);
+    
+    // Linear and angular drag scaled by the submerged fraction
+    float submerged = static_cast<float>(submergedCells) / body.pixelCount;
+    float drag = m_fluidDrag * submerged;
+    rigidBody->ApplyForce(-rigidBody->GetVelocity() * (drag * rigidBody->GetMass()));
+    rigidBody->ApplyTorque(-rigidBody->GetAngularVelocity() * drag * rigidBody->GetInertia());
+}
+
+void PixelBodySystem::ComputeStampKey(const PixelBody& body, int& keyX, int& keyY, int& keyRotation) const {
+    const RigidBody* rigidBody = body.rigidBody;
+    Vector2 position = rigidBody->GetPosition();
+    float rotationStep = STAMP_ROTATION_ARC / std::max(body.boundingRadius, 1.0f);
+    
+    keyX = static_cast<int>(std::lround(position.x / STAMP_POSITION_STEP));
+    keyY = static_cast<int>(std::lround(position.y / STAMP_POSITION_STEP));
+    keyRotation = static_cast<int>(std::lround(rigidBody->GetRotation() / rotationStep));
+}
+
+void PixelBodySystem::Rasterize(const PixelBody& body, Footprint& footprint) const {
+    footprint.clear();
+    
+    const RigidBody* rigidBody = body.rigidBody;
+    const Vector2 position = rigidBody->GetPosition();
+    const float c = std::cos(rigidBody->GetRotation());
+    const float s = std::sin(rigidBody->GetRotation());
+    const int worldWidth = static_cast<int>(m_world->GetWidth());
+    const int worldHeight = static_cast<int>(m_world->GetHeight());
+    
+    float radius = body.boundingRadius;
+    int minX = std::max(0, static_cast<int>(std::floor(position.x - radius)));
+    int minY = std::max(0, static_cast<int>(std::floor(position.y - radius)));
+    int maxX = std::min(worldWidth - 1, static_cast<int>(std::floor(position.x + radius)));
+    int maxY = std::min(worldHeight - 1, static_cast<int>(std::floor(position.y + radius)));
+    
+    // Inverse mapping: sample the mask at every covered cell center (no holes under rotation)
+    for (int y = minY; y <= maxY; ++y) {
+        float dy = y + 0.5f - position.y;
+        for (int x = minX; x <= maxX; ++x) {
+            float dx = x + 0.5f - position.x;
+            float localX = c * dx + s * dy + body.centerOfMass.x;
+            float localY = -s * dx + c * dy + body.centerOfMass.y;
+            if (localX < 0.0f || localY < 0.0f) continue;
+            
+            int px = static_cast<int>(localX);
+            int py = static_cast<int>(localY);
+            if (px >= body.width || py >= body.height) continue;
+            
+            uint32_t pixelIndex = static_cast<uint32_t>(py * body.width + px);
+            if (body.pixels[pixelIndex] == MATERIAL_EMPTY) continue;
+            
+            footprint.emplace_back(static_cast<uint32_t>(CoordToIndex(x, y, worldWidth)), pixelIndex);
+        }
+    }
+}
+
+void PixelBodySystem::Restamp() {
+    m_pendingFootprints.resize(m_bodies.size());
+    m_lastDirtyChunk = -1;
+    
+    // Pass 1: re-rasterise moved bodies and lift the cells they no longer cover.
+    // All lifts happen before any stamping so bodies can move into each other's old cells.
+    FrameVector<uint8_t> moved(m_bodies.size(), 0, FrameArena::Resource());
+    for (size_t b = 0; b < m_bodies.size(); ++b) {
+        PixelBody& body = *m_bodies[b];
+        
+        int keyX, keyY, keyRotation;
+        ComputeStampKey(body, keyX, keyY, keyRotation);
+        if (body.stamped && keyX == body.stampKeyX && keyY == body.stampKeyY && keyRotation == body.stampKeyRotation) {
+            continue;
+        }
+        
+        body.stampKeyX = keyX;
+        body.stampKeyY = keyY;
+        body.stampKeyRotation = keyRotation;
+        body.stamped = true;
+        moved[b] = 1;
+        
+        Footprint& next = m_pendingFootprints[b];
+        Rasterize(body, next);
+        
+        size_t o = 0;
+        size_t n = 0;
+        while (o < body.footprint.size()) {
+            if (n >= next.size() || body.footprint[o].first < next[n].first) {
+                LiftCell(body, body.footprint[o].first, body.footprint[o].second);
+                ++o;
+            } else if (next[n].first < body.footprint[o].first) {
+                ++n;
+            } else {
+                ++o;
+                ++n;
+            }
+        }
+    }
+    
+    // Pass 2: stamp newly covered cells and rewrite cells whose source pixel changed
+    auto& grid = m_world->m_currentGrid;
+    for (size_t b = 0; b < m_bodies.size(); ++b) {
+        if (!moved[b]) continue;
+        
+        PixelBody& body = *m_bodies[b];
+        Footprint& next = m_pendingFootprints[b];
+        Footprint stamped;
+        stamped.reserve(next.size());
+        
+        size_t o = 0;
+        for (const auto& entry : next) {
+            while (o < body.footprint.size() && body.footprint[o].first < entry.first) {
+                ++o;
+            }
+            
+            if (o < body.footprint.size() && body.footprint[o].first == entry.first) {
+                Cell& cell = grid[entry.first];
+                uint32_t stampedPixel = body.footprint[o].second;
+                if (!(cell.flags & CELL_FLAG_RIGID_BODY) || cell.material != body.pixels[stampedPixel]) {
+                    // Replaced while stamped (sand, a brush stroke): as when lifting, the cell
+                    // keeps what is there now and the body loses the pixel
+                    cell.flags &= static_cast<uint8_t>(~CELL_FLAG_RIGID_BODY);
+                    body.pixels[stampedPixel] = MATERIAL_EMPTY;
+                    body.shapeDirty = true;
+                    MarkCellDirty(entry.first);
+                    m_stats.liftedCells++;
+                    continue;
+                }
+                
+                // Still covered: only the sampled pixel may have changed
+                MaterialID material = body.pixels[entry.second];
+                if (cell.material != material) {
+                    cell.material = material;
+                    MarkCellDirty(entry.first);
+                }
+                stamped.push_back(entry);
+            } else if (StampCell(body, entry.first, entry.second)) {
+                stamped.push_back(entry);
+            }
+        }
+        
+        body.footprint.swap(stamped);
+        m_stats.restampedBodies++;
+    }
+}
+
+void PixelBodySystem::LiftCell(PixelBody& body, uint32_t gridIndex, uint32_t pixelIndex) {
+    Cell& cell = m_world->m_currentGrid[gridIndex];
+    if (!(cell.flags & CELL_FLAG_RIGID_BODY)) return;
+    
+    cell.flags &= static_cast<uint8_t>(~CELL_FLAG_RIGID_BODY);
+    if (cell.material == body.pixels[pixelIndex]) {
+        cell.material = MATERIAL_EMPTY;
+    } else {
+        // Something replaced this pixel while stamped (painting, erasing): the body loses it
+        body.pixels[pixelIndex] = MATERIAL_EMPTY;
+        body.shapeDirty = true;
+    }
+    
+    MarkCellDirty(gridIndex);
+    m_stats.liftedCells++;
+}
+
+bool PixelBodySystem::StampCell(PixelBody& body, uint32_t gridIndex, uint32_t pixelIndex) {
+    Cell& cell = m_world->m_currentGrid[gridIndex];
+    
+    // Overlaps with terrain or other bodies are left to the solver to separate
+    if ((cell.flags & CELL_FLAG_RIGID_BODY) || m_world->IsStaticMaterial(cell.material)) {
+        return false;
+    }
+    
+    const int width = static_cast<int>(m_world->GetWidth());
+    if (cell.material != MATERIAL_EMPTY) {
+        DisplaceCell(static_cast<int>(gridIndex) % width, static_cast<int>(gridIndex) / width);
+    }
+    
+    cell.material = body.pixels[pixelIndex];
+    cell.flags |= CELL_FLAG_RIGID_BODY;
+    cell.velocity_x = 0;
+    cell.velocity_y = 0;
+    
+    MarkCellDirty(gridIndex);
+    m_stats.stampedCells++;
+    return true;
+}
+
+bool PixelBodySystem::DisplaceCell(int x, int y) {
+    auto& grid = m_world->m_currentGrid;
+    const int width = static_cast<int>(m_world->GetWidth());
+    
+    // Push the displaced material to the nearest free cell, preferring upwards
+    for (int r = 1; r <= DISPLACE_RADIUS; ++r) {
+        const int candidates[5][2] = {{x, y - r}, {x - r, y}, {x + r, y}, {x - r, y - r}, {x + r, y - r}};
+        for (const auto& candidate : candidates) {
+            int tx = candidate[0];
+            int ty = candidate[1];
+            if (!m_world->IsValidPosition(tx, ty)) continue;
+            
+            Cell& target = grid[CoordToIndex(tx, ty, width)];
+            if (target.material != MATERIAL_EMPTY || (target.flags & CELL_FLAG_RIGID_BODY)) continue;
+            
+            Cell& source = grid[CoordToIndex(x, y, width)];
+            uint8_t targetFlags = target.flags;
+            target = source;
+            target.flags = targetFlags;
+            source.material = MATERIAL_EMPTY;
+            
+            MarkCellDirty(static_cast<uint32_t>(CoordToIndex(tx, ty, width)));
+            m_stats.displacedCells++;
+            return true;
+        }
+    }
+    
+    // Nowhere to go (fully enclosed): the material is overwritten
+    return false;
+}
+
+void PixelBodySystem::MarkCellDirty(uint32_t gridIndex) {
+    const int width = static_cast<int>(m_world->GetWidth());
+    int chunkX = static_cast<int>(gridIndex) % width / CHUNK_SIZE;
+    int chunkY = static_cast<int>(gridIndex) / width / CHUNK_SIZE;
+    m_world->MarkChunkChanged(chunkX, chunkY);
+    
+    int64_t chunkKey = static_cast<int64_t>(PackChunkKey(chunkX, chunkY));
+    if (chunkKey == m_lastDirtyChunk) return;
+    m_lastDirtyChunk = chunkKey;
+    
+    if (ChunkManager* chunkManager = m_world->GetChunkManager()) {
+        chunkManager->MarkChunkDirty(chunkX, chunkY);
+    }
+}
+
+} // namespace BGE
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "PhysicsWorld.h"
+#include "../Materials/Material.h"
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+
+namespace BGE {
+
+class SimulationWorld;
+class Chunk;
+
+// Exposed side of a boundary pixel, relative to the body's center of mass
+struct PixelOutlineSample {
+    Vector2 point;  // midpoint of the pixel side
+    Vector2 normal; // outward side normal
+};
+
+// Rigid body whose shape is a rasterised mask of material cells
+struct PixelBody {
+    RigidBody* rigidBody = nullptr;
+    int width = 0;
+    int height = 0;
+    std::vector<MaterialID> pixels; // row-major, MATERIAL_EMPTY = not part of the body
+    uint32_t pixelCount = 0;
+
+    Vector2 centerOfMass;           // mask space (cells from the top-left corner)
+    float boundingRadius = 0.0f;    // farthest pixel corner from the center of mass
+    std::vector<PixelOutlineSample> outline;
+
+    // Cells currently stamped into the grid as (grid index, pixel index), sorted by grid index
+    std::vector<std::pair<uint32_t, uint32_t>> footprint;
+    int stampKeyX = 0;
+    int stampKeyY = 0;
+    int stampKeyRotation = 0;
+    bool stamped = false;
+    bool shapeDirty = false;        // pixels were lost; mass properties need rebuilding
+};
+
+struct PixelBodyStats {
+    uint32_t bodyCount = 0;
+    uint32_t restampedBodies = 0;   // bodies whose raster changed this frame
+    uint32_t stampedCells = 0;
+    uint32_t liftedCells = 0;
+    uint32_t displacedCells = 0;
+    uint32_t refreshedChunks = 0;
+    uint32_t changedChunks = 0;
+    uint32_t terrainContacts = 0;
+};
+
+// Couples pixel-mask rigid bodies to the cell grid. Each frame bodies collide
+// against per-chunk static-cell bitmaps, float on liquids and powders, and are
+// then re-stamped into the grid. Re-stamping is incremental: only bodies whose
+// quantised pose changed are re-rasterised, and only the cells that differ
+// between the old and new footprint are lifted or stamped.
+class PixelBodySystem : public TerrainCollider {
+public:
+    PixelBodySystem(SimulationWorld* world, PhysicsWorld* physicsWorld);
+    ~PixelBodySystem() override;
+
+    // Creates a body from a width x height mask with its top-left corner at 'position' (cells)
+    RigidBody* CreateBody(const std::vector<MaterialID>& pixels, int width, int height, const Vector2& position);
+    RigidBody* CreateBox(MaterialID material, int width, int height, const Vector2& position);
+    void DestroyBody(RigidBody* body);
+    void Clear();
+
+    // Refreshes terrain bitmaps, applies buoyancy, steps physics and restamps moved bodies
+    void Update(float deltaTime);
+
+    // TerrainCollider: exposed pixel sides against the static-cell bitmaps
+    void Collide(const RigidBody& body, std::vector<TerrainContact>& contacts) override;
+
+    const PixelBody* GetBody(const RigidBody* body) const;
+    const std::vector<std::unique_ptr<PixelBody>>& GetBodies() const { return m_bodies; }
+    const PixelBodyStats& GetStats() const { return m_stats; }
+
+    void SetMaxContactsPerBody(uint32_t maxContacts) { m_maxContactsPerBody = maxContacts; }
+    void SetFluidDrag(float drag) { m_fluidDrag = drag; }
+
+private:
+    using Footprint = std::vector<std::pair<uint32_t, uint32_t>>;
+
+    void UpdateMaterialTables();
+    bool RebuildShape(PixelBody& body);
+    void RefreshTerrain(float deltaTime);
+    void ApplyBuoyancy(PixelBody& body);
+    void Restamp();
+
+    void Rasterize(const PixelBody& body, Footprint& footprint) const;
+    void ComputeStampKey(const PixelBody& body, int& keyX, int& keyY, int& keyRotation) const;
+    void LiftCell(PixelBody& body, uint32_t gridIndex, uint32_t pixelIndex);
+    bool StampCell(PixelBody& body, uint32_t gridIndex, uint32_t pixelIndex);
+    bool DisplaceCell(int x, int y);
+    void MarkCellDirty(uint32_t gridIndex);
+
+    bool IsSolid(int x, int y) const;
+    float EstimatePenetration(const Vector2& point, const Vector2& normal) const;
+
+    float GetDensity(MaterialID material) const;
+    bool IsFluid(MaterialID material) const;
+
+    SimulationWorld* m_world;
+    PhysicsWorld* m_physicsWorld;
+
+    std::vector<std::unique_ptr<PixelBody>> m_bodies;
+    std::unordered_map<uint32_t, PixelBody*> m_bodyByID; // RigidBody ID -> body
+
+    // Chunks refreshed this frame, keyed by packed chunk coordinates
+    std::unordered_map<uint64_t, const Chunk*> m_solidChunks;
+    // Last solid revision seen per chunk, to detect terrain changes under sleeping bodies
+    std::unordered_map<uint64_t, uint32_t> m_seenRevisions;
+
+    // Per-material lookups indexed by MaterialID
+    std::vector<float> m_densities;
+    std::vector<uint8_t> m_fluids; // liquid or powder: provides buoyancy, can be displaced
+    size_t m_materialTablesBuiltFor = 0;
+
+    // Scratch
+    std::vector<Footprint> m_pendingFootprints;
+    std::vector<TerrainContact> m_contactScratch;
+    int64_t m_lastDirtyChunk = -1;
+
+    PixelBodyStats m_stats;
+    uint32_t m_maxContactsPerBody = 8;
+    float m_fluidDrag = 2.0f;
+
+    static constexpr int DISPLACE_RADIUS = 6;
+    static constexpr float STAMP_POSITION_STEP = 0.25f; // cells
+    static constexpr float STAMP_ROTATION_ARC = 0.25f;  // cells swept by the farthest pixel
+};
+
+} // namespace BGE
@@ -17,18 +17,50 @@ RigidBody::RigidBody()
     , m_invInertia(1.0f)
     , m_restitution(0.3f)
     , m_friction(0.5f)
+    , m_shapeType(ShapeType::Circle)
+    , m_radius(1.0f)
+    , m_halfExtents(1.0f, 1.0f)
     , m_isStatic(false)
     , m_isSleeping(false)
-    , m_sleepTimer(0.0f) {
+    , m_fixedRotation(false)
+    , m_sleepTimer(0.0f)
+    , m_id(0) {
+    RecalculateInertia();
 }
 
 RigidBody::~RigidBody() = default;
 
 void RigidBody::SetMass(float mass) {
     m_mass = std::max(mass, 0.001f); // Prevent zero mass
+    RecalculateInertia();
+}
+
+void RigidBody::SetInertia(float inertia) {
+    m_inertia = std::max(inertia, 0.001f);
     RecalculateInverseMass();
 }
 
+void RigidBody::SetCircle(float radius) {
+    m_shapeType = ShapeType::Circle;
+    m_radius = std::abs(radius);
+    m_halfExtents = Vector2(m_radius, m_radius);
+    m_fixedRotation = false;
+    RecalculateInertia();
+}
+
+void RigidBody::SetBox(const Vector2& halfExtents) {
+    m_shapeType = ShapeType::Box;
+    m_halfExtents = Vector2(std::abs(halfExtents.x), std::abs(halfExtents.y));
+    m_radius = m_halfExtents.Length();
+    m_fixedRotation = true;
+    RecalculateInertia();
+}
+
+void RigidBody::GetBounds(Vector2& min, Vector2& max) const {
+    min = m_position - m_halfExtents;
+    max = m_position + m_halfExtents;
+}
+
 void RigidBody::ApplyForce(const Vector2& force) {
     if (m_isStatic) return;
     m_force += force;
@@ -126,6 +158,17 @@ void RigidBody::UpdateSleep(float deltaTime) {
     }
 }
 
+void RigidBody::RecalculateInertia() {
+    if (m_shapeType == ShapeType::Circle) {
+        m_inertia = 0.5f * m_mass * m_radius * m_radius;
+    } else {
+        // (w^2 + h^2) / 12 with w = 2 * halfExtents.x
+        m_inertia = m_mass * (m_halfExtents.x * m_halfExtents.x + m_halfExtents.y * m_halfExtents.y) / 3.0f;
+    }
+    m_inertia = std::max(m_inertia, 0.001f);
+    RecalculateInverseMass();
+}
+
 void RigidBody::RecalculateInverseMass() {
     if (m_isStatic) {
         m_invMass = 0.0f;
@@ -1,9 +1,17 @@
 #pragma once
 
 #include "../../Core/Math/Vector2.h"
+#include <cstdint>
 
 namespace BGE {
 
+class PhysicsWorld;
+
+enum class ShapeType {
+    Circle,
+    Box // Axis-aligned; rotation is not considered by collision
+};
+
 class RigidBody {
 public:
     RigidBody();
@@ -27,7 +35,22 @@ public:
     void SetMass(float mass);
     
     float GetInertia() const { return m_inertia; }
-    void SetInertia(float inertia) { m_inertia = inertia; }
+    void SetInertia(float inertia);
+    
+    float GetInverseMass() const { return m_invMass; }
+    float GetInverseInertia() const { return m_fixedRotation ? 0.0f : m_invInertia; }
+    
+    // Prevents angular response to contacts (default for boxes)
+    bool IsFixedRotation() const { return m_fixedRotation; }
+    void SetFixedRotation(bool fixedRotation) { m_fixedRotation = fixedRotation; }
+    
+    // Collision shape; setting a shape recomputes the inertia from the mass
+    ShapeType GetShapeType() const { return m_shapeType; }
+    void SetCircle(float radius);
+    void SetBox(const Vector2& halfExtents);
+    float GetRadius() const { return m_radius; }
+    Vector2 GetHalfExtents() const { return m_halfExtents; }
+    void GetBounds(Vector2& min, Vector2& max) const;
     
     // Material properties
     float GetRestitution() const { return m_restitution; }
@@ -46,6 +69,8 @@ public:
     // Simulation
     void Update(float deltaTime);
     void ClearForces();
+    Vector2 GetForce() const { return m_force; }
+    float GetTorque() const { return m_torque; }
     
     // States
     bool IsStatic() const { return m_isStatic; }
@@ -53,6 +78,17 @@ public:
     
     bool IsSleeping() const { return m_isSleeping; }
     void SetSleeping(bool sleeping) { m_isSleeping = sleeping; }
+    void WakeUp() { m_isSleeping = false; m_sleepTimer = 0.0f; }
+    
+    // Time spent below the sleep velocity thresholds
+    float GetSleepTime() const { return m_sleepTimer; }
+    
+    // Stable identifier assigned by PhysicsWorld (0 when not owned by a world)
+    uint32_t GetID() const { return m_id; }
+    
+    static constexpr float SLEEP_VELOCITY_THRESHOLD = 0.01f;
+    static constexpr float SLEEP_ANGULAR_VELOCITY_THRESHOLD = 0.01f;
+    static constexpr float SLEEP_TIME_THRESHOLD = 1.0f; // seconds
 
 private:
     // Transform
@@ -77,19 +113,24 @@ private:
     float m_restitution; // Bounciness
     float m_friction;
     
+    // Shape
+    ShapeType m_shapeType;
+    float m_radius;
+    Vector2 m_halfExtents;
+    
     // State flags
     bool m_isStatic;
     bool m_isSleeping;
-    
-    // Sleep threshold
-    static constexpr float SLEEP_VELOCITY_THRESHOLD = 0.01f;
-    static constexpr float SLEEP_ANGULAR_VELOCITY_THRESHOLD = 0.01f;
-    static constexpr float SLEEP_TIME_THRESHOLD = 1.0f; // seconds
+    bool m_fixedRotation;
     
     float m_sleepTimer;
+    uint32_t m_id;
     
     void UpdateSleep(float deltaTime);
     void RecalculateInverseMass();
+    void RecalculateInertia();
+    
+    friend class PhysicsWorld;
 };
 
 } // namespace BGE
\ No newline at end of file
@@ -3,7 +3,10 @@
 #include "World/ChunkManager.h"
 #include "CellularAutomata.h"
 #include "Physics/PhysicsWorld.h"
+#include "Physics/PixelBodySystem.h"
+#include "Physics/DebrisSystem.h"
 #include "../Core/Threading/ThreadPool.h"
+#include "../Core/Profiling/Profiler.h"
 #include <iostream>
 #include <algorithm>
 #include <cstring>
@@ -25,12 +28,22 @@ SimulationWorld::SimulationWorld(uint32_t width, uint32_t height)
     // Allocate pixel buffer (RGBA)
     m_pixelBuffer.resize(cellCount * 4);
     m_dirtyRegions.resize((width / 32 + 1) * (height / 32 + 1), true);
+    m_chunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    size_t chunkCount = static_cast<size_t>(m_chunksX) * ((height + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    m_chunkVersions.resize(chunkCount, 1);
+    m_nextChunkChanged.resize(chunkCount, 0);
     
     // Initialize systems
     m_materialSystem = std::make_unique<MaterialSystem>();
     m_chunkManager = std::make_unique<ChunkManager>(this);
     m_cellularAutomata = std::make_unique<CellularAutomata>(this);
     
+    m_physicsWorld = std::make_unique<PhysicsWorld>();
+    m_physicsWorld->SetGravity(Vector2(0.0f, GRAVITY * CELLS_PER_METER));
+    m_pixelBodySystem = std::make_unique<PixelBodySystem>(this, m_physicsWorld.get());
+    m_debrisSystem = std::make_unique<DebrisSystem>(this);
+    m_debrisSystem->SetGravity(GRAVITY * CELLS_PER_METER);
+    
     if (m_maxThreads == 0) {
         m_maxThreads = std::thread::hardware_concurrency();
     }
@@ -51,6 +64,7 @@ SimulationWorld::~SimulationWorld() {
 }
 
 void SimulationWorld::Update(float deltaTime) {
+    BGE_PROFILE_SCOPE("SimulationWorld::Update");
     auto startTime = std::chrono::high_resolution_clock::now();
     
     // Check if simulation should run
@@ -94,8 +108,17 @@ void SimulationWorld::Update(float deltaTime) {
         
         // Swap buffers if needed
         if (m_swapBuffers.exchange(false)) {
+            BGE_PROFILE_SCOPE("SimulationWorld::SwapBuffers");
             m_currentGrid.swap(m_nextGrid);
             
+            // The CA's material writes become visible now
+            for (size_t chunk = 0; chunk < m_nextChunkChanged.size(); ++chunk) {
+                if (m_nextChunkChanged[chunk]) {
+                    m_nextChunkChanged[chunk] = 0;
+                    ++m_chunkVersions[chunk];
+                }
+            }
+            
             // Debug water count changes
             static int logCount = 0;
             if ((waterBefore != waterAfterCA || waterAfterCA != waterAfterAll) && logCount++ < 10) {
@@ -105,13 +128,11 @@ void SimulationWorld::Update(float deltaTime) {
             }
         }
         
+        // Bodies move against the freshly swapped grid, then restamp into it
+        UpdatePhysics(deltaTime);
+        
         // Update statistics
         ++m_updateCount;
-        
-        if (m_updateCount % 60 == 0 && !m_paused) {
-            std::cout << "Simulation update " << m_updateCount 
-                      << ", time: " << (m_lastUpdateTime * 1000.0f) << "ms" << std::endl;
-        }
     }
     
     // Always update pixel buffer for rendering (even when paused)
@@ -128,6 +149,14 @@ void SimulationWorld::Reset() {
 }
 
 void SimulationWorld::Clear() {
+    // Bodies are stamped into the grid, so they go with it
+    if (m_pixelBodySystem) {
+        m_pixelBodySystem->Clear();
+    }
+    if (m_debrisSystem) {
+        m_debrisSystem->Clear();
+    }
+    
     // Clear all cells
     for (auto& cell : m_currentGrid) {
         cell = Cell{};
@@ -141,6 +170,10 @@ void SimulationWorld::Clear() {
     
     // Mark all regions dirty
     std::fill(m_dirtyRegions.begin(), m_dirtyRegions.end(), true);
+    for (uint64_t& version : m_chunkVersions) {
+        ++version;
+    }
+    std::fill(m_nextChunkChanged.begin(), m_nextChunkChanged.end(), 0);
     
     m_activeCells = 0;
 }
@@ -163,6 +196,9 @@ void SimulationWorld::SetMaterial(int x, int y, MaterialID material) {
     int index = CoordToIndex(x, y, m_width);
     MaterialID oldMaterial = m_currentGrid[index].material;
     m_currentGrid[index].material = material;
+    if (oldMaterial != material) {
+        MarkCellChanged(x, y);
+    }
     
     // CRITICAL DEBUG: Track every water change in current grid too
     if (oldMaterial == 2 && material != 2) {
@@ -231,8 +267,15 @@ void SimulationWorld::SetNextMaterial(int x, int y, MaterialID material) {
     if (!IsValidPosition(x, y)) return;
     
     int index = CoordToIndex(x, y, m_width);
+    
+    // Body cells are owned by PixelBodySystem until lifted
+    if (m_currentGrid[index].flags & CELL_FLAG_RIGID_BODY) return;
+    
     MaterialID oldMaterial = m_nextGrid[index].material;
     m_nextGrid[index].material = material;
+    if (oldMaterial != material) {
+        m_nextChunkChanged[(y / CHUNK_SIZE) * m_chunksX + x / CHUNK_SIZE] = 1;
+    }
     
     // CRITICAL DEBUG: Track every water change
     if (oldMaterial == 2 && material != 2) {
@@ -309,6 +352,130 @@ void SimulationWorld::MarkRegionClean(int x, int y, int width, int height) {
     }
 }
 
+bool SimulationWorld::IsStaticMaterial(MaterialID material) const {
+    if (material == MATERIAL_EMPTY || !m_materialSystem) return false;
+    
+    // Rebuild the lookup whenever materials were registered since the last build
+    const auto& materials = m_materialSystem->GetAllMaterials();
+    if (m_staticMaterialsBuiltFor != materials.size()) {
+        m_staticMaterials.clear();
+        for (const auto& mat : materials) {
+            if (mat->GetID() >= m_staticMaterials.size()) {
+                m_staticMaterials.resize(mat->GetID() + 1, 0);
+            }
+            m_staticMaterials[mat->GetID()] = mat->GetBehavior() == MaterialBehavior::Static ? 1 : 0;
+        }
+        m_staticMaterialsBuiltFor = materials.size();
+    }
+    
+    return material < m_staticMaterials.size() && m_staticMaterials[material] != 0;
+}
+
+bool SimulationWorld::RefreshSolidMask(int chunkX, int chunkY) {
+    if (!m_chunkManager) return false;
+    
+    int originX = chunkX * CHUNK_SIZE;
+    int originY = chunkY * CHUNK_SIZE;
+    if (originX >= static_cast<int>(m_width) || originY >= static_cast<int>(m_height) || originX < 0 || originY < 0) {
+        return false;
+    }
+    
+    // Newly registered materials may change which cells count as static
+    size_t materialCount = m_materialSystem->GetAllMaterials().size();
+    if (materialCount != m_solidMaskMaterialCount) {
+        uint32_t chunksY = static_cast<uint32_t>(m_chunkVersions.size() / m_chunksX);
+        for (uint32_t cy = 0; cy < chunksY; ++cy) {
+            for (uint32_t cx = 0; cx < m_chunksX; ++cx) {
+                if (Chunk* loaded = m_chunkManager->GetChunk(static_cast<int>(cx), static_cast<int>(cy))) {
+                    loaded->InvalidateSolidMask();
+                }
+            }
+        }
+        m_solidMaskMaterialCount = materialCount;
+    }
+    
+    // The version lives on the chunk, so a chunk unloaded and recreated is rescanned
+    Chunk* chunk = m_chunkManager->GetOrCreateChunk(chunkX, chunkY);
+    if (!chunk) return false;
+    
+    uint64_t version = m_chunkVersions[static_cast<size_t>(chunkY) * m_chunksX + chunkX];
+    if (chunk->GetSolidSourceVersion() == version) {
+        return false;
+    }
+    
+    int endX = std::min(originX + CHUNK_SIZE, static_cast<int>(m_width));
+    int endY = std::min(originY + CHUNK_SIZE, static_cast<int>(m_height));
+    
+    ChunkSolidMask mask{};
+    for (int y = originY; y < endY; ++y) {
+        const Cell* row = &m_currentGrid[CoordToIndex(0, y, m_width)];
+        uint64_t bits = 0;
+        for (int x = originX; x < endX; ++x) {
+            const Cell& cell = row[x];
+            if (!(cell.flags & CELL_FLAG_RIGID_BODY) && IsStaticMaterial(cell.material)) {
+                bits |= uint64_t(1) << (x - originX);
+            }
+        }
+        mask[y - originY] = bits;
+    }
+    
+    return chunk->SetSolidMask(mask, version);
+}
+
+uint64_t SimulationWorld::GetChunkVersion(int chunkX, int chunkY) const {
+    if (chunkX < 0 || chunkY < 0 || chunkX >= static_cast<int>(m_chunksX)) return 0;
+    size_t chunkIndex = static_cast<size_t>(chunkY) * m_chunksX + chunkX;
+    return chunkIndex < m_chunkVersions.size() ? m_chunkVersions[chunkIndex] : 0;
+}
+
+void SimulationWorld::MarkChunkChanged(int chunkX, int chunkY) {
+    size_t chunkIndex = static_cast<size_t>(chunkY) * m_chunksX + chunkX;
+    if (chunkIndex < m_chunkVersions.size()) {
+        ++m_chunkVersions[chunkIndex];
+    }
+}
+
+const ChunkContours* SimulationWorld::GetTerrainContours(int chunkX, int chunkY) {
+    if (!m_chunkManager || chunkX < 0 || chunkY < 0 ||
+        chunkX * CHUNK_SIZE >= static_cast<int>(m_width) || chunkY * CHUNK_SIZE >= static_cast<int>(m_height)) {
+        return nullptr;
+    }
+    
+    // The extra sample column/row comes from the east, south and south-east
+    // neighbours (none past the world edge, so the border itself gets no contour)
+    static const int offsets[4][2] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+    const ChunkSolidMask* sources[4] = {};
+    std::array<uint32_t, 4> revisions{};
+    for (int k = 0; k < 4; ++k) {
+        int cx = chunkX + offsets[k][0];
+        int cy = chunkY + offsets[k][1];
+        if (cx * CHUNK_SIZE >= static_cast<int>(m_width) || cy * CHUNK_SIZE >= static_cast<int>(m_height)) {
+            continue;
+        }
+        RefreshSolidMask(cx, cy);
+        if (const Chunk* source = m_chunkManager->GetChunk(cx, cy)) {
+            sources[k] = &source->GetSolidMask();
+            revisions[k] = source->GetSolidRevision();
+        }
+    }
+    
+    Chunk* chunk = m_chunkManager->GetChunk(chunkX, chunkY);
+    if (!chunk) return nullptr;
+    
+    ChunkContours& contours = chunk->GetContours();
+    if (contours.valid && contours.sourceRevisions == revisions && contours.tolerance == m_contourTolerance) {
+        return &contours;
+    }
+    
+    ContourExtractor::Extract(chunk->GetSolidMask(), sources[1], sources[2], sources[3],
+                              Vector2(static_cast<float>(chunkX * CHUNK_SIZE), static_cast<float>(chunkY * CHUNK_SIZE)),
+                              m_contourTolerance, contours.polylines);
+    contours.sourceRevisions = revisions;
+    contours.tolerance = m_contourTolerance;
+    contours.valid = true;
+    return &contours;
+}
+
 void SimulationWorld::SetMaxThreads(uint32_t threads) {
     m_maxThreads = threads;
     if (m_threadPool) {
@@ -316,7 +483,20 @@ void SimulationWorld::SetMaxThreads(uint32_t threads) {
     }
 }
 
+void SimulationWorld::UpdatePhysics(float deltaTime) {
+    BGE_PROFILE_SCOPE("SimulationWorld::UpdatePhysics");
+    if (m_pixelBodySystem) {
+        BGE_PROFILE_SCOPE("PixelBodySystem::Update");
+        m_pixelBodySystem->Update(deltaTime);
+    }
+    if (m_debrisSystem) {
+        BGE_PROFILE_SCOPE("DebrisSystem::Update");
+        m_debrisSystem->Update(deltaTime, m_threadPool.get());
+    }
+}
+
 void SimulationWorld::UpdateCellularAutomata(float deltaTime) {
+    BGE_PROFILE_SCOPE("SimulationWorld::UpdateCellularAutomata");
     if (m_cellularAutomata) {
         // CRITICAL FIX: Initialize next grid properly to prevent mass loss
         // Copy the current grid to preserve all materials
@@ -340,6 +520,7 @@ void SimulationWorld::UpdateCellularAutomata(float deltaTime) {
 }
 
 void SimulationWorld::UpdateTemperature(float deltaTime) {
+    BGE_PROFILE_SCOPE("SimulationWorld::UpdateTemperature");
     // CRITICAL FIX: Work with the NEXT grid to avoid overwriting material changes
     // Create a copy of next grid for temperature calculations
     std::vector<Cell> tempGrid = m_nextGrid;
@@ -382,6 +563,7 @@ void SimulationWorld::UpdateTemperature(float deltaTime) {
 }
 
 void SimulationWorld::UpdateReactions(float deltaTime) {
+    BGE_PROFILE_SCOPE("SimulationWorld::UpdateReactions");
     // Process material reactions
     for (uint32_t y = 0; y < m_height; ++y) {
         for (uint32_t x = 0; x < m_width; ++x) {
@@ -396,6 +578,7 @@ void SimulationWorld::UpdateReactions(float deltaTime) {
 }
 
 void SimulationWorld::UpdateEffects(float deltaTime) {
+    BGE_PROFILE_SCOPE("SimulationWorld::UpdateEffects");
     // Update effect timers and fade temporary effects
     for (uint32_t y = 0; y < m_height; ++y) {
         for (uint32_t x = 0; x < m_width; ++x) {
@@ -425,6 +608,7 @@ void SimulationWorld::UpdateEffects(float deltaTime) {
 }
 
 void SimulationWorld::UpdatePixelBuffer() {
+    BGE_PROFILE_SCOPE("SimulationWorld::UpdatePixelBuffer");
     // Convert world state to pixel buffer
     static bool debugPrinted = false;
     uint32_t nonEmptyCount = 0;
@@ -456,6 +640,25 @@ void SimulationWorld::UpdatePixelBuffer() {
         }
     }
     
+    // Airborne debris isn't in the grid; draw it over the cells
+    if (m_debrisSystem) {
+        const float* positionsX = m_debrisSystem->GetPositionsX();
+        const float* positionsY = m_debrisSystem->GetPositionsY();
+        const MaterialID* materials = m_debrisSystem->GetMaterials();
+        for (size_t i = 0; i < m_debrisSystem->GetCount(); ++i) {
+            int x = static_cast<int>(positionsX[i]);
+            int y = static_cast<int>(positionsY[i]);
+            if (!IsValidPosition(x, y)) continue;
+            
+            uint32_t color = MaterialToColor(materials[i], Cell{}.temperature, x, y);
+            int pixelIndex = CoordToIndex(x, m_height - 1 - y, m_width) * 4;
+            m_pixelBuffer[pixelIndex + 0] = (color >> 0) & 0xFF;
+            m_pixelBuffer[pixelIndex + 1] = (color >> 8) & 0xFF;
+            m_pixelBuffer[pixelIndex + 2] = (color >> 16) & 0xFF;
+            m_pixelBuffer[pixelIndex + 3] = (color >> 24) & 0xFF;
+        }
+    }
+    
     // Clean console output - remove debug spam
     static int updateCounter = 0;
     if (++updateCounter % 300 == 0 && nonEmptyCount > 0) {
@@ -508,7 +711,7 @@ uint32_t SimulationWorld::MaterialToColor(MaterialID material, float temperature
     }
 }
 
-uint32_t SimulationWorld::ApplyVisualPattern(uint32_t baseColor, const VisualProperties& props, int x, int y) const {
+uint32_t SimulationWorld::ApplyVisualPattern(uint32_t baseColor, const VisualProperties& props, int x, int y) {
     if (props.pattern == VisualPattern::Solid) {
         return baseColor;
     }
@@ -10,6 +10,8 @@ namespace BGE {
 
 class MaterialSystem;
 class PhysicsWorld;
+class PixelBodySystem;
+class DebrisSystem;
 class ThreadPool;
 class CellularAutomata;
 
@@ -41,7 +43,13 @@ struct Cell {
     uint8_t effectData = 0;         // Extra data for complex effects
 };
 
+// Cell::flags bits
+constexpr uint8_t CELL_FLAG_RIGID_BODY = 1 << 0; // Cell is owned by a stamped pixel body; CA leaves it alone
+
 class SimulationWorld {
+    friend class PixelBodySystem; // Stamps and lifts body cells directly in the current grid
+    friend class DebrisSystem;    // Deposits settled debris directly in the current grid
+
 public:
     explicit SimulationWorld(uint32_t width, uint32_t height);
     ~SimulationWorld();
@@ -82,12 +90,33 @@ public:
     // Systems access
     MaterialSystem* GetMaterialSystem() const { return m_materialSystem.get(); }
     PhysicsWorld* GetPhysicsWorld() const { return m_physicsWorld.get(); }
+    PixelBodySystem* GetPixelBodySystem() const { return m_pixelBodySystem.get(); }
+    DebrisSystem* GetDebrisSystem() const { return m_debrisSystem.get(); }
     ChunkManager* GetChunkManager() const { return m_chunkManager.get(); }
+    ThreadPool* GetThreadPool() const { return m_threadPool.get(); } // Null when single-threaded
+    
+    // Rigid body coupling
+    bool IsRigidBodyCell(int x, int y) const { return (GetCell(x, y).flags & CELL_FLAG_RIGID_BODY) != 0; }
+    bool IsStaticMaterial(MaterialID material) const;
+    // Rebuilds a chunk's static-cell bitmap from the grid; returns true if it changed.
+    // The scan is skipped when the chunk hasn't been modified since the last refresh.
+    bool RefreshSolidMask(int chunkX, int chunkY);
+    
+    // Collision polylines around static cells, cached per chunk and re-extracted
+    // only when the chunk's (or its east/south neighbours') bitmap changes
+    const ChunkContours* GetTerrainContours(int chunkX, int chunkY);
+    void SetContourTolerance(float tolerance) { m_contourTolerance = tolerance; }
+    float GetContourTolerance() const { return m_contourTolerance; }
     
     // Rendering support
     const uint8_t* GetPixelData() const { return m_pixelBuffer.data(); }
+    // Color of cell (x, y) of a material drawn with props; packed like the pixel buffer (R in the low byte)
+    static uint32_t ApplyVisualPattern(uint32_t baseColor, const VisualProperties& props, int x, int y);
     bool IsRegionDirty(int x, int y, int width, int height) const;
     void MarkRegionClean(int x, int y, int width, int height);
+    // Bumped when a cell of the chunk changes material or rigid-body ownership (for
+    // the CA, at the buffer swap); caches compare it to rescan only changed chunks
+    uint64_t GetChunkVersion(int chunkX, int chunkY) const;
     
     // Simulation control
     void Play() { m_paused = false; }
@@ -128,8 +157,10 @@ private:
     bool CanDisplace(MaterialID mover, MaterialID target) const;
     void SwapCells(int x1, int y1, int x2, int y2);
     uint32_t MaterialToColor(MaterialID material, float temperature, int x, int y) const;
-    uint32_t ApplyVisualPattern(uint32_t baseColor, const VisualProperties& props, int x, int y) const;
     uint32_t BlendEffectLayer(uint32_t baseColor, EffectLayer effect, uint8_t intensity) const;
+    // Used by PixelBodySystem and DebrisSystem after writing the current grid directly
+    void MarkChunkChanged(int chunkX, int chunkY);
+    void MarkCellChanged(int x, int y) { MarkChunkChanged(x / CHUNK_SIZE, y / CHUNK_SIZE); }
     
     // Threading support
     void UpdateChunkParallel(int chunkIndex, float deltaTime);
@@ -150,6 +181,8 @@ private:
     // Systems
     std::unique_ptr<MaterialSystem> m_materialSystem;
     std::unique_ptr<PhysicsWorld> m_physicsWorld;
+    std::unique_ptr<PixelBodySystem> m_pixelBodySystem;
+    std::unique_ptr<DebrisSystem> m_debrisSystem;
     std::unique_ptr<ChunkManager> m_chunkManager;
     std::unique_ptr<ThreadPool> m_threadPool;
     std::unique_ptr<CellularAutomata> m_cellularAutomata;
@@ -159,6 +192,20 @@ private:
     std::atomic<float> m_lastUpdateTime{0.0f};
     std::atomic<uint32_t> m_activeCells{0};
     
+    // Per-material static flag, indexed by MaterialID (rebuilt when materials change)
+    mutable std::vector<uint8_t> m_staticMaterials;
+    mutable size_t m_staticMaterialsBuiltFor = 0;
+    
+    // Grid versions, indexed by chunk. Material writes to the next grid only
+    // flag their chunk, which is bumped once the swap makes the write visible.
+    // A chunk's bitmap is only rescanned when its version differs from the one
+    // recorded on the Chunk when the bitmap was last built.
+    uint32_t m_chunksX = 0;
+    std::vector<uint64_t> m_chunkVersions;
+    std::vector<uint8_t> m_nextChunkChanged;
+    size_t m_solidMaskMaterialCount = 0;
+    float m_contourTolerance = ContourExtractor::DEFAULT_TOLERANCE;
+    
     // Settings
     bool m_multithreading = true;
     float m_simulationSpeed = 0.5f;
@@ -170,6 +217,7 @@ private:
     
     // Constants
     static constexpr float GRAVITY = 9.81f;
+    static constexpr float CELLS_PER_METER = 10.0f; // Physics works in cell units
     static constexpr float TEMPERATURE_DIFFUSION = 0.1f;
     static constexpr int CHUNK_SIZE = 64;
 };
@@ -17,6 +17,16 @@ void Chunk::Update(float deltaTime) {
     // TODO: Implement actual chunk update logic
 }
 
+bool Chunk::SetSolidMask(const ChunkSolidMask& mask, uint64_t sourceVersion) {
+    m_solidSourceVersion = sourceVersion;
+    if (m_solidRevision != 0 && mask == m_solidMask) {
+        return false;
+    }
+    m_solidMask = mask;
+    ++m_solidRevision;
+    return true;
+}
+
 bool Chunk::ShouldUpdate() const {
     return m_state == ChunkState::Active || m_state == ChunkState::Dirty;
 }
@@ -1,14 +1,20 @@
 #pragma once
 
+#include "ChunkContours.h"
 #include <vector>
+#include <array>
 #include <atomic>
 #include <bitset>
+#include <cstdint>
 
 namespace BGE {
 
 constexpr int CHUNK_SIZE = 64;
 constexpr int CHUNK_AREA = CHUNK_SIZE * CHUNK_SIZE;
 
+static_assert(CHUNK_SIZE == 64 && sizeof(ChunkSolidMask) == CHUNK_SIZE * sizeof(uint64_t),
+              "ChunkSolidMask packs a chunk row into a single 64-bit word");
+
 enum class ChunkState : uint8_t {
     Inactive,   // No active particles, skip updates
     Active,     // Has active particles, needs updating
@@ -69,6 +75,22 @@ public:
     void SetUpdatePriority(float priority) { m_updatePriority = priority; }
     float GetUpdatePriority() const { return m_updatePriority; }
     
+    // Static-cell bitmap (bit x of row y = local cell (x, y) is static solid).
+    // The revision only changes when the bitmap contents do; the source version is
+    // the owner's version of the cells it was built from, so a recreated chunk
+    // always starts out stale.
+    const ChunkSolidMask& GetSolidMask() const { return m_solidMask; }
+    bool IsSolid(int localX, int localY) const { return (m_solidMask[localY] >> localX) & 1u; }
+    bool SetSolidMask(const ChunkSolidMask& mask, uint64_t sourceVersion);
+    uint32_t GetSolidRevision() const { return m_solidRevision; }
+    bool HasSolidMask() const { return m_solidRevision != 0; }
+    uint64_t GetSolidSourceVersion() const { return m_solidSourceVersion; }
+    void InvalidateSolidMask() { m_solidSourceVersion = 0; }
+    
+    // Terrain contours cached from the bitmap (see SimulationWorld::GetTerrainContours)
+    const ChunkContours& GetContours() const { return m_contours; }
+    ChunkContours& GetContours() { return m_contours; }
+    
     // Memory management
     void Compress(); // Compress inactive regions
     void Decompress(); // Prepare for active use
@@ -98,6 +120,12 @@ private:
     std::atomic<uint32_t> m_activeCellCount{0};
     std::atomic<float> m_updatePriority{1.0f};
     
+    // Static-cell bitmap
+    ChunkSolidMask m_solidMask{};
+    uint32_t m_solidRevision = 0; // 0 = never built
+    uint64_t m_solidSourceVersion = 0; // 0 = stale
+    ChunkContours m_contours;
+    
     // Memory optimization
     bool m_compressed = false;
     
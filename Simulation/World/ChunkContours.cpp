@@ -0,0 +1,251 @@
+#include "ChunkContours.h"
+#include "../../Core/Memory/FrameArena.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace BGE {
+
+namespace {
+    constexpr int SIZE = 64;
+    
+    // Edge points between adjacent samples. Horizontal edges (between samples
+    // (i, j) and (i + 1, j)) come first, then vertical edges (between (i, j)
+    // and (i, j + 1)); each point is shared by the two squares on either side.
+    constexpr int H_EDGE_COUNT = SIZE * (SIZE + 1);
+    constexpr int EDGE_COUNT = H_EDGE_COUNT * 2;
+    
+    inline int HorizontalEdge(int i, int j) { return j * SIZE + i; }
+    inline int VerticalEdge(int i, int j) { return H_EDGE_COUNT + j * (SIZE + 1) + i; }
+    
+    inline Vector2 EdgePoint(int edge, const Vector2& origin) {
+        if (edge < H_EDGE_COUNT) {
+            return Vector2(origin.x + (edge % SIZE) + 1.0f, origin.y + (edge / SIZE) + 0.5f);
+        }
+        edge -= H_EDGE_COUNT;
+        return Vector2(origin.x + (edge % (SIZE + 1)) + 0.5f, origin.y + (edge / (SIZE + 1)) + 1.0f);
+    }
+    
+    // Segments per case (tl = 8, tr = 4, br = 2, bl = 1) as pairs of square
+    // sides (0 = top, 1 = right, 2 = bottom, 3 = left), oriented so solid is on
+    // the right. Saddles keep diagonal solids connected.
+    constexpr int8_t SEGMENT_TABLE[16][4] = {
+        {-1, -1, -1, -1},
+        { 3,  2, -1, -1},
+        { 2,  1, -1, -1},
+        { 3,  1, -1, -1},
+        { 1,  0, -1, -1},
+        { 3,  0,  1,  2},
+        { 2,  0, -1, -1},
+        { 3,  0, -1, -1},
+        { 0,  3, -1, -1},
+        { 0,  2, -1, -1},
+        { 0,  1,  2,  3},
+        { 0,  1, -1, -1},
+        { 1,  3, -1, -1},
+        { 1,  2, -1, -1},
+        { 2,  3, -1, -1},
+        {-1, -1, -1, -1},
+    };
+    
+    inline int SideEdge(int side, int i, int j) {
+        switch (side) {
+            case 0: return HorizontalEdge(i, j);
+            case 1: return VerticalEdge(i + 1, j);
+            case 2: return HorizontalEdge(i, j + 1);
+            default: return VerticalEdge(i, j);
+        }
+    }
+    
+    float DistanceToSegmentSq(const Vector2& p, const Vector2& a, const Vector2& b) {
+        Vector2 ab = b - a;
+        float lengthSq = ab.LengthSquared();
+        float t = lengthSq > 0.0f ? std::clamp((p - a).Dot(ab) / lengthSq, 0.0f, 1.0f) : 0.0f;
+        return (p - (a + ab * t)).LengthSquared();
+    }
+    
+    // Marks the points of [first, last] that survive simplification (ends are already kept)
+    void SimplifyRange(const std::vector<Vector2>& points, size_t first, size_t last, float toleranceSq,
+                       FrameVector<uint8_t>& keep, FrameVector<std::pair<size_t, size_t>>& stack) {
+        stack.clear();
+        stack.emplace_back(first, last);
+        while (!stack.empty()) {
+            auto [a, b] = stack.back();
+            stack.pop_back();
+            if (b <= a + 1) continue;
+            
+            float maxDistance = 0.0f;
+            size_t farthest = a;
+            for (size_t k = a + 1; k < b; ++k) {
+                float distance = DistanceToSegmentSq(points[k], points[a], points[b]);
+                if (distance > maxDistance) {
+                    maxDistance = distance;
+                    farthest = k;
+                }
+            }
+            
+            if (maxDistance > toleranceSq) {
+                keep[farthest] = 1;
+                stack.emplace_back(a, farthest);
+                stack.emplace_back(farthest, b);
+            }
+        }
+    }
+}
+
+size_t ChunkContours::GetSegmentCount() const {
+    size_t count = 0;
+    for (const auto& polyline : polylines) {
+        if (polyline.points.size() < 2) continue;
+        count += polyline.points.size() - (polyline.closed ? 0 : 1);
+    }
+    return count;
+}
+
+void ContourExtractor::Extract(const ChunkSolidMask& mask, const ChunkSolidMask* east,
+                               const ChunkSolidMask* south, const ChunkSolidMask* southEast,
+                               const Vector2& origin, float tolerance, std::vector<TerrainPolyline>& out) {
+    out.clear();
+    
+    // Sample row j (0..64) as 64 bits plus the extra sample borrowed from the east
+    auto sampleRow = [&](int j, uint64_t& bits, uint64_t& extra) {
+        if (j < SIZE) {
+            bits = mask[j];
+            extra = east ? ((*east)[j] & 1u) : (bits >> 63);
+        } else if (south) {
+            bits = (*south)[0];
+            extra = southEast ? ((*southEast)[0] & 1u) : east ? ((*east)[SIZE - 1] & 1u) : (bits >> 63);
+        } else {
+            bits = mask[SIZE - 1];
+            extra = east ? ((*east)[SIZE - 1] & 1u) : (bits >> 63);
+        }
+    };
+    
+    // Scratch for one chunk, from the thread's frame arena
+    FrameVector<int32_t> next(EDGE_COUNT, -1, FrameArena::Resource());
+    FrameVector<uint8_t> incoming(EDGE_COUNT, 0, FrameArena::Resource());
+    FrameVector<int32_t> used(FrameArena::Resource());
+    
+    uint64_t top, topExtra;
+    sampleRow(0, top, topExtra);
+    for (int j = 0; j < SIZE; ++j) {
+        uint64_t bottom, bottomExtra;
+        sampleRow(j + 1, bottom, bottomExtra);
+        
+        // Bit i of the shifted rows is sample i + 1, i.e. the right-hand corners
+        uint64_t topRight = (top >> 1) | (topExtra << 63);
+        uint64_t bottomRight = (bottom >> 1) | (bottomExtra << 63);
+        
+        // Only squares whose four corners disagree produce segments
+        uint64_t mixed = (top ^ topRight) | (bottom ^ bottomRight) | (top ^ bottom);
+        while (mixed) {
+            int i = std::countr_zero(mixed);
+            mixed &= mixed - 1;
+            
+            int index = static_cast<int>(((top >> i) & 1u) << 3 | ((topRight >> i) & 1u) << 2 |
+                                         ((bottomRight >> i) & 1u) << 1 | ((bottom >> i) & 1u));
+            const int8_t* segments = SEGMENT_TABLE[index];
+            for (int s = 0; s < 4 && segments[s] >= 0; s += 2) {
+                int from = SideEdge(segments[s], i, j);
+                int to = SideEdge(segments[s + 1], i, j);
+                next[from] = to;
+                incoming[to] = 1;
+                used.push_back(from);
+            }
+        }
+        
+        top = bottom;
+        topExtra = bottomExtra;
+    }
+    
+    if (used.empty()) return;
+    
+    auto trace = [&](int start, bool closed) {
+        TerrainPolyline polyline;
+        polyline.closed = closed;
+        int edge = start;
+        while (edge >= 0) {
+            polyline.points.push_back(EdgePoint(edge, origin));
+            int following = next[edge];
+            next[edge] = -1;
+            edge = following;
+            if (edge == start) break;
+        }
+        Simplify(polyline, tolerance);
+        out.push_back(std::move(polyline));
+    };
+    
+    // Chains crossing the chunk border first, then the remaining closed loops
+    for (int edge : used) {
+        if (next[edge] >= 0 && !incoming[edge]) {
+            trace(edge, false);
+        }
+    }
+    for (int edge : used) {
+        if (next[edge] >= 0) {
+            trace(edge, true);
+        }
+    }
+}
+
+void ContourExtractor::Simplify(TerrainPolyline& polyline, float tolerance) {
+    std::vector<Vector2>& points = polyline.points;
+    if (tolerance <= 0.0f || points.size() < 3) return;
+    
+    const float toleranceSq = tolerance * tolerance;
+    FrameVector<uint8_t> keep(FrameArena::Resource());
+    FrameVector<std::pair<size_t, size_t>> stack(FrameArena::Resource());
+    
+    if (!polyline.closed) {
+        keep.assign(points.size(), 0);
+        keep.front() = 1;
+        keep.back() = 1;
+        SimplifyRange(points, 0, points.size() - 1, toleranceSq, keep, stack);
+    } else {
+        // Anchor the loop at its first point and the point farthest from it
+        size_t farthest = 0;
+        float maxDistance = 0.0f;
+        for (size_t k = 1; k < points.size(); ++k) {
+            float distance = (points[k] - points[0]).LengthSquared();
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                farthest = k;
+            }
+        }
+        
+        points.push_back(points[0]);
+        keep.assign(points.size(), 0);
+        keep[0] = 1;
+        keep[farthest] = 1;
+        keep.back() = 1;
+        SimplifyRange(points, 0, farthest, toleranceSq, keep, stack);
+        SimplifyRange(points, farthest, points.size() - 1, toleranceSq, keep, stack);
+        keep.back() = 0;
+        points.pop_back();
+        
+        // Small loops must stay at least a triangle
+        if (std::count(keep.begin(), keep.end(), uint8_t(1)) < 3) {
+            size_t best = 0;
+            float bestDistance = -1.0f;
+            for (size_t k = 1; k < points.size(); ++k) {
+                if (keep[k]) continue;
+                float distance = DistanceToSegmentSq(points[k], points[0], points[farthest]);
+                if (distance > bestDistance) {
+                    bestDistance = distance;
+                    best = k;
+                }
+            }
+            keep[best] = 1;
+        }
+    }
+    
+    size_t write = 0;
+    for (size_t k = 0; k < points.size(); ++k) {
+        if (keep[k]) {
+            points[write++] = points[k];
+        }
+    }
+    points.resize(write);
+}
+
+} // namespace BGE
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../../Core/Math/Vector2.h"
+#include <vector>
+#include <array>
+#include <cstdint>
+
+namespace BGE {
+
+// One bit per cell, one 64-bit word per chunk row
+using ChunkSolidMask = std::array<uint64_t, 64>;
+
+// Boundary of static terrain in world cell units. Walking from one point to the
+// next, solid is on the right (y down), so the outward normal of a segment is
+// (d.y, -d.x). Open polylines end on the chunk border and continue in the
+// neighbouring chunk's contours at exactly the same point.
+struct TerrainPolyline {
+    std::vector<Vector2> points;
+    bool closed = false;
+};
+
+// Contours extracted from one chunk's static-cell bitmap
+struct ChunkContours {
+    std::vector<TerrainPolyline> polylines;
+    
+    // Solid revisions of this chunk and its east, south and south-east
+    // neighbours at extraction time (0 = chunk missing / outside the world)
+    std::array<uint32_t, 4> sourceRevisions{};
+    float tolerance = 0.0f;
+    bool valid = false;
+    
+    size_t GetSegmentCount() const;
+};
+
+// Marching squares over cell centers followed by Douglas-Peucker simplification
+class ContourExtractor {
+public:
+    static constexpr float DEFAULT_TOLERANCE = 0.5f; // cells
+    
+    // 'east', 'south' and 'southEast' supply the extra sample column/row that
+    // joins the contours to the neighbouring chunks. A null neighbour repeats
+    // this chunk's edge samples, so no contour runs along that edge.
+    static void Extract(const ChunkSolidMask& mask, const ChunkSolidMask* east,
+                        const ChunkSolidMask* south, const ChunkSolidMask* southEast,
+                        const Vector2& origin, float tolerance, std::vector<TerrainPolyline>& out);
+    
+    // Douglas-Peucker in place; open polylines keep both end points
+    static void Simplify(TerrainPolyline& polyline, float tolerance);
+};
+
+} // namespace BGE
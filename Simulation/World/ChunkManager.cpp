@@ -1,6 +1,8 @@
 #include "ChunkManager.h"
 #include "../SimulationWorld.h"
 #include "../../Core/Threading/ThreadPool.h"
+#include "../../Core/Profiling/Profiler.h"
+#include "../../Core/Memory/FrameArena.h"
 
 namespace BGE {
 
@@ -10,11 +12,12 @@ ChunkManager::ChunkManager(SimulationWorld* world) : m_world(world) {
 ChunkManager::~ChunkManager() = default;
 
 void ChunkManager::Update(float deltaTime) {
+    BGE_PROFILE_SCOPE("ChunkManager::Update");
     if (m_threadPool && m_maxConcurrentChunks > 1) {
         UpdateParallel(deltaTime);
     } else {
         // Sequential update
-        std::vector<Chunk*> chunksToUpdate;
+        FrameVector<Chunk*> chunksToUpdate(FrameArena::Resource());
         
         {
             std::shared_lock lock(m_chunksMutex);
@@ -108,7 +111,8 @@ void ChunkManager::UnloadChunk(int chunkX, int chunkY) {
 }
 
 void ChunkManager::UnloadInactiveChunks() {
-    std::vector<ChunkCoord> chunksToUnload;
+    BGE_PROFILE_SCOPE("ChunkManager::UnloadInactiveChunks");
+    FrameVector<ChunkCoord> chunksToUnload(FrameArena::Resource());
     
     {
         std::shared_lock lock(m_chunksMutex);
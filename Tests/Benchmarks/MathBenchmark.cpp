@@ -0,0 +1,289 @@
+// Microbenchmark: current Matrix4/MathBatch code vs. the Matrix4 code it replaced.
+// Validates that both paths agree, then reports ns/op for each. The baselines are the
+// previous implementations verbatim, writing through __restrict outputs so the compiler
+// is not forced to reload inputs after every store; build with BGE_MATH_FORCE_SCALAR to
+// measure the scalar fallback against the same baselines.
+
+#include "../../Core/Math/MathBatch.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <random>
+
+using namespace BGE;
+
+namespace {
+
+volatile float g_sink = 0.0f;
+
+float RandomFloat(std::mt19937& rng, float lo, float hi) {
+    return std::uniform_real_distribution<float>(lo, hi)(rng);
+}
+
+Quaternion RandomRotation(std::mt19937& rng) {
+    return Quaternion::FromEuler(RandomFloat(rng, -3.0f, 3.0f), RandomFloat(rng, -3.0f, 3.0f),
+                                 RandomFloat(rng, -3.0f, 3.0f));
+}
+
+Matrix4 RandomTRS(std::mt19937& rng) {
+    Vector3 position(RandomFloat(rng, -100.0f, 100.0f), RandomFloat(rng, -100.0f, 100.0f), RandomFloat(rng, -100.0f, 100.0f));
+    Vector3 scale(RandomFloat(rng, 0.5f, 2.0f), RandomFloat(rng, 0.5f, 2.0f), RandomFloat(rng, 0.5f, 2.0f));
+    return Matrix4::TRS(position, RandomRotation(rng), scale);
+}
+
+// Previous Matrix4::operator*
+void LegacyMultiply(const float* m, const float* other, float* __restrict result) {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result[i + j * 4] = 0.0f;
+            for (int k = 0; k < 4; ++k) {
+                result[i + j * 4] += m[i + k * 4] * other[k + j * 4];
+            }
+        }
+    }
+}
+
+// Previous Matrix4::Inverse (cofactor expansion)
+void LegacyInverse(const float* m, float* __restrict inv) {
+    float det;
+    
+    inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + 
+             m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+    
+    inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - 
+             m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+    
+    inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + 
+             m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+    
+    inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - 
+              m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+    
+    inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - 
+             m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+    
+    inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + 
+             m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+    
+    inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - 
+             m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+    
+    inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + 
+              m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+    
+    inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + 
+             m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+    
+    inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - 
+             m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+    
+    inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + 
+              m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+    
+    inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - 
+              m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+    
+    inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - 
+             m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+    
+    inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + 
+             m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+    
+    inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - 
+              m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+    
+    inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + 
+              m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+    
+    det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+    
+    if (det == 0) {
+        Matrix4 identity = Matrix4::CreateIdentity();
+        for (int i = 0; i < 16; i++) inv[i] = identity.m[i];
+        return;
+    }
+    
+    det = 1.0f / det;
+    
+    for (int i = 0; i < 16; i++) {
+        inv[i] = inv[i] * det;
+    }
+}
+
+// Previous Matrix4::TRS: translation * rotation * scale as two full products
+void LegacyTRS(const Vector3& position, const Quaternion& rotation, const Vector3& scale, float* __restrict out) {
+    Matrix4 t = Matrix4::Translation(position);
+    Matrix4 r = Matrix4::Rotation(rotation);
+    Matrix4 s = Matrix4::Scale(scale);
+    Matrix4 tr;
+    LegacyMultiply(t.m, r.m, tr.m);
+    LegacyMultiply(tr.m, s.m, out);
+}
+
+bool NearlyEqual(const Matrix4& a, const Matrix4& b, float epsilon) {
+    for (int i = 0; i < 16; ++i) {
+        float scale = std::max(1.0f, std::abs(a.m[i]));
+        if (std::abs(a.m[i] - b.m[i]) > epsilon * scale) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Function>
+double TimeNsPerOp(size_t ops, int repeats, Function func) {
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        func();
+        auto end = std::chrono::high_resolution_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ops);
+        best = std::min(best, ns);
+    }
+    return best;
+}
+
+void Report(const char* name, double previousNs, double currentNs) {
+    std::printf("%-28s previous %8.2f ns   current %8.2f ns   speedup %5.2fx\n",
+                name, previousNs, currentNs, previousNs / currentNs);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100000;
+    const int repeats = 5;
+    std::mt19937 rng(1234);
+    
+    std::vector<Matrix4> lhs(count), rhs(count), out(count), ref(count);
+    std::vector<Vector3> positions(count), scales(count), points(count), pointsOut(count);
+    std::vector<Vector2> points2D(count), points2DOut(count);
+    std::vector<Quaternion> rotations(count);
+    
+    for (size_t i = 0; i < count; ++i) {
+        lhs[i] = RandomTRS(rng);
+        rhs[i] = RandomTRS(rng);
+        positions[i] = Vector3(RandomFloat(rng, -50.0f, 50.0f), RandomFloat(rng, -50.0f, 50.0f), RandomFloat(rng, -50.0f, 50.0f));
+        scales[i] = Vector3(RandomFloat(rng, 0.5f, 2.0f), RandomFloat(rng, 0.5f, 2.0f), RandomFloat(rng, 0.5f, 2.0f));
+        rotations[i] = RandomRotation(rng);
+        points[i] = positions[i];
+        points2D[i] = Vector2(positions[i].x, positions[i].y);
+    }
+    
+    std::printf("BGE math benchmark: backend=%s, count=%zu\n", SIMD::GetBackendName(), count);
+    
+    // Validation
+    int failures = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Matrix4 scalarProduct;
+        SIMD::Mat4MulScalar(lhs[i].m, rhs[i].m, scalarProduct.m);
+        if (!NearlyEqual(lhs[i] * rhs[i], scalarProduct, 1e-5f)) failures++;
+        Matrix4 legacyProduct;
+        LegacyMultiply(lhs[i].m, rhs[i].m, legacyProduct.m);
+        if (!NearlyEqual(lhs[i] * rhs[i], legacyProduct, 1e-5f)) failures++;
+        
+        Matrix4 scalarInverse;
+        SIMD::Mat4InverseScalar(lhs[i].m, scalarInverse.m);
+        if (!NearlyEqual(lhs[i].Inverse(), scalarInverse, 1e-4f)) failures++;
+        Matrix4 legacyInverse;
+        LegacyInverse(lhs[i].m, legacyInverse.m);
+        if (!NearlyEqual(lhs[i].Inverse(), legacyInverse, 1e-4f)) failures++;
+        if (!NearlyEqual(lhs[i] * lhs[i].Inverse(), Matrix4::CreateIdentity(), 1e-4f)) failures++;
+        
+        Matrix4 legacyTRS;
+        LegacyTRS(positions[i], rotations[i], scales[i], legacyTRS.m);
+        if (!NearlyEqual(Matrix4::TRS(positions[i], rotations[i], scales[i]), legacyTRS, 1e-5f)) failures++;
+        
+        Quaternion q = rotations[i] * rotations[(i + 1) % count];
+        Matrix4 composed = rotations[i].ToMatrix() * rotations[(i + 1) % count].ToMatrix();
+        if (!NearlyEqual(q.ToMatrix(), composed, 1e-4f)) failures++;
+    }
+    
+    MathBatch::TransformPoints(lhs[0], points.data(), pointsOut.data(), count);
+    MathBatch::TransformPoints2D(lhs[0], points2D.data(), points2DOut.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+        Vector3 expected = lhs[0].TransformPoint(points[i]);
+        if ((expected - pointsOut[i]).Length() > 1e-3f) failures++;
+        Vector3 expected2D = lhs[0].TransformPoint(Vector3(points2D[i].x, points2D[i].y, 0.0f));
+        if (std::abs(expected2D.x - points2DOut[i].x) > 1e-3f || std::abs(expected2D.y - points2DOut[i].y) > 1e-3f) failures++;
+    }
+    
+    std::printf("Validation: %s (%d mismatches)\n", failures == 0 ? "PASS" : "FAIL", failures);
+    
+    // Timings
+    Report("Matrix4 multiply",
+        TimeNsPerOp(count, repeats, [&]() {
+            for (size_t i = 0; i < count; ++i) LegacyMultiply(lhs[i].m, rhs[i].m, out[i].m);
+            g_sink = out[count / 2].m[5];
+        }),
+        TimeNsPerOp(count, repeats, [&]() {
+            for (size_t i = 0; i < count; ++i) out[i] = lhs[i] * rhs[i];
+            g_sink = out[count / 2].m[5];
+        }));
+    
+    Report("Matrix4 inverse",
+        TimeNsPerOp(count, repeats, [&]() {
+            for (size_t i = 0; i < count; ++i) LegacyInverse(lhs[i].m, out[i].m);
+            g_sink = out[count / 2].m[5];
+        }),
+        TimeNsPerOp(count, repeats, [&]() {
+            for (size_t i = 0; i < count; ++i) out[i] = lhs[i].Inverse();
+            g_sink = out[count / 2].m[5];
+        }));
+    
+    Report("Matrix4 TRS",
+        TimeNsPerOp(count, repeats, [&]() {
+            for (size_t i = 0; i < count; ++i) LegacyTRS(positions[i], rotations[i], scales[i], out[i].m);
+            g_sink = out[count / 2].m[5];
+        }),
+        TimeNsPerOp(count, repeats, [&]() {
+            for (size_t i = 0; i < count; ++i) out[i] = Matrix4::TRS(positions[i], rotations[i], scales[i]);
+            g_sink = out[count / 2].m[5];
+        }));
+    
+    Report("Batch ComposeTRS",
+        TimeNsPerOp(count, repeats, [&]() {
+            for (size_t i = 0; i < count; ++i) LegacyTRS(positions[i], rotations[i], scales[i], out[i].m);
+            g_sink = out[count / 2].m[5];
+        }),
+        TimeNsPerOp(count, repeats, [&]() {
+            MathBatch::ComposeTRS(positions.data(), rotations.data(), scales.data(), out.data(), count);
+            g_sink = out[count / 2].m[5];
+        }));
+    
+    Report("Batch parent * locals",
+        TimeNsPerOp(count, repeats, [&]() {
+            for (size_t i = 0; i < count; ++i) LegacyMultiply(lhs[0].m, rhs[i].m, out[i].m);
+            g_sink = out[count / 2].m[5];
+        }),
+        TimeNsPerOp(count, repeats, [&]() {
+            MathBatch::MultiplyMatrices(lhs[0], rhs.data(), out.data(), count);
+            g_sink = out[count / 2].m[5];
+        }));
+    
+    Report("Batch TransformPoints",
+        TimeNsPerOp(count, repeats, [&]() {
+            for (size_t i = 0; i < count; ++i) pointsOut[i] = lhs[0].TransformPoint(points[i]);
+            g_sink = pointsOut[count / 2].x;
+        }),
+        TimeNsPerOp(count, repeats, [&]() {
+            MathBatch::TransformPoints(lhs[0], points.data(), pointsOut.data(), count);
+            g_sink = pointsOut[count / 2].x;
+        }));
+    
+    Report("Batch TransformPoints2D",
+        TimeNsPerOp(count, repeats, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                Vector3 p = lhs[0].TransformPoint(Vector3(points2D[i].x, points2D[i].y, 0.0f));
+                points2DOut[i] = Vector2(p.x, p.y);
+            }
+            g_sink = points2DOut[count / 2].x;
+        }),
+        TimeNsPerOp(count, repeats, [&]() {
+            MathBatch::TransformPoints2D(lhs[0], points2D.data(), points2DOut.data(), count);
+            g_sink = points2DOut[count / 2].x;
+        }));
+    
+    return failures == 0 ? 0 : 1;
+}
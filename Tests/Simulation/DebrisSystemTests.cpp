@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "../../Simulation/SimulationWorld.h"
+#include "../../Simulation/Physics/DebrisSystem.h"
+#include "../../Simulation/Materials/MaterialSystem.h"
+#include <memory>
+
+using namespace BGE;
+
+class DebrisSystemTest : public ::testing::Test {
+protected:
+    static constexpr int WORLD_SIZE = 128;
+    static constexpr int FLOOR_Y = 100;
+    static constexpr float TIME_STEP = 1.0f / 60.0f;
+    
+    void SetUp() override {
+        m_world = std::make_unique<SimulationWorld>(WORLD_SIZE, WORLD_SIZE);
+        m_floor = m_world->GetMaterialSystem()->CreateMaterialBuilder("TestFloor")
+            .SetBehavior(MaterialBehavior::Static);
+        m_debris = m_world->GetMaterialSystem()->CreateMaterialBuilder("TestDebris")
+            .SetBehavior(MaterialBehavior::Static);
+        
+        for (int x = 0; x < WORLD_SIZE; ++x) {
+            m_world->SetMaterial(x, FLOOR_Y, m_floor);
+        }
+    }
+    
+    void TearDown() override {
+        m_world.reset();
+    }
+    
+    // Steps only the debris system so the cellular automaton can't move the result
+    void RunUntilSettled(int maxSteps) {
+        DebrisSystem* debris = m_world->GetDebrisSystem();
+        for (int i = 0; i < maxSteps && (i == 0 || debris->GetCount() > 0); ++i) {
+            debris->Update(TIME_STEP);
+        }
+    }
+    
+    std::unique_ptr<SimulationWorld> m_world;
+    MaterialID m_floor = MATERIAL_EMPTY;
+    MaterialID m_debris = MATERIAL_EMPTY;
+};
+
+// Debris dropped onto the floor comes back as a fresh cell of its material
+TEST_F(DebrisSystemTest, DepositRoundTripRestoresMaterialDefaults) {
+    const int x = 40;
+    const int landingY = FLOOR_Y - 1;
+    
+    // Leave a stale temperature behind in the landing cell
+    m_world->SetTemperature(x, landingY, 900.0f);
+    ASSERT_EQ(m_world->GetCell(x, landingY).material, MATERIAL_EMPTY);
+    
+    DebrisSpawn spawn;
+    spawn.x = x + 0.5f;
+    spawn.y = 80.5f;
+    spawn.material = m_debris;
+    ASSERT_EQ(m_world->GetDebrisSystem()->Spawn({spawn}), 1u);
+    
+    RunUntilSettled(600);
+    
+    EXPECT_EQ(m_world->GetDebrisSystem()->GetCount(), 0u);
+    const Cell& cell = m_world->GetCell(x, landingY);
+    EXPECT_EQ(cell.material, m_debris);
+    EXPECT_FLOAT_EQ(cell.temperature, Cell{}.temperature);
+    EXPECT_EQ(cell.flags, 0);
+    EXPECT_EQ(cell.velocity_x, 0);
+    EXPECT_EQ(cell.velocity_y, 0);
+    EXPECT_EQ(cell.life, 0);
+    
+    // Nothing else in the column was written
+    EXPECT_EQ(m_world->GetCell(x, landingY - 1).material, MATERIAL_EMPTY);
+    EXPECT_EQ(m_world->GetCell(x, FLOOR_Y).material, m_floor);
+}
+
+// A second deposit on the same column stacks on top of the first
+TEST_F(DebrisSystemTest, DepositsStackInOccupiedColumn) {
+    const int x = 60;
+    
+    DebrisSpawn spawn;
+    spawn.x = x + 0.5f;
+    spawn.y = 70.5f;
+    spawn.material = m_debris;
+    ASSERT_EQ(m_world->GetDebrisSystem()->Spawn({spawn}), 1u);
+    RunUntilSettled(600);
+    
+    m_world->SetTemperature(x, FLOOR_Y - 2, -50.0f);
+    ASSERT_EQ(m_world->GetDebrisSystem()->Spawn({spawn}), 1u);
+    RunUntilSettled(600);
+    
+    EXPECT_EQ(m_world->GetCell(x, FLOOR_Y - 1).material, m_debris);
+    EXPECT_EQ(m_world->GetCell(x, FLOOR_Y - 2).material, m_debris);
+    EXPECT_FLOAT_EQ(m_world->GetCell(x, FLOOR_Y - 2).temperature, Cell{}.temperature);
+    EXPECT_EQ(m_world->GetCell(x, FLOOR_Y - 3).material, MATERIAL_EMPTY);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "../../Simulation/Physics/PhysicsWorld.h"
+#include <cmath>
+#include <vector>
+
+using namespace BGE;
+
+class PhysicsWorldTest : public ::testing::Test {
+protected:
+    static constexpr float TIME_STEP = 1.0f / 60.0f;
+    
+    void SetUp() override {
+        m_world = std::make_unique<PhysicsWorld>();
+        m_world->SetGravity(Vector2(0.0f, 9.81f));
+        
+        m_ground = m_world->CreateRigidBody();
+        m_ground->SetBox(Vector2(20.0f, 0.5f));
+        m_ground->SetPosition(Vector2(0.0f, 10.0f));
+        m_ground->SetStatic(true);
+    }
+    
+    void TearDown() override {
+        m_world.reset();
+    }
+    
+    // Unit box resting with its bottom face at groundTop - level (y points down)
+    RigidBody* CreateStackedBox(int level) {
+        RigidBody* box = m_world->CreateRigidBody();
+        box->SetBox(Vector2(0.5f, 0.5f));
+        box->SetPosition(Vector2(0.0f, GROUND_TOP - 0.5f - static_cast<float>(level)));
+        return box;
+    }
+    
+    void Step(int steps) {
+        for (int i = 0; i < steps; ++i) {
+            m_world->Update(TIME_STEP);
+        }
+    }
+    
+    // Every contact must reference live bodies whose IDs match its key
+    void ExpectContactsConsistent() const {
+        const auto& bodies = m_world->GetBodies();
+        for (const Contact& contact : m_world->GetContacts()) {
+            ASSERT_LT(contact.indexA, bodies.size());
+            EXPECT_EQ(bodies[contact.indexA]->GetID(), static_cast<uint32_t>(contact.key >> 32));
+            if (!contact.terrain) {
+                ASSERT_LT(contact.indexB, bodies.size());
+                EXPECT_EQ(bodies[contact.indexB]->GetID(), static_cast<uint32_t>(contact.key & 0xFFFFFFFFu));
+            }
+        }
+    }
+    
+    bool InContact(const RigidBody* a, const RigidBody* b) const {
+        const auto& bodies = m_world->GetBodies();
+        for (const Contact& contact : m_world->GetContacts()) {
+            if (contact.terrain) continue;
+            const RigidBody* bodyA = bodies[contact.indexA].get();
+            const RigidBody* bodyB = bodies[contact.indexB].get();
+            if ((bodyA == a && bodyB == b) || (bodyA == b && bodyB == a)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    static constexpr float GROUND_TOP = 9.5f;
+    
+    std::unique_ptr<PhysicsWorld> m_world;
+    RigidBody* m_ground = nullptr;
+};
+
+// A stack settles in place without drifting and eventually falls asleep
+TEST_F(PhysicsWorldTest, RestingStackStaysInPlaceAndSleeps) {
+    const int STACK_HEIGHT = 4;
+    std::vector<RigidBody*> boxes;
+    for (int level = 0; level < STACK_HEIGHT; ++level) {
+        boxes.push_back(CreateStackedBox(level));
+    }
+    
+    Step(600);
+    
+    for (int level = 0; level < STACK_HEIGHT; ++level) {
+        Vector2 expected(0.0f, GROUND_TOP - 0.5f - static_cast<float>(level));
+        Vector2 position = boxes[level]->GetPosition();
+        EXPECT_NEAR(position.x, expected.x, 0.05f) << "level " << level;
+        EXPECT_NEAR(position.y, expected.y, 0.1f) << "level " << level;
+        EXPECT_LT(boxes[level]->GetVelocity().Length(), 0.05f) << "level " << level;
+        EXPECT_TRUE(boxes[level]->IsSleeping()) << "level " << level;
+    }
+    ExpectContactsConsistent();
+}
+
+// Removing a body from the middle of a resting stack wakes what sat on it and
+// leaves no contacts pointing at the removed slot or the swapped-in body's old slot
+TEST_F(PhysicsWorldTest, DestroyDuringContactWakesAndRemapsContacts) {
+    RigidBody* bottom = CreateStackedBox(0);
+    RigidBody* middle = CreateStackedBox(1);
+    RigidBody* top = CreateStackedBox(2);
+    
+    // A separate resting box created last, so destroying the middle box swaps it into place
+    RigidBody* side = m_world->CreateRigidBody();
+    side->SetBox(Vector2(0.5f, 0.5f));
+    side->SetPosition(Vector2(5.0f, GROUND_TOP - 0.5f));
+    
+    Step(600);
+    ASSERT_TRUE(top->IsSleeping());
+    ASSERT_TRUE(InContact(middle, top));
+    ASSERT_TRUE(InContact(bottom, middle));
+    
+    m_world->DestroyRigidBody(middle);
+    
+    EXPECT_EQ(m_world->GetBodies().size(), 4u);
+    EXPECT_FALSE(top->IsSleeping());
+    EXPECT_FALSE(bottom->IsSleeping());
+    ExpectContactsConsistent();
+    EXPECT_TRUE(InContact(side, m_ground));
+    
+    // The top box drops onto the bottom one and settles there
+    Step(600);
+    ExpectContactsConsistent();
+    EXPECT_TRUE(InContact(bottom, top));
+    EXPECT_NEAR(top->GetPosition().y, GROUND_TOP - 1.5f, 0.1f);
+    EXPECT_NEAR(side->GetPosition().x, 5.0f, 0.05f);
+}
+
+// Destroying the last body leaves the remaining contacts untouched
+TEST_F(PhysicsWorldTest, DestroyLastBodyKeepsOtherContacts) {
+    RigidBody* bottom = CreateStackedBox(0);
+    RigidBody* top = CreateStackedBox(1);
+    
+    Step(120);
+    ASSERT_TRUE(InContact(bottom, top));
+    
+    m_world->DestroyRigidBody(top);
+    
+    ExpectContactsConsistent();
+    EXPECT_TRUE(InContact(bottom, m_ground));
+    EXPECT_FALSE(bottom->IsSleeping());
+}